@@ -65,6 +65,9 @@ private:
     Model                               m_Model;
     asdx::ResMotion                     m_Motion;
     asdx::MotionPlayer                  m_MotionPlayer;
+    asdx::BoundingBox                   m_ModelBounds;      //!< 現在の姿勢のモデルのバウンディングボックスです.
+    asdx::ViewFrustum                   m_ViewFrustum;      //!< モデルの可視判定に用いる視錐台です.
+    asdx::OcclusionBuffer               m_Occlusion;        //!< サブセットの可視判定に用いるオクルージョンバッファです.
     asdx::RefPtr<ID3D12RootSignature>   m_RootSignature;
     asdx::RefPtr<ID3D12PipelineState>   m_PSO;
     asdx::GraphicsCommandList           m_Bundle;
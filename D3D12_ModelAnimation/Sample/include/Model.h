@@ -16,6 +16,7 @@
 #include <asdxIndexBuffer.h>
 #include <asdxConstantBuffer.h>
 #include <asdxResMesh.h>
+#include <asdxOcclusion.h>
 #include <vector>
 #include <d3d12.h>
 
@@ -103,6 +104,25 @@ public:
     //---------------------------------------------------------------------------------------------
     void DrawCmd( ID3D12GraphicsCommandList* pCmd );
 
+    //---------------------------------------------------------------------------------------------
+    //! @brief      遮蔽物に隠れていないサブセットのみ描画コマンドを発行します.
+    //!
+    //! @details    サブセットの判定には, サブセットが参照するボーンのボックスを現在の姿勢で
+    //!             変換してマージしたボックスを用います. pBoneTransforms が nullptr の場合は
+    //!             バインドポーズのボックスを用いるため, 静的なメッシュにのみ使えます.
+    //!
+    //! @param[in]      pCmd            コマンドリストです.
+    //! @param[in]      occlusion       遮蔽物を描画済みのオクルージョンバッファです.
+    //! @param[in]      world           ワールド行列です.
+    //! @param[in]      pBoneTransforms ボーンのワールド行列です(MotionPlayer::GetWorldTransforms()). ボーン数分必要です.
+    //! @return     描画したサブセット数を返却します.
+    //---------------------------------------------------------------------------------------------
+    u32 DrawCmd(
+        ID3D12GraphicsCommandList*      pCmd,
+        const asdx::OcclusionBuffer&    occlusion,
+        const asdx::Matrix&             world,
+        const asdx::Matrix*             pBoneTransforms );
+
     //---------------------------------------------------------------------------------------------
     //! @brief      ボーンを取得します.
     //---------------------------------------------------------------------------------------------
@@ -110,6 +130,11 @@ public:
 
     u32 GetBoneCount() const;
 
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ボーンごとのバウンディングボックスを取得します.
+    //---------------------------------------------------------------------------------------------
+    const asdx::BoundingBox* GetBoneBoxes() const;
+
 private:
     //=============================================================================================
     // private variables.
@@ -117,7 +142,14 @@ private:
     std::vector<SkinningVertex>     m_Vertices;     //!< 頂点データ.
     std::vector<u32>                m_Indices;      //!< インデックスデータ.
     std::vector<asdx::ResBone>      m_Bones;        //!< ボーンです.
+    std::vector<asdx::BoundingBox>  m_BoneBoxes;    //!< ボーンごとのバウンディングボックスです.
     std::vector<asdx::ResSubset>    m_Subsets;      //!< サブセットです.
+    std::vector<asdx::BoundingBox>  m_SubsetBoxes;  //!< サブセットのバウンディングボックスです.
+    std::vector<u32>                m_SubsetBoneOffsets;    //!< サブセットごとの m_SubsetBones の開始位置です. サブセット数 + 1 個あります.
+    std::vector<u32>                m_SubsetBones;          //!< サブセットの頂点が参照するボーン番号です.
+    std::vector<asdx::BoundingBox>  m_PosedBoneBoxes;       //!< 現在の姿勢のボーンごとのボックスです.
+    std::vector<asdx::BoundingBox>  m_PosedSubsetBoxes;     //!< 現在の姿勢のサブセットのボックスです.
+    std::vector<u32>                m_VisibleMask;  //!< サブセットの可視判定結果です.
     std::vector<asdx::ResTexture>   m_ResTextures;  //!< テクスチャ.
     std::vector<Material>           m_Materials;    //!< マテリアルです.
     u8*                             m_pHeadCB;      //!< 定数バッファの戦闘ポインタ.
@@ -132,6 +164,11 @@ private:
     asdx::RefPtr<ID3D12Resource>    m_DummyTexture;
     asdx::DescHandle                m_DummySRV;
 
+    void SetupDrawCmd( ID3D12GraphicsCommandList* pCmd );
+    void DrawSubsetCmd( ID3D12GraphicsCommandList* pCmd, size_t index );
+    void CalcSubsetBones( const asdx::ResMesh& mesh );
+    void CalcPosedSubsetBoxes( const asdx::Matrix* pBoneTransforms );
+
     bool CreateTexture(
         asdx::Device& device,
         const asdx::ResTexture& texture,
@@ -40,7 +40,7 @@ cbuffer Transform : register( b0 )
     float4x4 World;
     float4x4 View;
     float4x4 Proj;
-    float4x4 Bones[256];
+    row_major float2x4 Bones[256];     // oΎl(, oΕ).
 };
 
 cbuffer Material : register( b1 )
@@ -19,16 +19,25 @@ VSOutput VSFunc(VSInput input)
 
     float4 localPos = float4(input.Position, 1.0f);
 
-    float4x4 skinning = (float4x4)0;
-    skinning += Bones[input.BoneIndex.x] * input.BoneWeight.x;
-    skinning += Bones[input.BoneIndex.y] * input.BoneWeight.y;
+    // oΎl𓯂ɑĐ`uh.
+    float2x4 dq0 = Bones[input.BoneIndex.x];
+    float2x4 dq1 = Bones[input.BoneIndex.y];
+    float    w1  = (dot(dq0[0], dq1[0]) < 0.0f) ? -input.BoneWeight.y : input.BoneWeight.y;
 
-    float4 transPos = mul(skinning, localPos);
+    float2x4 skinning = dq0 * input.BoneWeight.x + dq1 * w1;
+    skinning /= length(skinning[0]);
+
+    float4 real = skinning[0];
+    float4 dual = skinning[1];
+
+    float3 translation = 2.0f * (real.w * dual.xyz - dual.w * real.xyz + cross(real.xyz, dual.xyz));
+
+    float4 transPos = float4(localPos.xyz + 2.0f * cross(real.xyz, cross(real.xyz, localPos.xyz) + real.w * localPos.xyz) + translation, 1.0f);
     float4 worldPos = mul(World, transPos);
     float4 viewPos  = mul(View, worldPos);
     float4 projPos  = mul(Proj, viewPos);
 
-    float3 transNormal = mul((float3x3)skinning, input.Normal);
+    float3 transNormal = input.Normal + 2.0f * cross(real.xyz, cross(real.xyz, input.Normal) + real.w * input.Normal);
     float3 worldNormal = mul((float3x3)World, transNormal);
     worldNormal = normalize(worldNormal);
 
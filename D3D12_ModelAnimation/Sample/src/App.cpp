@@ -126,6 +126,15 @@ bool App::OnInit()
         m_ScissorRect.bottom = m_Height;
     }
 
+    // オクルージョンバッファの初期化. 可視判定用なので画面より粗い解像度にする.
+    {
+        if ( !m_Occlusion.Init( 320, 176 ) )
+        {
+            ELOG( "Error : OcclusionBuffer::Init() Failed." );
+            return false;
+        }
+    }
+
     // ルートシグニチャを生成.
     {
         D3D12_DESCRIPTOR_RANGE range[3];
@@ -284,6 +293,12 @@ bool App::OnInit()
         asdx::Vector3(0.0f, 1.0f, 0.0f));
     m_TransformParam.Proj  = asdx::Matrix::CreatePerspectiveFieldOfView( asdx::F_PIDIV4, aspectRatio, 1.0f, 1000.0f );
 
+    m_ViewFrustum.SetPerspective( asdx::F_PIDIV4, aspectRatio, 1.0f, 1000.0f );
+    m_ViewFrustum.SetLookAt(
+        asdx::Vector3(0.0f, 15.0f, -35.0f),
+        asdx::Vector3(0.0f, 10.0f, 0.0f),
+        asdx::Vector3(0.0f, 1.0f, 0.0f));
+
     if ( !InitModel() )
     {
         ELOG( "Error : InitModel() Failed." );
@@ -342,13 +357,14 @@ bool App::InitModel()
         m_MotionPlayer.SetMotion( &m_Motion );
         m_MotionPlayer.SetLoop( false );
         m_MotionPlayer.Update( 0.0f );
+        m_ModelBounds = m_MotionPlayer.CalcSkinnedBounds( m_Model.GetBoneBoxes() );
     }
 
     // 定数バッファ生成.
 
     {
         u32 size = asdx::RoundUp(
-            static_cast<u32>( sizeof(m_TransformParam) + sizeof(asdx::Matrix) * 256 ),
+            static_cast<u32>( sizeof(m_TransformParam) + sizeof(asdx::DualQuaternion) * 256 ),
             256 );
 
         if ( !m_TransformCB.Init( m_Device.GetDevice(), size ) )
@@ -358,7 +374,7 @@ bool App::InitModel()
         }
 
         m_TransformCB.Update( &m_TransformParam, sizeof(m_TransformParam) );
-        m_TransformCB.Update( m_MotionPlayer.GetSkinTransforms(), sizeof(asdx::Matrix) * m_MotionPlayer.GetTransformCount(), 0, sizeof(m_TransformParam) );
+        m_TransformCB.Update( m_MotionPlayer.GetSkinDualQuaternions(), sizeof(asdx::DualQuaternion) * m_MotionPlayer.GetTransformCount(), 0, sizeof(m_TransformParam) );
 
         D3D12_CONSTANT_BUFFER_VIEW_DESC desc = {};
         desc.SizeInBytes    = size;
@@ -411,6 +427,7 @@ void App::OnTerm()
 {
     TermModel();
 
+    m_Occlusion.Term();
     m_DeviceContext.Term();
     m_Device.Term();
 }
@@ -436,7 +453,8 @@ void App::OnFrameMove(const asdx::FrameEventArgs& args)
     if ( m_StopWatch.GetElapsedSec() > 0.8 && m_IsPlay )
     {
         m_MotionPlayer.Update( f32(args.ElapsedSec) * 30.0f );
-        m_TransformCB.Update( m_MotionPlayer.GetSkinTransforms(), sizeof(asdx::Matrix) * m_MotionPlayer.GetTransformCount(), 0, sizeof(m_TransformParam) );
+        m_ModelBounds = m_MotionPlayer.CalcSkinnedBounds( m_Model.GetBoneBoxes() );
+        m_TransformCB.Update( m_MotionPlayer.GetSkinDualQuaternions(), sizeof(asdx::DualQuaternion) * m_MotionPlayer.GetTransformCount(), 0, sizeof(m_TransformParam) );
     }
 }
 
@@ -468,7 +486,19 @@ void App::OnFrameRender(const asdx::FrameEventArgs& args)
     auto handleCBV = m_TransformHandle.GetHandleGpu();
     m_DeviceContext->SetGraphicsRootDescriptorTable( 0, handleCBV );
 
-    m_Model.DrawCmd( m_DeviceContext.GetGraphicsCommandList() );
+    // 現在の姿勢のモデル全体が視錐台の外にあれば, サブセットごとの判定を省略する.
+    auto worldBounds = asdx::BoundingBox::CreateFromTransformedBoxes( &m_ModelBounds, &m_TransformParam.World, 1 );
+    if ( m_ViewFrustum.Contains( worldBounds ) )
+    {
+        // 遮蔽物を描画する場合は Clear() と DrawCmd() の間で RenderMesh() を呼ぶ.
+        // 遮蔽物がなくても画面外のサブセットは描画しない.
+        m_Occlusion.Clear( m_TransformParam.View * m_TransformParam.Proj );
+        m_Model.DrawCmd(
+            m_DeviceContext.GetGraphicsCommandList(),
+            m_Occlusion,
+            m_TransformParam.World,
+            m_MotionPlayer.GetWorldTransforms() );
+    }
 
     m_DeviceContext.Transition(
         m_ColorTarget[m_FrameIndex].GetResource(),
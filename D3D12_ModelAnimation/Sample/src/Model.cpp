@@ -63,9 +63,14 @@ bool Model::Init
             m_Vertices[i].BoneWeights.y = mesh.BoneWeights[i].y;
         }
 
-        m_Subsets = mesh.Subsets;
+        m_Subsets     = mesh.Subsets;
+        m_SubsetBoxes = mesh.SubsetBoxes;
+        m_VisibleMask.resize( ( m_Subsets.size() + 31 ) / 32 );
         m_Indices = mesh.VertexIndices;
         m_Bones   = mesh.Bones;
+        m_BoneBoxes = mesh.BoneBoxes;
+
+        CalcSubsetBones( mesh );
     }
 
     u32 materialCount = 0;
@@ -239,6 +244,15 @@ void Model::Term()
     m_Subsets  .clear();
     m_Bones    .clear();
 
+    m_SubsetBoxes.clear();
+    m_BoneBoxes  .clear();
+    m_VisibleMask.clear();
+
+    m_SubsetBoneOffsets.clear();
+    m_SubsetBones      .clear();
+    m_PosedBoneBoxes   .clear();
+    m_PosedSubsetBoxes .clear();
+
     m_ResTextures.clear();
     m_Textures   .clear();
 
@@ -329,22 +343,155 @@ void Model::DrawCmd( ID3D12GraphicsCommandList* pCmd )
 {
     assert( pCmd != nullptr );
 
+    SetupDrawCmd( pCmd );
+
+    for( size_t i=0; i<m_Subsets.size(); ++i )
+    { DrawSubsetCmd( pCmd, i ); }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      遮蔽物に隠れていないサブセットのみ描画コマンドを発行します.
+//-------------------------------------------------------------------------------------------------
+u32 Model::DrawCmd
+(
+    ID3D12GraphicsCommandList*      pCmd,
+    const asdx::OcclusionBuffer&    occlusion,
+    const asdx::Matrix&             world,
+    const asdx::Matrix*             pBoneTransforms
+)
+{
+    assert( pCmd != nullptr );
+    assert( m_SubsetBoxes.size() == m_Subsets.size() );
+
+    if ( pBoneTransforms != nullptr )
+    {
+        CalcPosedSubsetBoxes( pBoneTransforms );
+        occlusion.TestBoxes( world, m_PosedSubsetBoxes.data(), u32( m_PosedSubsetBoxes.size() ), m_VisibleMask.data() );
+    }
+    else
+    {
+        occlusion.TestBoxes( world, m_SubsetBoxes.data(), u32( m_SubsetBoxes.size() ), m_VisibleMask.data() );
+    }
+
+    SetupDrawCmd( pCmd );
+
+    u32 count = 0;
+    for( size_t i=0; i<m_Subsets.size(); ++i )
+    {
+        if ( ( m_VisibleMask[i / 32] & ( 1u << ( i % 32 ) ) ) == 0 )
+        { continue; }
+
+        DrawSubsetCmd( pCmd, i );
+        count++;
+    }
+
+    return count;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      サブセット共通の描画設定を行います.
+//-------------------------------------------------------------------------------------------------
+void Model::SetupDrawCmd( ID3D12GraphicsCommandList* pCmd )
+{
     auto vbv = m_VB.GetView();
     auto ibv = m_IB.GetView();
 
     pCmd->IASetPrimitiveTopology( D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
     pCmd->IASetVertexBuffers( 0, 1, &vbv );
     pCmd->IASetIndexBuffer( &ibv );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      サブセットの描画コマンドを発行します.
+//-------------------------------------------------------------------------------------------------
+void Model::DrawSubsetCmd( ID3D12GraphicsCommandList* pCmd, size_t index )
+{
+    auto materialId = m_Subsets[index].MaterialId;
+    auto textureId  = m_Materials[materialId].TextureId;
+
+    auto handleSRV = ( textureId != U32_MAX ) ? m_SRV[textureId].GetHandleGpu() : m_DummySRV.GetHandleGpu();
+    pCmd->SetGraphicsRootDescriptorTable( 1, handleSRV );
+    pCmd->SetGraphicsRootDescriptorTable( 2, m_CBV[materialId].GetHandleGpu() );
+    pCmd->DrawIndexedInstanced( m_Subsets[index].Count, 1, m_Subsets[index].Offset, 0, 0 );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      サブセットの頂点が参照するボーンを求めます.
+//-------------------------------------------------------------------------------------------------
+void Model::CalcSubsetBones( const asdx::ResMesh& mesh )
+{
+    const auto boneCount   = u32( mesh.Bones.size() );
+    const auto vertexCount = mesh.Positions.size();
+    const auto hasWeights  = mesh.BoneIndices.size() >= vertexCount && mesh.BoneWeights.size() >= vertexCount;
+
+    m_SubsetBoneOffsets.clear();
+    m_SubsetBones      .clear();
+    m_SubsetBoneOffsets.reserve( m_Subsets.size() + 1 );
+
+    // 同じサブセット内での重複を, 最後に追加したサブセット番号 + 1 で判定する.
+    std::vector<u32> marks( boneCount, 0 );
+
+    for( size_t i=0; i<m_Subsets.size(); ++i )
+    {
+        m_SubsetBoneOffsets.push_back( u32( m_SubsetBones.size() ) );
+        if ( !hasWeights )
+        { continue; }
+
+        const auto mark = u32( i + 1 );
+        const auto& subset = m_Subsets[i];
+        for( u32 j=0; j<subset.Count; ++j )
+        {
+            auto vertexId = m_Indices[subset.Offset + j];
+            const auto& indices = mesh.BoneIndices[vertexId];
+            const auto& weights = mesh.BoneWeights[vertexId];
+
+            const u32 bones[4] = { indices.x, indices.y, indices.z, indices.w };
+            const f32 values[4] = { weights.x, weights.y, weights.z, weights.w };
+
+            for( u32 k=0; k<4; ++k )
+            {
+                if ( values[k] <= 0.0f || bones[k] >= boneCount || marks[bones[k]] == mark )
+                { continue; }
+
+                marks[bones[k]] = mark;
+                m_SubsetBones.push_back( bones[k] );
+            }
+        }
+    }
+
+    m_SubsetBoneOffsets.push_back( u32( m_SubsetBones.size() ) );
+
+    m_PosedBoneBoxes  .resize( boneCount );
+    m_PosedSubsetBoxes.resize( m_Subsets.size() );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      現在の姿勢のサブセットのボックスを求めます.
+//-------------------------------------------------------------------------------------------------
+void Model::CalcPosedSubsetBoxes( const asdx::Matrix* pBoneTransforms )
+{
+    assert( pBoneTransforms != nullptr );
+
+    for( size_t i=0; i<m_BoneBoxes.size(); ++i )
+    { m_PosedBoneBoxes[i] = asdx::BoundingBox::CreateFromTransformedBoxes( &m_BoneBoxes[i], &pBoneTransforms[i], 1 ); }
 
     for( size_t i=0; i<m_Subsets.size(); ++i )
     {
-        auto materialId = m_Subsets[i].MaterialId;
-        auto textureId = m_Materials[materialId].TextureId;
+        auto begin = m_SubsetBoneOffsets[i];
+        auto end   = m_SubsetBoneOffsets[i + 1];
+
+        // ボーンの影響を受けないサブセットはバインドポーズのまま動かない.
+        if ( begin == end )
+        {
+            m_PosedSubsetBoxes[i] = m_SubsetBoxes[i];
+            continue;
+        }
 
-        auto handleSRV = ( textureId != U32_MAX ) ? m_SRV[textureId].GetHandleGpu() : m_DummySRV.GetHandleGpu();
-        pCmd->SetGraphicsRootDescriptorTable( 1, handleSRV );
-        pCmd->SetGraphicsRootDescriptorTable( 2, m_CBV[materialId].GetHandleGpu() );
-        pCmd->DrawIndexedInstanced( m_Subsets[i].Count, 1, m_Subsets[i].Offset, 0, 0 );
+        asdx::BoundingBox box;
+        for( auto j=begin; j<end; ++j )
+        { box = asdx::BoundingBox::Merge( box, m_PosedBoneBoxes[m_SubsetBones[j]] ); }
+
+        m_PosedSubsetBoxes[i] = box;
     }
 }
 
@@ -353,3 +500,6 @@ asdx::ResBone* Model::GetBones()
 
 u32 Model::GetBoneCount() const
 { return static_cast<u32>( m_Bones.size() ); }
+
+const asdx::BoundingBox* Model::GetBoneBoxes() const
+{ return m_BoneBoxes.data(); }
@@ -0,0 +1,281 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxBench.cpp
+// Desc : Micro Benchmark Runner.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "asdxBench.h"
+#include <asdxCpuInfo.h>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+
+
+namespace /* anonymous */ {
+
+using namespace asdx;
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const SimdTier TIER_LIST[] = {
+    SimdTier::Scalar,
+    SimdTier::SSE2,
+    SimdTier::SSE4_1,
+    SimdTier::AVX2,
+    SimdTier::AVX512,
+    SimdTier::NEON,
+};
+
+//-------------------------------------------------------------------------------------------------
+//      英数字以外を除いて小文字で比較します("avx512" と "AVX-512" を同じとみなします).
+//-------------------------------------------------------------------------------------------------
+bool IsSameName( const char* a, const char* b )
+{
+    for( ;; )
+    {
+        while ( *a != '\0' && !isalnum( u8( *a ) ) ) { ++a; }
+        while ( *b != '\0' && !isalnum( u8( *b ) ) ) { ++b; }
+
+        if ( *a == '\0' || *b == '\0' )
+        { return ( *a == *b ); }
+
+        if ( tolower( u8( *a ) ) != tolower( u8( *b ) ) )
+        { return false; }
+
+        ++a;
+        ++b;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      "--key=value" 形式の引数であれば value を返却します.
+//-------------------------------------------------------------------------------------------------
+const char* GetOption( const char* arg, const char* key )
+{
+    auto len = strlen( key );
+    if ( strncmp( arg, key, len ) == 0 && arg[len] == '=' )
+    { return arg + len + 1; }
+
+    return nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      JSON文字列として書き出します.
+//-------------------------------------------------------------------------------------------------
+void WriteString( FILE* pFile, const char* value )
+{
+    fputc( '"', pFile );
+    for( auto p = value; *p != '\0'; ++p )
+    {
+        if ( *p == '"' || *p == '\\' )
+        { fputc( '\\', pFile ); }
+        fputc( *p, pFile );
+    }
+    fputc( '"', pFile );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      コンパイラ名を取得します.
+//-------------------------------------------------------------------------------------------------
+const char* GetCompilerName()
+{
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc";
+#else
+    return "unknown";
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+//      使用方法を表示します.
+//-------------------------------------------------------------------------------------------------
+void PrintUsage( const char* exe )
+{
+    fprintf( stderr,
+        "usage: %s [options]\n"
+        "  --filter=<text>     run benchmarks whose name contains <text>.\n"
+        "  --tier=<name>       limit the SIMD tier (scalar, sse2, sse4.1, avx2, avx512, neon).\n"
+        "  --min-time=<sec>    minimum measuring time per benchmark (default 0.5).\n"
+        "  --repeat=<count>    number of samples per benchmark (default 5).\n"
+        "  --out=<path>        write JSON to <path> instead of stdout.\n",
+        exe );
+}
+
+} // namespace /* anonymous */
+
+
+namespace asdx {
+namespace bench {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Runner class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------------
+Runner::Runner( f64 minTime, u32 repeat, const std::string& filter )
+: m_MinTime ( minTime )
+, m_Repeat  ( ( repeat > 0 ) ? repeat : 1 )
+, m_Filter  ( filter )
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------------
+//      実行対象のベンチマークかどうか判定します.
+//-------------------------------------------------------------------------------------------------
+bool Runner::IsEnabled( const char* name ) const
+{ return m_Filter.empty() || strstr( name, m_Filter.c_str() ) != nullptr; }
+
+//-------------------------------------------------------------------------------------------------
+//      計測結果を追加します.
+//-------------------------------------------------------------------------------------------------
+void Runner::AddResult( const char* name, u64 calls, u64 opsPerCall, u64 bytesPerCall, std::vector<f64>& seconds )
+{
+    std::sort( seconds.begin(), seconds.end() );
+
+    const auto ops = f64( calls ) * f64( opsPerCall );
+
+    Result result;
+    result.Name         = name;
+    result.Calls        = calls;
+    result.OpsPerCall   = opsPerCall;
+    result.BytesPerCall = bytesPerCall;
+    result.NsPerOp      = seconds[seconds.size() / 2] * 1e9 / ops;
+    result.NsPerOpMin   = seconds.front() * 1e9 / ops;
+    m_Results.push_back( result );
+
+    if ( bytesPerCall > 0 )
+    {
+        auto bytesPerOp = f64( bytesPerCall ) / f64( opsPerCall );
+        fprintf( stderr, "%-40s %12.3f ns/op %10.3f GB/s\n", name, result.NsPerOp, bytesPerOp / result.NsPerOp );
+    }
+    else
+    { fprintf( stderr, "%-40s %12.3f ns/op\n", name, result.NsPerOp ); }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      計測結果をJSON形式で書き出します.
+//-------------------------------------------------------------------------------------------------
+void Runner::WriteJson( FILE* pFile ) const
+{
+    fprintf( pFile, "{\n" );
+    fprintf( pFile, "  \"context\": {\n" );
+    fprintf( pFile, "    \"compiler\": " ); WriteString( pFile, GetCompilerName() ); fprintf( pFile, ",\n" );
+    fprintf( pFile, "    \"simd\": %s,\n",   ASDX_IS_SIMD   ? "true" : "false" );
+    fprintf( pFile, "    \"openmp\": %s,\n", ASDX_IS_OPENMP ? "true" : "false" );
+    fprintf( pFile, "    \"supported_tier\": " ); WriteString( pFile, GetSimdTierName( GetSupportedSimdTier() ) ); fprintf( pFile, ",\n" );
+    fprintf( pFile, "    \"active_tier\": " );    WriteString( pFile, GetSimdTierName( GetActiveSimdTier() ) );    fprintf( pFile, ",\n" );
+    fprintf( pFile, "    \"min_time\": %g,\n", m_MinTime );
+    fprintf( pFile, "    \"repeat\": %u\n", m_Repeat );
+    fprintf( pFile, "  },\n" );
+    fprintf( pFile, "  \"benchmarks\": [" );
+
+    for( size_t i=0; i<m_Results.size(); ++i )
+    {
+        const auto& r = m_Results[i];
+        fprintf( pFile, "%s\n    {\n", ( i == 0 ) ? "" : "," );
+        fprintf( pFile, "      \"name\": " ); WriteString( pFile, r.Name.c_str() ); fprintf( pFile, ",\n" );
+        fprintf( pFile, "      \"calls\": %llu,\n", static_cast<unsigned long long>( r.Calls ) );
+        fprintf( pFile, "      \"ops_per_call\": %llu,\n", static_cast<unsigned long long>( r.OpsPerCall ) );
+        fprintf( pFile, "      \"ns_per_op\": %.4f,\n", r.NsPerOp );
+        fprintf( pFile, "      \"ns_per_op_min\": %.4f,\n", r.NsPerOpMin );
+        fprintf( pFile, "      \"ops_per_sec\": %.1f", 1e9 / r.NsPerOp );
+        if ( r.BytesPerCall > 0 )
+        {
+            auto bytesPerOp = f64( r.BytesPerCall ) / f64( r.OpsPerCall );
+            fprintf( pFile, ",\n      \"bytes_per_sec\": %.1f", bytesPerOp * 1e9 / r.NsPerOp );
+        }
+        fprintf( pFile, "\n    }" );
+    }
+
+    fprintf( pFile, "\n  ]\n}\n" );
+}
+
+} // namespace bench
+} // namespace asdx
+
+
+//-------------------------------------------------------------------------------------------------
+//      メインエントリーポイントです.
+//-------------------------------------------------------------------------------------------------
+int main( int argc, char** argv )
+{
+    f64         minTime = 0.5;
+    u32         repeat  = 5;
+    std::string filter;
+    const char* pOutPath = nullptr;
+
+    for( auto i=1; i<argc; ++i )
+    {
+        const char* value;
+        if ( ( value = GetOption( argv[i], "--filter" ) ) != nullptr )
+        { filter = value; }
+        else if ( ( value = GetOption( argv[i], "--min-time" ) ) != nullptr )
+        { minTime = atof( value ); }
+        else if ( ( value = GetOption( argv[i], "--repeat" ) ) != nullptr )
+        { repeat = u32( atoi( value ) ); }
+        else if ( ( value = GetOption( argv[i], "--out" ) ) != nullptr )
+        { pOutPath = value; }
+        else if ( ( value = GetOption( argv[i], "--tier" ) ) != nullptr )
+        {
+            auto found = false;
+            for( auto tier : TIER_LIST )
+            {
+                if ( IsSameName( value, GetSimdTierName( tier ) ) )
+                {
+                    SetSimdTierLimit( tier );
+                    found = true;
+                    break;
+                }
+            }
+
+            if ( !found )
+            {
+                fprintf( stderr, "unknown tier : %s\n", value );
+                return -1;
+            }
+        }
+        else
+        {
+            PrintUsage( argv[0] );
+            return -1;
+        }
+    }
+
+    fprintf( stderr, "SIMD tier : %s (supported %s)\n",
+        GetSimdTierName( GetActiveSimdTier() ),
+        GetSimdTierName( GetSupportedSimdTier() ) );
+
+    asdx::bench::Runner runner( minTime, repeat, filter );
+    asdx::bench::RunMathBench    ( runner );
+    asdx::bench::RunGeometryBench( runner );
+    asdx::bench::RunHashBench    ( runner );
+    asdx::bench::RunRandomBench  ( runner );
+
+    auto pFile = stdout;
+    if ( pOutPath != nullptr )
+    {
+        pFile = fopen( pOutPath, "w" );
+        if ( pFile == nullptr )
+        {
+            fprintf( stderr, "failed to open : %s\n", pOutPath );
+            return -1;
+        }
+    }
+
+    runner.WriteJson( pFile );
+
+    if ( pFile != stdout )
+    { fclose( pFile ); }
+
+    return 0;
+}
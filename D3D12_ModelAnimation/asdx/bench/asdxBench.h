@@ -0,0 +1,175 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxBench.h
+// Desc : Micro Benchmark Runner.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxTypedef.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+namespace asdx {
+namespace bench {
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      値を使用済みとして扱い, 計測対象の処理が最適化で削除されないようにします.
+//-------------------------------------------------------------------------------------------------
+template<typename T>
+inline void DoNotOptimize( const T& value )
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile( "" : : "r,m"( value ) : "memory" );
+#else
+    static volatile const void* s_pSink;
+    s_pSink = &value;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      メモリへの書き込みを計測対象の処理の外に移動させないようにします.
+//-------------------------------------------------------------------------------------------------
+inline void ClobberMemory()
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile( "" : : : "memory" );
+#endif
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Result structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct Result
+{
+    std::string     Name;           //!< ベンチマーク名です.
+    u64             Calls;          //!< 1回の計測で呼び出した回数です.
+    u64             OpsPerCall;     //!< 1回の呼び出しで処理する要素数です.
+    u64             BytesPerCall;   //!< 1回の呼び出しで処理するバイト数です(0の場合はスループットを出力しません).
+    f64             NsPerOp;        //!< 1要素あたりの処理時間(中央値)です.
+    f64             NsPerOpMin;     //!< 1要素あたりの処理時間(最小値)です.
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Runner class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class Runner
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    /* NOTHING */
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //!
+    //! @param[in]      minTime     1つのベンチマークの計測に使う最小時間(秒)です.
+    //! @param[in]      repeat      計測の繰り返し回数です. 結果は中央値を採用します.
+    //! @param[in]      filter      名前にこの文字列を含むベンチマークのみ実行します. 空の場合は全て実行します.
+    //---------------------------------------------------------------------------------------------
+    Runner( f64 minTime, u32 repeat, const std::string& filter );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ベンチマークを実行します.
+    //!
+    //! @param[in]      name            ベンチマーク名です. "分類/処理/条件" の形式で付けます.
+    //! @param[in]      opsPerCall      1回の呼び出しで処理する要素数です.
+    //! @param[in]      bytesPerCall    1回の呼び出しで処理するバイト数です. 不要な場合は0を指定します.
+    //! @param[in]      func            計測する処理です. 引数なしで呼び出されます.
+    //---------------------------------------------------------------------------------------------
+    template<typename Func>
+    void Run( const char* name, u64 opsPerCall, u64 bytesPerCall, const Func& func );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      計測結果をJSON形式で書き出します.
+    //!
+    //! @param[in]      pFile       出力先です.
+    //---------------------------------------------------------------------------------------------
+    void WriteJson( FILE* pFile ) const;
+
+private:
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    f64                 m_MinTime;      //!< 1つのベンチマークの最小計測時間(秒)です.
+    u32                 m_Repeat;       //!< 計測の繰り返し回数です.
+    std::string         m_Filter;       //!< 実行するベンチマーク名の絞り込み条件です.
+    std::vector<Result> m_Results;      //!< 計測結果です.
+
+    //=============================================================================================
+    // private methods.
+    //=============================================================================================
+    bool IsEnabled( const char* name ) const;
+    void AddResult( const char* name, u64 calls, u64 opsPerCall, u64 bytesPerCall, std::vector<f64>& seconds );
+};
+
+//-------------------------------------------------------------------------------------------------
+//      ベンチマークを実行します.
+//      呼び出し回数を倍々に増やして1回の計測が minTime / repeat 以上になる回数を求め,
+//      その回数で repeat 回計測します.
+//-------------------------------------------------------------------------------------------------
+template<typename Func>
+void Runner::Run( const char* name, u64 opsPerCall, u64 bytesPerCall, const Func& func )
+{
+    using Clock = std::chrono::steady_clock;
+
+    if ( !IsEnabled( name ) )
+    { return; }
+
+    auto measure = [&]( u64 calls )
+    {
+        auto begin = Clock::now();
+        for( u64 i=0; i<calls; ++i )
+        {
+            func();
+            ClobberMemory();
+        }
+        return std::chrono::duration<f64>( Clock::now() - begin ).count();
+    };
+
+    const auto target = m_MinTime / m_Repeat;
+
+    u64 calls   = 1;
+    f64 elapsed = measure( calls );
+    while ( elapsed < target * 0.5 )
+    {
+        calls  *= ( elapsed > 0.0 && target / elapsed < 16.0 ) ? 2 : 16;
+        elapsed = measure( calls );
+    }
+
+    std::vector<f64> seconds;
+    seconds.reserve( m_Repeat );
+    for( u32 i=0; i<m_Repeat; ++i )
+    { seconds.push_back( measure( calls ) ); }
+
+    AddResult( name, calls, opsPerCall, bytesPerCall, seconds );
+}
+
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      各モジュールのベンチマークを登録して実行します.
+//-------------------------------------------------------------------------------------------------
+void RunMathBench    ( Runner& runner );
+void RunGeometryBench( Runner& runner );
+void RunHashBench    ( Runner& runner );
+void RunRandomBench  ( Runner& runner );
+
+} // namespace bench
+} // namespace asdx
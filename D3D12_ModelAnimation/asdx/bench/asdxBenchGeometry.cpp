@@ -0,0 +1,386 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxBenchGeometry.cpp
+// Desc : Geometry Module Benchmarks.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "asdxBench.h"
+#include <asdxGeometry.h>
+#include <asdxBvh.h>
+#include <asdxOcclusion.h>
+#include <asdxSpatial.h>
+
+
+namespace /* anonymous */ {
+
+using namespace asdx;
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const u32 OBJECT_COUNT = 4096;       //!< 判定するオブジェクト数です.
+static const u32 STREAM_COUNT = 50000;      //!< まとめて判定する際のオブジェクト数です.
+static const f32 SCENE_RANGE  = 200.0f;     //!< オブジェクトを配置する範囲(半径)です.
+static const u32 BVH_COUNT    = 100000;     //!< BVHに登録するオブジェクト数です.
+static const u32 RAY_COUNT    = 1024;       //!< 1回の計測で判定するレイの数です.
+static const u32 GRID_SIZE    = 256;        //!< 三角形BVHに使う格子メッシュの分割数です.
+static const u32 PACKET_COUNT = 64;         //!< 総当たりでまとめて判定するレイの数です.
+static const u32 OCCLUSION_WIDTH  = 320;    //!< オクルージョンバッファの横幅です.
+static const u32 OCCLUSION_HEIGHT = 192;    //!< オクルージョンバッファの縦幅です.
+static const u32 ACTOR_COUNT  = 8192;       //!< 空間インデックスに登録する移動オブジェクト数です.
+static const u32 QUERY_COUNT  = 64;         //!< 1回の計測で行う球の問い合わせ数です.
+static const f32 QUERY_RADIUS = 20.0f;      //!< 球の問い合わせの半径です.
+static const u32 BONE_COUNT   = 128;        //!< スキンメッシュの範囲を求める際のボーン数です.
+
+} // namespace /* anonymous */
+
+
+namespace asdx {
+namespace bench {
+
+//-------------------------------------------------------------------------------------------------
+//      幾何モジュールのベンチマークを実行します.
+//      配置範囲の約半分が視錐台と交差し, 分岐予測が効きにくい条件で計測します.
+//-------------------------------------------------------------------------------------------------
+void RunGeometryBench( Runner& runner )
+{
+    Random random( 2 );
+
+    ViewFrustum frustum;
+    frustum.SetPerspective( F_PIDIV4, 16.0f / 9.0f, 0.1f, SCENE_RANGE );
+    frustum.SetLookAt( Vector3( 0.0f, 0.0f, -SCENE_RANGE * 0.25f ), Vector3( 0.0f, 0.0f, 0.0f ), Vector3( 0.0f, 1.0f, 0.0f ) );
+
+    std::vector<Vector3>        points ( OBJECT_COUNT );
+    std::vector<BoundingSphere> spheres( OBJECT_COUNT );
+    std::vector<BoundingBox>    boxes  ( OBJECT_COUNT );
+    for( u32 i=0; i<OBJECT_COUNT; ++i )
+    {
+        auto center = Vector3(
+            random.GetAsF32( -SCENE_RANGE * 0.5f, SCENE_RANGE * 0.5f ),
+            random.GetAsF32( -SCENE_RANGE * 0.25f, SCENE_RANGE * 0.25f ),
+            random.GetAsF32( -SCENE_RANGE * 0.25f, SCENE_RANGE ) );
+        auto extent = Vector3( random.GetAsF32( 0.5f, 5.0f ), random.GetAsF32( 0.5f, 5.0f ), random.GetAsF32( 0.5f, 5.0f ) );
+
+        points [i] = center;
+        spheres[i] = BoundingSphere( center, extent.x );
+        boxes  [i] = BoundingBox( center - extent, center + extent );
+    }
+
+    std::vector<f32> cx( STREAM_COUNT ), cy( STREAM_COUNT ), cz( STREAM_COUNT );
+    std::vector<f32> ex( STREAM_COUNT ), ey( STREAM_COUNT ), ez( STREAM_COUNT );
+    std::vector<u32> mask( ( STREAM_COUNT + 31 ) / 32 );
+    for( u32 i=0; i<STREAM_COUNT; ++i )
+    {
+        const auto& box = boxes[i % OBJECT_COUNT];
+        auto center = box.GetCenter();
+        cx[i] = center.x;
+        cy[i] = center.y;
+        cz[i] = center.z;
+        ex[i] = box.maxi.x - center.x;
+        ey[i] = box.maxi.y - center.y;
+        ez[i] = box.maxi.z - center.z;
+    }
+
+    runner.Run( "ViewFrustum/Contains/Point", OBJECT_COUNT, 0, [&]()
+    {
+        u32 visible = 0;
+        for( u32 i=0; i<OBJECT_COUNT; ++i )
+        { visible += frustum.Contains( points[i] ) ? 1 : 0; }
+        DoNotOptimize( visible );
+    });
+
+    runner.Run( "ViewFrustum/Contains/Sphere", OBJECT_COUNT, 0, [&]()
+    {
+        u32 visible = 0;
+        for( u32 i=0; i<OBJECT_COUNT; ++i )
+        { visible += frustum.Contains( spheres[i] ) ? 1 : 0; }
+        DoNotOptimize( visible );
+    });
+
+    runner.Run( "ViewFrustum/Contains/Box", OBJECT_COUNT, 0, [&]()
+    {
+        u32 visible = 0;
+        for( u32 i=0; i<OBJECT_COUNT; ++i )
+        { visible += frustum.Contains( boxes[i] ) ? 1 : 0; }
+        DoNotOptimize( visible );
+    });
+
+    runner.Run( "ViewFrustum/ContainsBoxStream/50K", STREAM_COUNT, 0, [&]()
+    { frustum.ContainsBoxStream( cx.data(), cy.data(), cz.data(), ex.data(), ey.data(), ez.data(), STREAM_COUNT, mask.data() ); });
+
+    runner.Run( "ViewFrustum/ContainsSphereStream/50K", STREAM_COUNT, 0, [&]()
+    { frustum.ContainsSphereStream( cx.data(), cy.data(), cz.data(), ex.data(), STREAM_COUNT, mask.data() ); });
+
+    // BVH.
+    std::vector<BoundingBox> bvhBoxes( BVH_COUNT );
+    for( u32 i=0; i<BVH_COUNT; ++i )
+    {
+        auto center = Vector3(
+            random.GetAsF32( -SCENE_RANGE, SCENE_RANGE ),
+            random.GetAsF32( -SCENE_RANGE * 0.1f, SCENE_RANGE * 0.1f ),
+            random.GetAsF32( -SCENE_RANGE, SCENE_RANGE ) );
+        auto extent = Vector3( random.GetAsF32( 0.1f, 1.0f ), random.GetAsF32( 0.1f, 1.0f ), random.GetAsF32( 0.1f, 1.0f ) );
+        bvhBoxes[i] = BoundingBox( center - extent, center + extent );
+    }
+
+    std::vector<Ray> rays;
+    rays.reserve( RAY_COUNT );
+    for( u32 i=0; i<RAY_COUNT; ++i )
+    {
+        auto pos = Vector3( random.GetAsF32( -SCENE_RANGE, SCENE_RANGE ), 0.0f, random.GetAsF32( -SCENE_RANGE, SCENE_RANGE ) );
+        auto dir = Vector3::Normalize( Vector3( random.GetAsF32( -1.0f, 1.0f ), random.GetAsF32( -0.1f, 0.1f ), random.GetAsF32( -1.0f, 1.0f ) ) );
+        rays.push_back( Ray( pos, dir ) );
+    }
+
+    Bvh bvh;
+    runner.Run( "Bvh/Build/100K", BVH_COUNT, 0, [&]()
+    { bvh.Build( bvhBoxes.data(), BVH_COUNT ); });
+
+    runner.Run( "Bvh/Refit/100K", BVH_COUNT, 0, [&]()
+    { bvh.Refit( bvhBoxes.data() ); });
+
+    runner.Run( "Bvh/Intersect/100K", RAY_COUNT, 0, [&]()
+    {
+        u32 hits = 0;
+        for( const auto& ray : rays )
+        {
+            RayHit hit;
+            hits += bvh.Intersect( ray, &hit ) ? 1 : 0;
+        }
+        DoNotOptimize( hits );
+    });
+
+    runner.Run( "Bvh/IntersectAny/100K", RAY_COUNT, 0, [&]()
+    {
+        u32 hits = 0;
+        for( const auto& ray : rays )
+        { hits += bvh.IntersectAny( ray, SCENE_RANGE * 0.25f ) ? 1 : 0; }
+        DoNotOptimize( hits );
+    });
+
+    // 起伏のある格子メッシュ.
+    std::vector<Vector3> positions;
+    std::vector<u32>     indices;
+    positions.reserve( ( GRID_SIZE + 1 ) * ( GRID_SIZE + 1 ) );
+    indices  .reserve( GRID_SIZE * GRID_SIZE * 6 );
+    for( u32 z=0; z<=GRID_SIZE; ++z )
+    for( u32 x=0; x<=GRID_SIZE; ++x )
+    { positions.push_back( Vector3( f32( x ), random.GetAsF32( 0.0f, 2.0f ), f32( z ) ) ); }
+
+    for( u32 z=0; z<GRID_SIZE; ++z )
+    for( u32 x=0; x<GRID_SIZE; ++x )
+    {
+        auto i0 = z * ( GRID_SIZE + 1 ) + x;
+        auto i1 = i0 + GRID_SIZE + 1;
+        indices.push_back( i0 ); indices.push_back( i1     ); indices.push_back( i0 + 1 );
+        indices.push_back( i0 + 1 ); indices.push_back( i1 ); indices.push_back( i1 + 1 );
+    }
+
+    // 頂点配列からのバウンディングボリューム.
+    const auto vertexCount = u32( positions.size() );
+    runner.Run( "BoundingBox/Merge/66K", vertexCount, vertexCount * sizeof(Vector3), [&]()
+    {
+        BoundingBox box;
+        for( const auto& position : positions )
+        { box.Merge( position ); }
+        DoNotOptimize( box );
+    });
+
+    runner.Run( "BoundingBox/CreateFromPoints/66K", vertexCount, vertexCount * sizeof(Vector3), [&]()
+    {
+        auto box = BoundingBox::CreateFromPoints( positions.data(), vertexCount );
+        DoNotOptimize( box );
+    });
+
+    runner.Run( "BoundingBox/CreateFromIndexedPoints/393K", indices.size(), 0, [&]()
+    {
+        auto box = BoundingBox::CreateFromIndexedPoints( positions.data(), indices.data(), u32( indices.size() ) );
+        DoNotOptimize( box );
+    });
+
+    runner.Run( "BoundingSphere/CreateFromPoints/66K", vertexCount, vertexCount * sizeof(Vector3), [&]()
+    {
+        auto sphere = BoundingSphere::CreateFromPoints( positions.data(), vertexCount );
+        DoNotOptimize( sphere );
+    });
+
+    // ボーンごとのボックスからのスキンメッシュの範囲.
+    std::vector<BoundingBox> boneBoxes     ( BONE_COUNT );
+    std::vector<Matrix>      boneTransforms( BONE_COUNT );
+    for( u32 i=0; i<BONE_COUNT; ++i )
+    {
+        auto extent = Vector3( random.GetAsF32( 0.05f, 0.5f ), random.GetAsF32( 0.05f, 0.5f ), random.GetAsF32( 0.05f, 0.5f ) );
+        boneBoxes[i] = BoundingBox( -extent, extent );
+        boneTransforms[i] = Matrix::CreateRotationFromYawPitchRoll(
+                random.GetAsF32( -F_PI, F_PI ), random.GetAsF32( -F_PI, F_PI ), random.GetAsF32( -F_PI, F_PI ) )
+            * Matrix::CreateTranslation( random.GetAsF32( -1.0f, 1.0f ), random.GetAsF32( 0.0f, 2.0f ), random.GetAsF32( -1.0f, 1.0f ) );
+    }
+
+    runner.Run( "BoundingBox/CreateFromTransformedBoxes/128", BONE_COUNT, BONE_COUNT * ( sizeof(BoundingBox) + sizeof(Matrix) ), [&]()
+    {
+        auto box = BoundingBox::CreateFromTransformedBoxes( boneBoxes.data(), boneTransforms.data(), BONE_COUNT );
+        DoNotOptimize( box );
+    });
+
+    std::vector<Ray> meshRays;
+    meshRays.reserve( RAY_COUNT );
+    for( u32 i=0; i<RAY_COUNT; ++i )
+    {
+        auto pos = Vector3( random.GetAsF32( 0.0f, f32( GRID_SIZE ) ), 10.0f, random.GetAsF32( 0.0f, f32( GRID_SIZE ) ) );
+        auto dir = Vector3::Normalize( Vector3( random.GetAsF32( -1.0f, 1.0f ), -1.0f, random.GetAsF32( -1.0f, 1.0f ) ) );
+        meshRays.push_back( Ray( pos, dir ) );
+    }
+
+    const auto triangleCount = u32( indices.size() / 3 );
+    TriangleBvh meshBvh;
+    runner.Run( "TriangleBvh/Build/128K", triangleCount, 0, [&]()
+    { meshBvh.Build( positions.data(), u32( positions.size() ), indices.data(), u32( indices.size() ) ); });
+
+    runner.Run( "TriangleBvh/Intersect/128K", RAY_COUNT, 0, [&]()
+    {
+        u32 hits = 0;
+        for( const auto& ray : meshRays )
+        {
+            RayHit hit;
+            hits += meshBvh.Intersect( ray, &hit ) ? 1 : 0;
+        }
+        DoNotOptimize( hits );
+    });
+
+    // BVHを使わない総当たりの判定. 計測単位はレイと三角形の判定回数です.
+    runner.Run( "Ray/IntersectTriangles/128K", triangleCount, 0, [&]()
+    {
+        RayHit hit;
+        auto result = IntersectTriangles( meshRays[0], positions.data(), indices.data(), triangleCount, &hit );
+        DoNotOptimize( result );
+    });
+
+    std::vector<RayHit> packetHits( PACKET_COUNT );
+    runner.Run( "Ray/IntersectTrianglesPacket/128K", u64( PACKET_COUNT ) * triangleCount, 0, [&]()
+    {
+        auto hits = IntersectTrianglesPacket( meshRays.data(), PACKET_COUNT, positions.data(), indices.data(), triangleCount, packetHits.data() );
+        DoNotOptimize( hits );
+    });
+    // 格子メッシュを斜め上から見下ろした遮蔽物と, その上に置いたボックス.
+    auto occlusionView = Matrix::CreateLookAt(
+        Vector3( f32( GRID_SIZE ) * 0.5f, 12.0f, -8.0f ),
+        Vector3( f32( GRID_SIZE ) * 0.5f, 0.0f, f32( GRID_SIZE ) * 0.5f ),
+        Vector3( 0.0f, 1.0f, 0.0f ) );
+    auto occlusionProj = Matrix::CreatePerspectiveFieldOfView( F_PIDIV4, f32( OCCLUSION_WIDTH ) / f32( OCCLUSION_HEIGHT ), 0.5f, 500.0f );
+    auto identity      = Matrix::CreateIdentity();
+
+    std::vector<BoundingBox> occludees( STREAM_COUNT );
+    for( auto& box : occludees )
+    {
+        auto center = Vector3( random.GetAsF32( 0.0f, f32( GRID_SIZE ) ), random.GetAsF32( -1.0f, 3.0f ), random.GetAsF32( 0.0f, f32( GRID_SIZE ) ) );
+        auto extent = Vector3( random.GetAsF32( 0.2f, 1.0f ), random.GetAsF32( 0.2f, 1.0f ), random.GetAsF32( 0.2f, 1.0f ) );
+        box = BoundingBox( center - extent, center + extent );
+    }
+
+    OcclusionBuffer occlusion;
+    occlusion.Init( OCCLUSION_WIDTH, OCCLUSION_HEIGHT );
+    runner.Run( "OcclusionBuffer/RenderTriangles/128K", triangleCount, 0, [&]()
+    {
+        occlusion.Clear( occlusionView * occlusionProj );
+        occlusion.RenderTriangles( identity, positions.data(), indices.data(), u32( indices.size() ) );
+    });
+
+    runner.Run( "OcclusionBuffer/TestBoxes/50K", STREAM_COUNT, 0, [&]()
+    { occlusion.TestBoxes( identity, occludees.data(), STREAM_COUNT, mask.data() ); });
+
+    // 移動するオブジェクトの空間インデックス. 1回の計測で全オブジェクトを移動し, 次の計測で戻します.
+    std::vector<BoundingBox> actors( ACTOR_COUNT );
+    std::vector<Vector3>     velocities( ACTOR_COUNT );
+    for( u32 i=0; i<ACTOR_COUNT; ++i )
+    {
+        auto center = Vector3(
+            random.GetAsF32( -SCENE_RANGE, SCENE_RANGE ),
+            random.GetAsF32( -SCENE_RANGE * 0.05f, SCENE_RANGE * 0.05f ),
+            random.GetAsF32( -SCENE_RANGE, SCENE_RANGE ) );
+        auto extent = Vector3( 0.5f, 1.0f, 0.5f );
+        actors    [i] = BoundingBox( center - extent, center + extent );
+        velocities[i] = Vector3( random.GetAsF32( -0.5f, 0.5f ), 0.0f, random.GetAsF32( -0.5f, 0.5f ) );
+    }
+
+    std::vector<Vector3> queryCenters( QUERY_COUNT );
+    for( auto& center : queryCenters )
+    { center = Vector3( random.GetAsF32( -SCENE_RANGE, SCENE_RANGE ), 0.0f, random.GetAsF32( -SCENE_RANGE, SCENE_RANGE ) ); }
+
+    auto worldBounds = BoundingBox(
+        Vector3( -SCENE_RANGE, -SCENE_RANGE * 0.1f, -SCENE_RANGE ),
+        Vector3(  SCENE_RANGE,  SCENE_RANGE * 0.1f,  SCENE_RANGE ) );
+
+    LooseOctree     octree;
+    SpatialHashGrid grid;
+    octree.Init( worldBounds );
+    grid  .Init( QUERY_RADIUS );
+
+    std::vector<u32> octreeHandles( ACTOR_COUNT );
+    std::vector<u32> gridHandles  ( ACTOR_COUNT );
+    for( u32 i=0; i<ACTOR_COUNT; ++i )
+    {
+        octreeHandles[i] = octree.Insert( actors[i] );
+        gridHandles  [i] = grid  .Insert( actors[i] );
+    }
+
+    std::vector<u32> results;
+    results.reserve( ACTOR_COUNT );
+
+    f32 octreeStep = 1.0f;
+    runner.Run( "LooseOctree/Move/8K", ACTOR_COUNT, 0, [&]()
+    {
+        for( u32 i=0; i<ACTOR_COUNT; ++i )
+        {
+            auto offset = velocities[i] * octreeStep;
+            octree.Move( octreeHandles[i], BoundingBox( actors[i].mini + offset, actors[i].maxi + offset ) );
+        }
+        octreeStep = ( octreeStep > 0.0f ) ? 0.0f : 1.0f;
+    });
+
+    runner.Run( "LooseOctree/QueryFrustum/8K", 1, 0, [&]()
+    {
+        results.clear();
+        octree.QueryFrustum( frustum, &results );
+        DoNotOptimize( results.data() );
+    });
+
+    runner.Run( "LooseOctree/QueryRadius/8K", QUERY_COUNT, 0, [&]()
+    {
+        results.clear();
+        for( const auto& center : queryCenters )
+        { octree.QueryRadius( center, QUERY_RADIUS, &results ); }
+        DoNotOptimize( results.data() );
+    });
+
+    f32 gridStep = 1.0f;
+    runner.Run( "SpatialHashGrid/Move/8K", ACTOR_COUNT, 0, [&]()
+    {
+        for( u32 i=0; i<ACTOR_COUNT; ++i )
+        {
+            auto offset = velocities[i] * gridStep;
+            grid.Move( gridHandles[i], BoundingBox( actors[i].mini + offset, actors[i].maxi + offset ) );
+        }
+        gridStep = ( gridStep > 0.0f ) ? 0.0f : 1.0f;
+    });
+
+    runner.Run( "SpatialHashGrid/QueryFrustum/8K", 1, 0, [&]()
+    {
+        results.clear();
+        grid.QueryFrustum( frustum, &results );
+        DoNotOptimize( results.data() );
+    });
+
+    runner.Run( "SpatialHashGrid/QueryRadius/8K", QUERY_COUNT, 0, [&]()
+    {
+        results.clear();
+        for( const auto& center : queryCenters )
+        { grid.QueryRadius( center, QUERY_RADIUS, &results ); }
+        DoNotOptimize( results.data() );
+    });
+}
+
+} // namespace bench
+} // namespace asdx
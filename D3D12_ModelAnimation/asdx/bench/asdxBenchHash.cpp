@@ -0,0 +1,208 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxBenchHash.cpp
+// Desc : Hash Module Benchmarks.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "asdxBench.h"
+#include <asdxHash.h>
+#include <asdxHashMap.h>
+#include <asdxStringInterner.h>
+#include <asdxMath.h>
+#include <map>
+#include <unordered_map>
+
+
+namespace /* anonymous */ {
+
+using namespace asdx;
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const u32 BYTE_SIZES[]   = { 16, 64, 256, 1024, 4096, 65536, 1024 * 1024 };  //!< バイト列のサイズです.
+static const u32 STRING_SIZES[] = { 16, 64, 256, 4096 };                            //!< 文字列の長さです.
+static const u32 STREAM_SIZE    = 64 * 1024 * 1024;                                 //!< 分割して処理するバッファのサイズです.
+static const u32 STREAM_CHUNK   = 1024 * 1024;                                      //!< 1回に追加するサイズです.
+static const u32 MAP_SIZES[]    = { 64, 4096, 262144 };                             //!< マップの要素数です.
+static const u32 LOOKUP_COUNT   = 4096;                                             //!< 1回に検索するキー数です.
+static const u32 NAME_COUNT     = 256;                                              //!< 登録する名前の数です.
+
+//-------------------------------------------------------------------------------------------------
+//      サイズを名前に付けます.
+//-------------------------------------------------------------------------------------------------
+std::string MakeName( const char* prefix, u32 size )
+{
+    char buf[64];
+    if ( size >= 1024 * 1024 && size % ( 1024 * 1024 ) == 0 )
+    { sprintf( buf, "%s/%uM", prefix, size / ( 1024 * 1024 ) ); }
+    else if ( size >= 1024 && size % 1024 == 0 )
+    { sprintf( buf, "%s/%uK", prefix, size / 1024 ); }
+    else
+    { sprintf( buf, "%s/%u", prefix, size ); }
+    return buf;
+}
+
+} // namespace /* anonymous */
+
+
+namespace asdx {
+namespace bench {
+
+//-------------------------------------------------------------------------------------------------
+//      ハッシュモジュールのベンチマークを実行します.
+//      1回の呼び出しを1要素とし, スループットはバイト単位で出力します.
+//-------------------------------------------------------------------------------------------------
+void RunHashBench( Runner& runner )
+{
+    Random random( 3 );
+
+    std::vector<u8> bytes( 1024 * 1024 );
+    for( auto& b : bytes )
+    { b = u8( random.GetAsU32() ); }
+
+    for( auto size : BYTE_SIZES )
+    {
+        runner.Run( MakeName( "Crc32/Bytes", size ).c_str(), 1, size, [&]()
+        { DoNotOptimize( Crc32( size, bytes.data() ).GetHash() ); });
+    }
+
+    // アセットパックなどの大きなバッファを分割して処理する.
+    {
+        std::vector<u8> stream( STREAM_SIZE );
+        for( size_t i=0; i<stream.size(); i += bytes.size() )
+        { memcpy( stream.data() + i, bytes.data(), bytes.size() ); }
+
+        runner.Run( MakeName( "Crc32/Update", STREAM_SIZE ).c_str(), 1, STREAM_SIZE, [&]()
+        {
+            Crc32 crc;
+            for( u32 offset=0; offset<STREAM_SIZE; offset += STREAM_CHUNK )
+            { crc.Update( STREAM_CHUNK, stream.data() + offset ); }
+            DoNotOptimize( crc.GetHash() );
+        });
+
+        runner.Run( MakeName( "Xxh3/Update", STREAM_SIZE ).c_str(), 1, STREAM_SIZE, [&]()
+        {
+            Xxh3 hash;
+            for( u32 offset=0; offset<STREAM_SIZE; offset += STREAM_CHUNK )
+            { hash.Update( STREAM_CHUNK, stream.data() + offset ); }
+            DoNotOptimize( hash.GetHash64() );
+        });
+    }
+
+    for( auto size : BYTE_SIZES )
+    {
+        runner.Run( MakeName( "Fnv1a/Bytes", size ).c_str(), 1, size, [&]()
+        { DoNotOptimize( Fnv1a( size, bytes.data() ).GetHash() ); });
+    }
+
+    for( auto size : BYTE_SIZES )
+    {
+        runner.Run( MakeName( "Xxh3_64/Bytes", size ).c_str(), 1, size, [&]()
+        { DoNotOptimize( CalcXxh3_64( size, bytes.data() ) ); });
+
+        runner.Run( MakeName( "Xxh3_128/Bytes", size ).c_str(), 1, size, [&]()
+        { DoNotOptimize( CalcXxh3_128( size, bytes.data() ).Low ); });
+    }
+
+    for( auto size : STRING_SIZES )
+    {
+        std::string text( size, ' ' );
+        for( auto& c : text )
+        { c = char8( 'a' + random.GetAsU32() % 26 ); }
+
+        runner.Run( MakeName( "Crc32/String", size ).c_str(), 1, size, [&]()
+        { DoNotOptimize( Crc32( text.c_str() ).GetHash() ); });
+
+        runner.Run( MakeName( "Fnv1a/String", size ).c_str(), 1, size, [&]()
+        { DoNotOptimize( Fnv1a( text.c_str() ).GetHash() ); });
+    }
+
+    // 半分は存在しないキーを検索する.
+    for( auto size : MAP_SIZES )
+    {
+        HashMap<u32, u32>               hashMap( size );
+        std::unordered_map<u32, u32>    unorderedMap;
+        std::map<u32, u32>              orderedMap;
+
+        // 登録するキーは奇数, 存在しないキーは偶数にする.
+        std::vector<u32> entries( size );
+        for( u32 i=0; i<size; ++i )
+        {
+            auto key = random.GetAsU32() | 1;
+            hashMap.Insert( key, i );
+            unorderedMap[key] = i;
+            orderedMap  [key] = i;
+            entries[i] = key;
+        }
+
+        std::vector<u32> keys( LOOKUP_COUNT );
+        for( u32 i=0; i<LOOKUP_COUNT; ++i )
+        {
+            keys[i] = ( i & 1 )
+                ? random.GetAsU32() & ~1u
+                : entries[random.GetAsU32() % size];
+        }
+
+        runner.Run( MakeName( "HashMap/Find", size ).c_str(), LOOKUP_COUNT, 0, [&]()
+        {
+            u32 sum = 0;
+            for( auto key : keys )
+            {
+                auto pValue = hashMap.Find( key );
+                sum += ( pValue != nullptr ) ? *pValue : 0;
+            }
+            DoNotOptimize( sum );
+        });
+
+        runner.Run( MakeName( "UnorderedMap/Find", size ).c_str(), LOOKUP_COUNT, 0, [&]()
+        {
+            u32 sum = 0;
+            for( auto key : keys )
+            {
+                auto itr = unorderedMap.find( key );
+                sum += ( itr != unorderedMap.end() ) ? itr->second : 0;
+            }
+            DoNotOptimize( sum );
+        });
+
+        runner.Run( MakeName( "Map/Find", size ).c_str(), LOOKUP_COUNT, 0, [&]()
+        {
+            u32 sum = 0;
+            for( auto key : keys )
+            {
+                auto itr = orderedMap.find( key );
+                sum += ( itr != orderedMap.end() ) ? itr->second : 0;
+            }
+            DoNotOptimize( sum );
+        });
+    }
+
+    // 登録済みの名前を再度登録する(ロード時のボーン名の解決).
+    {
+        auto& interner = StringInterner::GetInstance();
+
+        std::vector<std::wstring> names( NAME_COUNT );
+        for( u32 i=0; i<NAME_COUNT; ++i )
+        {
+            char16 buf[64];
+            swprintf( buf, 64, L"Bone_%04u_Spine", i );
+            names[i] = buf;
+            interner.Intern( names[i].c_str() );
+        }
+
+        runner.Run( MakeName( "StringInterner/Intern", NAME_COUNT ).c_str(), NAME_COUNT, 0, [&]()
+        {
+            u32 sum = 0;
+            for( auto& name : names )
+            { sum += interner.Intern( name.c_str() ); }
+            DoNotOptimize( sum );
+        });
+    }
+}
+
+} // namespace bench
+} // namespace asdx
@@ -0,0 +1,191 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxBenchMath.cpp
+// Desc : Math Module Benchmarks.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "asdxBench.h"
+#include <asdxMath.h>
+
+
+namespace /* anonymous */ {
+
+using namespace asdx;
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const u32 MATRIX_COUNT = 256;            //!< 行列のベンチマークで処理する個数です.
+static const u32 ELEMENT_COUNT = 4096;          //!< ベクトル, 四元数のベンチマークで処理する個数です.
+static const u32 LARGE_COUNT = 1024 * 1024;     //!< 並列化の効果を計測する際の個数です.
+
+//-------------------------------------------------------------------------------------------------
+//      ランダムな単位ベクトルを生成します.
+//-------------------------------------------------------------------------------------------------
+Vector3 RandomAxis( Random& random )
+{
+    Vector3 v;
+    do
+    {
+        v = Vector3( random.GetAsF32( -1.0f, 1.0f ), random.GetAsF32( -1.0f, 1.0f ), random.GetAsF32( -1.0f, 1.0f ) );
+    }
+    while ( Vector3::Dot( v, v ) < 1e-2f );
+
+    return Vector3::Normalize( v );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ランダムな回転を生成します.
+//-------------------------------------------------------------------------------------------------
+Quaternion RandomRotation( Random& random )
+{ return Quaternion::CreateFromAxisAngle( RandomAxis( random ), random.GetAsF32( -F_PI, F_PI ) ); }
+
+//-------------------------------------------------------------------------------------------------
+//      ランダムな剛体変換を生成します.
+//-------------------------------------------------------------------------------------------------
+Matrix RandomRigid( Random& random )
+{
+    auto m = Matrix::CreateFromQuaternion( RandomRotation( random ) );
+    m._41 = random.GetAsF32( -10.0f, 10.0f );
+    m._42 = random.GetAsF32( -10.0f, 10.0f );
+    m._43 = random.GetAsF32( -10.0f, 10.0f );
+    return m;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ランダムなスケールを含むアフィン変換を生成します.
+//-------------------------------------------------------------------------------------------------
+Matrix RandomAffine( Random& random )
+{
+    auto s = Matrix::CreateScale( random.GetAsF32( 0.5f, 2.0f ), random.GetAsF32( 0.5f, 2.0f ), random.GetAsF32( 0.5f, 2.0f ) );
+    return Matrix::Multiply( s, RandomRigid( random ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ランダムな透視変換を含む行列を生成します.
+//-------------------------------------------------------------------------------------------------
+Matrix RandomProjective( Random& random )
+{
+    auto proj = Matrix::CreatePerspectiveFieldOfView( random.GetAsF32( 0.5f, 1.5f ), 16.0f / 9.0f, 0.1f, 1000.0f );
+    return Matrix::Multiply( RandomAffine( random ), proj );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ランダムな位置座標を生成します.
+//-------------------------------------------------------------------------------------------------
+Vector3 RandomPosition( Random& random, f32 range )
+{ return Vector3( random.GetAsF32( -range, range ), random.GetAsF32( -range, range ), random.GetAsF32( -range, range ) ); }
+
+} // namespace /* anonymous */
+
+
+namespace asdx {
+namespace bench {
+
+//-------------------------------------------------------------------------------------------------
+//      数学モジュールのベンチマークを実行します.
+//-------------------------------------------------------------------------------------------------
+void RunMathBench( Runner& runner )
+{
+    Random random( 1 );
+
+    // Matrix.
+    {
+        std::vector<Matrix> a( MATRIX_COUNT ), b( MATRIX_COUNT ), c( MATRIX_COUNT ), r( MATRIX_COUNT );
+        for( u32 i=0; i<MATRIX_COUNT; ++i )
+        {
+            a[i] = RandomProjective( random );
+            b[i] = RandomAffine( random );
+            c[i] = RandomRigid( random );
+        }
+
+        runner.Run( "Matrix/Multiply", MATRIX_COUNT, 0, [&]()
+        {
+            for( u32 i=0; i<MATRIX_COUNT; ++i )
+            { Matrix::Multiply( a[i], b[i], r[i] ); }
+        });
+
+        runner.Run( "Matrix/Invert", MATRIX_COUNT, 0, [&]()
+        {
+            for( u32 i=0; i<MATRIX_COUNT; ++i )
+            { Matrix::Invert( a[i], r[i] ); }
+        });
+
+        runner.Run( "Matrix/InvertAffine", MATRIX_COUNT, 0, [&]()
+        {
+            for( u32 i=0; i<MATRIX_COUNT; ++i )
+            { Matrix::InvertAffine( b[i], r[i] ); }
+        });
+
+        runner.Run( "Matrix/InvertRigid", MATRIX_COUNT, 0, [&]()
+        {
+            for( u32 i=0; i<MATRIX_COUNT; ++i )
+            { Matrix::InvertRigid( c[i], r[i] ); }
+        });
+
+        runner.Run( "Matrix/Classify", MATRIX_COUNT, 0, [&]()
+        {
+            u32 sum = 0;
+            for( u32 i=0; i<MATRIX_COUNT; ++i )
+            { sum += u32( Matrix::Classify( b[i] ) ); }
+            DoNotOptimize( sum );
+        });
+    }
+
+    // Quaternion.
+    {
+        std::vector<Quaternion> a( ELEMENT_COUNT ), b( ELEMENT_COUNT ), r( ELEMENT_COUNT );
+        std::vector<f32> t( ELEMENT_COUNT );
+        for( u32 i=0; i<ELEMENT_COUNT; ++i )
+        {
+            a[i] = RandomRotation( random );
+            b[i] = RandomRotation( random );
+            t[i] = random.GetAsF32();
+        }
+
+        runner.Run( "Quaternion/Slerp", ELEMENT_COUNT, 0, [&]()
+        {
+            for( u32 i=0; i<ELEMENT_COUNT; ++i )
+            { Quaternion::Slerp( a[i], b[i], t[i], r[i] ); }
+        });
+
+        runner.Run( "Quaternion/SlerpArray", ELEMENT_COUNT, 0, [&]()
+        { Quaternion::SlerpArray( a.data(), b.data(), t.data(), ELEMENT_COUNT, r.data() ); });
+
+        runner.Run( "Quaternion/NlerpArray", ELEMENT_COUNT, 0, [&]()
+        { Quaternion::NlerpArray( a.data(), b.data(), t.data(), ELEMENT_COUNT, r.data() ); });
+    }
+
+    // Vector3.
+    {
+        std::vector<Vector3> v( LARGE_COUNT ), r( LARGE_COUNT );
+        for( u32 i=0; i<LARGE_COUNT; ++i )
+        { v[i] = RandomPosition( random, 100.0f ); }
+
+        const auto m = RandomAffine( random );
+
+        runner.Run( "Vector3/Normalize", ELEMENT_COUNT, 0, [&]()
+        {
+            for( u32 i=0; i<ELEMENT_COUNT; ++i )
+            { Vector3::Normalize( v[i], r[i] ); }
+        });
+
+        runner.Run( "Vector3/Transform", ELEMENT_COUNT, 0, [&]()
+        {
+            for( u32 i=0; i<ELEMENT_COUNT; ++i )
+            { Vector3::Transform( v[i], m, r[i] ); }
+        });
+
+        runner.Run( "Vector3/TransformArray", ELEMENT_COUNT, 0, [&]()
+        { Vector3::TransformArray( v.data(), ELEMENT_COUNT, m, r.data() ); });
+
+        runner.Run( "Vector3/TransformArray/1M", LARGE_COUNT, LARGE_COUNT * sizeof(Vector3) * 2, [&]()
+        { Vector3::TransformArray( v.data(), LARGE_COUNT, m, r.data() ); });
+    }
+}
+
+} // namespace bench
+} // namespace asdx
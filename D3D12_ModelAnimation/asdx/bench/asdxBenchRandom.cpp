@@ -0,0 +1,58 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxBenchRandom.cpp
+// Desc : Random Number Generator Benchmarks.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "asdxBench.h"
+#include <asdxMath.h>
+
+
+namespace /* anonymous */ {
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const u32 VALUE_COUNT = 4096;    //!< 1回の呼び出しで生成する乱数の数です.
+
+} // namespace /* anonymous */
+
+
+namespace asdx {
+namespace bench {
+
+//-------------------------------------------------------------------------------------------------
+//      乱数生成のベンチマークを実行します.
+//-------------------------------------------------------------------------------------------------
+void RunRandomBench( Runner& runner )
+{
+    std::vector<u32> u( VALUE_COUNT );
+    std::vector<f32> f( VALUE_COUNT );
+
+    Random random( 4 );
+    RandomStream stream( 4 );
+
+    runner.Run( "Random/GetAsU32", VALUE_COUNT, VALUE_COUNT * sizeof(u32), [&]()
+    {
+        for( u32 i=0; i<VALUE_COUNT; ++i )
+        { u[i] = random.GetAsU32(); }
+    });
+
+    runner.Run( "Random/GetAsF32", VALUE_COUNT, VALUE_COUNT * sizeof(f32), [&]()
+    {
+        for( u32 i=0; i<VALUE_COUNT; ++i )
+        { f[i] = random.GetAsF32( -1.0f, 1.0f ); }
+    });
+
+    runner.Run( "RandomStream/FillU32", VALUE_COUNT, VALUE_COUNT * sizeof(u32), [&]()
+    { stream.Fill( u.data(), VALUE_COUNT ); });
+
+    runner.Run( "RandomStream/FillF32", VALUE_COUNT, VALUE_COUNT * sizeof(f32), [&]()
+    { stream.Fill( f.data(), VALUE_COUNT, -1.0f, 1.0f ); });
+}
+
+} // namespace bench
+} // namespace asdx
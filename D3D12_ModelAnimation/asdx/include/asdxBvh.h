@@ -0,0 +1,381 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxBvh.h
+// Desc : Bounding Volume Hierarchy Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxGeometry.h>
+#include <vector>
+
+
+namespace asdx {
+
+//-------------------------------------------------------------------------------------------------
+// Forward Declarations
+//-------------------------------------------------------------------------------------------------
+struct ResMesh;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// BvhNode structure
+// 深さ優先順に並べたBVHのノードです(32byte).
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct BvhNode
+{
+    Vector3     mini;       //!< 最小値です.
+    u32         offset;     //!< 葉ノードは先頭プリミティブ番号, 内部ノードは右の子ノード番号です(左の子は直後).
+    Vector3     maxi;       //!< 最大値です.
+    u32         count;      //!< 葉ノードのプリミティブ数です. 内部ノードは0です.
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// RayHit structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct RayHit
+{
+    f32     distance;   //!< 交点までのパラメータ(方向ベクトルの長さ単位)です.
+    u32     index;      //!< 交差したプリミティブの番号です.
+    f32     u;          //!< 交点の重心座標です(三角形のみ).
+    f32     v;          //!< 交点の重心座標です(三角形のみ).
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Bvh class
+// バウンディングボックス単位のBVHです.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class Bvh
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    /* NOTHING */
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------------------
+    Bvh();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //---------------------------------------------------------------------------------------------
+    ~Bvh();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ビン分割SAHでBVHを構築します.
+    //!
+    //! @details    OpenMPが有効な場合は部分木ごとにタスクに分配して構築します.
+    //!             構築結果はスレッド数によらず同じです.
+    //! @param[in]      pBoxes      プリミティブのバウンディングボックスの配列です.
+    //! @param[in]      count       プリミティブ数です.
+    //! @retval true    構築に成功.
+    //! @retval false   構築に失敗.
+    //---------------------------------------------------------------------------------------------
+    bool Build( const BoundingBox* pBoxes, u32 count );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      木構造を保ったままノードのバウンディングボックスを更新します.
+    //!
+    //! @details    移動するオブジェクト向けです. 移動量が大きい場合は Build() で再構築してください.
+    //! @param[in]      pBoxes      プリミティブのバウンディングボックスの配列です. 要素数は構築時と同じです.
+    //---------------------------------------------------------------------------------------------
+    void Refit( const BoundingBox* pBoxes );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      終了処理を行います.
+    //---------------------------------------------------------------------------------------------
+    void Term();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      レイと最も近いバウンディングボックスを求めます.
+    //!
+    //! @param[in]      ray             レイです.
+    //! @param[out]     pHit            交差結果の格納先です.
+    //! @param[in]      maxDistance     交差を判定する最大距離です.
+    //! @retval true    交差しました.
+    //! @retval false   交差しませんでした.
+    //---------------------------------------------------------------------------------------------
+    bool Intersect( const Ray& ray, RayHit* pHit, f32 maxDistance = F32_MAX ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      レイがいずれかのバウンディングボックスと交差するか判定します.
+    //!
+    //! @details    最初に見つかった交差で打ち切ります. 遮蔽判定向けです.
+    //! @param[in]      ray             レイです.
+    //! @param[in]      maxDistance     交差を判定する最大距離です.
+    //! @retval true    交差しました.
+    //! @retval false   交差しませんでした.
+    //---------------------------------------------------------------------------------------------
+    bool IntersectAny( const Ray& ray, f32 maxDistance = F32_MAX ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      全体のバウンディングボックスを取得します.
+    //!
+    //! @return     全体のバウンディングボックスを返却します.
+    //---------------------------------------------------------------------------------------------
+    BoundingBox GetBounds() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ノードの配列を取得します.
+    //!
+    //! @return     深さ優先順に並んだノードの配列を返却します.
+    //---------------------------------------------------------------------------------------------
+    const BvhNode* GetNodes() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ノード数を取得します.
+    //!
+    //! @return     ノード数を返却します.
+    //---------------------------------------------------------------------------------------------
+    u32 GetNodeCount() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      葉ノードの並びにおけるプリミティブ番号の配列を取得します.
+    //!
+    //! @return     BvhNode::offset から BvhNode::count 個が葉ノードに含まれるプリミティブ番号です.
+    //---------------------------------------------------------------------------------------------
+    const u32* GetIndices() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      プリミティブ数を取得します.
+    //!
+    //! @return     プリミティブ数を返却します.
+    //---------------------------------------------------------------------------------------------
+    u32 GetPrimitiveCount() const;
+
+private:
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    std::vector<BvhNode>        m_Nodes;        //!< ノードです.
+    std::vector<u32>            m_Indices;      //!< 葉ノードの並びにおけるプリミティブ番号です.
+    std::vector<BoundingBox>    m_Boxes;        //!< 葉ノードの並びに並べ替えたバウンディングボックスです.
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TriangleBvh class
+// 三角形単位のBVHです.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class TriangleBvh
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    /* NOTHING */
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------------------
+    TriangleBvh();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //---------------------------------------------------------------------------------------------
+    ~TriangleBvh();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      三角形リストからBVHを構築します.
+    //!
+    //! @param[in]      pPositions      位置座標の配列です.
+    //! @param[in]      vertexCount     頂点数です.
+    //! @param[in]      pIndices        頂点インデックスの配列です(3つで1つの三角形).
+    //! @param[in]      indexCount      頂点インデックス数です.
+    //! @retval true    構築に成功.
+    //! @retval false   構築に失敗.
+    //---------------------------------------------------------------------------------------------
+    bool Build(
+        const Vector3*  pPositions,
+        u32             vertexCount,
+        const u32*      pIndices,
+        u32             indexCount );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      メッシュリソースの位置座標と頂点インデックスからBVHを構築します.
+    //!
+    //! @param[in]      mesh        メッシュリソースです.
+    //! @retval true    構築に成功.
+    //! @retval false   構築に失敗.
+    //---------------------------------------------------------------------------------------------
+    bool Build( const ResMesh& mesh );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      木構造を保ったまま頂点位置を更新します.
+    //!
+    //! @param[in]      pPositions      位置座標の配列です. 頂点数は構築時と同じです.
+    //---------------------------------------------------------------------------------------------
+    void Refit( const Vector3* pPositions );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      終了処理を行います.
+    //---------------------------------------------------------------------------------------------
+    void Term();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      レイと最も近い三角形を求めます.
+    //!
+    //! @details    裏面も交差として扱います. RayHit::index は構築時の三角形番号です.
+    //! @param[in]      ray             レイです.
+    //! @param[out]     pHit            交差結果の格納先です.
+    //! @param[in]      maxDistance     交差を判定する最大距離です.
+    //! @retval true    交差しました.
+    //! @retval false   交差しませんでした.
+    //---------------------------------------------------------------------------------------------
+    bool Intersect( const Ray& ray, RayHit* pHit, f32 maxDistance = F32_MAX ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      レイがいずれかの三角形と交差するか判定します.
+    //!
+    //! @param[in]      ray             レイです.
+    //! @param[in]      maxDistance     交差を判定する最大距離です.
+    //! @retval true    交差しました.
+    //! @retval false   交差しませんでした.
+    //---------------------------------------------------------------------------------------------
+    bool IntersectAny( const Ray& ray, f32 maxDistance = F32_MAX ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      全体のバウンディングボックスを取得します.
+    //!
+    //! @return     全体のバウンディングボックスを返却します.
+    //---------------------------------------------------------------------------------------------
+    BoundingBox GetBounds() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ノードの配列を取得します.
+    //!
+    //! @return     深さ優先順に並んだノードの配列を返却します.
+    //---------------------------------------------------------------------------------------------
+    const BvhNode* GetNodes() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ノード数を取得します.
+    //!
+    //! @return     ノード数を返却します.
+    //---------------------------------------------------------------------------------------------
+    u32 GetNodeCount() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      三角形数を取得します.
+    //!
+    //! @return     三角形数を返却します.
+    //---------------------------------------------------------------------------------------------
+    u32 GetTriangleCount() const;
+
+private:
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    std::vector<BvhNode>    m_Nodes;            //!< ノードです.
+    std::vector<u32>        m_Indices;          //!< 葉ノードの並びにおける三角形番号です.
+    std::vector<u32>        m_VertexIndices;    //!< 葉ノードの並びに並べ替えた頂点インデックスです.
+    std::vector<Vector3>    m_Vertices;         //!< 葉ノードの並びに並べ替えた三角形の頂点です.
+};
+
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      1本のレイと三角形リストの交差判定を行い, 最も近い交点を求めます.
+//!
+//! @details    三角形を命令セットの幅ごとにまとめて判定します(Moller-Trumbore). 裏面も交差として扱います.
+//!             三角形数が多い場合はOpenMPでスレッドに分配します. 距離が等しい場合は番号の小さい三角形を返します.
+//!             BVHを構築せずに全ての三角形を判定するため, 同じメッシュに何度も問い合わせる場合は
+//!             TriangleBvh を使用してください.
+//! @param[in]      ray             レイです.
+//! @param[in]      pPositions      位置座標の配列です.
+//! @param[in]      pIndices        頂点インデックスの配列です(3つで1つの三角形).
+//! @param[in]      triangleCount   三角形数です.
+//! @param[out]     pHit            交差結果の格納先です.
+//! @param[in]      maxDistance     交差を判定する最大距離です.
+//! @retval true    交差しました.
+//! @retval false   交差しませんでした.
+//-------------------------------------------------------------------------------------------------
+bool IntersectTriangles(
+    const Ray&      ray,
+    const Vector3*  pPositions,
+    const u32*      pIndices,
+    u32             triangleCount,
+    RayHit*         pHit,
+    f32             maxDistance = F32_MAX );
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      1本のレイとメッシュリソースの交差判定を行い, 最も近い交点を求めます.
+//!
+//! @param[in]      ray             レイです.
+//! @param[in]      mesh            メッシュリソースです.
+//! @param[out]     pHit            交差結果の格納先です.
+//! @param[in]      maxDistance     交差を判定する最大距離です.
+//! @retval true    交差しました.
+//! @retval false   交差しませんでした.
+//-------------------------------------------------------------------------------------------------
+bool IntersectTriangles(
+    const Ray&      ray,
+    const ResMesh&  mesh,
+    RayHit*         pHit,
+    f32             maxDistance = F32_MAX );
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      複数のレイと三角形リストの交差判定をまとめて行い, レイごとに最も近い交点を求めます.
+//!
+//! @details    命令セットの幅(4/8/16本)のレイを1つのパケットとし, 三角形をブロック単位で判定します.
+//!             レイの本数が多い場合はOpenMPでスレッドに分配します.
+//!             交差しなかったレイの結果は index が U32_MAX, distance が maxDistance になります.
+//! @param[in]      pRays           レイの配列です.
+//! @param[in]      rayCount        レイの本数です.
+//! @param[in]      pPositions      位置座標の配列です.
+//! @param[in]      pIndices        頂点インデックスの配列です(3つで1つの三角形).
+//! @param[in]      triangleCount   三角形数です.
+//! @param[out]     pHits           交差結果の格納先です. rayCount 個の要素が必要です.
+//! @param[in]      maxDistance     交差を判定する最大距離です.
+//! @return     交差したレイの本数を返却します.
+//-------------------------------------------------------------------------------------------------
+u32 IntersectTrianglesPacket(
+    const Ray*      pRays,
+    u32             rayCount,
+    const Vector3*  pPositions,
+    const u32*      pIndices,
+    u32             triangleCount,
+    RayHit*         pHits,
+    f32             maxDistance = F32_MAX );
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      複数のレイとメッシュリソースの交差判定をまとめて行います.
+//!
+//! @param[in]      pRays           レイの配列です.
+//! @param[in]      rayCount        レイの本数です.
+//! @param[in]      mesh            メッシュリソースです.
+//! @param[out]     pHits           交差結果の格納先です. rayCount 個の要素が必要です.
+//! @param[in]      maxDistance     交差を判定する最大距離です.
+//! @return     交差したレイの本数を返却します.
+//-------------------------------------------------------------------------------------------------
+u32 IntersectTrianglesPacket(
+    const Ray*      pRays,
+    u32             rayCount,
+    const ResMesh&  mesh,
+    RayHit*         pHits,
+    f32             maxDistance = F32_MAX );
+
+} // namespace asdx
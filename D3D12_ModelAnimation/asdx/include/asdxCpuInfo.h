@@ -0,0 +1,86 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxCpuInfo.h
+// Desc : CPU Feature Detection and SIMD Tier Selection.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxTypedef.h>
+
+
+namespace asdx {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// SimdTier enum
+///////////////////////////////////////////////////////////////////////////////////////////////////
+enum class SimdTier : u32
+{
+    Scalar = 0,         //!< スカラー演算.
+    SSE2,               //!< SSE2 (4レーン).
+    SSE4_1,             //!< SSE4.1 (4レーン).
+    AVX2,               //!< AVX2 (8レーン).
+    AVX512,             //!< AVX-512F (16レーン).
+    NEON,               //!< NEON (4レーン).
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// CpuFeature structure
+// CPUとOSが対応している命令セットです.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct CpuFeature
+{
+    bool    SSE2;           //!< SSE2.
+    bool    SSE4_1;         //!< SSE4.1.
+    bool    SSE4_2;         //!< SSE4.2 (CRC32命令).
+    bool    POPCNT;         //!< POPCNT.
+    bool    PCLMUL;         //!< PCLMULQDQ (キャリーレス乗算).
+    bool    AVX;            //!< AVX (OSによるYMMレジスタの退避を含む).
+    bool    AVX2;           //!< AVX2.
+    bool    FMA;            //!< FMA3.
+    bool    F16C;           //!< 半精度浮動小数変換.
+    bool    AVX512F;        //!< AVX-512F (OSによるZMMレジスタの退避を含む).
+    bool    NEON;           //!< NEON.
+    bool    CRC32;          //!< ARMv8 CRC32命令.
+};
+
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      CPUの対応命令セットを取得します.
+//!
+//! @details    初回呼び出し時にCPUIDで判定し, 以降はその結果を返却します.
+//-------------------------------------------------------------------------------------------------
+const CpuFeature& GetCpuFeature();
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      CPUとビルド設定の双方が対応している最上位のSIMD段階を取得します.
+//-------------------------------------------------------------------------------------------------
+SimdTier GetSupportedSimdTier();
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      バッチ演算カーネルが現在使用しているSIMD段階を取得します.
+//-------------------------------------------------------------------------------------------------
+SimdTier GetActiveSimdTier();
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      バッチ演算カーネルが使用するSIMD段階の上限を設定します.
+//!
+//! @details    比較計測のために下位の段階を強制する用途を想定しています.
+//!             上限以下で利用可能な最上位の段階が選択されます. 上限に対応していない段階を
+//!             指定した場合はそれより下位の段階になり, SimdTier::Scalar は常に選択可能です.
+//!             カーネル実行中の別スレッドから呼び出さないでください.
+//!
+//! @param[in]      limit       上限とする段階です.
+//! @return     実際に選択された段階を返却します.
+//-------------------------------------------------------------------------------------------------
+SimdTier SetSimdTierLimit( SimdTier limit );
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      SIMD段階の名前を取得します.
+//-------------------------------------------------------------------------------------------------
+const char* GetSimdTierName( SimdTier tier );
+
+} // namespace asdx
@@ -153,6 +153,41 @@ struct BoundingBox
     //! @return     2つのバウンディングボックスをマージした結果を返却します.
     //---------------------------------------------------------------------------------------------
     static BoundingBox Merge( const BoundingBox& a, const BoundingBox& b );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      点群を含むバウンディングボックスを求めます.
+    //!
+    //! @details    点数が多い場合は複数スレッドで処理します.
+    //!
+    //! @param[in]      pPoints     点群です.
+    //! @param[in]      count       点数です.
+    //! @return     点群を含むバウンディングボックスを返却します. 点数が0の場合は BoundingBox() を返却します.
+    //---------------------------------------------------------------------------------------------
+    static BoundingBox CreateFromPoints( const Vector3* pPoints, u32 count );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      インデックスで指定した点群を含むバウンディングボックスを求めます.
+    //!
+    //! @param[in]      pPoints     点群です.
+    //! @param[in]      pIndices    点の番号の配列です.
+    //! @param[in]      indexCount  インデックス数です.
+    //! @return     点群を含むバウンディングボックスを返却します. 点数が0の場合は BoundingBox() を返却します.
+    //---------------------------------------------------------------------------------------------
+    static BoundingBox CreateFromIndexedPoints( const Vector3* pPoints, const u32* pIndices, u32 indexCount );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ボックスをそれぞれの行列で変換したものを含むバウンディングボックスを求めます.
+    //!
+    //! @details    ボックス i は pTransforms[i] で変換します. 空のボックスは無視します.
+    //!             ボーンごとのボックスとボーンのワールド行列からスキンメッシュの範囲を求める用途を
+    //!             想定しており, 処理量はボックス数に比例します.
+    //!
+    //! @param[in]      pBoxes          ボックスの配列です.
+    //! @param[in]      pTransforms     変換行列の配列です.
+    //! @param[in]      count           ボックス数です.
+    //! @return     変換したボックスを含むバウンディングボックスを返却します. 有効なボックスがない場合は BoundingBox() を返却します.
+    //---------------------------------------------------------------------------------------------
+    static BoundingBox CreateFromTransformedBoxes( const BoundingBox* pBoxes, const Matrix* pTransforms, u32 count );
 };
 
 
@@ -236,6 +271,29 @@ struct BoundingSphere
     //! @return     2つのバウンディングスフィアをマージした結果を返却します.
     //---------------------------------------------------------------------------------------------
     static BoundingSphere Merge( const BoundingSphere& a, const BoundingSphere& b );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      点群を含むバウンディングスフィアを求めます.
+    //!
+    //! @details    バウンディングボックスの中心から Ritter の方法でスフィアを広げ, 半径を縮めて
+    //!             広げ直す処理を繰り返して小さくします. 最小のスフィアである保証はありません.
+    //!             点数が多い場合は複数スレッドで処理します.
+    //!
+    //! @param[in]      pPoints     点群です.
+    //! @param[in]      count       点数です.
+    //! @return     点群を含むバウンディングスフィアを返却します. 点数が0の場合は半径0を返却します.
+    //---------------------------------------------------------------------------------------------
+    static BoundingSphere CreateFromPoints( const Vector3* pPoints, u32 count );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      インデックスで指定した点群を含むバウンディングスフィアを求めます.
+    //!
+    //! @param[in]      pPoints     点群です.
+    //! @param[in]      pIndices    点の番号の配列です.
+    //! @param[in]      indexCount  インデックス数です.
+    //! @return     点群を含むバウンディングスフィアを返却します. 点数が0の場合は半径0を返却します.
+    //---------------------------------------------------------------------------------------------
+    static BoundingSphere CreateFromIndexedPoints( const Vector3* pPoints, const u32* pIndices, u32 indexCount );
 };
 
 
@@ -361,6 +419,62 @@ public:
     //---------------------------------------------------------------------------------------------
     std::array<Vector3, 8> GetCorners() const;
 
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ワールド空間の6平面を取得します.
+    //!
+    //! @details    各平面は (nx, ny, nz, d) の形式で, 法線は正規化済みかつ錐台の内側を向きます.
+    //!             点 p の符号付き距離は nx * p.x + ny * p.y + nz * p.z + d です.
+    //!             並びは 手前, 奥, 左, 右, 下, 上 の順で, 判定条件は Contains( const Vector3& ) と同じです.
+    //! @param[out]     pPlanes     6平面の格納先です.
+    //---------------------------------------------------------------------------------------------
+    void GetPlanes( Vector4* pPlanes ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      中心と半分の大きさを成分ごとの配列で与えたバウンディングボックスをまとめて判定します.
+    //!
+    //! @details    平面ごとに中心との距離とボックスの投影半径を比較します(p-vertex判定).
+    //!             i番目の結果は pResults[i / 32] の bit (i % 32) に格納され, 1は錐台内(一部を含む)です.
+    //!             最後のワードの未使用bitは0になります.
+    //!             要素数が多い場合はOpenMPでスレッドに分配します. 呼び出し側で分割する場合は
+    //!             区間の先頭を32の倍数にし, 各配列と pResults + 先頭 / 32 を渡してください.
+    //! @param[in]      pCenterX    中心のX成分の配列です.
+    //! @param[in]      pCenterY    中心のY成分の配列です.
+    //! @param[in]      pCenterZ    中心のZ成分の配列です.
+    //! @param[in]      pExtentX    半分の大きさのX成分の配列です.
+    //! @param[in]      pExtentY    半分の大きさのY成分の配列です.
+    //! @param[in]      pExtentZ    半分の大きさのZ成分の配列です.
+    //! @param[in]      count       ボックスの数です.
+    //! @param[out]     pResults    可視判定のビットマスクです. (count + 31) / 32 個のu32が必要です.
+    //---------------------------------------------------------------------------------------------
+    void ContainsBoxStream(
+        const f32*  pCenterX,
+        const f32*  pCenterY,
+        const f32*  pCenterZ,
+        const f32*  pExtentX,
+        const f32*  pExtentY,
+        const f32*  pExtentZ,
+        u32         count,
+        u32*        pResults ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      中心と半径を成分ごとの配列で与えたバウンディングスフィアをまとめて判定します.
+    //!
+    //! @details    平面との符号付き距離で判定します. 結果の並びは ContainsBoxStream() と同じです.
+    //! @param[in]      pCenterX    中心のX成分の配列です.
+    //! @param[in]      pCenterY    中心のY成分の配列です.
+    //! @param[in]      pCenterZ    中心のZ成分の配列です.
+    //! @param[in]      pRadius     半径の配列です.
+    //! @param[in]      count       スフィアの数です.
+    //! @param[out]     pResults    可視判定のビットマスクです. (count + 31) / 32 個のu32が必要です.
+    //---------------------------------------------------------------------------------------------
+    void ContainsSphereStream(
+        const f32*  pCenterX,
+        const f32*  pCenterY,
+        const f32*  pCenterZ,
+        const f32*  pRadius,
+        u32         count,
+        u32*        pResults ) const;
+
 private:
     //=============================================================================================
     // private variables.
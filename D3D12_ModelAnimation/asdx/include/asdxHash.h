@@ -9,6 +9,7 @@
 // Includes
 //-------------------------------------------------------------------------------------------------
 #include <asdxTypedef.h>
+#include <cstddef>
 
 
 namespace asdx {
@@ -74,6 +75,19 @@ public:
     //---------------------------------------------------------------------------------------------
     Crc32( const Crc32& value );
 
+    //---------------------------------------------------------------------------------------------
+    //! @brief      バッファを追加してハッシュキーを更新します.
+    //!
+    //! @details    分割したバッファを順に追加した結果は, 連結したバッファから生成した結果と一致します.
+    //!             既定のコンストラクタで生成した場合は空のバッファの値(0)から開始します.
+    //!             大きなバッファはCPUが対応していればキャリーレス乗算(x86)またはCRC32命令(ARM64)で
+    //!             処理します. SetSimdTierLimit() で SSE4.1 未満を指定した場合は使用しません.
+    //!
+    //! @param[in]      size        バッファサイズです.
+    //! @param[in]      pBuffer     バッファです.
+    //---------------------------------------------------------------------------------------------
+    void Update( size_t size, const void* pBuffer );
+
     //---------------------------------------------------------------------------------------------
     //! @brief      ハッシュキーを取得します.
     //!
@@ -408,4 +422,211 @@ private:
     /* NOTHING */
 };
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Hash128 structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct Hash128
+{
+    u64     Low;        //!< 下位64ビットです.
+    u64     High;       //!< 上位64ビットです.
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      等価比較演算子です.
+    //---------------------------------------------------------------------------------------------
+    bool operator == ( const Hash128& value ) const
+    { return ( Low == value.Low ) && ( High == value.High ); }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      非等価比較演算子です.
+    //---------------------------------------------------------------------------------------------
+    bool operator != ( const Hash128& value ) const
+    { return ( Low != value.Low ) || ( High != value.High ); }
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Xxh3 class
+// xxHash3 (XXH3 v0.8) の64ビット/128ビットハッシュを分割したバッファから求めます.
+// 結果は xxHash の XXH3_64bits_withSeed() / XXH3_128bits_withSeed() と一致します.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class Xxh3
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    /* NOTHING */
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //!
+    //! @param[in]      seed        シード値です.
+    //---------------------------------------------------------------------------------------------
+    explicit Xxh3( u64 seed = 0 );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      空のバッファの状態に戻します.
+    //!
+    //! @param[in]      seed        シード値です.
+    //---------------------------------------------------------------------------------------------
+    void Reset( u64 seed = 0 );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      バッファを追加します.
+    //!
+    //! @details    分割したバッファを順に追加した結果は, 連結したバッファから求めた結果と一致します.
+    //!
+    //! @param[in]      size        バッファサイズです.
+    //! @param[in]      pBuffer     バッファです.
+    //---------------------------------------------------------------------------------------------
+    void Update( size_t size, const void* pBuffer );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      これまでに追加したバッファの64ビットハッシュを取得します.
+    //!
+    //! @return     ハッシュキーを返却します.
+    //---------------------------------------------------------------------------------------------
+    u64 GetHash64() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      これまでに追加したバッファの128ビットハッシュを取得します.
+    //!
+    //! @return     ハッシュキーを返却します.
+    //---------------------------------------------------------------------------------------------
+    Hash128 GetHash128() const;
+
+protected:
+    //=============================================================================================
+    // protected variables.
+    //=============================================================================================
+    /* NOTHING */
+
+    //=============================================================================================
+    // protected methods.
+    //=============================================================================================
+    /* NOTHING */
+
+private:
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    static const u32 SECRET_SIZE = 192;     //!< シークレットのバイト数です.
+    static const u32 BUFFER_SIZE = 256;     //!< 内部バッファのバイト数です.
+
+    u64     m_Acc[8];                   //!< アキュムレータです.
+    u8      m_Secret[SECRET_SIZE];      //!< シード値から生成したシークレットです.
+    u8      m_Buffer[BUFFER_SIZE];      //!< 未処理のバッファです.
+    u64     m_Seed;                     //!< シード値です.
+    u64     m_TotalSize;                //!< 追加したバッファの合計サイズです.
+    u32     m_BufferedSize;             //!< 内部バッファに保持しているバイト数です.
+    u32     m_StripeCount;              //!< 現在のブロックで処理したストライプ数です.
+
+    //=============================================================================================
+    // private methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ストライプを処理し, ブロックの終わりに達したらアキュムレータをかき混ぜます.
+    //---------------------------------------------------------------------------------------------
+    static void ConsumeStripes( u64* pAcc, u32& stripeCount, const u8* pInput, size_t stripes, const u8* pSecret );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      最後のストライプまで処理したアキュムレータを求めます. 合計サイズが240バイトを超える場合のみ使用します.
+    //---------------------------------------------------------------------------------------------
+    void DigestLong( u64* pAcc ) const;
+};
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      バッファの xxHash3 64ビットハッシュを求めます.
+//!
+//! @details    CRC32やFNVと比べて衝突しにくく, 大きなバッファはSIMDで処理します.
+//!             アセットやパイプラインステートのキャッシュのキーに使用します.
+//!
+//! @param[in]      size        バッファサイズです.
+//! @param[in]      pBuffer     バッファです.
+//! @param[in]      seed        シード値です.
+//! @return     ハッシュキーを返却します.
+//-------------------------------------------------------------------------------------------------
+u64 CalcXxh3_64( size_t size, const void* pBuffer, u64 seed = 0 );
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      バッファの xxHash3 128ビットハッシュを求めます.
+//!
+//! @param[in]      size        バッファサイズです.
+//! @param[in]      pBuffer     バッファです.
+//! @param[in]      seed        シード値です.
+//! @return     ハッシュキーを返却します.
+//-------------------------------------------------------------------------------------------------
+Hash128 CalcXxh3_128( size_t size, const void* pBuffer, u64 seed = 0 );
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      文字列のFNV-1ハッシュを求めます.
+//!
+//! @details    コンパイル時に評価でき, Fnv1 の同じ引数のコンストラクタと同じ値になります.
+//!             再帰で求めるため, 実行時の長い文字列には Fnv1 を使用してください.
+//!
+//! @param[in]      pBuffer     文字列です.
+//! @return     ハッシュキーを返却します.
+//-------------------------------------------------------------------------------------------------
+constexpr u32 CalcFnv1( const char8*  pBuffer );
+constexpr u32 CalcFnv1( const char16* pBuffer );
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      文字列のFNV-1aハッシュを求めます.
+//!
+//! @details    コンパイル時に評価でき, Fnv1a の同じ引数のコンストラクタと同じ値になります.
+//!             再帰で求めるため, 実行時の長い文字列には Fnv1a を使用してください.
+//!
+//! @param[in]      pBuffer     文字列です.
+//! @return     ハッシュキーを返却します.
+//-------------------------------------------------------------------------------------------------
+constexpr u32 CalcFnv1a( const char8*  pBuffer );
+constexpr u32 CalcFnv1a( const char16* pBuffer );
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      文字列のCRC32を求めます.
+//!
+//! @details    コンパイル時に評価でき, Crc32 の同じ引数のコンストラクタと同じ値になります.
+//!             char16 版は Crc32 と同じく各文字の下位8ビットのみを処理します.
+//!             再帰で求めるため, 実行時の長い文字列には Crc32 を使用してください.
+//!
+//! @param[in]      pBuffer     文字列です.
+//! @return     ハッシュキーを返却します.
+//-------------------------------------------------------------------------------------------------
+constexpr u32 CalcCrc32( const char8*  pBuffer );
+constexpr u32 CalcCrc32( const char16* pBuffer );
+
+
+inline namespace literals {
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      文字列リテラルのハッシュキーを求めます.
+//!
+//! @details    "Head"_fnv1a は CalcFnv1a( "Head" ) と同じ値です. switch 文の case ラベルにも使えます.
+//!             using namespace asdx::literals; または using namespace asdx; で使用します.
+//-------------------------------------------------------------------------------------------------
+constexpr u32 operator "" _fnv1 ( const char8*  pBuffer, size_t length );
+constexpr u32 operator "" _fnv1 ( const char16* pBuffer, size_t length );
+constexpr u32 operator "" _fnv1a( const char8*  pBuffer, size_t length );
+constexpr u32 operator "" _fnv1a( const char16* pBuffer, size_t length );
+constexpr u32 operator "" _crc32( const char8*  pBuffer, size_t length );
+constexpr u32 operator "" _crc32( const char16* pBuffer, size_t length );
+
+} // inline namespace literals
+
 } // namespace asdx
+
+
+//-------------------------------------------------------------------------------------------------
+// Inline Files
+//-------------------------------------------------------------------------------------------------
+#include <detail/asdxHash.inl>
@@ -0,0 +1,245 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxHashMap.h
+// Desc : Open Addressing Hash Map.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxTypedef.h>
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+
+namespace asdx {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// HashOf structure
+// キーのハッシュ値を求める関数オブジェクトです. 整数とポインタに対して特殊化しています.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+struct HashOf;
+
+template<>
+struct HashOf<u32>
+{
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ハッシュ値を求めます.
+    //---------------------------------------------------------------------------------------------
+    u32 operator () ( u32 value ) const;
+};
+
+template<>
+struct HashOf<s32>
+{
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ハッシュ値を求めます.
+    //---------------------------------------------------------------------------------------------
+    u32 operator () ( s32 value ) const;
+};
+
+template<>
+struct HashOf<u64>
+{
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ハッシュ値を求めます.
+    //---------------------------------------------------------------------------------------------
+    u32 operator () ( u64 value ) const;
+};
+
+template<typename T>
+struct HashOf<T*>
+{
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ハッシュ値を求めます.
+    //---------------------------------------------------------------------------------------------
+    u32 operator () ( const T* value ) const;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// HashMap class
+// オープンアドレス法(Robin Hood hashing)によるハッシュマップです.
+// 要素はキーと値を並べた1つの配列に格納し, 探索は連続したメモリを順に読みます.
+// 容量を確保した後は, 要素数が容量の7/8以下であれば追加と削除でメモリを確保しません.
+// キーと値はデフォルトコンストラクタとムーブ代入が可能である必要があります.
+// 追加と削除で要素が移動するため, Find() で取得したポインタは次の変更まで有効です.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename KeyType, typename ValueType, typename Hasher = HashOf<KeyType>>
+class HashMap
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    /* NOTHING */
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------------------
+    HashMap();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      引数付きコンストラクタです.
+    //!
+    //! @param[in]      count       メモリを再確保せずに格納できる要素数です.
+    //---------------------------------------------------------------------------------------------
+    explicit HashMap( u32 count );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      メモリを再確保せずに格納できる要素数を指定します.
+    //!
+    //! @param[in]      count       要素数です.
+    //---------------------------------------------------------------------------------------------
+    void Reserve( u32 count );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      要素を追加します.
+    //!
+    //! @param[in]      key         キーです.
+    //! @param[in]      value       値です.
+    //! @retval true    追加しました.
+    //! @retval false   キーが既に存在します. 値は変更しません.
+    //---------------------------------------------------------------------------------------------
+    bool Insert( const KeyType& key, const ValueType& value );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      要素を削除します.
+    //!
+    //! @param[in]      key         キーです.
+    //! @retval true    削除しました.
+    //! @retval false   キーが存在しません.
+    //---------------------------------------------------------------------------------------------
+    bool Erase( const KeyType& key );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      全ての要素を削除します. 容量は変更しません.
+    //---------------------------------------------------------------------------------------------
+    void Clear();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      値を検索します.
+    //!
+    //! @param[in]      key         キーです.
+    //! @return     値へのポインタを返却します. キーが存在しない場合は nullptr を返却します.
+    //---------------------------------------------------------------------------------------------
+    ValueType*       Find( const KeyType& key );
+    const ValueType* Find( const KeyType& key ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      キーが存在するかどうかチェックします.
+    //!
+    //! @param[in]      key         キーです.
+    //! @retval true    存在します.
+    //! @retval false   存在しません.
+    //---------------------------------------------------------------------------------------------
+    bool Contains( const KeyType& key ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      値を取得します. キーが存在しない場合はデフォルト値で追加します.
+    //!
+    //! @param[in]      key         キーです.
+    //! @return     値への参照を返却します.
+    //---------------------------------------------------------------------------------------------
+    ValueType& operator [] ( const KeyType& key );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      全ての要素に対して関数を呼び出します. 順序は不定です.
+    //!
+    //! @param[in]      func        void( const KeyType&, ValueType& ) 形式の関数です.
+    //---------------------------------------------------------------------------------------------
+    template<typename Func>
+    void ForEach( Func func );
+
+    template<typename Func>
+    void ForEach( Func func ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      要素数を取得します.
+    //!
+    //! @return     要素数を返却します.
+    //---------------------------------------------------------------------------------------------
+    u32 GetCount() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      要素を格納する配列の大きさを取得します.
+    //!
+    //! @return     配列の大きさを返却します.
+    //---------------------------------------------------------------------------------------------
+    u32 GetCapacity() const;
+
+protected:
+    //=============================================================================================
+    // protected variables.
+    //=============================================================================================
+    /* NOTHING */
+
+    //=============================================================================================
+    // protected methods.
+    //=============================================================================================
+    /* NOTHING */
+
+private:
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Slot structure
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct Slot
+    {
+        Slot()
+        : Distance( 0 ), Key(), Value()
+        { /* DO_NOTHING */ }
+
+        u32         Distance;   //!< 本来の位置からの距離 + 1 です. 0 は空きです.
+        KeyType     Key;        //!< キーです.
+        ValueType   Value;      //!< 値です.
+    };
+
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    static const u32 MIN_CAPACITY = 16;     //!< 最小の配列の大きさです.
+
+    std::vector<Slot>   m_Slots;    //!< 要素の配列です. 大きさは2の累乗です.
+    u32                 m_Count;    //!< 要素数です.
+    u32                 m_Mask;     //!< 配列の大きさ - 1 です.
+    Hasher              m_Hasher;   //!< ハッシュ関数です.
+
+    //=============================================================================================
+    // private methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      キーの位置を検索します. 存在しない場合は U32_MAX を返却します.
+    //---------------------------------------------------------------------------------------------
+    u32 FindIndex( const KeyType& key ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      存在しないキーを追加し, 位置を返却します.
+    //---------------------------------------------------------------------------------------------
+    u32 InsertNew( KeyType&& key, ValueType&& value );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      配列の大きさを変更して再配置します.
+    //---------------------------------------------------------------------------------------------
+    void Rehash( u32 capacity );
+};
+
+} // namespace asdx
+
+
+//-------------------------------------------------------------------------------------------------
+// Inline Files
+//-------------------------------------------------------------------------------------------------
+#include <detail/asdxHashMap.inl>
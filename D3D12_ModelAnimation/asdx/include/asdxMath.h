@@ -9,6 +9,7 @@
 // Includes
 //--------------------------------------------------------------------------------------------------
 #include <asdxTypedef.h>
+#include <asdxSimd.h>
 #include <cmath>
 #include <cfloat>
 #include <cassert>
@@ -25,6 +26,7 @@ struct Vector3;
 struct Vector4;
 struct Matrix;
 struct Quaternion;
+struct DualQuaternion;
 
 
 //--------------------------------------------------------------------------------------------------
@@ -49,6 +51,18 @@ static constexpr f64 D_PIDIV6  = 0.52359877559829887307710723054658;     //!< π
 static constexpr f64 D_EPSILON = 2.2204460492503131e-016;                //!< マシンイプシロン(double)
 
 static constexpr f32 ONB_EPSILON = 0.01f;                                //!< 正規直交規定を算出する際に用いるイプシロン値です.
+static constexpr f32 RIGID_EPSILON = 1.0e-5f;                           //!< 剛体変換行列を判定する際に用いるイプシロン値です.
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MatrixType enum
+///////////////////////////////////////////////////////////////////////////////////////////////////
+enum class MatrixType : u32
+{
+    General = 0,        //!< 一般の4x4行列.
+    Affine,             //!< アフィン変換行列(4列目が 0, 0, 0, 1).
+    Rigid,              //!< 剛体変換行列(回転と平行移動のみ).
+};
 
 
 //--------------------------------------------------------------------------------------------------
@@ -190,6 +204,8 @@ u32     Comb( u32 n, u32 r );
 //--------------------------------------------------------------------------------------------------
 //! @brief      f32型からf16型に変換します.
 //!
+//! @details    最近接偶数に丸めます. f16で表現できない値は無限大に, NaNはquiet NaNになります.
+//!
 //! @param [in]     value       f16型に変換する値.
 //! @return     半精度浮動小数表現に変換した結果を返却します.
 //--------------------------------------------------------------------------------------------------
@@ -1539,6 +1555,102 @@ public:
     //----------------------------------------------------------------------------------------------
     static void    TransformCoord( const Vector3& coord, const Matrix& matrix, Vector3& result );
 
+    //----------------------------------------------------------------------------------------------
+    //! @brief      指定された行列を用いて，位置座標の配列をまとめて変換します.
+    //!
+    //! @param [in]     pPositions  入力ベクトルの配列.
+    //! @param [in]     count       ベクトル数.
+    //! @param [in]     matrix      変換行列.
+    //! @param [out]    pResults    変換されたベクトルの格納先. pPositions と同じでも構いません.
+    //----------------------------------------------------------------------------------------------
+    static void    TransformArray( const Vector3* pPositions, u32 count, const Matrix& matrix, Vector3* pResults );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      指定された行列を用いて，法線ベクトルの配列をまとめて変換します.
+    //!
+    //! @param [in]     pNormals    入力ベクトルの配列.
+    //! @param [in]     count       ベクトル数.
+    //! @param [in]     matrix      変換行列.
+    //! @param [out]    pResults    変換されたベクトルの格納先. pNormals と同じでも構いません.
+    //----------------------------------------------------------------------------------------------
+    static void    TransformNormalArray( const Vector3* pNormals, u32 count, const Matrix& matrix, Vector3* pResults );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      指定された行列を用いて，ベクトルの配列をまとめて変換し，w=1に射影します.
+    //!
+    //! @param [in]     pCoords     入力ベクトルの配列.
+    //! @param [in]     count       ベクトル数.
+    //! @param [in]     matrix      変換行列.
+    //! @param [out]    pResults    変換されたベクトルの格納先. pCoords と同じでも構いません.
+    //----------------------------------------------------------------------------------------------
+    static void    TransformCoordArray( const Vector3* pCoords, u32 count, const Matrix& matrix, Vector3* pResults );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      成分ごとの配列(SoA)で与えられた位置座標をまとめて変換します.
+    //!
+    //! @param [in]     pX          入力X成分の配列.
+    //! @param [in]     pY          入力Y成分の配列.
+    //! @param [in]     pZ          入力Z成分の配列.
+    //! @param [in]     count       ベクトル数.
+    //! @param [in]     matrix      変換行列.
+    //! @param [out]    pResultX    変換後のX成分の格納先.
+    //! @param [out]    pResultY    変換後のY成分の格納先.
+    //! @param [out]    pResultZ    変換後のZ成分の格納先.
+    //----------------------------------------------------------------------------------------------
+    static void    TransformStream(
+        const f32*      pX,
+        const f32*      pY,
+        const f32*      pZ,
+        u32             count,
+        const Matrix&   matrix,
+        f32*            pResultX,
+        f32*            pResultY,
+        f32*            pResultZ );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      成分ごとの配列(SoA)で与えられた法線ベクトルをまとめて変換します.
+    //!
+    //! @param [in]     pX          入力X成分の配列.
+    //! @param [in]     pY          入力Y成分の配列.
+    //! @param [in]     pZ          入力Z成分の配列.
+    //! @param [in]     count       ベクトル数.
+    //! @param [in]     matrix      変換行列.
+    //! @param [out]    pResultX    変換後のX成分の格納先.
+    //! @param [out]    pResultY    変換後のY成分の格納先.
+    //! @param [out]    pResultZ    変換後のZ成分の格納先.
+    //----------------------------------------------------------------------------------------------
+    static void    TransformNormalStream(
+        const f32*      pX,
+        const f32*      pY,
+        const f32*      pZ,
+        u32             count,
+        const Matrix&   matrix,
+        f32*            pResultX,
+        f32*            pResultY,
+        f32*            pResultZ );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      成分ごとの配列(SoA)で与えられたベクトルをまとめて変換し，w=1に射影します.
+    //!
+    //! @param [in]     pX          入力X成分の配列.
+    //! @param [in]     pY          入力Y成分の配列.
+    //! @param [in]     pZ          入力Z成分の配列.
+    //! @param [in]     count       ベクトル数.
+    //! @param [in]     matrix      変換行列.
+    //! @param [out]    pResultX    変換後のX成分の格納先.
+    //! @param [out]    pResultY    変換後のY成分の格納先.
+    //! @param [out]    pResultZ    変換後のZ成分の格納先.
+    //----------------------------------------------------------------------------------------------
+    static void    TransformCoordStream(
+        const f32*      pX,
+        const f32*      pY,
+        const f32*      pZ,
+        u32             count,
+        const Matrix&   matrix,
+        f32*            pResultX,
+        f32*            pResultY,
+        f32*            pResultZ );
+
     //----------------------------------------------------------------------------------------------
     //! @brief      スカラー3重積を計算します.
     //!
@@ -2159,6 +2271,42 @@ public:
     //----------------------------------------------------------------------------------------------
     static void    Transform( const Vector4& position, const Matrix& matrix, Vector4 &result );
 
+    //----------------------------------------------------------------------------------------------
+    //! @brief      指定された行列を用いて，ベクトルの配列をまとめて変換します.
+    //!
+    //! @param [in]     pPositions  入力ベクトルの配列.
+    //! @param [in]     count       ベクトル数.
+    //! @param [in]     matrix      変換行列.
+    //! @param [out]    pResults    変換されたベクトルの格納先. pPositions と同じでも構いません.
+    //----------------------------------------------------------------------------------------------
+    static void    TransformArray( const Vector4* pPositions, u32 count, const Matrix& matrix, Vector4* pResults );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      成分ごとの配列(SoA)で与えられたベクトルをまとめて変換します.
+    //!
+    //! @param [in]     pX          入力X成分の配列.
+    //! @param [in]     pY          入力Y成分の配列.
+    //! @param [in]     pZ          入力Z成分の配列.
+    //! @param [in]     pW          入力W成分の配列.
+    //! @param [in]     count       ベクトル数.
+    //! @param [in]     matrix      変換行列.
+    //! @param [out]    pResultX    変換後のX成分の格納先.
+    //! @param [out]    pResultY    変換後のY成分の格納先.
+    //! @param [out]    pResultZ    変換後のZ成分の格納先.
+    //! @param [out]    pResultW    変換後のW成分の格納先.
+    //----------------------------------------------------------------------------------------------
+    static void    TransformStream(
+        const f32*      pX,
+        const f32*      pY,
+        const f32*      pZ,
+        const f32*      pW,
+        u32             count,
+        const Matrix&   matrix,
+        f32*            pResultX,
+        f32*            pResultY,
+        f32*            pResultZ,
+        f32*            pResultW );
+
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -2513,6 +2661,64 @@ public:
     //----------------------------------------------------------------------------------------------
     static void    Invert( const Matrix& value, Matrix &result );
 
+    //----------------------------------------------------------------------------------------------
+    //! @brief      指定された種別を前提に逆行列を求めます.
+    //!
+    //! @param [in]     value       逆行列を求める値.
+    //! @param [in]     type        行列の種別. Classify() の結果か, それより一般的な種別を指定します.
+    //! @return     逆行列を返却します.
+    //----------------------------------------------------------------------------------------------
+    static Matrix  Invert( const Matrix& value, MatrixType type );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      指定された種別を前提に逆行列を求めます.
+    //!
+    //! @param [in]     value       逆行列を求める値.
+    //! @param [in]     type        行列の種別. Classify() の結果か, それより一般的な種別を指定します.
+    //! @param [out]    result      逆行列.
+    //----------------------------------------------------------------------------------------------
+    static void    Invert( const Matrix& value, MatrixType type, Matrix &result );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      アフィン変換行列の逆行列を求めます.
+    //!
+    //! @param [in]     value       逆行列を求める値. 4列目が (0, 0, 0, 1) である必要があります.
+    //! @return     逆行列を返却します.
+    //----------------------------------------------------------------------------------------------
+    static Matrix  InvertAffine( const Matrix& value );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      アフィン変換行列の逆行列を求めます.
+    //!
+    //! @param [in]     value       逆行列を求める値. 4列目が (0, 0, 0, 1) である必要があります.
+    //! @param [out]    result      逆行列.
+    //----------------------------------------------------------------------------------------------
+    static void    InvertAffine( const Matrix& value, Matrix &result );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      剛体変換行列の逆行列を求めます.
+    //!
+    //! @param [in]     value       逆行列を求める値. 回転と平行移動のみで構成されている必要があります.
+    //! @return     逆行列を返却します.
+    //----------------------------------------------------------------------------------------------
+    static Matrix  InvertRigid( const Matrix& value );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      剛体変換行列の逆行列を求めます.
+    //!
+    //! @param [in]     value       逆行列を求める値. 回転と平行移動のみで構成されている必要があります.
+    //! @param [out]    result      逆行列.
+    //----------------------------------------------------------------------------------------------
+    static void    InvertRigid( const Matrix& value, Matrix &result );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      逆行列の計算に使える最も限定的な種別を判定します.
+    //!
+    //! @param [in]     value       判定する行列.
+    //! @return     行列の種別を返却します.
+    //----------------------------------------------------------------------------------------------
+    static MatrixType Classify( const Matrix& value );
+
     //----------------------------------------------------------------------------------------------
     //! @brief      拡大縮小行列を生成します.
     //!
@@ -3331,6 +3537,68 @@ public:
     //----------------------------------------------------------------------------------------------
     static void        Slerp( const Quaternion& a, const Quaternion& b, f32 amount, Quaternion &result );
 
+    //----------------------------------------------------------------------------------------------
+    //! @brief      四元数の配列をまとめて球面線形補間します.
+    //!
+    //! @details    sin/acos を使わない級数近似で計算するため, Slerp() との差は最大で 1e-6 程度です.
+    //!             内積が負の組は最短経路で補間します.
+    //! @param [in]     pA          入力四元数の配列.
+    //! @param [in]     pB          入力四元数の配列.
+    //! @param [in]     pAmounts    組ごとの補間係数の配列.
+    //! @param [in]     count       四元数の数.
+    //! @param [out]    pResults    補間結果の格納先. pA または pB と同じでも構いません.
+    //----------------------------------------------------------------------------------------------
+    static void        SlerpArray(
+        const Quaternion*   pA,
+        const Quaternion*   pB,
+        const f32*          pAmounts,
+        u32                 count,
+        Quaternion*         pResults );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      四元数の配列をまとめて線形補間し, 正規化します.
+    //!
+    //! @details    内積が負の組は最短経路で補間します.
+    //! @param [in]     pA          入力四元数の配列.
+    //! @param [in]     pB          入力四元数の配列.
+    //! @param [in]     pAmounts    組ごとの補間係数の配列.
+    //! @param [in]     count       四元数の数.
+    //! @param [out]    pResults    補間結果の格納先. pA または pB と同じでも構いません.
+    //----------------------------------------------------------------------------------------------
+    static void        NlerpArray(
+        const Quaternion*   pA,
+        const Quaternion*   pB,
+        const f32*          pAmounts,
+        u32                 count,
+        Quaternion*         pResults );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      四元数の配列をまとめて正規化します.
+    //!
+    //! @param [in]     pValues     入力四元数の配列. 長さ0の要素を含んではいけません.
+    //! @param [in]     count       四元数の数.
+    //! @param [out]    pResults    正規化結果の格納先. pValues と同じでも構いません.
+    //----------------------------------------------------------------------------------------------
+    static void        NormalizeArray( const Quaternion* pValues, u32 count, Quaternion* pResults );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      四元数の配列を成分ごとの配列(SoA)で表した3x4行列にまとめて変換します.
+    //!
+    //! @details    3x4行列は Matrix::CreateFromQuaternion() の結果を転置して平行移動を4列目に置いたもので,
+    //!             r行c列の要素を pResults[(r * 4 + c) * stride + i] に格納します.
+    //! @param [in]     pRotations      回転を表す四元数の配列.
+    //! @param [in]     pTranslations   平行移動の配列. nullptr の場合は平行移動なしとします.
+    //! @param [in]     count           四元数の数.
+    //! @param [in]     stride          各要素の配列の間隔(要素数単位). count 以上である必要があります.
+    //! @param [out]    pResults        変換結果の格納先. 12 * stride 個の要素が必要です.
+    //----------------------------------------------------------------------------------------------
+    static void        ToMatrix3x4Stream(
+        const Quaternion*   pRotations,
+        const Vector3*      pTranslations,
+        u32                 count,
+        u32                 stride,
+        f32*                pResults );
+
     //----------------------------------------------------------------------------------------------
     //! @brief      球面四角形補間を行います.
     //!
@@ -3358,6 +3626,186 @@ public:
 };
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// DualQuaternion structure
+////////////////////////////////////////////////////////////////////////////////////////////////////
+struct DualQuaternion
+{
+public:
+    //==============================================================================================
+    // public variables
+    //==============================================================================================
+    Quaternion  real;       //!< 実部(回転)です.
+    Quaternion  dual;       //!< 双対部(0.5 * 平行移動 * 回転)です.
+
+    //==============================================================================================
+    // public methods
+    //==============================================================================================
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      引数なしコンストラクタです.
+    //----------------------------------------------------------------------------------------------
+    DualQuaternion();
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      実部と双対部を指定して生成します.
+    //!
+    //! @param [in]     nreal       実部.
+    //! @param [in]     ndual       双対部.
+    //----------------------------------------------------------------------------------------------
+    DualQuaternion( const Quaternion& nreal, const Quaternion& ndual );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      回転と平行移動から生成します.
+    //!
+    //! @param [in]     rotation    回転を表す単位四元数.
+    //! @param [in]     translation 平行移動量(回転後に適用されます).
+    //----------------------------------------------------------------------------------------------
+    DualQuaternion( const Quaternion& rotation, const Vector3& translation );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      単位双対四元数を生成します.
+    //!
+    //! @return     単位双対四元数を返却します.
+    //----------------------------------------------------------------------------------------------
+    static DualQuaternion CreateIdentity();
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      剛体変換行列から生成します.
+    //!
+    //! @details    左上3x3の各行を正規化してから回転を取り出すため, 拡大縮小成分は無視されます.
+    //! @param [in]     value       変換行列.
+    //! @return     双対四元数を返却します.
+    //----------------------------------------------------------------------------------------------
+    static DualQuaternion CreateFromMatrix( const Matrix& value );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      剛体変換行列から生成します.
+    //!
+    //! @details    左上3x3の各行を正規化してから回転を取り出すため, 拡大縮小成分は無視されます.
+    //! @param [in]     value       変換行列.
+    //! @param [out]    result      双対四元数.
+    //----------------------------------------------------------------------------------------------
+    static void           CreateFromMatrix( const Matrix& value, DualQuaternion& result );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      行列の配列をまとめて双対四元数に変換します.
+    //!
+    //! @param [in]     pMatrices   変換行列の配列.
+    //! @param [in]     count       行列の数.
+    //! @param [out]    pResults    変換結果の格納先.
+    //----------------------------------------------------------------------------------------------
+    static void           CreateFromMatrixArray( const Matrix* pMatrices, u32 count, DualQuaternion* pResults );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      変換行列に変換します.
+    //!
+    //! @param [in]     value       単位双対四元数.
+    //! @return     変換行列を返却します.
+    //----------------------------------------------------------------------------------------------
+    static Matrix         ToMatrix( const DualQuaternion& value );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      変換行列に変換します.
+    //!
+    //! @param [in]     value       単位双対四元数.
+    //! @param [out]    result      変換行列.
+    //----------------------------------------------------------------------------------------------
+    static void           ToMatrix( const DualQuaternion& value, Matrix& result );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      平行移動量を取得します.
+    //!
+    //! @param [in]     value       単位双対四元数.
+    //! @return     平行移動量を返却します.
+    //----------------------------------------------------------------------------------------------
+    static Vector3        GetTranslation( const DualQuaternion& value );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      正規化します.
+    //!
+    //! @param [in]     value       入力双対四元数. 実部の長さが0であってはいけません.
+    //! @return     正規化した結果を返却します.
+    //----------------------------------------------------------------------------------------------
+    static DualQuaternion Normalize( const DualQuaternion& value );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      正規化します.
+    //!
+    //! @param [in]     value       入力双対四元数. 実部の長さが0であってはいけません.
+    //! @param [out]    result      正規化した結果.
+    //----------------------------------------------------------------------------------------------
+    static void           Normalize( const DualQuaternion& value, DualQuaternion& result );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      乗算します. a による変換の後に b による変換を行うものになります.
+    //!
+    //! @param [in]     a           入力双対四元数.
+    //! @param [in]     b           入力双対四元数.
+    //! @return     乗算結果を返却します.
+    //----------------------------------------------------------------------------------------------
+    static DualQuaternion Multiply( const DualQuaternion& a, const DualQuaternion& b );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      乗算します. a による変換の後に b による変換を行うものになります.
+    //!
+    //! @param [in]     a           入力双対四元数.
+    //! @param [in]     b           入力双対四元数.
+    //! @param [out]    result      乗算結果.
+    //----------------------------------------------------------------------------------------------
+    static void           Multiply( const DualQuaternion& a, const DualQuaternion& b, DualQuaternion& result );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      線形ブレンド(DLB)を行い, 正規化します.
+    //!
+    //! @details    実部の内積が負の要素は先頭要素と同じ半球に揃えてから加算します.
+    //! @param [in]     pValues     単位双対四元数の配列.
+    //! @param [in]     pWeights    重みの配列.
+    //! @param [in]     count       要素数. 1以上である必要があります.
+    //! @return     ブレンド結果を返却します.
+    //----------------------------------------------------------------------------------------------
+    static DualQuaternion Blend( const DualQuaternion* pValues, const f32* pWeights, u32 count );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      線形補間(DLB)を行い, 正規化します.
+    //!
+    //! @param [in]     a           入力双対四元数.
+    //! @param [in]     b           入力双対四元数.
+    //! @param [in]     amount      補間係数.
+    //! @return     補間結果を返却します.
+    //----------------------------------------------------------------------------------------------
+    static DualQuaternion Lerp( const DualQuaternion& a, const DualQuaternion& b, f32 amount );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      線形補間(DLB)を行い, 正規化します.
+    //!
+    //! @param [in]     a           入力双対四元数.
+    //! @param [in]     b           入力双対四元数.
+    //! @param [in]     amount      補間係数.
+    //! @param [out]    result      補間結果.
+    //----------------------------------------------------------------------------------------------
+    static void           Lerp( const DualQuaternion& a, const DualQuaternion& b, f32 amount, DualQuaternion& result );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      位置座標を変換します.
+    //!
+    //! @param [in]     position    入力位置座標.
+    //! @param [in]     value       単位双対四元数.
+    //! @return     変換された位置座標を返却します.
+    //----------------------------------------------------------------------------------------------
+    static Vector3        Transform( const Vector3& position, const DualQuaternion& value );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      法線ベクトルを変換します(回転のみ適用します).
+    //!
+    //! @param [in]     normal      入力法線ベクトル.
+    //! @param [in]     value       単位双対四元数.
+    //! @return     変換された法線ベクトルを返却します.
+    //----------------------------------------------------------------------------------------------
+    static Vector3        TransformNormal( const Vector3& normal, const DualQuaternion& value );
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Random class (XorShift)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -3366,7 +3814,7 @@ class Random
     //==============================================================================================
     // list of friend classes and methods.
     //==============================================================================================
-    /* NOTHING */
+    friend class RandomStream;
 
 private:
     //==============================================================================================
@@ -3495,6 +3943,14 @@ public:
     //----------------------------------------------------------------------------------------------
     f64  GetAsF64( f64 a, f64 b );
 
+    //----------------------------------------------------------------------------------------------
+    //! @brief      乱数列を 2^64 個先まで進めます.
+    //!
+    //! @details    GetAsU32() を 2^64 回呼び出した場合と同じ状態になります.
+    //!             複製したインスタンスの一方を進めることで, 重複しない乱数列を得られます.
+    //----------------------------------------------------------------------------------------------
+    void Jump();
+
     //----------------------------------------------------------------------------------------------
     //! @brief      代入演算子です.
     //
@@ -3523,6 +3979,126 @@ public:
 };
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// RandomStream class (XorShift x LaneCount)
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class RandomStream
+{
+    //==============================================================================================
+    // list of friend classes and methods.
+    //==============================================================================================
+    /* NOTHING */
+
+public:
+    //==============================================================================================
+    // public variables
+    //==============================================================================================
+    static const u32 LaneCount = 8;     //!< 独立した乱数列の数です. 命令セットによらず固定です.
+
+    //==============================================================================================
+    // public methods
+    //==============================================================================================
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //! @param [in]     seed        設定する種.
+    //----------------------------------------------------------------------------------------------
+    RandomStream ( s32 seed );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      乱数生成器の現在の状態から生成します.
+    //!
+    //! @details    レーン0は random と同じ乱数列になり, レーンkはレーンk-1を 2^64 個進めた乱数列になります.
+    //! @param [in]     random      元になる乱数生成器.
+    //----------------------------------------------------------------------------------------------
+    explicit RandomStream ( const Random& random );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      コピーコンストラクタです.
+    //! @param [in]     stream      複製元のインスタンス.
+    //----------------------------------------------------------------------------------------------
+    RandomStream ( const RandomStream& stream );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //----------------------------------------------------------------------------------------------
+    ~RandomStream();
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      ランダム種を設定します.
+    //! @param [in]     seed        設定する種. レーン0は Random(seed) と同じ乱数列になります.
+    //----------------------------------------------------------------------------------------------
+    void SetSeed ( s32 seed );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      乱数をu32型としてまとめて生成します.
+    //!
+    //! @details    i番目の値はレーン (i % LaneCount) の (i / LaneCount) 番目の乱数です.
+    //!             結果は実行環境の命令セットによらず同じです.
+    //!             countがLaneCountの倍数でない場合, 最後の段の残りは次の呼び出しで出力するため,
+    //!             Fill( p, n ) と Fill( p + n, m ) の結果は Fill( p, n + m ) と同じです.
+    //! @param [out]    pValues     乱数の格納先.
+    //! @param [in]     count       生成する数.
+    //----------------------------------------------------------------------------------------------
+    void Fill( u32* pValues, u32 count );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      乱数をf32型としてまとめて生成します.
+    //!
+    //! @details    値は上位24bitから求めるため, 0.0fから1.0f未満の範囲で等間隔になります.
+    //!             並び順と途中で分割して呼び出した場合の扱いはu32型と同じです.
+    //! @param [out]    pValues     乱数の格納先.
+    //! @param [in]     count       生成する数.
+    //----------------------------------------------------------------------------------------------
+    void Fill( f32* pValues, u32 count );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      指定された値範囲で乱数をf32型としてまとめて生成します.
+    //! @param [out]    pValues     乱数の格納先.
+    //! @param [in]     count       生成する数.
+    //! @param [in]     a           最小値.
+    //! @param [in]     b           最大値.
+    //----------------------------------------------------------------------------------------------
+    void Fill( f32* pValues, u32 count, f32 a, f32 b );
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      全レーンの乱数列を 2^67 個先まで進めます.
+    //!
+    //! @details    LaneCount x 2^64 個分進めるため, 進める前の全レーンと重複しない乱数列になります.
+    //----------------------------------------------------------------------------------------------
+    void Jump();
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      重複しない乱数列を分割します.
+    //!
+    //! @details    現在の乱数列の複製を返却し, 自身は Jump() で進めます.
+    //!             ワーカースレッドごとに呼び出し順で分割すれば, 再現性のある独立した乱数列になります.
+    //! @return     分割した乱数列を返却します.
+    //----------------------------------------------------------------------------------------------
+    RandomStream Split();
+
+    //----------------------------------------------------------------------------------------------
+    //! @brief      代入演算子です.
+    //!
+    //! @param [in]     stream      代入する値.
+    //! @return     代入結果を返却します.
+    //----------------------------------------------------------------------------------------------
+    RandomStream& operator = ( const RandomStream& stream );
+
+private:
+    //==============================================================================================
+    // private variables
+    //==============================================================================================
+    u32     m_State[4 * LaneCount];     //!< 各レーンの x, y, z, w をこの順に LaneCount 個ずつ並べた状態です.
+    u32     m_Offset;                   //!< 次の段で出力済みのレーン数です.
+
+    //==============================================================================================
+    // private methods
+    //==============================================================================================
+    void SetState( const Random& random );
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // OrthonormalBasis structure
 ////////////////////////////////////////////////////////////////////////////////////////////////////
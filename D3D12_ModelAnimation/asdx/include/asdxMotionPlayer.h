@@ -9,6 +9,7 @@
 // Includes
 //-------------------------------------------------------------------------------------------------
 #include <asdxMath.h>
+#include <asdxGeometry.h>
 #include <asdxResMotion.h>
 #include <vector>
 #include <map>
@@ -127,6 +128,24 @@ public:
     //---------------------------------------------------------------------------------------------
     const Matrix* GetSkinTransforms() const;
 
+    //---------------------------------------------------------------------------------------------
+    //! @brief      スキニング用の双対四元数を取得します.
+    //!
+    //! @return     スキニング行列を双対四元数に変換したものを返却します.
+    //---------------------------------------------------------------------------------------------
+    const DualQuaternion* GetSkinDualQuaternions() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      現在の姿勢のスキンメッシュを含むバウンディングボックスを求めます.
+    //!
+    //! @details    ボーンごとのボックスを Update() で求めたワールド行列で変換してマージします.
+    //!             処理量は頂点数によらずボーン数に比例します.
+    //!
+    //! @param[in]      pBoneBoxes      ボーンごとのボックスです(ResMesh::BoneBoxes). ボーン数分必要です.
+    //! @return     モデル座標系のバウンディングボックスを返却します.
+    //---------------------------------------------------------------------------------------------
+    BoundingBox CalcSkinnedBounds( const BoundingBox* pBoneBoxes ) const;
+
 private:
     //=============================================================================================
     // private variables.
@@ -138,7 +157,9 @@ private:
     std::vector<Matrix> m_BoneTransforms;       //!< ボーン行列です(親ボーン基準の行列).
     std::vector<Matrix> m_WorldTransforms;      //!< ワールド行列です(ワールド座標基準の行列).
     std::vector<Matrix> m_SkinTransforms;       //!< スキニング行列です(バインドポーズ基準の行列).
+    std::vector<DualQuaternion> m_SkinDualQuaternions;  //!< スキニング用の双対四元数です.
     bool                m_IsLoop;               //!< ループ再生フラグです.
+    std::vector<u32>    m_MotionToBone;         //!< モーションのボーン番号からボーン番号への対応表です. 対応がない場合は U32_MAX です.
 
     //=============================================================================================
     // private methods.
@@ -158,6 +179,11 @@ private:
     //---------------------------------------------------------------------------------------------
     void UpdateBoneTransforms();
 
+    //---------------------------------------------------------------------------------------------
+    //! @brief      モーションとボーンをボーン名の名前IDで対応付けます.
+    //---------------------------------------------------------------------------------------------
+    void UpdateBoneMap();
+
     //---------------------------------------------------------------------------------------------
     //! @brief      ワールド行列を更新します.
     //---------------------------------------------------------------------------------------------
@@ -0,0 +1,192 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxOcclusion.h
+// Desc : Software Occlusion Culling Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxGeometry.h>
+#include <vector>
+
+
+namespace asdx {
+
+//-------------------------------------------------------------------------------------------------
+// Forward Declarations
+//-------------------------------------------------------------------------------------------------
+struct ResMesh;
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const u32 OCCLUSION_TILE_WIDTH  = 32;    //!< 深度タイルの幅です(ピクセル).
+static const u32 OCCLUSION_TILE_HEIGHT = 8;     //!< 深度タイルの高さです(ピクセル).
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// OcclusionBuffer class
+// 遮蔽物の三角形をCPUで低解像度にラスタライズし, ボックスが隠れているか判定する深度バッファです.
+// ※ Andersson et al. "Masked Software Occlusion Culling", HPG 2015 を参照.
+//
+// 画面を 32x8 ピクセルのタイルに分け, タイルごとに全体の最大深度と, 被覆マスク付きの作業レイヤーの
+// 最大深度のみを保持します. ボックスの判定はタイル単位の深度で行うため, ピクセル単位の深度を
+// 持つ場合より保守的(隠れていても可視と判定することがある)ですが, 誤って不可視とはしません.
+// 深度は射影後の z / w で, 奥ほど大きい値です.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class OcclusionBuffer
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    /* NOTHING */
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------------------
+    OcclusionBuffer();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //---------------------------------------------------------------------------------------------
+    ~OcclusionBuffer();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      初期化処理を行います.
+    //!
+    //! @param[in]      width       横幅です. OCCLUSION_TILE_WIDTH の倍数を指定します.
+    //! @param[in]      height      縦幅です. OCCLUSION_TILE_HEIGHT の倍数を指定します.
+    //! @retval true    初期化に成功.
+    //! @retval false   初期化に失敗.
+    //---------------------------------------------------------------------------------------------
+    bool Init( u32 width, u32 height );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      終了処理を行います.
+    //---------------------------------------------------------------------------------------------
+    void Term();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      深度をクリアし, ビュー射影行列を設定します.
+    //!
+    //! @param[in]      viewProj    ビュー行列と射影行列を掛けた行列です.
+    //---------------------------------------------------------------------------------------------
+    void Clear( const Matrix& viewProj );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      遮蔽物の三角形リストを描画します.
+    //!
+    //! @details    裏向き(画面上で反時計回り)の三角形は描画しません.
+    //!             手前のクリップ面をまたぐ三角形は切り取って描画します.
+    //!             前から順に描画するほど効率良く深度が更新されます.
+    //!
+    //! @param[in]      world           ワールド行列です.
+    //! @param[in]      pPositions      位置座標の配列です.
+    //! @param[in]      pIndices        頂点インデックスの配列です.
+    //! @param[in]      indexCount      頂点インデックス数です.
+    //---------------------------------------------------------------------------------------------
+    void RenderTriangles(
+        const Matrix&   world,
+        const Vector3*  pPositions,
+        const u32*      pIndices,
+        u32             indexCount );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      遮蔽物のメッシュを描画します.
+    //!
+    //! @param[in]      world           ワールド行列です.
+    //! @param[in]      mesh            メッシュリソースです.
+    //---------------------------------------------------------------------------------------------
+    void RenderMesh( const Matrix& world, const ResMesh& mesh );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ワールド空間のボックスが見えるかどうか判定します.
+    //!
+    //! @param[in]      box         判定するボックスです.
+    //! @retval true    見える可能性があります. 手前のクリップ面をまたぐ場合も true です.
+    //! @retval false   遮蔽物に隠れているか, 画面外です.
+    //---------------------------------------------------------------------------------------------
+    bool TestBox( const BoundingBox& box ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ボックス配列をまとめて判定します.
+    //!
+    //! @details    ボックスは world の座標系で指定し, 8頂点を射影して判定します.
+    //!             要素数が多い場合はOpenMPでスレッドに分配します.
+    //!
+    //! @param[in]      world       ボックスの座標系からワールド空間への変換行列です.
+    //! @param[in]      pBoxes      ボックスの配列です.
+    //! @param[in]      count       ボックス数です.
+    //! @param[out]     pResults    判定結果です. 要素 i の結果は pResults[i / 32] の (i % 32) bit目で,
+    //!                             見える可能性がある場合に1になります. (count + 31) / 32 個必要です.
+    //---------------------------------------------------------------------------------------------
+    void TestBoxes(
+        const Matrix&       world,
+        const BoundingBox*  pBoxes,
+        u32                 count,
+        u32*                pResults ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ピクセルごとの保守的な深度を取得します. デバッグ表示用です.
+    //!
+    //! @param[out]     pDepth      深度の格納先です. 横幅 x 縦幅 個必要です. 遮蔽物のない位置は F32_MAX です.
+    //---------------------------------------------------------------------------------------------
+    void ReadDepth( f32* pDepth ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      横幅を取得します.
+    //!
+    //! @return     横幅を返却します.
+    //---------------------------------------------------------------------------------------------
+    u32 GetWidth() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      縦幅を取得します.
+    //!
+    //! @return     縦幅を返却します.
+    //---------------------------------------------------------------------------------------------
+    u32 GetHeight() const;
+
+private:
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Tile structure
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct Tile
+    {
+        u32     mask[OCCLUSION_TILE_HEIGHT];    //!< 作業レイヤーの被覆マスクです(1行32ピクセル).
+        f32     zMax0;                          //!< タイル全体の最大深度です.
+        f32     zMax1;                          //!< 作業レイヤーの被覆ピクセルの最大深度です.
+    };
+
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    std::vector<Tile>   m_Tiles;        //!< 深度タイルです.
+    std::vector<f32>    m_Triangles;    //!< 設定済み三角形の作業領域です.
+    u32                 m_Width;        //!< 横幅です.
+    u32                 m_Height;       //!< 縦幅です.
+    u32                 m_TileCountX;   //!< 横方向のタイル数です.
+    u32                 m_TileCountY;   //!< 縦方向のタイル数です.
+    Matrix              m_ViewProj;     //!< ビュー射影行列です.
+
+    //=============================================================================================
+    // private methods.
+    //=============================================================================================
+    void RasterizeTriangle( const f32* pTriangle );
+    void ClipTriangle( const Matrix& worldViewProj, const Vector3* pPositions, const u32* pIndices );
+    bool TestRect( const f32* pRect ) const;
+};
+
+} // namespace asdx
@@ -0,0 +1,119 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxPack.h
+// Desc : Data Packing Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxMath.h>
+
+
+namespace asdx {
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      f32型の配列をf16型にまとめて変換します.
+//!
+//! @details    F32ToF16() と同じく最近接偶数に丸め, 範囲外の値は無限大になります.
+//!
+//! @param[in]      pValues     変換する値の配列.
+//! @param[in]      count       要素数.
+//! @param[out]     pResults    変換結果の格納先.
+//-------------------------------------------------------------------------------------------------
+void F32ToF16Array( const f32* pValues, u32 count, f16* pResults );
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      f16型の配列をf32型にまとめて変換します.
+//!
+//! @param[in]      pValues     変換する値の配列.
+//! @param[in]      count       要素数.
+//! @param[out]     pResults    変換結果の格納先.
+//-------------------------------------------------------------------------------------------------
+void F16ToF32Array( const f16* pValues, u32 count, f32* pResults );
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      [-1, 1] の値の配列を符号付き正規化整数(SNORM)にまとめて変換します.
+//!
+//! @details    値域外の値は飽和させ, 最近接偶数に丸めます. NaNは -1 として扱います.
+//!
+//! @param[in]      pValues     変換する値の配列.
+//! @param[in]      count       要素数.
+//! @param[out]     pResults    変換結果の格納先.
+//-------------------------------------------------------------------------------------------------
+void F32ToSnorm8Array ( const f32* pValues, u32 count, s8*  pResults );
+void F32ToSnorm16Array( const f32* pValues, u32 count, s16* pResults );
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      符号付き正規化整数(SNORM)の配列をまとめて [-1, 1] の値に変換します.
+//!
+//! @details    最小値(-128, -32768)は -1 になります.
+//!
+//! @param[in]      pValues     変換する値の配列.
+//! @param[in]      count       要素数.
+//! @param[out]     pResults    変換結果の格納先.
+//-------------------------------------------------------------------------------------------------
+void Snorm8ToF32Array ( const s8*  pValues, u32 count, f32* pResults );
+void Snorm16ToF32Array( const s16* pValues, u32 count, f32* pResults );
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      [0, 1] の値の配列を符号なし正規化整数(UNORM)にまとめて変換します.
+//!
+//! @details    値域外の値は飽和させ, 最近接偶数に丸めます. NaNは 0 として扱います.
+//!
+//! @param[in]      pValues     変換する値の配列.
+//! @param[in]      count       要素数.
+//! @param[out]     pResults    変換結果の格納先.
+//-------------------------------------------------------------------------------------------------
+void F32ToUnorm8Array ( const f32* pValues, u32 count, u8*  pResults );
+void F32ToUnorm16Array( const f32* pValues, u32 count, u16* pResults );
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      符号なし正規化整数(UNORM)の配列をまとめて [0, 1] の値に変換します.
+//!
+//! @param[in]      pValues     変換する値の配列.
+//! @param[in]      count       要素数.
+//! @param[out]     pResults    変換結果の格納先.
+//-------------------------------------------------------------------------------------------------
+void Unorm8ToF32Array ( const u8*  pValues, u32 count, f32* pResults );
+void Unorm16ToF32Array( const u16* pValues, u32 count, f32* pResults );
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      単位ベクトルを八面体写像で [-1, 1]^2 に符号化します.
+//!
+//! @details    結果を F32ToSnorm16Array() などで量子化すると, 法線を4byte(または2byte)で
+//!             表現できます. ゼロベクトルは扱えません.
+//!
+//! @param[in]      normal      符号化する単位ベクトル.
+//! @return     符号化した値を返却します.
+//-------------------------------------------------------------------------------------------------
+Vector2 EncodeOctahedral( const Vector3& normal );
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      八面体写像で符号化された値を単位ベクトルに復号します.
+//!
+//! @param[in]      value       符号化された値.
+//! @return     復号した単位ベクトルを返却します.
+//-------------------------------------------------------------------------------------------------
+Vector3 DecodeOctahedral( const Vector2& value );
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      単位ベクトルの配列をまとめて八面体写像で符号化します.
+//!
+//! @param[in]      pNormals    符号化する単位ベクトルの配列.
+//! @param[in]      count       要素数.
+//! @param[out]     pResults    符号化結果の格納先.
+//-------------------------------------------------------------------------------------------------
+void EncodeOctahedralArray( const Vector3* pNormals, u32 count, Vector2* pResults );
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      八面体写像で符号化された値の配列をまとめて単位ベクトルに復号します.
+//!
+//! @param[in]      pValues     符号化された値の配列.
+//! @param[in]      count       要素数.
+//! @param[out]     pResults    復号結果の格納先.
+//-------------------------------------------------------------------------------------------------
+void DecodeOctahedralArray( const Vector2* pValues, u32 count, Vector3* pResults );
+
+} // namespace asdx
@@ -9,6 +9,9 @@
 // Includes
 //-------------------------------------------------------------------------------------------------
 #include <asdxMath.h>
+#include <asdxGeometry.h>
+#include <asdxStringInterner.h>
+#include <string>
 #include <vector>
 
 
@@ -20,9 +23,18 @@ namespace asdx {
 struct ResBone
 {
     std::wstring        Name;           //!< ボーン名です.
+    u32                 NameId;         //!< ボーン名の名前ID(StringInterner)です.
     u32                 ParentId;       //!< 親ボーン番号.
     Matrix              BindPose;       //!< バインドポーズ行列です.
     Matrix              InvBindPose;    //!< 逆バインドポーズ行列です.
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです. 名前IDは NAME_ID_INVALID になります.
+    //---------------------------------------------------------------------------------------------
+    ResBone()
+    : NameId  ( NAME_ID_INVALID )
+    , ParentId( U32_MAX )
+    { /* DO_NOTHING */ }
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -48,6 +60,9 @@ struct ResMesh
     std::vector<u32>        VertexIndices;  //!< 頂点インデックスです.
     std::vector<ResSubset>  Subsets;        //!< サブセットデータです.
     std::vector<ResBone>    Bones;          //!< ボーン.
+    std::vector<BoundingBox>    SubsetBoxes;    //!< サブセットごとのバウンディングボックス(バインドポーズ)です.
+    std::vector<BoundingSphere> SubsetSpheres;  //!< サブセットごとのバウンディングスフィア(バインドポーズ)です.
+    std::vector<BoundingBox>    BoneBoxes;      //!< ボーンごとのバウンディングボックス(逆バインドポーズ適用後)です. 影響する頂点がないボーンは空です.
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -86,6 +101,28 @@ public:
     //! @param[in]      ptr     破棄するメッシュリソースへのポインタ.
     //---------------------------------------------------------------------------------------------
     static void Dispose( ResMesh*& ptr );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      サブセットごとのバウンディングボリュームを求めます.
+    //!
+    //! @details    Create() で読み込んだ場合は自動的に呼び出されます.
+    //!             頂点位置やサブセットを変更した場合に呼び出してください.
+    //!
+    //! @param[in,out]  pMesh       メッシュリソースです.
+    //---------------------------------------------------------------------------------------------
+    static void CalcSubsetBounds( ResMesh* pMesh );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ボーンごとのバウンディングボックスを求めます.
+    //!
+    //! @details    重みが0より大きいボーンごとに, 頂点位置に逆バインドポーズ行列を掛けた点を含む
+    //!             ボックスを求めます. ボーンのワールド行列で変換してマージすると, 線形ブレンド
+    //!             スキニング後の全頂点を含むボックスになります.
+    //!             Create() で読み込んだ場合は自動的に呼び出されます.
+    //!
+    //! @param[in,out]  pMesh       メッシュリソースです.
+    //---------------------------------------------------------------------------------------------
+    static void CalcBoneBounds( ResMesh* pMesh );
 };
 
 } // namespace asdx
@@ -9,6 +9,8 @@
 // Includes
 //-------------------------------------------------------------------------------------------------
 #include <asdxMath.h>
+#include <asdxStringInterner.h>
+#include <string>
 #include <vector>
 
 
@@ -29,7 +31,15 @@ struct ResKeyFrame
 struct ResKeyFrameSet
 {
     std::wstring                BoneName;   //!< ボーン名です.
+    u32                         BoneNameId; //!< ボーン名の名前ID(StringInterner)です.
     std::vector<ResKeyFrame>    KeyFrames;  //!< キーフレームデータです.
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです. 名前IDは NAME_ID_INVALID になります.
+    //---------------------------------------------------------------------------------------------
+    ResKeyFrameSet()
+    : BoneNameId( NAME_ID_INVALID )
+    { /* DO_NOTHING */ }
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -16,17 +16,21 @@
     #include <xmmintrin.h>
     #include <emmintrin.h>
     #include <tmmintrin.h>
-    #include <nmmintrin.h>
+  #if ASDX_IS_SSE4_1
+    #include <smmintrin.h>
+  #endif
 
     typedef __m64       b64;
     typedef __m128      b128;
 
 #elif ASDX_IS_NEON
+  #if defined(_MSC_VER)
     #include <armintr.h>
+  #endif
     #include <arm_neon.h>
 
-    typedef __n64       b64;
-    typedef __n128      b128;
+    typedef float32x2_t b64;
+    typedef float32x4_t b128;
 
 #endif
 
@@ -64,6 +68,30 @@ public:
     //---------------------------------------------------------------------------------------------
     static b128 Create( f32 x, f32 y, f32 z, f32 w );
 
+    //---------------------------------------------------------------------------------------------
+    //! @brief      全成分に同じ値を設定したベクトルを生成します.
+    //!
+    //! @param[in]      value       設定する値.
+    //! @return     ベクトルを返します.
+    //---------------------------------------------------------------------------------------------
+    static b128 Replicate( f32 value );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      メモリから4成分を読み込みます.
+    //!
+    //! @param[in]      pValues     要素数4の配列(アライメント不要).
+    //! @return     読み込んだベクトルを返します.
+    //---------------------------------------------------------------------------------------------
+    static b128 Load( const f32* pValues );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      メモリに4成分を書き込みます.
+    //!
+    //! @param[out]     pResult     書き込み先の配列(アライメント不要).
+    //! @param[in]      value       書き込むベクトル.
+    //---------------------------------------------------------------------------------------------
+    static void Store( f32* pResult, const b128& value );
+
     //---------------------------------------------------------------------------------------------
     //! @brief      X成分を設定します.
     //!
@@ -245,6 +273,16 @@ public:
     //! @return     4次元ベクトルの内積を返却します.
     //---------------------------------------------------------------------------------------------
     static b128 Dot4( const b128& a, const b128& b );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      4x4の転置を行います.
+    //!
+    //! @param[in,out]  r0      1行目.
+    //! @param[in,out]  r1      2行目.
+    //! @param[in,out]  r2      3行目.
+    //! @param[in,out]  r3      4行目.
+    //---------------------------------------------------------------------------------------------
+    static void Transpose( b128& r0, b128& r1, b128& r2, b128& r3 );
 };
 
 } // namespace asdx
@@ -0,0 +1,389 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxSpatial.h
+// Desc : Spatial Index Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxGeometry.h>
+#include <vector>
+
+
+namespace asdx {
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const u32 LOOSE_OCTREE_MAX_DEPTH = 8;    //!< ルーズ八分木の最大の階層数です.
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// LooseOctree class
+// 各辺を2倍に広げたセルにオブジェクトを1つだけ登録する八分木です.
+// オブジェクトの大きさと中心から登録先のノードが決まるため, 移動は階層数に比例する時間で済み,
+// 木の再構築は不要です. ノードは全階層分を配列で確保します.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class LooseOctree
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    /* NOTHING */
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------------------
+    LooseOctree();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //---------------------------------------------------------------------------------------------
+    ~LooseOctree();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      初期化処理を行います.
+    //!
+    //! @details    bounds を含む立方体をルートとします. 範囲外のオブジェクトも登録できますが,
+    //!             ルートに置かれて問い合わせのたびに個別に判定されます.
+    //!             ノード数は (8^depth - 1) / 7 で, 1ノードあたり8byteです.
+    //!
+    //! @param[in]      bounds      登録するオブジェクトが主に存在する範囲です.
+    //! @param[in]      depth       階層数です. 1 以上 LOOSE_OCTREE_MAX_DEPTH 以下を指定します.
+    //! @retval true    初期化に成功.
+    //! @retval false   初期化に失敗.
+    //---------------------------------------------------------------------------------------------
+    bool Init( const BoundingBox& bounds, u32 depth = 6 );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      終了処理を行います.
+    //---------------------------------------------------------------------------------------------
+    void Term();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      全てのオブジェクトを削除します.
+    //---------------------------------------------------------------------------------------------
+    void Clear();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      オブジェクトを登録します.
+    //!
+    //! @param[in]      box         オブジェクトのバウンディングボックスです.
+    //! @return     オブジェクトのハンドルを返却します. 削除されたハンドルは再利用されます.
+    //---------------------------------------------------------------------------------------------
+    u32 Insert( const BoundingBox& box );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      オブジェクトを登録します.
+    //!
+    //! @param[in]      sphere      オブジェクトのバウンディングスフィアです.
+    //! @return     オブジェクトのハンドルを返却します. 削除されたハンドルは再利用されます.
+    //---------------------------------------------------------------------------------------------
+    u32 Insert( const BoundingSphere& sphere );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      オブジェクトを移動します.
+    //!
+    //! @param[in]      handle      オブジェクトのハンドルです.
+    //! @param[in]      box         移動後のバウンディングボックスです.
+    //---------------------------------------------------------------------------------------------
+    void Move( u32 handle, const BoundingBox& box );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      オブジェクトを移動します.
+    //!
+    //! @param[in]      handle      オブジェクトのハンドルです.
+    //! @param[in]      sphere      移動後のバウンディングスフィアです.
+    //---------------------------------------------------------------------------------------------
+    void Move( u32 handle, const BoundingSphere& sphere );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      オブジェクトを削除します.
+    //!
+    //! @param[in]      handle      オブジェクトのハンドルです.
+    //---------------------------------------------------------------------------------------------
+    void Remove( u32 handle );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      視錐台と交差するオブジェクトを求めます.
+    //!
+    //! @details    判定は ViewFrustum::GetPlanes() の6平面とバウンディングボックスで行います.
+    //!             錐台に完全に含まれるノード以下のオブジェクトは個別に判定しません.
+    //!
+    //! @param[in]      frustum     視錐台です.
+    //! @param[out]     pResults    交差したオブジェクトのハンドルを末尾に追加します.
+    //---------------------------------------------------------------------------------------------
+    void QueryFrustum( const ViewFrustum& frustum, std::vector<u32>* pResults ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      球と交差するオブジェクトを求めます.
+    //!
+    //! @param[in]      center      球の中心です.
+    //! @param[in]      radius      球の半径です.
+    //! @param[out]     pResults    交差したオブジェクトのハンドルを末尾に追加します.
+    //---------------------------------------------------------------------------------------------
+    void QueryRadius( const Vector3& center, f32 radius, std::vector<u32>* pResults ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      オブジェクトのバウンディングボックスを取得します.
+    //!
+    //! @param[in]      handle      オブジェクトのハンドルです.
+    //! @return     オブジェクトのバウンディングボックスを返却します.
+    //---------------------------------------------------------------------------------------------
+    const BoundingBox& GetBounds( u32 handle ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      登録されているオブジェクト数を取得します.
+    //!
+    //! @return     登録されているオブジェクト数を返却します.
+    //---------------------------------------------------------------------------------------------
+    u32 GetCount() const;
+
+private:
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Node structure
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct Node
+    {
+        u32     head;       //!< ノードに登録されたオブジェクトの先頭です.
+        u32     total;      //!< 子孫を含めたオブジェクト数です.
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Object structure
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct Object
+    {
+        BoundingBox     box;        //!< バウンディングボックスです.
+        u32             owner;      //!< 登録先のノード番号です. 未使用の場合は U32_MAX です.
+        u32             prev;       //!< 同じノードの前のオブジェクトです.
+        u32             next;       //!< 同じノードの次のオブジェクト, または次の未使用オブジェクトです.
+    };
+
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    std::vector<Node>       m_Nodes;                                //!< 全階層のノードです.
+    std::vector<Object>     m_Objects;                              //!< オブジェクトです.
+    u32                     m_FreeHead;                             //!< 未使用オブジェクトの先頭です.
+    u32                     m_Count;                                //!< 登録されているオブジェクト数です.
+    u32                     m_Depth;                                //!< 階層数です.
+    u32                     m_LevelOffset[LOOSE_OCTREE_MAX_DEPTH];  //!< 階層ごとの先頭ノード番号です.
+    Vector3                 m_Origin;                               //!< ルートの最小値です.
+    f32                     m_Size;                                 //!< ルートの一辺の長さです.
+
+    //=============================================================================================
+    // private methods.
+    //=============================================================================================
+    u32  FindNode( const BoundingBox& box ) const;
+    void Link  ( u32 handle, u32 node );
+    void Unlink( u32 handle );
+    void GetNodeCoord( u32 node, u32& level, u32& x, u32& y, u32& z ) const;
+    BoundingBox GetLooseBounds( u32 level, u32 x, u32 y, u32 z ) const;
+
+    template<typename Classify, typename Test>
+    void Query( const Classify& classify, const Test& test, std::vector<u32>* pResults ) const;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// SpatialHashGrid class
+// オブジェクトを中心が含まれる1つのセルに登録する, 範囲に制限のない一様格子です.
+// 使用中のセルのみをハッシュ表で管理します. 移動は登録先のセルが変わった場合のみ付け替えます.
+// セルの一辺は球の問い合わせの半径程度にすると, 引くセル数と判定するオブジェクト数の釣り合いが取れます.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class SpatialHashGrid
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    /* NOTHING */
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------------------
+    SpatialHashGrid();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //---------------------------------------------------------------------------------------------
+    ~SpatialHashGrid();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      初期化処理を行います.
+    //!
+    //! @param[in]      cellSize    セルの一辺の長さです.
+    //! @retval true    初期化に成功.
+    //! @retval false   初期化に失敗.
+    //---------------------------------------------------------------------------------------------
+    bool Init( f32 cellSize );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      終了処理を行います.
+    //---------------------------------------------------------------------------------------------
+    void Term();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      全てのオブジェクトを削除します.
+    //---------------------------------------------------------------------------------------------
+    void Clear();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      オブジェクトを登録します.
+    //!
+    //! @param[in]      box         オブジェクトのバウンディングボックスです.
+    //! @return     オブジェクトのハンドルを返却します. 削除されたハンドルは再利用されます.
+    //---------------------------------------------------------------------------------------------
+    u32 Insert( const BoundingBox& box );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      オブジェクトを登録します.
+    //!
+    //! @param[in]      sphere      オブジェクトのバウンディングスフィアです.
+    //! @return     オブジェクトのハンドルを返却します. 削除されたハンドルは再利用されます.
+    //---------------------------------------------------------------------------------------------
+    u32 Insert( const BoundingSphere& sphere );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      オブジェクトを移動します.
+    //!
+    //! @param[in]      handle      オブジェクトのハンドルです.
+    //! @param[in]      box         移動後のバウンディングボックスです.
+    //---------------------------------------------------------------------------------------------
+    void Move( u32 handle, const BoundingBox& box );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      オブジェクトを移動します.
+    //!
+    //! @param[in]      handle      オブジェクトのハンドルです.
+    //! @param[in]      sphere      移動後のバウンディングスフィアです.
+    //---------------------------------------------------------------------------------------------
+    void Move( u32 handle, const BoundingSphere& sphere );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      オブジェクトを削除します.
+    //!
+    //! @param[in]      handle      オブジェクトのハンドルです.
+    //---------------------------------------------------------------------------------------------
+    void Remove( u32 handle );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      視錐台と交差するオブジェクトを求めます.
+    //!
+    //! @details    錐台を囲む範囲のセル数が使用中のセル数より少なければ範囲内のセルを引き,
+    //!             そうでなければ使用中の全セルを判定します.
+    //!             判定は ViewFrustum::GetPlanes() の6平面とバウンディングボックスで行います.
+    //!
+    //! @param[in]      frustum     視錐台です.
+    //! @param[out]     pResults    交差したオブジェクトのハンドルを末尾に追加します.
+    //---------------------------------------------------------------------------------------------
+    void QueryFrustum( const ViewFrustum& frustum, std::vector<u32>* pResults ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      球と交差するオブジェクトを求めます.
+    //!
+    //! @param[in]      center      球の中心です.
+    //! @param[in]      radius      球の半径です.
+    //! @param[out]     pResults    交差したオブジェクトのハンドルを末尾に追加します.
+    //---------------------------------------------------------------------------------------------
+    void QueryRadius( const Vector3& center, f32 radius, std::vector<u32>* pResults ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      オブジェクトのバウンディングボックスを取得します.
+    //!
+    //! @param[in]      handle      オブジェクトのハンドルです.
+    //! @return     オブジェクトのバウンディングボックスを返却します.
+    //---------------------------------------------------------------------------------------------
+    const BoundingBox& GetBounds( u32 handle ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      登録されているオブジェクト数を取得します.
+    //!
+    //! @return     登録されているオブジェクト数を返却します.
+    //---------------------------------------------------------------------------------------------
+    u32 GetCount() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      使用中のセル数を取得します.
+    //!
+    //! @return     使用中のセル数を返却します.
+    //---------------------------------------------------------------------------------------------
+    u32 GetCellCount() const;
+
+private:
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Cell structure
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct Cell
+    {
+        s32     x;          //!< セル座標です.
+        s32     y;          //!< セル座標です.
+        s32     z;          //!< セル座標です.
+        u32     head;       //!< セルに登録されたオブジェクトの先頭です.
+        u32     count;      //!< セルに登録されたオブジェクト数です.
+        f32     extent;     //!< 登録されたオブジェクトがセルからはみ出す量の上限です.
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Object structure
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct Object
+    {
+        BoundingBox     box;        //!< バウンディングボックスです.
+        u32             owner;      //!< 登録先のセル番号です. 未使用の場合は U32_MAX です.
+        u32             prev;       //!< 同じセルの前のオブジェクトです.
+        u32             next;       //!< 同じセルの次のオブジェクト, または次の未使用オブジェクトです.
+    };
+
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    std::vector<Cell>       m_Cells;        //!< 使用中のセルです.
+    std::vector<u32>        m_Table;        //!< セル座標からセル番号を引くハッシュ表です(線形探索).
+    std::vector<Object>     m_Objects;      //!< オブジェクトです.
+    u32                     m_FreeHead;     //!< 未使用オブジェクトの先頭です.
+    u32                     m_Count;        //!< 登録されているオブジェクト数です.
+    f32                     m_CellSize;     //!< セルの一辺の長さです.
+    f32                     m_InvCellSize;  //!< セルの一辺の長さの逆数です.
+    f32                     m_MaxExtent;    //!< 全セルの extent の上限です. セルが空になっても減らしません.
+    s32                     m_CellMin[3];   //!< 使用したセル座標の最小値です. セルが空になっても戻しません.
+    s32                     m_CellMax[3];   //!< 使用したセル座標の最大値です. セルが空になっても戻しません.
+
+    //=============================================================================================
+    // private methods.
+    //=============================================================================================
+    u32  FindCell  ( s32 x, s32 y, s32 z ) const;
+    u32  AddCell   ( s32 x, s32 y, s32 z );
+    void RemoveCell( u32 index );
+    void Rehash    ( u32 capacity );
+    void Link  ( u32 handle, const BoundingBox& box );
+    void Unlink( u32 handle );
+    BoundingBox GetLooseBounds( const Cell& cell ) const;
+
+    template<typename Classify, typename Test>
+    void Query( const BoundingBox& range, const Classify& classify, const Test& test, std::vector<u32>* pResults ) const;
+};
+
+} // namespace asdx
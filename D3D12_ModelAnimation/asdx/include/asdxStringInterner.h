@@ -0,0 +1,139 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxStringInterner.h
+// Desc : String Interner.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxTypedef.h>
+#include <asdxHashMap.h>
+#include <mutex>
+#include <vector>
+
+
+namespace asdx {
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const u32 NAME_ID_INVALID = 0;   //!< 無効な名前IDです.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// StringInterner class
+// 文字列を登録し, 32ビットの名前IDで参照します.
+// 名前IDは文字列の Fnv1a ハッシュで, 実行ごとに変わらず, L"Head"_fnv1a で静的に求めることもできます.
+// 登録した文字列は終了まで解放せず, GetName() で取得したポインタは常に有効です.
+// 文字列はまとめて確保した領域に格納するため, 容量を確保した後は登録時にメモリを確保しません.
+// 全てのメソッドはスレッドセーフです.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class StringInterner : private NonCopyable
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    /* NOTHING */
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      唯一のインスタンスを取得します.
+    //!
+    //! @return     シングルトンインスタンスを返却します.
+    //---------------------------------------------------------------------------------------------
+    static StringInterner& GetInstance();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      文字列を登録します.
+    //!
+    //! @details    登録済みの文字列は同じ名前IDを返却します.
+    //!             異なる文字列とハッシュが衝突した場合はアサートし, NAME_ID_INVALID を返却します.
+    //!
+    //! @param[in]      pName       文字列です.
+    //! @return     名前IDを返却します. nullptr の場合は NAME_ID_INVALID を返却します.
+    //---------------------------------------------------------------------------------------------
+    u32 Intern( const char16* pName );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      名前IDから文字列を取得します.
+    //!
+    //! @param[in]      id          名前IDです.
+    //! @return     文字列を返却します. 登録されていない場合は nullptr を返却します.
+    //---------------------------------------------------------------------------------------------
+    const char16* GetName( u32 id ) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      登録した文字列の数を取得します.
+    //!
+    //! @return     文字列の数を返却します.
+    //---------------------------------------------------------------------------------------------
+    u32 GetCount() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      メモリを再確保せずに登録できる文字列の数と合計文字数を指定します.
+    //!
+    //! @param[in]      count       文字列の数です.
+    //! @param[in]      length      終端文字を含む合計文字数です.
+    //---------------------------------------------------------------------------------------------
+    void Reserve( u32 count, u32 length );
+
+protected:
+    //=============================================================================================
+    // protected variables.
+    //=============================================================================================
+    /* NOTHING */
+
+    //=============================================================================================
+    // protected methods.
+    //=============================================================================================
+    /* NOTHING */
+
+private:
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    static StringInterner   s_Instance;             //!< シングルトンインスタンスです.
+    static const u32        CHUNK_LENGTH = 4096;    //!< 1回に確保する文字数です.
+
+    mutable std::mutex              m_Mutex;        //!< ミューテックスです.
+    HashMap<u32, const char16*>     m_Names;        //!< 名前IDから文字列への対応表です.
+    std::vector<char16*>            m_Chunks;       //!< 文字列を格納する領域です.
+    u32                             m_ChunkUsed;    //!< 最後の領域で使用した文字数です.
+    u32                             m_ChunkLength;  //!< 最後の領域の文字数です.
+
+    //=============================================================================================
+    // private methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------------------
+    StringInterner();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //---------------------------------------------------------------------------------------------
+    ~StringInterner();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      文字数 length 以上の文字列を格納する領域を追加します.
+    //---------------------------------------------------------------------------------------------
+    void AddChunk( u32 length );
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      文字列を格納する領域を確保します.
+    //---------------------------------------------------------------------------------------------
+    char16* AllocChars( u32 length );
+};
+
+} // namespace asdx
@@ -137,15 +137,18 @@
 #endif//ASDX_WIDE
 
 
-#if defined(_M_IX86) || defined(_M_AMD64)
-  #if defined(_M_IX86_FP)
+#if defined(_M_AMD64) || defined(__x86_64__) || defined(__SSE2__)
+    #define ASDX_IS_SSE2   (1)     // SSE2有効(x64では常に有効).
+    #define ASDX_IS_NEON   (0)     // NEON無効.
+#elif defined(_M_IX86)
+  #if defined(_M_IX86_FP) && (_M_IX86_FP >= 2)
     #define ASDX_IS_SSE2   (1)     // SSE2有効.
     #define ASDX_IS_NEON   (0)     // NEON無効.
   #else
     #define ASDX_IS_SSE2   (0)     // SSE2無効.
     #define ASDX_IS_NEON   (0)     // NEON無効.
   #endif
-#elif defined(_M_ARM)
+#elif defined(_M_ARM) || defined(_M_ARM64) || defined(__ARM_NEON)
     #define ASDX_IS_SSE2   (0)     // SSE2無効.
     #define ASDX_IS_NEON   (1)     // NEON有効.
 #else
@@ -153,6 +156,8 @@
     #define ASDX_IS_NEON   (0)     // NEON無効.
 #endif
 
+#define ASDX_IS_SSE        ASDX_IS_SSE2
+
 
 #if defined(__AVX__)
     #define ASDX_IS_AVX    (1)     // Advanced Vector Extension有効.
@@ -166,8 +171,29 @@
     #define ASDX_IS_AVX2   (0)
 #endif
 
+#if defined(__AVX512F__)
+    #define ASDX_IS_AVX512 (1)     // AVX-512F有効.
+#else
+    #define ASDX_IS_AVX512 (0)     // AVX-512F無効.
+#endif
+
+// MSVCは__F16C__を定義しないため, /arch:AVX2以上の指定をF16C有効とみなします.
+#if defined(__F16C__) || ( defined(_MSC_VER) && ASDX_IS_AVX2 )
+    #define ASDX_IS_F16C   (1)     // 半精度浮動小数変換命令有効.
+#else
+    #define ASDX_IS_F16C   (0)     // 半精度浮動小数変換命令無効.
+#endif
+
+// MSVCは__SSE4_1__を定義しないため, /arch:AVX以上の指定をSSE4.1有効とみなします.
+// /arch を指定せずにSSE4.1を使う翻訳単位は ASDX_ENABLE_SSE4_1 を定義します.
+#if ASDX_IS_SSE2 && (defined(__SSE4_1__) || defined(ASDX_ENABLE_SSE4_1) || ASDX_IS_AVX)
+    #define ASDX_IS_SSE4_1 (1)     // SSE4.1有効.
+#else
+    #define ASDX_IS_SSE4_1 (0)     // SSE4.1無効.
+#endif
+
 
-#if defined(ASDX_USE_SIMD)
+#if defined(ASDX_USE_SIMD) && (ASDX_IS_SSE2 || ASDX_IS_NEON)
     #define ASDX_IS_SIMD   (1)     // SIMD演算有効.
 #else
     #define ASDX_IS_SIMD   (0)     // SIMD演算無効.
@@ -290,27 +316,54 @@ using char16 = wchar_t;
 //! @typedef    sptr
 //! @brief      符号付き整数ポインタです.
 //-------------------------------------------------------------------------------------------------
-#ifdef _WIN64
+#if defined(_WIN64)
 using sptr = __int64;
-#else
+#elif ASDX_IS_WIN
 using sptr = _w64 int;
+#else
+using sptr = signed long;
 #endif
 
 //-------------------------------------------------------------------------------------------------
 //! @typedef    uptr
 //! @brief      符号なし整数ポインタです.
 //-------------------------------------------------------------------------------------------------
-#ifdef _WIN64 
+#if defined(_WIN64)
 using uptr = unsigned __int64;
-#else
+#elif ASDX_IS_WIN
 using uptr = _w64 unsigned int;
+#else
+using uptr = unsigned long;
 #endif
 
 //-------------------------------------------------------------------------------------------------
 //! @typedef    nullptr_type
 //! @brief      nullptr型です。
 //-------------------------------------------------------------------------------------------------
+#ifdef _MSC_VER
 using nullptr_type = decltype(__nullptr);
+#else
+using nullptr_type = decltype(nullptr);
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+// MSVC以外では整数リテラルの接尾辞(i8, ui32 など)が使えないため, 標準の表記で先に定義します.
+//--------------------------------------------------------------------------------------------------
+#ifndef _MSC_VER
+    #define S8_MIN          (-127 - 1)
+    #define S16_MIN         (-32767 - 1)
+    #define S32_MIN         (-2147483647 - 1)
+    #define S64_MIN         (-9223372036854775807ll - 1)
+    #define S8_MAX          127
+    #define S16_MAX         32767
+    #define S32_MAX         2147483647
+    #define S64_MAX         9223372036854775807ll
+    #define U8_MAX          0xffu
+    #define U16_MAX         0xffffu
+    #define U32_MAX         0xffffffffu
+    #define U64_MAX         0xffffffffffffffffull
+#endif//_MSC_VER
 
 
 //--------------------------------------------------------------------------------------------------
@@ -349,8 +349,9 @@ void ViewFrustum::SetPerspective
     const f32 farClip
 )
 {
-    m_FactorR  = tanf( fieldOfView / 2.0f );
-    m_FactorU  = m_FactorR * aspectRatio;
+    // fieldOfView は Matrix::CreatePerspectiveFieldOfView() と同じく垂直方向の視野角です.
+    m_FactorU  = tanf( fieldOfView / 2.0f );
+    m_FactorR  = m_FactorU * aspectRatio;
     m_NearClip = nearClip;
     m_FarClip  = farClip;
 }
@@ -384,10 +385,11 @@ void ViewFrustum::SetLookAt
     const Vector3& upward
 )
 {
+    // Contains() は m_Forward 方向を可視とするので, 注視点へ向かうベクトルにする.
     m_Position = position;
-    m_Forward  = Vector3::Normalize(position - target);
-    m_Right    = Vector3::Normalize(Vector3::Cross(upward, m_Forward));
-    m_Upward   = Vector3::Normalize(Vector3::Cross(m_Forward, m_Right));
+    m_Forward  = Vector3::Normalize(target - position);
+    m_Right    = Vector3::Normalize(Vector3::Cross(m_Forward, upward));
+    m_Upward   = Vector3::Normalize(Vector3::Cross(m_Right, m_Forward));
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -402,9 +404,9 @@ void ViewFrustum::SetLookTo
 )
 {
     m_Position = position;
-    m_Forward  = -direction;
-    m_Right    = Vector3::Normalize(Vector3::Cross(upward, m_Forward));
-    m_Upward   = Vector3::Normalize(Vector3::Cross(m_Forward, m_Right));
+    m_Forward  = Vector3::Normalize(direction);
+    m_Right    = Vector3::Normalize(Vector3::Cross(m_Forward, upward));
+    m_Upward   = Vector3::Normalize(Vector3::Cross(m_Right, m_Forward));
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -549,6 +551,7 @@ bool ViewFrustum::Contains( const BoundingBox& box ) const
         p.x = corners[(i & 1)].x;
         p.y = corners[(i >> 2) & 1].y;
         p.z = corners[(i >> 1) & 1].z;
+        p  -= m_Position;
 
         auto r = m_Right.x   * p.x + m_Right.y   * p.y + m_Right.z   * p.z;
         auto u = m_Upward.x  * p.x + m_Upward.y  * p.y + m_Upward.z  * p.z;
@@ -593,6 +596,7 @@ bool ViewFrustum::Contains( const BoundingBox& box ) const
 //-------------------------------------------------------------------------------------------------
 //      8角の頂点を取得します.
 //-------------------------------------------------------------------------------------------------
+ASDX_INLINE
 std::array<Vector3, 8> ViewFrustum::GetCorners() const
 {
     std::array<Vector3, 8> result;
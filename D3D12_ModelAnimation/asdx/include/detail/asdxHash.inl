@@ -0,0 +1,146 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxHash.inl
+// Desc : Hash Key Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+namespace asdx {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Constexpr Hash Functions
+///////////////////////////////////////////////////////////////////////////////////////////////////
+namespace detail {
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static constexpr u32 FNV_OFFSET_BASIS_32 = 2166136261;
+static constexpr u32 FNV_PRIME_32        = 16777619;
+static constexpr u32 CRC32_POLYNOMIAL    = 0xEDB88320;
+
+// VS2015 は C++11 の constexpr のみ対応するため, 各関数は1つの return 文とし, ループは末尾再帰で書きます.
+// 文字は実行時版と同じく u32 への変換で符号拡張されます.
+
+//-------------------------------------------------------------------------------------------------
+//      FNV-1ハッシュを1文字ずつ更新します.
+//-------------------------------------------------------------------------------------------------
+template<typename T>
+constexpr u32 Fnv1Step( const T* pBuffer, size_t length, u32 hash )
+{
+    return ( length == 0 )
+        ? hash
+        : Fnv1Step( pBuffer + 1, length - 1, ( FNV_PRIME_32 * hash ) ^ u32( pBuffer[0] ) );
+}
+
+template<typename T>
+constexpr u32 Fnv1Step( const T* pBuffer, u32 hash )
+{
+    return ( pBuffer[0] == 0 )
+        ? hash
+        : Fnv1Step( pBuffer + 1, ( FNV_PRIME_32 * hash ) ^ u32( pBuffer[0] ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      FNV-1aハッシュを1文字ずつ更新します.
+//-------------------------------------------------------------------------------------------------
+template<typename T>
+constexpr u32 Fnv1aStep( const T* pBuffer, size_t length, u32 hash )
+{
+    return ( length == 0 )
+        ? hash
+        : Fnv1aStep( pBuffer + 1, length - 1, ( hash ^ u32( pBuffer[0] ) ) * FNV_PRIME_32 );
+}
+
+template<typename T>
+constexpr u32 Fnv1aStep( const T* pBuffer, u32 hash )
+{
+    return ( pBuffer[0] == 0 )
+        ? hash
+        : Fnv1aStep( pBuffer + 1, ( hash ^ u32( pBuffer[0] ) ) * FNV_PRIME_32 );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      CRC32のテーブルの値を求めます.
+//-------------------------------------------------------------------------------------------------
+constexpr u32 Crc32Bit( u32 c )
+{ return ( c & 1 ) ? ( ( c >> 1 ) ^ CRC32_POLYNOMIAL ) : ( c >> 1 ); }
+
+constexpr u32 Crc32Table( u32 index )
+{ return Crc32Bit( Crc32Bit( Crc32Bit( Crc32Bit( Crc32Bit( Crc32Bit( Crc32Bit( Crc32Bit( index ) ) ) ) ) ) ) ); }
+
+//-------------------------------------------------------------------------------------------------
+//      CRC32のレジスタ値を1文字ずつ更新します. 各文字の下位8ビットのみを処理します.
+//-------------------------------------------------------------------------------------------------
+template<typename T>
+constexpr u32 Crc32Step( const T* pBuffer, size_t length, u32 crc )
+{
+    return ( length == 0 )
+        ? crc
+        : Crc32Step( pBuffer + 1, length - 1, Crc32Table( ( crc ^ u32( pBuffer[0] ) ) & 0xFF ) ^ ( crc >> 8 ) );
+}
+
+template<typename T>
+constexpr u32 Crc32Step( const T* pBuffer, u32 crc )
+{
+    return ( pBuffer[0] == 0 )
+        ? crc
+        : Crc32Step( pBuffer + 1, Crc32Table( ( crc ^ u32( pBuffer[0] ) ) & 0xFF ) ^ ( crc >> 8 ) );
+}
+
+} // namespace detail
+
+//-------------------------------------------------------------------------------------------------
+//      文字列のFNV-1ハッシュを求めます.
+//-------------------------------------------------------------------------------------------------
+constexpr u32 CalcFnv1( const char8* pBuffer )
+{ return detail::Fnv1Step( pBuffer, detail::FNV_OFFSET_BASIS_32 ); }
+
+constexpr u32 CalcFnv1( const char16* pBuffer )
+{ return detail::Fnv1Step( pBuffer, detail::FNV_OFFSET_BASIS_32 ); }
+
+//-------------------------------------------------------------------------------------------------
+//      文字列のFNV-1aハッシュを求めます.
+//-------------------------------------------------------------------------------------------------
+constexpr u32 CalcFnv1a( const char8* pBuffer )
+{ return detail::Fnv1aStep( pBuffer, detail::FNV_OFFSET_BASIS_32 ); }
+
+constexpr u32 CalcFnv1a( const char16* pBuffer )
+{ return detail::Fnv1aStep( pBuffer, detail::FNV_OFFSET_BASIS_32 ); }
+
+//-------------------------------------------------------------------------------------------------
+//      文字列のCRC32を求めます.
+//-------------------------------------------------------------------------------------------------
+constexpr u32 CalcCrc32( const char8* pBuffer )
+{ return detail::Crc32Step( pBuffer, 0xFFFFFFFF ) ^ 0xFFFFFFFF; }
+
+constexpr u32 CalcCrc32( const char16* pBuffer )
+{ return detail::Crc32Step( pBuffer, 0xFFFFFFFF ) ^ 0xFFFFFFFF; }
+
+
+inline namespace literals {
+
+//-------------------------------------------------------------------------------------------------
+//      文字列リテラルのハッシュキーを求めます.
+//-------------------------------------------------------------------------------------------------
+constexpr u32 operator "" _fnv1( const char8* pBuffer, size_t length )
+{ return detail::Fnv1Step( pBuffer, length, detail::FNV_OFFSET_BASIS_32 ); }
+
+constexpr u32 operator "" _fnv1( const char16* pBuffer, size_t length )
+{ return detail::Fnv1Step( pBuffer, length, detail::FNV_OFFSET_BASIS_32 ); }
+
+constexpr u32 operator "" _fnv1a( const char8* pBuffer, size_t length )
+{ return detail::Fnv1aStep( pBuffer, length, detail::FNV_OFFSET_BASIS_32 ); }
+
+constexpr u32 operator "" _fnv1a( const char16* pBuffer, size_t length )
+{ return detail::Fnv1aStep( pBuffer, length, detail::FNV_OFFSET_BASIS_32 ); }
+
+constexpr u32 operator "" _crc32( const char8* pBuffer, size_t length )
+{ return detail::Crc32Step( pBuffer, length, 0xFFFFFFFF ) ^ 0xFFFFFFFF; }
+
+constexpr u32 operator "" _crc32( const char16* pBuffer, size_t length )
+{ return detail::Crc32Step( pBuffer, length, 0xFFFFFFFF ) ^ 0xFFFFFFFF; }
+
+} // inline namespace literals
+
+} // namespace asdx
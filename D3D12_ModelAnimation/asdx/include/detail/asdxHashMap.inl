@@ -0,0 +1,323 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxHashMap.inl
+// Desc : Open Addressing Hash Map.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+namespace asdx {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// HashOf structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 連続した整数のキーも配列全体に散らばるように, MurmurHash3 の最終処理でビットを拡散します.
+
+//-------------------------------------------------------------------------------------------------
+//      ハッシュ値を求めます.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 HashOf<u32>::operator () ( u32 value ) const
+{
+    value ^= value >> 16;
+    value *= 0x85ebca6b;
+    value ^= value >> 13;
+    value *= 0xc2b2ae35;
+    value ^= value >> 16;
+    return value;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ハッシュ値を求めます.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 HashOf<s32>::operator () ( s32 value ) const
+{ return HashOf<u32>()( u32( value ) ); }
+
+//-------------------------------------------------------------------------------------------------
+//      ハッシュ値を求めます.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+u32 HashOf<u64>::operator () ( u64 value ) const
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return u32( value );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ハッシュ値を求めます.
+//-------------------------------------------------------------------------------------------------
+template<typename T> ASDX_INLINE
+u32 HashOf<T*>::operator () ( const T* value ) const
+{ return HashOf<u64>()( u64( reinterpret_cast<uintptr_t>( value ) ) ); }
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// HashMap class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------------
+template<typename K, typename V, typename H> ASDX_INLINE
+HashMap<K, V, H>::HashMap()
+: m_Slots ()
+, m_Count ( 0 )
+, m_Mask  ( 0 )
+, m_Hasher()
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------------
+//      引数付きコンストラクタです.
+//-------------------------------------------------------------------------------------------------
+template<typename K, typename V, typename H> ASDX_INLINE
+HashMap<K, V, H>::HashMap( u32 count )
+: m_Slots ()
+, m_Count ( 0 )
+, m_Mask  ( 0 )
+, m_Hasher()
+{ Reserve( count ); }
+
+//-------------------------------------------------------------------------------------------------
+//      メモリを再確保せずに格納できる要素数を指定します.
+//-------------------------------------------------------------------------------------------------
+template<typename K, typename V, typename H>
+void HashMap<K, V, H>::Reserve( u32 count )
+{
+    auto capacity = MIN_CAPACITY;
+    while( u64( count ) * 8 > u64( capacity ) * 7 )
+    { capacity *= 2; }
+
+    if ( capacity > m_Slots.size() )
+    { Rehash( capacity ); }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      要素を追加します.
+//-------------------------------------------------------------------------------------------------
+template<typename K, typename V, typename H> ASDX_INLINE
+bool HashMap<K, V, H>::Insert( const K& key, const V& value )
+{
+    if ( FindIndex( key ) != U32_MAX )
+    { return false; }
+
+    InsertNew( K( key ), V( value ) );
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      要素を削除します.
+//-------------------------------------------------------------------------------------------------
+template<typename K, typename V, typename H>
+bool HashMap<K, V, H>::Erase( const K& key )
+{
+    auto index = FindIndex( key );
+    if ( index == U32_MAX )
+    { return false; }
+
+    // 後続の要素を1つずつ前に詰める(墓標を残さない).
+    auto next = ( index + 1 ) & m_Mask;
+    while( m_Slots[next].Distance > 1 )
+    {
+        m_Slots[index] = std::move( m_Slots[next] );
+        m_Slots[index].Distance--;
+        index = next;
+        next  = ( next + 1 ) & m_Mask;
+    }
+
+    m_Slots[index].Distance = 0;
+    m_Slots[index].Key      = K();
+    m_Slots[index].Value    = V();
+    m_Count--;
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      全ての要素を削除します.
+//-------------------------------------------------------------------------------------------------
+template<typename K, typename V, typename H>
+void HashMap<K, V, H>::Clear()
+{
+    for( auto& slot : m_Slots )
+    {
+        if ( slot.Distance == 0 )
+        { continue; }
+
+        slot.Distance = 0;
+        slot.Key      = K();
+        slot.Value    = V();
+    }
+
+    m_Count = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      値を検索します.
+//-------------------------------------------------------------------------------------------------
+template<typename K, typename V, typename H> ASDX_INLINE
+V* HashMap<K, V, H>::Find( const K& key )
+{
+    auto index = FindIndex( key );
+    return ( index != U32_MAX ) ? &m_Slots[index].Value : nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      値を検索します.
+//-------------------------------------------------------------------------------------------------
+template<typename K, typename V, typename H> ASDX_INLINE
+const V* HashMap<K, V, H>::Find( const K& key ) const
+{
+    auto index = FindIndex( key );
+    return ( index != U32_MAX ) ? &m_Slots[index].Value : nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      キーが存在するかどうかチェックします.
+//-------------------------------------------------------------------------------------------------
+template<typename K, typename V, typename H> ASDX_INLINE
+bool HashMap<K, V, H>::Contains( const K& key ) const
+{ return FindIndex( key ) != U32_MAX; }
+
+//-------------------------------------------------------------------------------------------------
+//      値を取得します. キーが存在しない場合はデフォルト値で追加します.
+//-------------------------------------------------------------------------------------------------
+template<typename K, typename V, typename H> ASDX_INLINE
+V& HashMap<K, V, H>::operator [] ( const K& key )
+{
+    auto index = FindIndex( key );
+    if ( index == U32_MAX )
+    { index = InsertNew( K( key ), V() ); }
+
+    return m_Slots[index].Value;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      全ての要素に対して関数を呼び出します.
+//-------------------------------------------------------------------------------------------------
+template<typename K, typename V, typename H>
+template<typename Func>
+void HashMap<K, V, H>::ForEach( Func func )
+{
+    for( auto& slot : m_Slots )
+    {
+        if ( slot.Distance != 0 )
+        { func( static_cast<const K&>( slot.Key ), slot.Value ); }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      全ての要素に対して関数を呼び出します.
+//-------------------------------------------------------------------------------------------------
+template<typename K, typename V, typename H>
+template<typename Func>
+void HashMap<K, V, H>::ForEach( Func func ) const
+{
+    for( auto& slot : m_Slots )
+    {
+        if ( slot.Distance != 0 )
+        { func( slot.Key, slot.Value ); }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      要素数を取得します.
+//-------------------------------------------------------------------------------------------------
+template<typename K, typename V, typename H> ASDX_INLINE
+u32 HashMap<K, V, H>::GetCount() const
+{ return m_Count; }
+
+//-------------------------------------------------------------------------------------------------
+//      要素を格納する配列の大きさを取得します.
+//-------------------------------------------------------------------------------------------------
+template<typename K, typename V, typename H> ASDX_INLINE
+u32 HashMap<K, V, H>::GetCapacity() const
+{ return u32( m_Slots.size() ); }
+
+//-------------------------------------------------------------------------------------------------
+//      キーの位置を検索します.
+//-------------------------------------------------------------------------------------------------
+template<typename K, typename V, typename H> ASDX_INLINE
+u32 HashMap<K, V, H>::FindIndex( const K& key ) const
+{
+    if ( m_Count == 0 )
+    { return U32_MAX; }
+
+    // 本来の位置からの距離が探索中の距離より短い要素に達したら, キーは存在しない.
+    auto index    = m_Hasher( key ) & m_Mask;
+    auto distance = 1u;
+    for(;;)
+    {
+        const auto& slot = m_Slots[index];
+        if ( slot.Distance < distance )
+        { return U32_MAX; }
+
+        if ( slot.Distance == distance && slot.Key == key )
+        { return index; }
+
+        index = ( index + 1 ) & m_Mask;
+        distance++;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      存在しないキーを追加し, 位置を返却します.
+//-------------------------------------------------------------------------------------------------
+template<typename K, typename V, typename H>
+u32 HashMap<K, V, H>::InsertNew( K&& key, V&& value )
+{
+    if ( u64( m_Count + 1 ) * 8 > u64( m_Slots.size() ) * 7 )
+    { Rehash( ( m_Slots.empty() ) ? MIN_CAPACITY : u32( m_Slots.size() ) * 2 ); }
+
+    Slot incoming;
+    incoming.Distance = 1;
+    incoming.Key      = std::move( key );
+    incoming.Value    = std::move( value );
+
+    // 本来の位置から遠い要素を優先して配置し, 探索距離のばらつきを抑える.
+    auto index  = m_Hasher( incoming.Key ) & m_Mask;
+    auto result = U32_MAX;
+    for(;;)
+    {
+        auto& slot = m_Slots[index];
+        if ( slot.Distance == 0 )
+        {
+            slot = std::move( incoming );
+            m_Count++;
+            return ( result != U32_MAX ) ? result : index;
+        }
+
+        if ( slot.Distance < incoming.Distance )
+        {
+            std::swap( slot, incoming );
+            if ( result == U32_MAX )
+            { result = index; }
+        }
+
+        index = ( index + 1 ) & m_Mask;
+        incoming.Distance++;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      配列の大きさを変更して再配置します.
+//-------------------------------------------------------------------------------------------------
+template<typename K, typename V, typename H>
+void HashMap<K, V, H>::Rehash( u32 capacity )
+{
+    std::vector<Slot> slots( capacity );
+    m_Slots.swap( slots );
+    m_Mask  = capacity - 1;
+    m_Count = 0;
+
+    for( auto& slot : slots )
+    {
+        if ( slot.Distance != 0 )
+        { InsertNew( std::move( slot.Key ), std::move( slot.Value ) ); }
+    }
+}
+
+} // namespace asdx
@@ -154,7 +154,7 @@ u32 Comb( u32 n, u32 r )
 ASDX_INLINE 
 f16 F32ToF16( f32 value )
 {
-    f16 result;
+    u32 result;
 
     // ビット列を崩さないままu32型に変換.
     u32 bit = *reinterpret_cast<u32*>( &value );
@@ -165,25 +165,20 @@ f16 F32ToF16( f32 value )
     // 符号部を削ぎ落す.
     bit     = bit & 0x7FFFFFFFU;
 
-    // f16として表現する際に値がデカ過ぎる場合は，無限大にクランプ.
-    if ( bit > 0x47FFEFFFU)
-    { result = 0x7FFFU; }
+    // f16として表現する際に値がデカ過ぎる場合は無限大, NaNはquiet NaNにする.
+    if ( bit >= 0x47800000U )
+    { result = ( bit > 0x7F800000U ) ? 0x7E00U : 0x7C00U; }
+    // 正規化されたf16として表現するために小さすぎる値は正規化されていない値に変換.
+    else if ( bit < 0x38800000U )
+    {
+        // 0.5を加算して仮数部を下位10bitに揃え, 加算の丸めで最近接偶数に丸める.
+        f32 f = *reinterpret_cast<f32*>( &bit ) + 0.5f;
+        result = *reinterpret_cast<u32*>( &f ) - 0x3F000000U;
+    }
     else
     {
-        // 正規化されたf16として表現するために小さすぎる値は正規化されていない値に変換.
-        if ( bit < 0x38800000U)
-        {
-            u32 shift = 113U - ( bit >> 23U);
-            bit    = (0x800000U | ( bit & 0x7FFFFFU)) >> shift;
-        }
-        else
-        {
-            // 正規化されたf16として表現するために指数部に再度バイアスをかける
-            bit += 0xC8000000U;
-        }
-
-        // f16型表現にする.
-        result = (( bit + 0x0FFFU + (( bit >> 13U) & 1U)) >> 13U) & 0x7FFFU; 
+        // 正規化されたf16として表現するために指数部に再度バイアスをかけ, 最近接偶数に丸める.
+        result = ( bit + 0xC8000FFFU + (( bit >> 13U) & 1U) ) >> 13U;
     }
 
     // 符号部を付け足して返却.
@@ -193,44 +188,23 @@ f16 F32ToF16( f32 value )
 //-------------------------------------------------------------------------------------------------
 //      16bit 浮動小数から　32bit 浮動小数に変換します.
 //-------------------------------------------------------------------------------------------------
-ASDX_INLINE 
+ASDX_INLINE
 f32 F16ToF32( f16 value )
 {
-    u32 exponent;
-    u32 result;
+    // 指数部と仮数部をf32の位置にずらし, 2^112 を掛けて指数部のバイアスを補正する.
+    // 非正規化数もこの乗算で正規化される.
+    u32 magic    = 0x77800000U;
+    u32 expmant  = static_cast<u32>( value & 0x7FFF );
+    u32 shifted  = expmant << 13;
+    f32 scaled   = *reinterpret_cast<f32*>( &shifted ) * *reinterpret_cast<f32*>( &magic );
+    u32 result   = *reinterpret_cast<u32*>( &scaled );
 
-    // 仮数
-    u32 mantissa = static_cast<u32>( value & 0x03FF );
+    // 無限大, NaN.
+    if ( expmant > 0x7BFF )
+    { result |= 0x7F800000U; }
 
-    // 正規化済みの場合.
-    if ( ( value & 0x7C00 ) != 0 )
-    {
-        // 指数部を計算.
-        exponent = static_cast<u32>( ( value >> 10 ) & 0x1F );
-    }
-    // 正規化されていない場合.
-    else if ( mantissa != 0 )
-    {
-        // 結果となるf32で値を正規化する.
-        exponent = 1;
-
-        do {
-            exponent--;
-            mantissa <<= 1;
-        } while ( ( mantissa & 0x0400 ) == 0);
-
-        mantissa &= 0x03FF;
-    }
-    // 値がゼロの場合.
-    else
-    {
-        // 指数部を計算.
-        exponent = (u32)-112;
-    }
-
-    result = ( ( value & 0x8000 ) << 16) | // 符号部.
-             ( ( exponent + 112 ) << 23) | // 指数部.
-             ( mantissa << 13 );           // 仮数部.
+    // 符号部.
+    result |= static_cast<u32>( value & 0x8000 ) << 16;
 
     return *reinterpret_cast<f32*>( &result );
 }
@@ -253,6 +227,70 @@ f64 Lerp( f64 a, f64 b, f64 amount )
     return a + amount * ( b - a );
 }
 
+#if ASDX_IS_SIMD
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// SIMD Functions
+///////////////////////////////////////////////////////////////////////////////////////////////////
+namespace detail {
+
+//-------------------------------------------------------------------------------------------------
+//      行ベクトルと行列(4行)の積を求めます.
+//      スカラー版と同じ加算順序 ((x*r0 + y*r1) + z*r2) + w*r3 で計算し, 結果を一致させます.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+b128 TransformRow( const f32* v, const b128& r0, const b128& r1, const b128& r2, const b128& r3 )
+{
+    b128 result = Simd::Mul( Simd::Replicate( v[0] ), r0 );
+    result = Simd::Mad( Simd::Replicate( v[1] ), r1, result );
+    result = Simd::Mad( Simd::Replicate( v[2] ), r2, result );
+    result = Simd::Mad( Simd::Replicate( v[3] ), r3, result );
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      行列同士を乗算します.
+//      b を先にレジスタへ読み込むため, result は a, b のどちらと同じでも構いません.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+void MultiplyMatrix( const f32* a, const f32* b, f32* result )
+{
+    b128 r0 = Simd::Load( b + 0  );
+    b128 r1 = Simd::Load( b + 4  );
+    b128 r2 = Simd::Load( b + 8  );
+    b128 r3 = Simd::Load( b + 12 );
+
+    Simd::Store( result + 0,  TransformRow( a + 0,  r0, r1, r2, r3 ) );
+    Simd::Store( result + 4,  TransformRow( a + 4,  r0, r1, r2, r3 ) );
+    Simd::Store( result + 8,  TransformRow( a + 8,  r0, r1, r2, r3 ) );
+    Simd::Store( result + 12, TransformRow( a + 12, r0, r1, r2, r3 ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      行列同士を乗算し，乗算結果を転置します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+void MultiplyTransposeMatrix( const f32* a, const f32* b, f32* result )
+{
+    b128 r0 = Simd::Load( b + 0  );
+    b128 r1 = Simd::Load( b + 4  );
+    b128 r2 = Simd::Load( b + 8  );
+    b128 r3 = Simd::Load( b + 12 );
+
+    b128 m0 = TransformRow( a + 0,  r0, r1, r2, r3 );
+    b128 m1 = TransformRow( a + 4,  r0, r1, r2, r3 );
+    b128 m2 = TransformRow( a + 8,  r0, r1, r2, r3 );
+    b128 m3 = TransformRow( a + 12, r0, r1, r2, r3 );
+    Simd::Transpose( m0, m1, m2, m3 );
+
+    Simd::Store( result + 0,  m0 );
+    Simd::Store( result + 4,  m1 );
+    Simd::Store( result + 8,  m2 );
+    Simd::Store( result + 12, m3 );
+}
+
+} // namespace detail
+#endif//ASDX_IS_SIMD
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Vector2 structure
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -3024,11 +3062,22 @@ void Vector4::SmoothStep( const Vector4 &a, const Vector4 &b, f32 amount, Vector
 ASDX_INLINE
 Vector4 Vector4::Transform( const Vector4& position, const Matrix& matrix )
 {
+#if ASDX_IS_SIMD
+    Vector4 result;
+    Simd::Store( &result.x, detail::TransformRow(
+        &position.x,
+        Simd::Load( matrix.m[0] ),
+        Simd::Load( matrix.m[1] ),
+        Simd::Load( matrix.m[2] ),
+        Simd::Load( matrix.m[3] ) ) );
+    return result;
+#else
     return Vector4(
         ( ( ((position.x * matrix._11) + (position.y * matrix._21)) + (position.z * matrix._31) ) + (position.w * matrix._41)),
         ( ( ((position.x * matrix._12) + (position.y * matrix._22)) + (position.z * matrix._32) ) + (position.w * matrix._42)),
         ( ( ((position.x * matrix._13) + (position.y * matrix._23)) + (position.z * matrix._33) ) + (position.w * matrix._43)),
         ( ( ((position.x * matrix._14) + (position.y * matrix._24)) + (position.z * matrix._34) ) + (position.w * matrix._44)) );
+#endif
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -3037,10 +3086,19 @@ Vector4 Vector4::Transform( const Vector4& position, const Matrix& matrix )
 ASDX_INLINE
 void Vector4::Transform( const Vector4 &position, const Matrix &matrix, Vector4 &result )
 {
+#if ASDX_IS_SIMD
+    Simd::Store( &result.x, detail::TransformRow(
+        &position.x,
+        Simd::Load( matrix.m[0] ),
+        Simd::Load( matrix.m[1] ),
+        Simd::Load( matrix.m[2] ),
+        Simd::Load( matrix.m[3] ) ) );
+#else
     result.x = ( ( ((position.x * matrix._11) + (position.y * matrix._21)) + (position.z * matrix._31) ) + (position.w * matrix._41));
     result.y = ( ( ((position.x * matrix._12) + (position.y * matrix._22)) + (position.z * matrix._32) ) + (position.w * matrix._42));
     result.z = ( ( ((position.x * matrix._13) + (position.y * matrix._23)) + (position.z * matrix._33) ) + (position.w * matrix._43));
     result.w = ( ( ((position.x * matrix._14) + (position.y * matrix._24)) + (position.z * matrix._34) ) + (position.w * matrix._44));
+#endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -3128,6 +3186,10 @@ Matrix::operator const f32* () const
 ASDX_INLINE 
 Matrix& Matrix::operator *= ( const Matrix &value )
 {
+#if ASDX_IS_SIMD
+    detail::MultiplyMatrix( &_11, &value._11, &_11 );
+    return (*this);
+#else
     auto m11 = ( _11 * value._11 ) + ( _12 * value._21 ) + ( _13 * value._31 ) + ( _14 * value._41 );
     auto m12 = ( _11 * value._12 ) + ( _12 * value._22 ) + ( _13 * value._32 ) + ( _14 * value._42 );
     auto m13 = ( _11 * value._13 ) + ( _12 * value._23 ) + ( _13 * value._33 ) + ( _14 * value._43 );
@@ -3154,6 +3216,7 @@ Matrix& Matrix::operator *= ( const Matrix &value )
     _41 = m41;  _42 = m42;  _43 = m43;  _44 = m44;
 
     return (*this);
+#endif
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -3245,6 +3308,11 @@ Matrix Matrix::operator - () const
 ASDX_INLINE 
 Matrix Matrix::operator * ( const Matrix& value ) const
 {
+#if ASDX_IS_SIMD
+    Matrix result;
+    detail::MultiplyMatrix( &_11, &value._11, &result._11 );
+    return result;
+#else
     return Matrix(
         ( _11 * value._11 ) + ( _12 * value._21 ) + ( _13 * value._31 ) + ( _14 * value._41 ),
         ( _11 * value._12 ) + ( _12 * value._22 ) + ( _13 * value._32 ) + ( _14 * value._42 ),
@@ -3266,6 +3334,7 @@ Matrix Matrix::operator * ( const Matrix& value ) const
         ( _41 * value._13 ) + ( _42 * value._23 ) + ( _43 * value._33 ) + ( _44 * value._43 ),
         ( _41 * value._14 ) + ( _42 * value._24 ) + ( _43 * value._34 ) + ( _44 * value._44 )
     );
+#endif
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -3460,6 +3529,11 @@ void Matrix::Transpose( const Matrix &value, Matrix &result )
 ASDX_INLINE
 Matrix Matrix::Multiply( const Matrix& a, const Matrix& b )
 {
+#if ASDX_IS_SIMD
+    Matrix result;
+    detail::MultiplyMatrix( &a._11, &b._11, &result._11 );
+    return result;
+#else
     return Matrix(
         ( a._11 * b._11 ) + ( a._12 * b._21 ) + ( a._13 * b._31 ) + ( a._14 * b._41 ),
         ( a._11 * b._12 ) + ( a._12 * b._22 ) + ( a._13 * b._32 ) + ( a._14 * b._42 ),
@@ -3481,6 +3555,7 @@ Matrix Matrix::Multiply( const Matrix& a, const Matrix& b )
         ( a._41 * b._13 ) + ( a._42 * b._23 ) + ( a._43 * b._33 ) + ( a._44 * b._43 ),
         ( a._41 * b._14 ) + ( a._42 * b._24 ) + ( a._43 * b._34 ) + ( a._44 * b._44 )
     );
+#endif
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -3489,6 +3564,9 @@ Matrix Matrix::Multiply( const Matrix& a, const Matrix& b )
 ASDX_INLINE
 void Matrix::Multiply( const Matrix &a, const Matrix &b, Matrix &result )
 {
+#if ASDX_IS_SIMD
+    detail::MultiplyMatrix( &a._11, &b._11, &result._11 );
+#else
     result._11 = ( a._11 * b._11 ) + ( a._12 * b._21 ) + ( a._13 * b._31 ) + ( a._14 * b._41 );
     result._12 = ( a._11 * b._12 ) + ( a._12 * b._22 ) + ( a._13 * b._32 ) + ( a._14 * b._42 );
     result._13 = ( a._11 * b._13 ) + ( a._12 * b._23 ) + ( a._13 * b._33 ) + ( a._14 * b._43 );
@@ -3508,6 +3586,7 @@ void Matrix::Multiply( const Matrix &a, const Matrix &b, Matrix &result )
     result._42 = ( a._41 * b._12 ) + ( a._42 * b._22 ) + ( a._43 * b._32 ) + ( a._44 * b._42 );
     result._43 = ( a._41 * b._13 ) + ( a._42 * b._23 ) + ( a._43 * b._33 ) + ( a._44 * b._43 );
     result._44 = ( a._41 * b._14 ) + ( a._42 * b._24 ) + ( a._43 * b._34 ) + ( a._44 * b._44 );
+#endif
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -3556,27 +3635,33 @@ void Matrix::Multiply( const Matrix &value, f32 scaleFactor, Matrix &result )
 ASDX_INLINE
 Matrix Matrix::MultiplyTranspose( const Matrix& a, const Matrix& b )
 {
+#if ASDX_IS_SIMD
+    Matrix result;
+    detail::MultiplyTransposeMatrix( &a._11, &b._11, &result._11 );
+    return result;
+#else
     return Matrix(
         ( a._11 * b._11 ) + ( a._12 * b._21 ) + ( a._13 * b._31 ) + ( a._14 * b._41 ),
-        ( a._11 * b._12 ) + ( a._12 * b._22 ) + ( a._13 * b._32 ) + ( a._14 * b._42 ),
-        ( a._11 * b._13 ) + ( a._12 * b._23 ) + ( a._13 * b._33 ) + ( a._14 * b._43 ),
-        ( a._11 * b._14 ) + ( a._12 * b._24 ) + ( a._13 * b._34 ) + ( a._14 * b._44 ),
-
         ( a._21 * b._11 ) + ( a._22 * b._21 ) + ( a._23 * b._31 ) + ( a._24 * b._41 ),
-        ( a._21 * b._12 ) + ( a._22 * b._22 ) + ( a._23 * b._32 ) + ( a._24 * b._42 ),
-        ( a._21 * b._13 ) + ( a._22 * b._23 ) + ( a._23 * b._33 ) + ( a._24 * b._43 ),
-        ( a._21 * b._14 ) + ( a._22 * b._24 ) + ( a._23 * b._34 ) + ( a._24 * b._44 ),
-
         ( a._31 * b._11 ) + ( a._32 * b._21 ) + ( a._33 * b._31 ) + ( a._34 * b._41 ),
-        ( a._31 * b._12 ) + ( a._32 * b._22 ) + ( a._33 * b._32 ) + ( a._34 * b._42 ),
-        ( a._31 * b._13 ) + ( a._32 * b._23 ) + ( a._33 * b._33 ) + ( a._34 * b._43 ),
-        ( a._31 * b._14 ) + ( a._32 * b._24 ) + ( a._33 * b._34 ) + ( a._34 * b._44 ),
-
         ( a._41 * b._11 ) + ( a._42 * b._21 ) + ( a._43 * b._31 ) + ( a._44 * b._41 ),
+
+        ( a._11 * b._12 ) + ( a._12 * b._22 ) + ( a._13 * b._32 ) + ( a._14 * b._42 ),
+        ( a._21 * b._12 ) + ( a._22 * b._22 ) + ( a._23 * b._32 ) + ( a._24 * b._42 ),
+        ( a._31 * b._12 ) + ( a._32 * b._22 ) + ( a._33 * b._32 ) + ( a._34 * b._42 ),
         ( a._41 * b._12 ) + ( a._42 * b._22 ) + ( a._43 * b._32 ) + ( a._44 * b._42 ),
+
+        ( a._11 * b._13 ) + ( a._12 * b._23 ) + ( a._13 * b._33 ) + ( a._14 * b._43 ),
+        ( a._21 * b._13 ) + ( a._22 * b._23 ) + ( a._23 * b._33 ) + ( a._24 * b._43 ),
+        ( a._31 * b._13 ) + ( a._32 * b._23 ) + ( a._33 * b._33 ) + ( a._34 * b._43 ),
         ( a._41 * b._13 ) + ( a._42 * b._23 ) + ( a._43 * b._33 ) + ( a._44 * b._43 ),
+
+        ( a._11 * b._14 ) + ( a._12 * b._24 ) + ( a._13 * b._34 ) + ( a._14 * b._44 ),
+        ( a._21 * b._14 ) + ( a._22 * b._24 ) + ( a._23 * b._34 ) + ( a._24 * b._44 ),
+        ( a._31 * b._14 ) + ( a._32 * b._24 ) + ( a._33 * b._34 ) + ( a._34 * b._44 ),
         ( a._41 * b._14 ) + ( a._42 * b._24 ) + ( a._43 * b._34 ) + ( a._44 * b._44 )
     );
+#endif
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -3585,6 +3670,9 @@ Matrix Matrix::MultiplyTranspose( const Matrix& a, const Matrix& b )
 ASDX_INLINE
 void Matrix::MultiplyTranspose( const Matrix &a, const Matrix &b, Matrix &result )
 {
+#if ASDX_IS_SIMD
+    detail::MultiplyTransposeMatrix( &a._11, &b._11, &result._11 );
+#else
     result._11 = ( a._11 * b._11 ) + ( a._12 * b._21 ) + ( a._13 * b._31 ) + ( a._14 * b._41 );
     result._21 = ( a._11 * b._12 ) + ( a._12 * b._22 ) + ( a._13 * b._32 ) + ( a._14 * b._42 );
     result._31 = ( a._11 * b._13 ) + ( a._12 * b._23 ) + ( a._13 * b._33 ) + ( a._14 * b._43 );
@@ -3604,6 +3692,7 @@ void Matrix::MultiplyTranspose( const Matrix &a, const Matrix &b, Matrix &result
     result._24 = ( a._41 * b._12 ) + ( a._42 * b._22 ) + ( a._43 * b._32 ) + ( a._44 * b._42 );
     result._34 = ( a._41 * b._13 ) + ( a._42 * b._23 ) + ( a._43 * b._33 ) + ( a._44 * b._43 );
     result._44 = ( a._41 * b._14 ) + ( a._42 * b._24 ) + ( a._43 * b._34 ) + ( a._44 * b._44 );
+#endif
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -3692,6 +3781,157 @@ void Matrix::Invert( const Matrix &value, Matrix &result )
     result._44 /= det;
 }
 
+//-------------------------------------------------------------------------------------------------
+//      指定された種別を前提に逆行列を求めます.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+Matrix Matrix::Invert( const Matrix& value, MatrixType type )
+{
+    Matrix result;
+    Invert( value, type, result );
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      指定された種別を前提に逆行列を求めます.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+void Matrix::Invert( const Matrix& value, MatrixType type, Matrix &result )
+{
+    switch( type )
+    {
+    case MatrixType::Rigid:
+        InvertRigid( value, result );
+        break;
+
+    case MatrixType::Affine:
+        InvertAffine( value, result );
+        break;
+
+    default:
+        result = Invert( value );
+        break;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      アフィン変換行列の逆行列を求めます.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+Matrix Matrix::InvertAffine( const Matrix& value )
+{
+    Matrix result;
+    InvertAffine( value, result );
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      アフィン変換行列の逆行列を求めます.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+void Matrix::InvertAffine( const Matrix& value, Matrix &result )
+{
+    assert( value._14 == 0.0f && value._24 == 0.0f && value._34 == 0.0f && value._44 == 1.0f );
+
+    // 左上3x3の余因子.
+    auto c11 = value._22 * value._33 - value._23 * value._32;
+    auto c12 = value._13 * value._32 - value._12 * value._33;
+    auto c13 = value._12 * value._23 - value._13 * value._22;
+
+    auto c21 = value._23 * value._31 - value._21 * value._33;
+    auto c22 = value._11 * value._33 - value._13 * value._31;
+    auto c23 = value._13 * value._21 - value._11 * value._23;
+
+    auto c31 = value._21 * value._32 - value._22 * value._31;
+    auto c32 = value._12 * value._31 - value._11 * value._32;
+    auto c33 = value._11 * value._22 - value._12 * value._21;
+
+    auto det = value._11 * c11 + value._12 * c21 + value._13 * c31;
+    assert( !IsZero( det ) );
+
+    auto invDet = 1.0f / det;
+    c11 *= invDet; c12 *= invDet; c13 *= invDet;
+    c21 *= invDet; c22 *= invDet; c23 *= invDet;
+    c31 *= invDet; c32 *= invDet; c33 *= invDet;
+
+    auto tx = value._41;
+    auto ty = value._42;
+    auto tz = value._43;
+
+    result._11 = c11;   result._12 = c12;   result._13 = c13;   result._14 = 0.0f;
+    result._21 = c21;   result._22 = c22;   result._23 = c23;   result._24 = 0.0f;
+    result._31 = c31;   result._32 = c32;   result._33 = c33;   result._34 = 0.0f;
+
+    result._41 = -( tx * c11 + ty * c21 + tz * c31 );
+    result._42 = -( tx * c12 + ty * c22 + tz * c32 );
+    result._43 = -( tx * c13 + ty * c23 + tz * c33 );
+    result._44 = 1.0f;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      剛体変換行列の逆行列を求めます.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+Matrix Matrix::InvertRigid( const Matrix& value )
+{
+    Matrix result;
+    InvertRigid( value, result );
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      剛体変換行列の逆行列を求めます.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+void Matrix::InvertRigid( const Matrix& value, Matrix &result )
+{
+    assert( value._14 == 0.0f && value._24 == 0.0f && value._34 == 0.0f && value._44 == 1.0f );
+
+    // 回転部分は転置, 平行移動は回転の転置を掛けて反転.
+    auto m11 = value._11; auto m12 = value._12; auto m13 = value._13;
+    auto m21 = value._21; auto m22 = value._22; auto m23 = value._23;
+    auto m31 = value._31; auto m32 = value._32; auto m33 = value._33;
+    auto tx  = value._41; auto ty  = value._42; auto tz  = value._43;
+
+    result._11 = m11;   result._12 = m21;   result._13 = m31;   result._14 = 0.0f;
+    result._21 = m12;   result._22 = m22;   result._23 = m32;   result._24 = 0.0f;
+    result._31 = m13;   result._32 = m23;   result._33 = m33;   result._34 = 0.0f;
+
+    result._41 = -( tx * m11 + ty * m12 + tz * m13 );
+    result._42 = -( tx * m21 + ty * m22 + tz * m23 );
+    result._43 = -( tx * m31 + ty * m32 + tz * m33 );
+    result._44 = 1.0f;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      逆行列の計算に使える最も限定的な種別を判定します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+MatrixType Matrix::Classify( const Matrix& value )
+{
+    // 射影成分を持つ場合は一般行列.
+    if ( value._14 != 0.0f || value._24 != 0.0f || value._34 != 0.0f || value._44 != 1.0f )
+    { return MatrixType::General; }
+
+    // 左上3x3の各行が正規直交していれば剛体変換.
+    auto d11 = value._11 * value._11 + value._12 * value._12 + value._13 * value._13;
+    auto d22 = value._21 * value._21 + value._22 * value._22 + value._23 * value._23;
+    auto d33 = value._31 * value._31 + value._32 * value._32 + value._33 * value._33;
+    auto d12 = value._11 * value._21 + value._12 * value._22 + value._13 * value._23;
+    auto d13 = value._11 * value._31 + value._12 * value._32 + value._13 * value._33;
+    auto d23 = value._21 * value._31 + value._22 * value._32 + value._23 * value._33;
+
+    if ( fabs( d11 - 1.0f ) <= RIGID_EPSILON
+      && fabs( d22 - 1.0f ) <= RIGID_EPSILON
+      && fabs( d33 - 1.0f ) <= RIGID_EPSILON
+      && fabs( d12 ) <= RIGID_EPSILON
+      && fabs( d13 ) <= RIGID_EPSILON
+      && fabs( d23 ) <= RIGID_EPSILON )
+    { return MatrixType::Rigid; }
+
+    return MatrixType::Affine;
+}
+
 //-------------------------------------------------------------------------------------------------
 //      拡大・縮小行列を生成します.
 //-------------------------------------------------------------------------------------------------
@@ -4829,7 +5069,7 @@ Quaternion& Quaternion::operator *= ( const Quaternion& q )
     auto X = ( q.x * w ) + ( x * q.w ) + ( q.y * z ) - ( q.z * y );
     auto Y = ( q.y * w ) + ( y * q.w ) + ( q.z * x ) - ( q.x * z );
     auto Z = ( q.z * w ) + ( z * q.w ) + ( q.x * y ) - ( q.y * x );
-    auto W = ( q.w * w ) - ( q.x * x ) - ( q.y * y ) + ( q.z * z );
+    auto W = ( q.w * w ) - ( q.x * x ) - ( q.y * y ) - ( q.z * z );
     x = X;
     y = Y;
     z = Z;
@@ -4883,14 +5123,14 @@ Quaternion Quaternion::operator - () const
 //-------------------------------------------------------------------------------------------------
 ASDX_INLINE 
 Quaternion Quaternion::operator + ( const Quaternion& q ) const
-{ return Quaternion( x + q.x, y + q.y, z + q.z, w + q.z ); }
+{ return Quaternion( x + q.x, y + q.y, z + q.z, w + q.w ); }
 
 //-------------------------------------------------------------------------------------------------
 //      減算演算子です.
 //-------------------------------------------------------------------------------------------------
 ASDX_INLINE 
 Quaternion Quaternion::operator - ( const Quaternion& q ) const
-{ return Quaternion( x - q.x, y - q.y, z - q.z, w - q.z ); }
+{ return Quaternion( x - q.x, y - q.y, z - q.z, w - q.w ); }
 
 //-------------------------------------------------------------------------------------------------
 //      乗算演算子です.
@@ -4902,7 +5142,7 @@ Quaternion Quaternion::operator * ( const Quaternion& q ) const
         ( q.x * w ) + ( x * q.w ) + ( q.y * z ) - ( q.z * y ),
         ( q.y * w ) + ( y * q.w ) + ( q.z * x ) - ( q.x * z ),
         ( q.z * w ) + ( z * q.w ) + ( q.x * y ) - ( q.y * x ),
-        ( q.w * w ) - ( q.x * x ) - ( q.y * y ) + ( q.z * z )
+        ( q.w * w ) - ( q.x * x ) - ( q.y * y ) - ( q.z * z )
    );
 }
 
@@ -5062,7 +5302,7 @@ Quaternion Quaternion::Multiply( const Quaternion& a, const Quaternion& b )
         ( b.x * a.w ) + ( a.x * b.w ) + ( b.y * a.z ) - ( b.z * a.y ),
         ( b.y * a.w ) + ( a.y * b.w ) + ( b.z * a.x ) - ( b.x * a.z ),
         ( b.z * a.w ) + ( a.z * b.w ) + ( b.x * a.y ) - ( b.y * a.x ),
-        ( b.w * a.w ) - ( b.x * a.x ) - ( b.y * a.y ) + ( b.z * a.z )
+        ( b.w * a.w ) - ( b.x * a.x ) - ( b.y * a.y ) - ( b.z * a.z )
    );
 }
 
@@ -5075,7 +5315,7 @@ void Quaternion::Multiply( const Quaternion& a, const Quaternion& b, Quaternion&
     result.x = ( b.x * a.w ) + ( a.x * b.w ) + ( b.y * a.z ) - ( b.z * a.y );
     result.y = ( b.y * a.w ) + ( a.y * b.w ) + ( b.z * a.x ) - ( b.x * a.z );
     result.z = ( b.z * a.w ) + ( a.z * b.w ) + ( b.x * a.y ) - ( b.y * a.x );
-    result.w = ( b.w * a.w ) - ( b.x * a.x ) - ( b.y * a.y ) + ( b.z * a.z );
+    result.w = ( b.w * a.w ) - ( b.x * a.x ) - ( b.y * a.y ) - ( b.z * a.z );
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -5135,10 +5375,10 @@ void Quaternion::Normalize( const Quaternion& value, Quaternion &result )
 {
     auto mag = value.Length();
     assert( mag > 0.0f );
-    result.x /= mag;
-    result.y /= mag;
-    result.z /= mag;
-    result.w /= mag;
+    result.x = value.x / mag;
+    result.y = value.y / mag;
+    result.z = value.z / mag;
+    result.w = value.w / mag;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -5510,6 +5750,243 @@ void Quaternion::Squad
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////
+// DualQuaternion structure
+////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      引数なしコンストラクタです.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+DualQuaternion::DualQuaternion()
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------------
+//      実部と双対部を指定して生成します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+DualQuaternion::DualQuaternion( const Quaternion& nreal, const Quaternion& ndual )
+: real( nreal )
+, dual( ndual )
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------------
+//      回転と平行移動から生成します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+DualQuaternion::DualQuaternion( const Quaternion& rotation, const Vector3& translation )
+: real( rotation )
+{
+    // dual = 0.5 * t * q (ハミルトン積).
+    const auto& q = rotation;
+    const auto& t = translation;
+    dual.x =  0.5f * ( t.x * q.w + t.y * q.z - t.z * q.y );
+    dual.y =  0.5f * ( t.y * q.w + t.z * q.x - t.x * q.z );
+    dual.z =  0.5f * ( t.z * q.w + t.x * q.y - t.y * q.x );
+    dual.w = -0.5f * ( t.x * q.x + t.y * q.y + t.z * q.z );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      単位双対四元数を生成します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+DualQuaternion DualQuaternion::CreateIdentity()
+{
+    return DualQuaternion(
+        Quaternion( 0.0f, 0.0f, 0.0f, 1.0f ),
+        Quaternion( 0.0f, 0.0f, 0.0f, 0.0f ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      剛体変換行列から生成します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+DualQuaternion DualQuaternion::CreateFromMatrix( const Matrix& value )
+{
+    DualQuaternion result;
+    CreateFromMatrix( value, result );
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      剛体変換行列から生成します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+void DualQuaternion::CreateFromMatrix( const Matrix& value, DualQuaternion& result )
+{
+    // 拡大縮小成分を取り除く.
+    auto r0 = Vector3::Normalize( Vector3( value._11, value._12, value._13 ) );
+    auto r1 = Vector3::Normalize( Vector3( value._21, value._22, value._23 ) );
+    auto r2 = Vector3::Normalize( Vector3( value._31, value._32, value._33 ) );
+
+    Matrix rotation(
+        r0.x, r0.y, r0.z, 0.0f,
+        r1.x, r1.y, r1.z, 0.0f,
+        r2.x, r2.y, r2.z, 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f );
+
+    auto q = Quaternion::Normalize( Quaternion::CreateFromRotationMatrix( rotation ) );
+    result = DualQuaternion( q, Vector3( value._41, value._42, value._43 ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      変換行列に変換します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+Matrix DualQuaternion::ToMatrix( const DualQuaternion& value )
+{
+    Matrix result;
+    ToMatrix( value, result );
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      変換行列に変換します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+void DualQuaternion::ToMatrix( const DualQuaternion& value, Matrix& result )
+{
+    Matrix::CreateFromQuaternion( value.real, result );
+
+    auto t = GetTranslation( value );
+    result._41 = t.x;
+    result._42 = t.y;
+    result._43 = t.z;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      平行移動量を取得します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+Vector3 DualQuaternion::GetTranslation( const DualQuaternion& value )
+{
+    // t = 2 * dual * conj(real) (ハミルトン積)のベクトル部.
+    const auto& r = value.real;
+    const auto& d = value.dual;
+    return Vector3(
+        2.0f * ( r.w * d.x - d.w * r.x + r.y * d.z - r.z * d.y ),
+        2.0f * ( r.w * d.y - d.w * r.y + r.z * d.x - r.x * d.z ),
+        2.0f * ( r.w * d.z - d.w * r.z + r.x * d.y - r.y * d.x ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      正規化します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+DualQuaternion DualQuaternion::Normalize( const DualQuaternion& value )
+{
+    DualQuaternion result;
+    Normalize( value, result );
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      正規化します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+void DualQuaternion::Normalize( const DualQuaternion& value, DualQuaternion& result )
+{
+    auto mag = value.real.Length();
+    assert( mag > 0.0f );
+
+    auto invMag = 1.0f / mag;
+    auto r = value.real * invMag;
+    auto d = value.dual * invMag;
+
+    // 実部と直交しない成分を取り除く.
+    auto dot = Quaternion::Dot( r, d );
+    result.real = r;
+    result.dual = d - r * dot;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      乗算します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+DualQuaternion DualQuaternion::Multiply( const DualQuaternion& a, const DualQuaternion& b )
+{
+    DualQuaternion result;
+    Multiply( a, b, result );
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      乗算します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+void DualQuaternion::Multiply( const DualQuaternion& a, const DualQuaternion& b, DualQuaternion& result )
+{
+    // Quaternion::Multiply( a, b ) は a の後に b を適用する順序.
+    auto r = Quaternion::Multiply( a.real, b.real );
+    auto d = Quaternion::Multiply( a.dual, b.real ) + Quaternion::Multiply( a.real, b.dual );
+    result.real = r;
+    result.dual = d;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      線形ブレンドを行い, 正規化します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+DualQuaternion DualQuaternion::Blend( const DualQuaternion* pValues, const f32* pWeights, u32 count )
+{
+    assert( pValues != nullptr && pWeights != nullptr && count > 0 );
+
+    auto pivot = pValues[0].real;
+    auto r = pValues[0].real * pWeights[0];
+    auto d = pValues[0].dual * pWeights[0];
+
+    for( u32 i=1; i<count; ++i )
+    {
+        auto w = ( Quaternion::Dot( pivot, pValues[i].real ) < 0.0f ) ? -pWeights[i] : pWeights[i];
+        r += pValues[i].real * w;
+        d += pValues[i].dual * w;
+    }
+
+    return Normalize( DualQuaternion( r, d ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      線形補間を行い, 正規化します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+DualQuaternion DualQuaternion::Lerp( const DualQuaternion& a, const DualQuaternion& b, f32 amount )
+{
+    DualQuaternion result;
+    Lerp( a, b, amount, result );
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      線形補間を行い, 正規化します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+void DualQuaternion::Lerp( const DualQuaternion& a, const DualQuaternion& b, f32 amount, DualQuaternion& result )
+{
+    const DualQuaternion values[2] = { a, b };
+    const f32 weights[2] = { 1.0f - amount, amount };
+    result = Blend( values, weights, 2 );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      位置座標を変換します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+Vector3 DualQuaternion::Transform( const Vector3& position, const DualQuaternion& value )
+{ return TransformNormal( position, value ) + GetTranslation( value ); }
+
+//-------------------------------------------------------------------------------------------------
+//      法線ベクトルを変換します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+Vector3 DualQuaternion::TransformNormal( const Vector3& normal, const DualQuaternion& value )
+{
+    // v' = v + 2 * cross( q.xyz, cross( q.xyz, v ) + q.w * v ).
+    Vector3 q( value.real.x, value.real.y, value.real.z );
+    auto t = Vector3::Cross( q, normal ) + normal * value.real.w;
+    return normal + Vector3::Cross( q, t ) * 2.0f;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////
 // OrthonormalBasis structure
 ////////////////////////////////////////////////////////////////////////////////////
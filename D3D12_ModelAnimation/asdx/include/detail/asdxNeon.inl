@@ -19,37 +19,58 @@ namespace asdx {
 ASDX_INLINE
 b128 Simd::Create( f32 x, f32 y, f32 z, f32 w )
 {
-    f32 element = { x, y, z, w };
-    return __vld1q_f32( element );
+    f32 element[4] = { x, y, z, w };
+    return vld1q_f32( element );
 }
 
+//-------------------------------------------------------------------------------------------------
+//      全成分に同じ値を設定します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+b128 Simd::Replicate( f32 value )
+{ return vdupq_n_f32( value ); }
+
+//-------------------------------------------------------------------------------------------------
+//      メモリから読み込みます.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+b128 Simd::Load( const f32* pValues )
+{ return vld1q_f32( pValues ); }
+
+//-------------------------------------------------------------------------------------------------
+//      メモリに書き込みます.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+void Simd::Store( f32* pResult, const b128& value )
+{ vst1q_f32( pResult, value ); }
+
 //-------------------------------------------------------------------------------------------------
 //      X成分を設定します.
 //-------------------------------------------------------------------------------------------------
 ASDX_INLINE
 void Simd::SetX( b128& value, f32 x )
-{ vsetq_lane_f32( x, value, 0 ); }
+{ value = vsetq_lane_f32( x, value, 0 ); }
 
 //-------------------------------------------------------------------------------------------------
 //      Y成分を設定します.
 //-------------------------------------------------------------------------------------------------
-ASDX_INILNE
+ASDX_INLINE
 void Simd::SetY( b128& value, f32 y )
-{ vsetq_lane_f32( y, value, 1 ); }
+{ value = vsetq_lane_f32( y, value, 1 ); }
 
 //-------------------------------------------------------------------------------------------------
 //      Z成分を設定します.
 //-------------------------------------------------------------------------------------------------
 ASDX_INLINE
 void Simd::SetZ( b128& value, f32 z )
-{ vsetq_lane_f32( z, value, 2 ); }
+{ value = vsetq_lane_f32( z, value, 2 ); }
 
 //-------------------------------------------------------------------------------------------------
 //      W成分を設定します.
 //-------------------------------------------------------------------------------------------------
 ASDX_INLINE
 void Simd::SetW( b128& value, f32 w )
-{ vsetq_lane_f32( w, value, 3 ); }
+{ value = vsetq_lane_f32( w, value, 3 ); }
 
 //-------------------------------------------------------------------------------------------------
 //      X成分を取得します.
@@ -178,8 +199,8 @@ ASDX_INLINE
 b128 Simd::Dot3( const b128& a, const b128& b )
 {
     b128 tmp = vmulq_f32( a, b );
-    b128 v1 = vget_low_f32( tmp );
-    b128 v2 = vget_high_f32( tmp );
+    b64  v1 = vget_low_f32( tmp );
+    b64  v2 = vget_high_f32( tmp );
     v1 = vpadd_f32( v1, v1 );
     v2 = vdup_lane_f32( v2, 0 );
     v1 = vadd_f32( v1, v2 );
@@ -193,14 +214,28 @@ ASDX_INLINE
 b128 Simd::Dot4( const b128& a, const b128& b )
 {
     b128 tmp = vmulq_f32( a, b );
-    b128 v1 = vget_low_f32( tmp );
-    b128 v2 = vget_high_f32( tmp );
+    b64  v1 = vget_low_f32( tmp );
+    b64  v2 = vget_high_f32( tmp );
     v1 = vpadd_f32( v1, v1 );
     v2 = vpadd_f32( v2, v2 );
     v1 = vadd_f32( v1, v2 );
     return vcombine_f32( v1, v1 );
 }
 
+//-------------------------------------------------------------------------------------------------
+//      4x4の転置を行います.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+void Simd::Transpose( b128& r0, b128& r1, b128& r2, b128& r3 )
+{
+    float32x4x2_t t01 = vtrnq_f32( r0, r1 );
+    float32x4x2_t t23 = vtrnq_f32( r2, r3 );
+    r0 = vcombine_f32( vget_low_f32 ( t01.val[0] ), vget_low_f32 ( t23.val[0] ) );
+    r1 = vcombine_f32( vget_low_f32 ( t01.val[1] ), vget_low_f32 ( t23.val[1] ) );
+    r2 = vcombine_f32( vget_high_f32( t01.val[0] ), vget_high_f32( t23.val[0] ) );
+    r3 = vcombine_f32( vget_high_f32( t01.val[1] ), vget_high_f32( t23.val[1] ) );
+}
+
 } // namespace asdx
 
 #endif//ASDX_IS_NEON
\ No newline at end of file
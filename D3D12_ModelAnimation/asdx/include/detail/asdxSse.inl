@@ -20,6 +20,29 @@ ASDX_INLINE
 b128 Simd::Create( f32 x, f32 y, f32 z, f32 w )
 { return _mm_set_ps( w, z, y, x ); }
 
+//-------------------------------------------------------------------------------------------------
+//      全成分に同じ値を設定します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+b128 Simd::Replicate( f32 value )
+{ return _mm_set1_ps( value ); }
+
+//-------------------------------------------------------------------------------------------------
+//      メモリから読み込みます.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+b128 Simd::Load( const f32* pValues )
+{ return _mm_loadu_ps( pValues ); }
+
+//-------------------------------------------------------------------------------------------------
+//      メモリに書き込みます.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+void Simd::Store( f32* pResult, const b128& value )
+{ _mm_storeu_ps( pResult, value ); }
+
+#if ASDX_IS_SSE4_1
+
 //-------------------------------------------------------------------------------------------------
 //      X成分を設定します.
 //-------------------------------------------------------------------------------------------------
@@ -88,6 +111,78 @@ f32 Simd::GetW( const b128& value )
     return ret;
 }
 
+#else
+
+//-------------------------------------------------------------------------------------------------
+//      X成分を設定します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+void Simd::SetX( b128& value, f32 x )
+{ value = _mm_move_ss( value, _mm_set_ss(x) ); }
+
+//-------------------------------------------------------------------------------------------------
+//      Y成分を設定します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+void Simd::SetY( b128& value, f32 y )
+{
+    b128 tmp = _mm_shuffle_ps( value, value, _MM_SHUFFLE(3, 2, 0, 1) );
+    tmp = _mm_move_ss( tmp, _mm_set_ss(y) );
+    value = _mm_shuffle_ps( tmp, tmp, _MM_SHUFFLE(3, 2, 0, 1) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      Z成分を設定します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+void Simd::SetZ( b128& value, f32 z )
+{
+    b128 tmp = _mm_shuffle_ps( value, value, _MM_SHUFFLE(3, 0, 1, 2) );
+    tmp = _mm_move_ss( tmp, _mm_set_ss(z) );
+    value = _mm_shuffle_ps( tmp, tmp, _MM_SHUFFLE(3, 0, 1, 2) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      W成分を設定します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+void Simd::SetW( b128& value, f32 w )
+{
+    b128 tmp = _mm_shuffle_ps( value, value, _MM_SHUFFLE(0, 2, 1, 3) );
+    tmp = _mm_move_ss( tmp, _mm_set_ss(w) );
+    value = _mm_shuffle_ps( tmp, tmp, _MM_SHUFFLE(0, 2, 1, 3) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      X成分を取得します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+f32 Simd::GetX( const b128& value )
+{ return _mm_cvtss_f32( value ); }
+
+//-------------------------------------------------------------------------------------------------
+//      Y成分を取得します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+f32 Simd::GetY( const b128& value )
+{ return _mm_cvtss_f32( _mm_shuffle_ps( value, value, _MM_SHUFFLE(1, 1, 1, 1) ) ); }
+
+//-------------------------------------------------------------------------------------------------
+//      Z成分を取得します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+f32 Simd::GetZ( const b128& value )
+{ return _mm_cvtss_f32( _mm_shuffle_ps( value, value, _MM_SHUFFLE(2, 2, 2, 2) ) ); }
+
+//-------------------------------------------------------------------------------------------------
+//      W成分を取得します.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+f32 Simd::GetW( const b128& value )
+{ return _mm_cvtss_f32( _mm_shuffle_ps( value, value, _MM_SHUFFLE(3, 3, 3, 3) ) ); }
+
+#endif//ASDX_IS_SSE4_1
+
 //-------------------------------------------------------------------------------------------------
 //      加算計算を行います.
 //-------------------------------------------------------------------------------------------------
@@ -181,6 +276,8 @@ ASDX_INLINE
 b128 Simd::Max( const b128& a, const b128& b )
 { return _mm_max_ps( a, b ); }
 
+#if ASDX_IS_SSE4_1
+
 //-------------------------------------------------------------------------------------------------
 //      内積を求めます.
 //-------------------------------------------------------------------------------------------------
@@ -195,6 +292,44 @@ ASDX_INLINE
 b128 Simd::Dot4( const b128& a, const b128& b )
 { return _mm_dp_ps( a, b,  0xff ); }
 
+#else
+
+//-------------------------------------------------------------------------------------------------
+//      内積を求めます.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+b128 Simd::Dot3( const b128& a, const b128& b )
+{
+    b128 tmp = _mm_mul_ps( a, b );
+    b128 y   = _mm_shuffle_ps( tmp, tmp, _MM_SHUFFLE(1, 1, 1, 1) );
+    b128 z   = _mm_shuffle_ps( tmp, tmp, _MM_SHUFFLE(2, 2, 2, 2) );
+    tmp = _mm_add_ss( tmp, y );
+    tmp = _mm_add_ss( tmp, z );
+    return _mm_shuffle_ps( tmp, tmp, _MM_SHUFFLE(0, 0, 0, 0) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      内積を求めます.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+b128 Simd::Dot4( const b128& a, const b128& b )
+{
+    b128 tmp = _mm_mul_ps( a, b );
+    b128 shf = _mm_shuffle_ps( tmp, tmp, _MM_SHUFFLE(2, 3, 0, 1) );
+    tmp = _mm_add_ps( tmp, shf );
+    shf = _mm_shuffle_ps( tmp, tmp, _MM_SHUFFLE(1, 0, 3, 2) );
+    return _mm_add_ps( tmp, shf );
+}
+
+#endif//ASDX_IS_SSE4_1
+
+//-------------------------------------------------------------------------------------------------
+//      4x4の転置を行います.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE
+void Simd::Transpose( b128& r0, b128& r1, b128& r2, b128& r3 )
+{ _MM_TRANSPOSE4_PS( r0, r1, r2, r3 ); }
+
 } // namespace asdx
 
 #endif//ASDX_IS_SSE
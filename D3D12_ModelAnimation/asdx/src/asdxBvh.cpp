@@ -0,0 +1,1046 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxBvh.cpp
+// Desc : Bounding Volume Hierarchy Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxBvh.h>
+#include <asdxResMesh.h>
+#include "kernels/asdxKernelTable.h"
+#include "kernels/asdxParallel.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+
+namespace /* anonymous */ {
+
+using namespace asdx;
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const u32 BIN_COUNT          = 16;       //!< SAH評価に使うビン数です.
+static const u32 MAX_LEAF_SIZE      = 4;        //!< 葉ノードに含めるプリミティブの最大数です(SAHで分割しない場合を除く).
+static const u32 MAX_DEPTH          = 60;       //!< 木の最大深さです. これ以上は分割せず葉ノードにします.
+static const u32 STACK_SIZE         = 64;       //!< 走査スタックの大きさです(MAX_DEPTH以上).
+static const u32 TASK_GRAIN         = 4096;     //!< 部分木を別タスクで構築するプリミティブ数の下限です.
+static const f32 TRAVERSAL_COST     = 1.0f;     //!< プリミティブ1つの交差判定に対するノード走査の相対コストです.
+static const u32 PACKET_CHUNK       = 64;       //!< まとめて判定するレイの本数です(命令セットの幅の倍数).
+static const u32 TRIANGLE_BLOCK     = 1024;     //!< レイのまとまりごとに続けて判定する三角形数です.
+
+static_assert( sizeof(BvhNode) == 32, "BvhNode must be 32 bytes." );
+static_assert( STACK_SIZE >= MAX_DEPTH, "Traversal stack is too small." );
+static_assert( sizeof(Vector3) == sizeof(f32) * 3, "Vector3 must be tightly packed." );
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Bin structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct Bin
+{
+    BoundingBox box;        //!< ビンに含まれるプリミティブのバウンディングボックスです.
+    u32         count;      //!< ビンに含まれるプリミティブ数です.
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PrimRef structure
+// 構築中に並べ替えるプリミティブの参照です. 間接参照を避けるためボックスを直接持ちます.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct PrimRef
+{
+    Vector3     mini;       //!< 最小値です.
+    u32         index;      //!< プリミティブ番号です.
+    Vector3     maxi;       //!< 最大値です.
+    u32         padding;    //!< パディングです.
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// BuildContext structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct BuildContext
+{
+    PrimRef*                pPrims;         //!< 並べ替えるプリミティブです.
+    BvhNode*                pNodes;         //!< 構築中のノードです(子ノードは連続した2つ).
+    std::atomic<u32>        nodeCount;      //!< 確保済みのノード数です.
+};
+
+//-------------------------------------------------------------------------------------------------
+//      指定軸の成分を取得します.
+//-------------------------------------------------------------------------------------------------
+inline f32 GetAxis( const Vector3& value, u32 axis )
+{ return ( axis == 0 ) ? value.x : ( axis == 1 ) ? value.y : value.z; }
+
+//-------------------------------------------------------------------------------------------------
+//      重心の2倍を求めます. ビン分割では相対位置だけを使うため0.5倍を省略します.
+//-------------------------------------------------------------------------------------------------
+inline Vector3 GetCentroid2( const PrimRef& prim )
+{ return prim.mini + prim.maxi; }
+
+//-------------------------------------------------------------------------------------------------
+//      ボックスをマージします.
+//-------------------------------------------------------------------------------------------------
+inline void MergeBox( BoundingBox& box, const PrimRef& prim )
+{
+    box.mini = Vector3::Min( box.mini, prim.mini );
+    box.maxi = Vector3::Max( box.maxi, prim.maxi );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      バウンディングボックスの表面積の半分を求めます.
+//-------------------------------------------------------------------------------------------------
+inline f32 HalfArea( const BoundingBox& box )
+{
+    auto size = box.maxi - box.mini;
+    if ( size.x < 0.0f || size.y < 0.0f || size.z < 0.0f )
+    { return 0.0f; }
+
+    return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ビン番号を求めます.
+//-------------------------------------------------------------------------------------------------
+inline u32 GetBinIndex( f32 value, f32 mini, f32 scale, u32 binCount )
+{
+    auto index = u32( ( value - mini ) * scale );
+    return ( index < binCount - 1 ) ? index : binCount - 1;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ノードを葉ノードにします.
+//-------------------------------------------------------------------------------------------------
+inline void SetLeaf( BvhNode& node, u32 begin, u32 end )
+{
+    node.offset = begin;
+    node.count  = end - begin;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      区間 [begin, end) のプリミティブから部分木を構築します.
+//-------------------------------------------------------------------------------------------------
+void BuildNode( BuildContext* pContext, u32 nodeIndex, u32 begin, u32 end, u32 depth )
+{
+    auto& node  = pContext->pNodes[nodeIndex];
+    auto  count = end - begin;
+
+    // ノードと重心のバウンディングボックスを求める.
+    BoundingBox bounds;
+    BoundingBox centroidBounds;
+    for( auto i=begin; i<end; ++i )
+    {
+        const auto& prim = pContext->pPrims[i];
+        MergeBox( bounds, prim );
+        centroidBounds.Merge( GetCentroid2( prim ) );
+    }
+    node.mini = bounds.mini;
+    node.maxi = bounds.maxi;
+
+    if ( count <= 1 || depth >= MAX_DEPTH )
+    {
+        SetLeaf( node, begin, end );
+        return;
+    }
+
+    // 3軸分のビンに振り分ける.
+    // 小さなノードではビンの初期化と走査が支配的になるため, ビン数を要素数に合わせて減らす.
+    auto binCount = ( count < BIN_COUNT ) ? count : BIN_COUNT;
+    Bin bins[3][BIN_COUNT];
+    f32 scales[3] = {};
+    for( u32 axis=0; axis<3; ++axis )
+    {
+        auto extent = GetAxis( centroidBounds.maxi, axis ) - GetAxis( centroidBounds.mini, axis );
+        scales[axis] = ( extent > 0.0f ) ? f32( binCount ) / extent : 0.0f;
+
+        for( u32 i=0; i<binCount; ++i )
+        {
+            bins[axis][i].box   = BoundingBox();
+            bins[axis][i].count = 0;
+        }
+    }
+
+    for( auto i=begin; i<end; ++i )
+    {
+        const auto& prim = pContext->pPrims[i];
+        auto centroid = GetCentroid2( prim );
+        for( u32 axis=0; axis<3; ++axis )
+        {
+            if ( scales[axis] == 0.0f )
+            { continue; }
+
+            auto& bin = bins[axis][GetBinIndex( GetAxis( centroid, axis ), GetAxis( centroidBounds.mini, axis ), scales[axis], binCount )];
+            MergeBox( bin.box, prim );
+            bin.count++;
+        }
+    }
+
+    // ビン境界ごとのSAHコストを求め, 最小のものを選ぶ.
+    auto bestCost  = F32_MAX;
+    u32  bestAxis  = 0;
+    u32  bestSplit = 0;
+    for( u32 axis=0; axis<3; ++axis )
+    {
+        if ( scales[axis] == 0.0f )
+        { continue; }
+
+        f32 rightCost[BIN_COUNT] = {};
+        BoundingBox rightBox;
+        u32 rightCount = 0;
+        for( auto i=binCount - 1; i>0; --i )
+        {
+            if ( bins[axis][i].count > 0 )
+            {
+                rightBox    = BoundingBox::Merge( rightBox, bins[axis][i].box );
+                rightCount += bins[axis][i].count;
+            }
+            rightCost[i] = HalfArea( rightBox ) * f32( rightCount );
+        }
+
+        BoundingBox leftBox;
+        u32 leftCount = 0;
+        for( u32 i=1; i<binCount; ++i )
+        {
+            if ( bins[axis][i - 1].count == 0 )
+            { continue; }
+
+            leftBox    = BoundingBox::Merge( leftBox, bins[axis][i - 1].box );
+            leftCount += bins[axis][i - 1].count;
+            if ( leftCount == count )
+            { break; }
+
+            auto cost = HalfArea( leftBox ) * f32( leftCount ) + rightCost[i];
+            if ( cost < bestCost )
+            {
+                bestCost  = cost;
+                bestAxis  = axis;
+                bestSplit = i;
+            }
+        }
+    }
+
+    u32 mid = begin;
+    if ( bestCost < F32_MAX )
+    {
+        // 分割しない場合のコストと比較する.
+        auto area = HalfArea( bounds );
+        auto splitCost = TRAVERSAL_COST + ( ( area > 0.0f ) ? bestCost / area : f32( count ) );
+        if ( count <= MAX_LEAF_SIZE && f32( count ) <= splitCost )
+        {
+            SetLeaf( node, begin, end );
+            return;
+        }
+
+        auto mini  = GetAxis( centroidBounds.mini, bestAxis );
+        auto scale = scales[bestAxis];
+        auto pos   = std::partition( pContext->pPrims + begin, pContext->pPrims + end, [&]( const PrimRef& prim )
+        { return GetBinIndex( GetAxis( GetCentroid2( prim ), bestAxis ), mini, scale, binCount ) < bestSplit; });
+        mid = u32( pos - pContext->pPrims );
+    }
+    else
+    {
+        // 重心が全て一致する場合は分割しても良くならない.
+        if ( count <= MAX_LEAF_SIZE )
+        {
+            SetLeaf( node, begin, end );
+            return;
+        }
+        mid = begin + count / 2;
+    }
+
+    auto left = pContext->nodeCount.fetch_add( 2 );
+    node.offset = left;
+    node.count  = 0;
+
+#if ASDX_IS_OPENMP
+    if ( mid - begin >= TASK_GRAIN && end - mid >= TASK_GRAIN )
+    {
+        #pragma omp task firstprivate( pContext, left, begin, mid, depth )
+        BuildNode( pContext, left, begin, mid, depth + 1 );
+    }
+    else
+#endif
+    {
+        BuildNode( pContext, left, begin, mid, depth + 1 );
+    }
+
+    BuildNode( pContext, left + 1, mid, end, depth + 1 );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      BVHを構築し, 深さ優先順に並べ替えます.
+//-------------------------------------------------------------------------------------------------
+void BuildTree( const BoundingBox* pBoxes, u32 count, std::vector<BvhNode>& nodes, std::vector<u32>& indices )
+{
+    std::vector<PrimRef> prims( count );
+    for( u32 i=0; i<count; ++i )
+    {
+        prims[i].mini    = pBoxes[i].mini;
+        prims[i].index   = i;
+        prims[i].maxi    = pBoxes[i].maxi;
+        prims[i].padding = 0;
+    }
+
+    // 葉ノード以外は子ノードを2つずつ持つため, ノード数は最大で 2 * count - 1 です.
+    std::vector<BvhNode> temp( count * 2 - 1 );
+
+    BuildContext context;
+    context.pPrims      = prims.data();
+    context.pNodes      = temp.data();
+    context.nodeCount   = 1;
+
+#if ASDX_IS_OPENMP
+    if ( count >= TASK_GRAIN * 2 )
+    {
+        auto pContext = &context;
+
+        #pragma omp parallel
+        {
+            #pragma omp single
+            BuildNode( pContext, 0, 0, count, 0 );
+        }
+    }
+    else
+#endif
+    {
+        BuildNode( &context, 0, 0, count, 0 );
+    }
+
+    indices.resize( count );
+    for( u32 i=0; i<count; ++i )
+    { indices[i] = prims[i].index; }
+
+    // タスクの実行順によらない深さ優先順に並べ替える.
+    struct Item
+    {
+        u32 src;        //!< 構築時のノード番号です.
+        u32 parent;     //!< 右の子ノードとして自身を参照する親ノード番号です.
+    };
+
+    nodes.clear();
+    nodes.reserve( context.nodeCount );
+
+    std::vector<Item> stack;
+    stack.push_back( { 0, U32_MAX } );
+    while( !stack.empty() )
+    {
+        auto item = stack.back();
+        stack.pop_back();
+
+        auto index = u32( nodes.size() );
+        nodes.push_back( temp[item.src] );
+        if ( item.parent != U32_MAX )
+        { nodes[item.parent].offset = index; }
+
+        const auto& node = temp[item.src];
+        if ( node.count == 0 )
+        {
+            stack.push_back( { node.offset + 1, index } );
+            stack.push_back( { node.offset, U32_MAX } );
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      葉ノードのバウンディングボックスから全ノードを更新します.
+//      深さ優先順では子ノードは親ノードより後ろにあるため, 末尾から更新すれば済みます.
+//-------------------------------------------------------------------------------------------------
+template<typename LeafFunc>
+void RefitTree( std::vector<BvhNode>& nodes, const LeafFunc& leafBounds )
+{
+    for( auto i=nodes.size(); i>0; --i )
+    {
+        auto& node = nodes[i - 1];
+
+        BoundingBox box;
+        if ( node.count > 0 )
+        { box = leafBounds( node.offset, node.count ); }
+        else
+        {
+            const auto& left  = nodes[i];
+            const auto& right = nodes[node.offset];
+            box.mini = Vector3::Min( left.mini, right.mini );
+            box.maxi = Vector3::Max( left.maxi, right.maxi );
+        }
+
+        node.mini = box.mini;
+        node.maxi = box.maxi;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      レイとボックスの交差区間を求めます.
+//      方向成分が0の軸で 0 * inf が NaN になっても, 比較が偽になり区間が狭まらないようにしています.
+//-------------------------------------------------------------------------------------------------
+inline bool IntersectBox
+(
+    const Vector3&  mini,
+    const Vector3&  maxi,
+    const Ray&      ray,
+    f32             tMax,
+    f32&            tNear
+)
+{
+    auto t0 = 0.0f;
+    auto t1 = tMax;
+
+    auto slab = [&]( f32 lo, f32 hi, f32 pos, f32 invDir )
+    {
+        auto a = ( lo - pos ) * invDir;
+        auto b = ( hi - pos ) * invDir;
+        auto n = ( a < b ) ? a : b;
+        auto f = ( a < b ) ? b : a;
+        if ( n > t0 ) { t0 = n; }
+        if ( f < t1 ) { t1 = f; }
+    };
+
+    slab( mini.x, maxi.x, ray.pos.x, ray.invDir.x );
+    slab( mini.y, maxi.y, ray.pos.y, ray.invDir.y );
+    slab( mini.z, maxi.z, ray.pos.z, ray.invDir.z );
+
+    tNear = t0;
+    return t0 <= t1;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      レイと三角形の交差判定を行います(Moller-Trumbore).
+//-------------------------------------------------------------------------------------------------
+inline bool IntersectTriangle
+(
+    const Ray&      ray,
+    const Vector3&  v0,
+    const Vector3&  v1,
+    const Vector3&  v2,
+    f32             tMax,
+    f32&            t,
+    f32&            u,
+    f32&            v
+)
+{
+    auto e1  = v1 - v0;
+    auto e2  = v2 - v0;
+    auto p   = Vector3::Cross( ray.dir, e2 );
+    auto det = Vector3::Dot( e1, p );
+    if ( det == 0.0f )
+    { return false; }
+
+    auto invDet = 1.0f / det;
+    auto s = ray.pos - v0;
+    u = Vector3::Dot( s, p ) * invDet;
+    if ( u < 0.0f || u > 1.0f )
+    { return false; }
+
+    auto q = Vector3::Cross( s, e1 );
+    v = Vector3::Dot( ray.dir, q ) * invDet;
+    if ( v < 0.0f || u + v > 1.0f )
+    { return false; }
+
+    t = Vector3::Dot( e2, q ) * invDet;
+    return ( t >= 0.0f && t < tMax );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      近い子ノードから順にBVHを走査します.
+//
+//      leafFunc は bool( u32 first, u32 count, f32& tMax ) の形式で, 交差した場合は tMax を
+//      交点までの距離に更新して true を返します. AnyHit が true の場合は最初の交差で打ち切ります.
+//-------------------------------------------------------------------------------------------------
+template<bool AnyHit, typename LeafFunc>
+bool Traverse( const std::vector<BvhNode>& nodes, const Ray& ray, f32 maxDistance, const LeafFunc& leafFunc )
+{
+    if ( nodes.empty() )
+    { return false; }
+
+    const auto* pNodes = nodes.data();
+
+    f32 tNear;
+    if ( !IntersectBox( pNodes[0].mini, pNodes[0].maxi, ray, maxDistance, tNear ) )
+    { return false; }
+
+    u32 stackIndex[STACK_SIZE];
+    f32 stackDist [STACK_SIZE];
+    u32 top   = 0;
+    u32 index = 0;
+    auto tMax = maxDistance;
+    auto hit  = false;
+
+    for( ;; )
+    {
+        const auto& node = pNodes[index];
+        if ( node.count > 0 )
+        {
+            if ( leafFunc( node.offset, node.count, tMax ) )
+            {
+                hit = true;
+                if ( AnyHit )
+                { return true; }
+            }
+        }
+        else
+        {
+            auto left  = index + 1;
+            auto right = node.offset;
+
+            f32 tLeft, tRight;
+            auto hitLeft  = IntersectBox( pNodes[left ].mini, pNodes[left ].maxi, ray, tMax, tLeft  );
+            auto hitRight = IntersectBox( pNodes[right].mini, pNodes[right].maxi, ray, tMax, tRight );
+
+            if ( hitLeft && hitRight )
+            {
+                if ( tRight < tLeft )
+                {
+                    std::swap( left, right );
+                    std::swap( tLeft, tRight );
+                }
+
+                stackIndex[top] = right;
+                stackDist [top] = tRight;
+                top++;
+                index = left;
+                continue;
+            }
+            else if ( hitLeft )
+            {
+                index = left;
+                continue;
+            }
+            else if ( hitRight )
+            {
+                index = right;
+                continue;
+            }
+        }
+
+        // 既に見つかった交点より遠いノードは飛ばす.
+        for( ;; )
+        {
+            if ( top == 0 )
+            { return hit; }
+
+            top--;
+            if ( stackDist[top] <= tMax )
+            {
+                index = stackIndex[top];
+                break;
+            }
+        }
+    }
+}
+
+} // namespace /* anonymous */
+
+
+namespace asdx {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Bvh class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------------
+Bvh::Bvh()
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------------
+Bvh::~Bvh()
+{ Term(); }
+
+//-------------------------------------------------------------------------------------------------
+//      BVHを構築します.
+//-------------------------------------------------------------------------------------------------
+bool Bvh::Build( const BoundingBox* pBoxes, u32 count )
+{
+    Term();
+
+    if ( pBoxes == nullptr || count == 0 )
+    { return false; }
+
+    BuildTree( pBoxes, count, m_Nodes, m_Indices );
+
+    m_Boxes.resize( count );
+    for( u32 i=0; i<count; ++i )
+    { m_Boxes[i] = pBoxes[m_Indices[i]]; }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ノードのバウンディングボックスを更新します.
+//-------------------------------------------------------------------------------------------------
+void Bvh::Refit( const BoundingBox* pBoxes )
+{
+    assert( pBoxes != nullptr || m_Boxes.empty() );
+
+    for( size_t i=0; i<m_Boxes.size(); ++i )
+    { m_Boxes[i] = pBoxes[m_Indices[i]]; }
+
+    RefitTree( m_Nodes, [&]( u32 first, u32 count )
+    {
+        BoundingBox box;
+        for( auto i=first; i<first + count; ++i )
+        { box = BoundingBox::Merge( box, m_Boxes[i] ); }
+        return box;
+    });
+}
+
+//-------------------------------------------------------------------------------------------------
+//      終了処理を行います.
+//-------------------------------------------------------------------------------------------------
+void Bvh::Term()
+{
+    m_Nodes  .clear();
+    m_Indices.clear();
+    m_Boxes  .clear();
+}
+
+//-------------------------------------------------------------------------------------------------
+//      レイと最も近いバウンディングボックスを求めます.
+//-------------------------------------------------------------------------------------------------
+bool Bvh::Intersect( const Ray& ray, RayHit* pHit, f32 maxDistance ) const
+{
+    RayHit result = {};
+
+    // 始点がボックス内にある場合は距離0で交差します.
+    auto hit = Traverse<false>( m_Nodes, ray, maxDistance, [&]( u32 first, u32 count, f32& tMax )
+    {
+        auto found = false;
+        for( auto i=first; i<first + count; ++i )
+        {
+            f32 t;
+            if ( IntersectBox( m_Boxes[i].mini, m_Boxes[i].maxi, ray, tMax, t ) && t < tMax )
+            {
+                tMax            = t;
+                result.distance = t;
+                result.index    = m_Indices[i];
+                found           = true;
+            }
+        }
+        return found;
+    });
+
+    if ( hit && pHit != nullptr )
+    { *pHit = result; }
+
+    return hit;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      レイがいずれかのバウンディングボックスと交差するか判定します.
+//-------------------------------------------------------------------------------------------------
+bool Bvh::IntersectAny( const Ray& ray, f32 maxDistance ) const
+{
+    return Traverse<true>( m_Nodes, ray, maxDistance, [&]( u32 first, u32 count, f32& )
+    {
+        for( auto i=first; i<first + count; ++i )
+        {
+            f32 t;
+            if ( IntersectBox( m_Boxes[i].mini, m_Boxes[i].maxi, ray, maxDistance, t ) )
+            { return true; }
+        }
+        return false;
+    });
+}
+
+//-------------------------------------------------------------------------------------------------
+//      全体のバウンディングボックスを取得します.
+//-------------------------------------------------------------------------------------------------
+BoundingBox Bvh::GetBounds() const
+{
+    if ( m_Nodes.empty() )
+    { return BoundingBox(); }
+
+    return BoundingBox( m_Nodes[0].mini, m_Nodes[0].maxi );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ノードの配列を取得します.
+//-------------------------------------------------------------------------------------------------
+const BvhNode* Bvh::GetNodes() const
+{ return m_Nodes.data(); }
+
+//-------------------------------------------------------------------------------------------------
+//      ノード数を取得します.
+//-------------------------------------------------------------------------------------------------
+u32 Bvh::GetNodeCount() const
+{ return u32( m_Nodes.size() ); }
+
+//-------------------------------------------------------------------------------------------------
+//      葉ノードの並びにおけるプリミティブ番号の配列を取得します.
+//-------------------------------------------------------------------------------------------------
+const u32* Bvh::GetIndices() const
+{ return m_Indices.data(); }
+
+//-------------------------------------------------------------------------------------------------
+//      プリミティブ数を取得します.
+//-------------------------------------------------------------------------------------------------
+u32 Bvh::GetPrimitiveCount() const
+{ return u32( m_Indices.size() ); }
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TriangleBvh class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------------
+TriangleBvh::TriangleBvh()
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------------
+TriangleBvh::~TriangleBvh()
+{ Term(); }
+
+//-------------------------------------------------------------------------------------------------
+//      三角形リストからBVHを構築します.
+//-------------------------------------------------------------------------------------------------
+bool TriangleBvh::Build
+(
+    const Vector3*  pPositions,
+    u32             vertexCount,
+    const u32*      pIndices,
+    u32             indexCount
+)
+{
+    Term();
+
+    auto triangleCount = indexCount / 3;
+    if ( pPositions == nullptr || pIndices == nullptr || triangleCount == 0 )
+    { return false; }
+
+    std::vector<BoundingBox> boxes( triangleCount );
+    for( u32 i=0; i<triangleCount; ++i )
+    {
+        auto i0 = pIndices[i * 3 + 0];
+        auto i1 = pIndices[i * 3 + 1];
+        auto i2 = pIndices[i * 3 + 2];
+        if ( i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount )
+        { return false; }
+
+        auto& box = boxes[i];
+        box.mini = Vector3::Min( pPositions[i0], Vector3::Min( pPositions[i1], pPositions[i2] ) );
+        box.maxi = Vector3::Max( pPositions[i0], Vector3::Max( pPositions[i1], pPositions[i2] ) );
+    }
+
+    BuildTree( boxes.data(), triangleCount, m_Nodes, m_Indices );
+
+    m_VertexIndices.resize( triangleCount * 3 );
+    m_Vertices     .resize( triangleCount * 3 );
+    for( u32 i=0; i<triangleCount; ++i )
+    {
+        for( u32 j=0; j<3; ++j )
+        {
+            auto index = pIndices[m_Indices[i] * 3 + j];
+            m_VertexIndices[i * 3 + j] = index;
+            m_Vertices     [i * 3 + j] = pPositions[index];
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      メッシュリソースからBVHを構築します.
+//-------------------------------------------------------------------------------------------------
+bool TriangleBvh::Build( const ResMesh& mesh )
+{
+    return Build(
+        mesh.Positions.data(),
+        u32( mesh.Positions.size() ),
+        mesh.VertexIndices.data(),
+        u32( mesh.VertexIndices.size() ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      頂点位置を更新します.
+//-------------------------------------------------------------------------------------------------
+void TriangleBvh::Refit( const Vector3* pPositions )
+{
+    assert( pPositions != nullptr || m_Vertices.empty() );
+
+    for( size_t i=0; i<m_Vertices.size(); ++i )
+    { m_Vertices[i] = pPositions[m_VertexIndices[i]]; }
+
+    RefitTree( m_Nodes, [&]( u32 first, u32 count )
+    {
+        BoundingBox box;
+        for( auto i=first * 3; i<( first + count ) * 3; ++i )
+        { box.Merge( m_Vertices[i] ); }
+        return box;
+    });
+}
+
+//-------------------------------------------------------------------------------------------------
+//      終了処理を行います.
+//-------------------------------------------------------------------------------------------------
+void TriangleBvh::Term()
+{
+    m_Nodes        .clear();
+    m_Indices      .clear();
+    m_VertexIndices.clear();
+    m_Vertices     .clear();
+}
+
+//-------------------------------------------------------------------------------------------------
+//      レイと最も近い三角形を求めます.
+//-------------------------------------------------------------------------------------------------
+bool TriangleBvh::Intersect( const Ray& ray, RayHit* pHit, f32 maxDistance ) const
+{
+    RayHit result = {};
+
+    auto hit = Traverse<false>( m_Nodes, ray, maxDistance, [&]( u32 first, u32 count, f32& tMax )
+    {
+        auto found = false;
+        for( auto i=first; i<first + count; ++i )
+        {
+            f32 t, u, v;
+            if ( IntersectTriangle( ray, m_Vertices[i * 3 + 0], m_Vertices[i * 3 + 1], m_Vertices[i * 3 + 2], tMax, t, u, v ) )
+            {
+                tMax            = t;
+                result.distance = t;
+                result.index    = m_Indices[i];
+                result.u        = u;
+                result.v        = v;
+                found           = true;
+            }
+        }
+        return found;
+    });
+
+    if ( hit && pHit != nullptr )
+    { *pHit = result; }
+
+    return hit;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      レイがいずれかの三角形と交差するか判定します.
+//-------------------------------------------------------------------------------------------------
+bool TriangleBvh::IntersectAny( const Ray& ray, f32 maxDistance ) const
+{
+    return Traverse<true>( m_Nodes, ray, maxDistance, [&]( u32 first, u32 count, f32& tMax )
+    {
+        for( auto i=first; i<first + count; ++i )
+        {
+            f32 t, u, v;
+            if ( IntersectTriangle( ray, m_Vertices[i * 3 + 0], m_Vertices[i * 3 + 1], m_Vertices[i * 3 + 2], tMax, t, u, v ) )
+            { return true; }
+        }
+        return false;
+    });
+}
+
+//-------------------------------------------------------------------------------------------------
+//      全体のバウンディングボックスを取得します.
+//-------------------------------------------------------------------------------------------------
+BoundingBox TriangleBvh::GetBounds() const
+{
+    if ( m_Nodes.empty() )
+    { return BoundingBox(); }
+
+    return BoundingBox( m_Nodes[0].mini, m_Nodes[0].maxi );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ノードの配列を取得します.
+//-------------------------------------------------------------------------------------------------
+const BvhNode* TriangleBvh::GetNodes() const
+{ return m_Nodes.data(); }
+
+//-------------------------------------------------------------------------------------------------
+//      ノード数を取得します.
+//-------------------------------------------------------------------------------------------------
+u32 TriangleBvh::GetNodeCount() const
+{ return u32( m_Nodes.size() ); }
+
+//-------------------------------------------------------------------------------------------------
+//      三角形数を取得します.
+//-------------------------------------------------------------------------------------------------
+u32 TriangleBvh::GetTriangleCount() const
+{ return u32( m_Indices.size() ); }
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Ray-Triangle Functions
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      1本のレイと三角形リストの交差判定を行います.
+//-------------------------------------------------------------------------------------------------
+bool IntersectTriangles
+(
+    const Ray&      ray,
+    const Vector3*  pPositions,
+    const u32*      pIndices,
+    u32             triangleCount,
+    RayHit*         pHit,
+    f32             maxDistance
+)
+{
+    assert( ( pPositions != nullptr && pIndices != nullptr ) || triangleCount == 0 );
+
+    const f32 r[6] = { ray.pos.x, ray.pos.y, ray.pos.z, ray.dir.x, ray.dir.y, ray.dir.z };
+
+    auto src    = reinterpret_cast<const f32*>( pPositions );
+    auto kernel = wide::GetKernelTable().IntersectTriangles;
+
+    // ブロックごとに最も近い交点を求めてから, ブロック順に選ぶ.
+    struct Result
+    {
+        f32 hit[3];
+        u32 index;
+    };
+
+    const auto blockCount = ( triangleCount + wide::PARALLEL_GRAIN - 1 ) / wide::PARALLEL_GRAIN;
+    std::vector<Result> results( ( blockCount > 0 ) ? blockCount : 1 );
+    for( auto& result : results )
+    {
+        result.hit[0] = maxDistance;
+        result.hit[1] = 0.0f;
+        result.hit[2] = 0.0f;
+        result.index  = U32_MAX;
+    }
+
+    wide::ParallelFor( triangleCount, wide::PARALLEL_GRAIN, [&]( u32 begin, u32 end )
+    {
+        auto& result = results[begin / wide::PARALLEL_GRAIN];
+        kernel( r, src, pIndices, begin, end, result.hit, &result.index );
+    });
+
+    const Result* pBest = nullptr;
+    for( const auto& result : results )
+    {
+        if ( result.index != U32_MAX && ( pBest == nullptr || result.hit[0] < pBest->hit[0] ) )
+        { pBest = &result; }
+    }
+
+    if ( pBest == nullptr )
+    { return false; }
+
+    if ( pHit != nullptr )
+    {
+        pHit->distance = pBest->hit[0];
+        pHit->index    = pBest->index;
+        pHit->u        = pBest->hit[1];
+        pHit->v        = pBest->hit[2];
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      1本のレイとメッシュリソースの交差判定を行います.
+//-------------------------------------------------------------------------------------------------
+bool IntersectTriangles( const Ray& ray, const ResMesh& mesh, RayHit* pHit, f32 maxDistance )
+{
+    return IntersectTriangles(
+        ray,
+        mesh.Positions.data(),
+        mesh.VertexIndices.data(),
+        u32( mesh.VertexIndices.size() / 3 ),
+        pHit,
+        maxDistance );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      複数のレイと三角形リストの交差判定をまとめて行います.
+//-------------------------------------------------------------------------------------------------
+u32 IntersectTrianglesPacket
+(
+    const Ray*      pRays,
+    u32             rayCount,
+    const Vector3*  pPositions,
+    const u32*      pIndices,
+    u32             triangleCount,
+    RayHit*         pHits,
+    f32             maxDistance
+)
+{
+    assert( ( pRays != nullptr && pHits != nullptr ) || rayCount == 0 );
+    assert( ( pPositions != nullptr && pIndices != nullptr ) || triangleCount == 0 );
+
+    auto src    = reinterpret_cast<const f32*>( pPositions );
+    auto kernel = wide::GetKernelTable().IntersectPacket;
+
+    wide::ParallelFor( rayCount, PACKET_CHUNK, [&]( u32 begin, u32 end )
+    {
+        f32 rays [6 * PACKET_CHUNK];
+        f32 hits [3 * PACKET_CHUNK];
+        u32 index[PACKET_CHUNK];
+
+        for( auto chunk=begin; chunk<end; chunk += PACKET_CHUNK )
+        {
+            auto count = ( end - chunk < PACKET_CHUNK ) ? end - chunk : PACKET_CHUNK;
+
+            for( u32 i=0; i<count; ++i )
+            {
+                const auto& ray = pRays[chunk + i];
+                rays[0 * PACKET_CHUNK + i] = ray.pos.x;
+                rays[1 * PACKET_CHUNK + i] = ray.pos.y;
+                rays[2 * PACKET_CHUNK + i] = ray.pos.z;
+                rays[3 * PACKET_CHUNK + i] = ray.dir.x;
+                rays[4 * PACKET_CHUNK + i] = ray.dir.y;
+                rays[5 * PACKET_CHUNK + i] = ray.dir.z;
+
+                hits[0 * PACKET_CHUNK + i] = maxDistance;
+                hits[1 * PACKET_CHUNK + i] = 0.0f;
+                hits[2 * PACKET_CHUNK + i] = 0.0f;
+                index[i] = U32_MAX;
+            }
+
+            // 三角形をブロックに分け, ブロックの頂点がキャッシュにある間に全パケットを判定する.
+            for( u32 tri=0; tri<triangleCount; tri += TRIANGLE_BLOCK )
+            {
+                auto triEnd = ( triangleCount - tri < TRIANGLE_BLOCK ) ? triangleCount : tri + TRIANGLE_BLOCK;
+                kernel( rays, PACKET_CHUNK, 0, count, src, pIndices, tri, triEnd, hits, index );
+            }
+
+            for( u32 i=0; i<count; ++i )
+            {
+                auto& hit = pHits[chunk + i];
+                hit.distance = hits[0 * PACKET_CHUNK + i];
+                hit.index    = index[i];
+                hit.u        = hits[1 * PACKET_CHUNK + i];
+                hit.v        = hits[2 * PACKET_CHUNK + i];
+            }
+        }
+    });
+
+    u32 hitCount = 0;
+    for( u32 i=0; i<rayCount; ++i )
+    { hitCount += ( pHits[i].index != U32_MAX ) ? 1 : 0; }
+
+    return hitCount;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      複数のレイとメッシュリソースの交差判定をまとめて行います.
+//-------------------------------------------------------------------------------------------------
+u32 IntersectTrianglesPacket
+(
+    const Ray*      pRays,
+    u32             rayCount,
+    const ResMesh&  mesh,
+    RayHit*         pHits,
+    f32             maxDistance
+)
+{
+    return IntersectTrianglesPacket(
+        pRays,
+        rayCount,
+        mesh.Positions.data(),
+        mesh.VertexIndices.data(),
+        u32( mesh.VertexIndices.size() / 3 ),
+        pHits,
+        maxDistance );
+}
+
+} // namespace asdx
@@ -0,0 +1,298 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxCpuInfo.cpp
+// Desc : CPU Feature Detection and SIMD Tier Selection.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxCpuInfo.h>
+#include "kernels/asdxKernelTable.h"
+#include <atomic>
+#include <cassert>
+#include <cstring>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+    #define ASDX_IS_X86     (1)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#else
+    #define ASDX_IS_X86     (0)
+#endif
+
+#if defined(__linux__) && defined(__aarch64__)
+    #include <sys/auxv.h>
+    #include <asm/hwcap.h>
+#endif
+
+
+namespace /* anonymous */ {
+
+using namespace asdx;
+using namespace asdx::wide;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TierEntry structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct TierEntry
+{
+    SimdTier    Tier;                           //!< 段階.
+    const char* Name;                           //!< 名前.
+    const KernelTable* (*GetTable)();           //!< カーネルテーブル取得関数.
+};
+
+//-------------------------------------------------------------------------------------------------
+//      段階の一覧です. 上位の段階から順に並べます.
+//-------------------------------------------------------------------------------------------------
+static const TierEntry TIER_ENTRIES[] = {
+    { SimdTier::AVX512, "AVX-512", GetKernelTableAvx512 },
+    { SimdTier::AVX2,   "AVX2",    GetKernelTableAvx2   },
+    { SimdTier::SSE4_1, "SSE4.1",  GetKernelTableSse41  },
+    { SimdTier::SSE2,   "SSE2",    GetKernelTableSse2   },
+    { SimdTier::NEON,   "NEON",    GetKernelTableSse2   },
+    { SimdTier::Scalar, "Scalar",  GetKernelTableScalar },
+};
+
+//-------------------------------------------------------------------------------------------------
+// Global Variables
+//-------------------------------------------------------------------------------------------------
+std::atomic<const KernelTable*>     g_pKernelTable( nullptr );
+std::atomic<u32>                    g_ActiveTier( u32( SimdTier::Scalar ) );
+
+
+#if ASDX_IS_X86
+//-------------------------------------------------------------------------------------------------
+//      CPUID命令を実行します.
+//-------------------------------------------------------------------------------------------------
+void CpuId( u32 leaf, u32 subLeaf, u32 regs[4] )
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuidex( info, s32( leaf ), s32( subLeaf ) );
+    for( auto i=0; i<4; ++i )
+    { regs[i] = u32( info[i] ); }
+#else
+    __cpuid_count( leaf, subLeaf, regs[0], regs[1], regs[2], regs[3] );
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+//      OSが退避するレジスタ状態(XCR0)を取得します.
+//-------------------------------------------------------------------------------------------------
+u64 GetXCR0()
+{
+#if defined(_MSC_VER)
+    return u64( _xgetbv( 0 ) );
+#else
+    u32 lo, hi;
+    __asm__ __volatile__( "xgetbv" : "=a"(lo), "=d"(hi) : "c"(0) );
+    return ( u64( hi ) << 32 ) | lo;
+#endif
+}
+#endif//ASDX_IS_X86
+
+//-------------------------------------------------------------------------------------------------
+//      対応命令セットを判定します.
+//-------------------------------------------------------------------------------------------------
+CpuFeature DetectCpuFeature()
+{
+    CpuFeature result;
+    memset( &result, 0, sizeof(result) );
+
+#if ASDX_IS_X86
+    u32 regs[4];
+    CpuId( 0, 0, regs );
+    const auto maxLeaf = regs[0];
+    if ( maxLeaf < 1 )
+    { return result; }
+
+    CpuId( 1, 0, regs );
+    const auto ecx1 = regs[2];
+    const auto edx1 = regs[3];
+
+    result.SSE2   = ( edx1 & ( 1u << 26 ) ) != 0;
+    result.SSE4_1 = ( ecx1 & ( 1u << 19 ) ) != 0;
+    result.SSE4_2 = ( ecx1 & ( 1u << 20 ) ) != 0;
+    result.POPCNT = ( ecx1 & ( 1u << 23 ) ) != 0;
+    result.PCLMUL = ( ecx1 & ( 1u <<  1 ) ) != 0;
+
+    // AVX以降はOSがYMM/ZMMレジスタを退避していることも確認する.
+    const auto osxsave = ( ecx1 & ( 1u << 27 ) ) != 0;
+    const auto xcr0    = osxsave ? GetXCR0() : 0;
+    const auto osYmm   = ( xcr0 & 0x06 ) == 0x06;     // XMM, YMM.
+    const auto osZmm   = ( xcr0 & 0xe6 ) == 0xe6;     // XMM, YMM, opmask, ZMM.
+
+    result.AVX  = osYmm && ( ecx1 & ( 1u << 28 ) ) != 0;
+    result.FMA  = result.AVX && ( ecx1 & ( 1u << 12 ) ) != 0;
+    result.F16C = result.AVX && ( ecx1 & ( 1u << 29 ) ) != 0;
+
+    if ( maxLeaf >= 7 )
+    {
+        CpuId( 7, 0, regs );
+        const auto ebx7 = regs[1];
+        result.AVX2    = result.AVX && ( ebx7 & ( 1u <<  5 ) ) != 0;
+        result.AVX512F = result.AVX && osZmm && ( ebx7 & ( 1u << 16 ) ) != 0;
+    }
+#elif ASDX_IS_NEON
+    result.NEON = true;
+
+    // Windows on ARM はCRC32命令を必須とする.
+  #if defined(_M_ARM64) || defined(__ARM_FEATURE_CRC32)
+    result.CRC32 = true;
+  #elif defined(__linux__) && defined(__aarch64__)
+    result.CRC32 = ( getauxval( AT_HWCAP ) & HWCAP_CRC32 ) != 0;
+  #endif
+#endif
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      CPUが段階に対応しているかどうかチェックします.
+//-------------------------------------------------------------------------------------------------
+bool IsSupported( const CpuFeature& feature, SimdTier tier )
+{
+    switch( tier )
+    {
+    case SimdTier::Scalar:  return true;
+    case SimdTier::SSE2:    return feature.SSE2;
+    case SimdTier::SSE4_1:  return feature.SSE2 && feature.SSE4_1;
+    case SimdTier::AVX2:    return feature.AVX2 && feature.F16C;
+    case SimdTier::AVX512:  return feature.AVX2 && feature.F16C && feature.AVX512F;
+    case SimdTier::NEON:    return feature.NEON;
+    }
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      段階の順位を求めます. NEONはSSE2と同順位です.
+//-------------------------------------------------------------------------------------------------
+u32 GetRank( SimdTier tier )
+{
+    switch( tier )
+    {
+    case SimdTier::Scalar:  return 0;
+    case SimdTier::SSE2:    return 1;
+    case SimdTier::NEON:    return 1;
+    case SimdTier::SSE4_1:  return 2;
+    case SimdTier::AVX2:    return 3;
+    case SimdTier::AVX512:  return 4;
+    }
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      上限以下で利用可能な最上位の段階を選択し, 有効にします.
+//-------------------------------------------------------------------------------------------------
+SimdTier SelectTier( u32 limitRank )
+{
+    const auto& feature = GetCpuFeature();
+
+    for( auto& entry : TIER_ENTRIES )
+    {
+        if ( GetRank( entry.Tier ) > limitRank || !IsSupported( feature, entry.Tier ) )
+        { continue; }
+
+        auto pTable = entry.GetTable();
+        if ( pTable == nullptr )
+        { continue; }
+
+        g_ActiveTier.store( u32( entry.Tier ) );
+        g_pKernelTable.store( pTable );
+        return entry.Tier;
+    }
+
+    // スカラー版は常に存在するため, ここには到達しない.
+    assert( false );
+    return SimdTier::Scalar;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      カーネルテーブルを初期化します.
+//-------------------------------------------------------------------------------------------------
+const KernelTable* InitKernelTable()
+{
+    // 複数スレッドから同時に呼ばれても同じ結果を書き込むだけなので排他は不要.
+    SelectTier( GetRank( SimdTier::AVX512 ) );
+    return g_pKernelTable.load();
+}
+
+} // namespace /* anonymous */
+
+
+namespace asdx {
+
+//-------------------------------------------------------------------------------------------------
+//      CPUの対応命令セットを取得します.
+//-------------------------------------------------------------------------------------------------
+const CpuFeature& GetCpuFeature()
+{
+    static const CpuFeature s_Feature = DetectCpuFeature();
+    return s_Feature;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      CPUとビルド設定の双方が対応している最上位のSIMD段階を取得します.
+//-------------------------------------------------------------------------------------------------
+SimdTier GetSupportedSimdTier()
+{
+    const auto& feature = GetCpuFeature();
+
+    for( auto& entry : TIER_ENTRIES )
+    {
+        if ( IsSupported( feature, entry.Tier ) && entry.GetTable() != nullptr )
+        { return entry.Tier; }
+    }
+
+    return SimdTier::Scalar;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      バッチ演算カーネルが現在使用しているSIMD段階を取得します.
+//-------------------------------------------------------------------------------------------------
+SimdTier GetActiveSimdTier()
+{
+    wide::GetKernelTable();
+    return SimdTier( g_ActiveTier.load() );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      バッチ演算カーネルが使用するSIMD段階の上限を設定します.
+//-------------------------------------------------------------------------------------------------
+SimdTier SetSimdTierLimit( SimdTier limit )
+{ return SelectTier( GetRank( limit ) ); }
+
+//-------------------------------------------------------------------------------------------------
+//      SIMD段階の名前を取得します.
+//-------------------------------------------------------------------------------------------------
+const char* GetSimdTierName( SimdTier tier )
+{
+    for( auto& entry : TIER_ENTRIES )
+    {
+        if ( entry.Tier == tier )
+        { return entry.Name; }
+    }
+
+    return "Unknown";
+}
+
+namespace wide {
+
+//-------------------------------------------------------------------------------------------------
+//      現在有効なカーネルテーブルを取得します.
+//-------------------------------------------------------------------------------------------------
+const KernelTable& GetKernelTable()
+{
+    auto pTable = g_pKernelTable.load();
+    if ( pTable == nullptr )
+    { pTable = InitKernelTable(); }
+
+    return *pTable;
+}
+
+} // namespace wide
+} // namespace asdx
@@ -0,0 +1,320 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxGeometryBatch.cpp
+// Desc : Batch Geometry Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxGeometry.h>
+#include "kernels/asdxKernelTable.h"
+#include "kernels/asdxParallel.h"
+#include <vector>
+
+
+namespace /* anonymous */ {
+
+using namespace asdx;
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const u32 SPHERE_REFINE_COUNT = 8;       //!< バウンディングスフィアを縮めて広げ直す回数です.
+static const f32 SPHERE_SHRINK_RATIO = 0.95f;   //!< 広げ直す前に半径に掛ける値です.
+
+static_assert( sizeof(Vector3) == sizeof(f32) * 3, "Vector3 must be tightly packed." );
+static_assert( sizeof(Vector4) == sizeof(f32) * 4, "Vector4 must be tightly packed." );
+static_assert( sizeof(Matrix)  == sizeof(f32) * 16, "Matrix must be tightly packed." );
+static_assert( sizeof(BoundingBox) == sizeof(f32) * 6, "BoundingBox must be tightly packed." );
+static_assert( wide::PARALLEL_GRAIN % 32 == 0, "Parallel grain must be a multiple of the mask word size." );
+
+//-------------------------------------------------------------------------------------------------
+//      点 position を通り, 法線が normal の平面を正規化して返却します.
+//-------------------------------------------------------------------------------------------------
+Vector4 MakePlane( const Vector3& normal, const Vector3& position, f32 offset )
+{
+    auto invLen = 1.0f / normal.Length();
+    auto d      = offset - Vector3::Dot( normal, position );
+    return Vector4( normal.x * invLen, normal.y * invLen, normal.z * invLen, d * invLen );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      区間を PARALLEL_GRAIN ごとのブロックに分けて処理します.
+//      スレッド数によらずブロックの分け方が同じになるため, 結果は常に一致します.
+//-------------------------------------------------------------------------------------------------
+template<typename Func>
+void ForEachBlock( u32 count, const Func& func )
+{
+    wide::ParallelFor( count, wide::PARALLEL_GRAIN, [&]( u32 begin, u32 end )
+    {
+        for( auto i=begin; i<end; i += wide::PARALLEL_GRAIN )
+        {
+            auto last = ( end - i < wide::PARALLEL_GRAIN ) ? end : i + wide::PARALLEL_GRAIN;
+            func( i / wide::PARALLEL_GRAIN, i, last );
+        }
+    });
+}
+
+//-------------------------------------------------------------------------------------------------
+//      点群のバウンディングボックスを求めます.
+//      pIndices が nullptr の場合は pPoints を先頭から count 個処理します.
+//-------------------------------------------------------------------------------------------------
+BoundingBox CalcBoundingBox( const Vector3* pPoints, const u32* pIndices, u32 count )
+{
+    const auto blockCount = ( count + wide::PARALLEL_GRAIN - 1 ) / wide::PARALLEL_GRAIN;
+    std::vector<BoundingBox> boxes( blockCount );
+
+    auto src = reinterpret_cast<const f32*>( pPoints );
+    const auto& table = wide::GetKernelTable();
+
+    ForEachBlock( count, [&]( u32 block, u32 begin, u32 end )
+    {
+        auto minmax = &boxes[block].mini.x;
+        if ( pIndices == nullptr )
+        { table.BoundsArray3( src, begin, end, minmax ); }
+        else
+        { table.BoundsIndexed3( src, pIndices, begin, end, minmax ); }
+    });
+
+    BoundingBox result;
+    for( const auto& box : boxes )
+    { result = BoundingBox::Merge( result, box ); }
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      点群を順に含むようにバウンディングスフィアを広げます.
+//      ブロックごとに広げたスフィアをブロック順にマージします.
+//-------------------------------------------------------------------------------------------------
+BoundingSphere GrowBoundingSphere
+(
+    const Vector3*          pPoints,
+    const u32*              pIndices,
+    u32                     count,
+    const BoundingSphere&   sphere
+)
+{
+    const auto blockCount = ( count + wide::PARALLEL_GRAIN - 1 ) / wide::PARALLEL_GRAIN;
+    std::vector<BoundingSphere> spheres( blockCount, sphere );
+
+    auto src    = reinterpret_cast<const f32*>( pPoints );
+    auto kernel = wide::GetKernelTable().GrowSphere3;
+
+    ForEachBlock( count, [&]( u32 block, u32 begin, u32 end )
+    { kernel( src, pIndices, begin, end, &spheres[block].center.x ); });
+
+    auto result = sphere;
+    for( u32 i=0; i<blockCount; ++i )
+    { result = ( i == 0 ) ? spheres[i] : BoundingSphere::Merge( result, spheres[i] ); }
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      中心を変えずに, 点群を含む最小の半径にします.
+//-------------------------------------------------------------------------------------------------
+BoundingSphere FitBoundingSphere
+(
+    const Vector3*  pPoints,
+    const u32*      pIndices,
+    u32             count,
+    const Vector3&  center
+)
+{
+    const auto blockCount = ( count + wide::PARALLEL_GRAIN - 1 ) / wide::PARALLEL_GRAIN;
+    std::vector<f32> distSq( blockCount, 0.0f );
+
+    auto src    = reinterpret_cast<const f32*>( pPoints );
+    auto kernel = wide::GetKernelTable().MaxDistanceSq3;
+
+    ForEachBlock( count, [&]( u32 block, u32 begin, u32 end )
+    { kernel( src, pIndices, begin, end, &center.x, &distSq[block] ); });
+
+    auto maxDistSq = 0.0f;
+    for( auto value : distSq )
+    { maxDistSq = Max( maxDistSq, value ); }
+
+    // 平方根の丸めで最も遠い点が外に出ないようにする.
+    auto radius = sqrtf( maxDistSq );
+    if ( radius * radius < maxDistSq )
+    { radius = nextafterf( radius, F32_MAX ); }
+
+    return BoundingSphere( center, radius );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      点群のバウンディングスフィアを求めます.
+//      pIndices が nullptr の場合は pPoints を先頭から count 個処理します.
+//-------------------------------------------------------------------------------------------------
+BoundingSphere CalcBoundingSphere( const Vector3* pPoints, const u32* pIndices, u32 count )
+{
+    if ( count == 0 )
+    { return BoundingSphere( Vector3( 0.0f, 0.0f, 0.0f ), 0.0f ); }
+
+    // ボックスの中心を候補とする. 最小のスフィアの半径はボックスの最も長い辺の半分以上なので,
+    // Ritter の方法はこれを初期値として広げる.
+    auto box    = CalcBoundingBox( pPoints, pIndices, count );
+    auto size   = box.maxi - box.mini;
+    auto radius = Max( size.x, Max( size.y, size.z ) ) * 0.5f;
+    auto result = FitBoundingSphere( pPoints, pIndices, count, box.GetCenter() );
+
+    // 広げたスフィアは中心を保ったまま半径を詰め, 小さくなったものを採用する.
+    // 2回目以降は半径を縮めてから広げ直す.
+    BoundingSphere trial( box.GetCenter(), radius );
+    for( u32 i=0; i<=SPHERE_REFINE_COUNT; ++i )
+    {
+        trial = GrowBoundingSphere( pPoints, pIndices, count, trial );
+        trial = FitBoundingSphere ( pPoints, pIndices, count, trial.center );
+        if ( trial.radius < result.radius )
+        { result = trial; }
+
+        trial.radius *= SPHERE_SHRINK_RATIO;
+    }
+
+    return result;
+}
+
+} // namespace /* anonymous */
+
+
+namespace asdx {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// ViewFrustum class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      ワールド空間の6平面を取得します.
+//-------------------------------------------------------------------------------------------------
+void ViewFrustum::GetPlanes( Vector4* pPlanes ) const
+{
+    assert( pPlanes != nullptr );
+
+    // Contains( const Vector3& ) の判定式 near <= f <= far, |r| <= FactorR * f, |u| <= FactorU * f を
+    // 視点からの相対位置に対する半空間に書き直したもの.
+    pPlanes[0] = MakePlane(  m_Forward,                         m_Position, -m_NearClip );
+    pPlanes[1] = MakePlane( -m_Forward,                         m_Position,  m_FarClip  );
+    pPlanes[2] = MakePlane(  m_Right  + m_Forward * m_FactorR,  m_Position,  0.0f );
+    pPlanes[3] = MakePlane( -m_Right  + m_Forward * m_FactorR,  m_Position,  0.0f );
+    pPlanes[4] = MakePlane(  m_Upward + m_Forward * m_FactorU,  m_Position,  0.0f );
+    pPlanes[5] = MakePlane( -m_Upward + m_Forward * m_FactorU,  m_Position,  0.0f );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      バウンディングボックスの配列をまとめて判定します.
+//-------------------------------------------------------------------------------------------------
+void ViewFrustum::ContainsBoxStream
+(
+    const f32*  pCenterX,
+    const f32*  pCenterY,
+    const f32*  pCenterZ,
+    const f32*  pExtentX,
+    const f32*  pExtentY,
+    const f32*  pExtentZ,
+    u32         count,
+    u32*        pResults
+) const
+{
+    assert( pResults != nullptr || count == 0 );
+
+    Vector4 planes[6];
+    GetPlanes( planes );
+
+    auto kernel = wide::GetKernelTable().CullBoxStream;
+
+    wide::ParallelFor( count, wide::PARALLEL_GRAIN, [&]( u32 begin, u32 end )
+    { kernel( &planes[0].x, pCenterX, pCenterY, pCenterZ, pExtentX, pExtentY, pExtentZ, begin, end, pResults ); });
+}
+
+//-------------------------------------------------------------------------------------------------
+//      バウンディングスフィアの配列をまとめて判定します.
+//-------------------------------------------------------------------------------------------------
+void ViewFrustum::ContainsSphereStream
+(
+    const f32*  pCenterX,
+    const f32*  pCenterY,
+    const f32*  pCenterZ,
+    const f32*  pRadius,
+    u32         count,
+    u32*        pResults
+) const
+{
+    assert( pResults != nullptr || count == 0 );
+
+    Vector4 planes[6];
+    GetPlanes( planes );
+
+    auto kernel = wide::GetKernelTable().CullSphereStream;
+
+    wide::ParallelFor( count, wide::PARALLEL_GRAIN, [&]( u32 begin, u32 end )
+    { kernel( &planes[0].x, pCenterX, pCenterY, pCenterZ, pRadius, begin, end, pResults ); });
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// BoundingBox structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      点群を含むバウンディングボックスを求めます.
+//-------------------------------------------------------------------------------------------------
+BoundingBox BoundingBox::CreateFromPoints( const Vector3* pPoints, u32 count )
+{
+    assert( pPoints != nullptr || count == 0 );
+    return CalcBoundingBox( pPoints, nullptr, count );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      インデックスで指定した点群を含むバウンディングボックスを求めます.
+//-------------------------------------------------------------------------------------------------
+BoundingBox BoundingBox::CreateFromIndexedPoints( const Vector3* pPoints, const u32* pIndices, u32 indexCount )
+{
+    assert( ( pPoints != nullptr && pIndices != nullptr ) || indexCount == 0 );
+    return CalcBoundingBox( pPoints, pIndices, indexCount );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ボックスをそれぞれの行列で変換したものを含むバウンディングボックスを求めます.
+//-------------------------------------------------------------------------------------------------
+BoundingBox BoundingBox::CreateFromTransformedBoxes( const BoundingBox* pBoxes, const Matrix* pTransforms, u32 count )
+{
+    assert( ( pBoxes != nullptr && pTransforms != nullptr ) || count == 0 );
+
+    BoundingBox result;
+    if ( count == 0 )
+    { return result; }
+
+    // ボーン数程度の要素数を想定するため, スレッドには分配しない.
+    wide::GetKernelTable().MergeTransformedBoxes(
+        &pBoxes[0].mini.x, &pTransforms[0]._11, 0, count, &result.mini.x );
+
+    return result;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// BoundingSphere structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      点群を含むバウンディングスフィアを求めます.
+//-------------------------------------------------------------------------------------------------
+BoundingSphere BoundingSphere::CreateFromPoints( const Vector3* pPoints, u32 count )
+{
+    assert( pPoints != nullptr || count == 0 );
+    return CalcBoundingSphere( pPoints, nullptr, count );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      インデックスで指定した点群を含むバウンディングスフィアを求めます.
+//-------------------------------------------------------------------------------------------------
+BoundingSphere BoundingSphere::CreateFromIndexedPoints( const Vector3* pPoints, const u32* pIndices, u32 indexCount )
+{
+    assert( ( pPoints != nullptr && pIndices != nullptr ) || indexCount == 0 );
+    return CalcBoundingSphere( pPoints, pIndices, indexCount );
+}
+
+} // namespace asdx
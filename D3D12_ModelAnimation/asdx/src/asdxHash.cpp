@@ -8,11 +8,21 @@
 // Includes
 //-------------------------------------------------------------------------------------------------
 #include <asdxHash.h>
+#include <asdxCpuInfo.h>
+#include "kernels/asdxKernelTable.h"
+#include <cassert>
 #include <cstring>
+#include <cwchar>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
 
 
 namespace /* anonymous */ {
 
+using namespace asdx;
+
 //-------------------------------------------------------------------------------------------------
 // Constant Values.
 //-------------------------------------------------------------------------------------------------
@@ -86,6 +96,501 @@ const u32 CRC_TABLE[ 256 ] = {
 const u32 FNV_OFFSET_BASIS_32   = 2166136261;
 const u32 FNV_PRIME_32          = 16777619;
 
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// CrcSliceTable structure
+// 8バイト単位で処理するためのテーブルです(slicing-by-8).
+// Table[k][b] は値 b の後に k バイトの0が続く場合のCRCです.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct CrcSliceTable
+{
+    u32 Table[8][256];
+
+    CrcSliceTable()
+    {
+        for( u32 i=0; i<256; ++i )
+        { Table[0][i] = CRC_TABLE[i]; }
+
+        for( u32 k=1; k<8; ++k )
+        {
+            for( u32 i=0; i<256; ++i )
+            { Table[k][i] = ( Table[k - 1][i] >> 8 ) ^ CRC_TABLE[Table[k - 1][i] & 0xFF]; }
+        }
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+//      テーブルを用いてCRC32のレジスタ値を更新します.
+//-------------------------------------------------------------------------------------------------
+u32 UpdateCrc32Table( u32 crc, const u8* pBuffer, size_t size )
+{
+    static const CrcSliceTable s_Slice;
+    const auto& t = s_Slice.Table;
+
+    // バイト単位で組み立てるため, エンディアンによらず同じ結果になる.
+    for( ; size >= 8; size -= 8, pBuffer += 8 )
+    {
+        auto lo = crc ^ ( u32( pBuffer[0] ) | ( u32( pBuffer[1] ) << 8 ) | ( u32( pBuffer[2] ) << 16 ) | ( u32( pBuffer[3] ) << 24 ) );
+        auto hi =         u32( pBuffer[4] ) | ( u32( pBuffer[5] ) << 8 ) | ( u32( pBuffer[6] ) << 16 ) | ( u32( pBuffer[7] ) << 24 );
+
+        crc = t[7][ lo        & 0xFF] ^ t[6][( lo >>  8 ) & 0xFF]
+            ^ t[5][( lo >> 16 ) & 0xFF] ^ t[4][  lo >> 24        ]
+            ^ t[3][ hi        & 0xFF] ^ t[2][( hi >>  8 ) & 0xFF]
+            ^ t[1][( hi >> 16 ) & 0xFF] ^ t[0][  hi >> 24        ];
+    }
+
+    for( ; size > 0; --size, ++pBuffer )
+    { crc = CRC_TABLE[( crc ^ *pBuffer ) & 0xFF] ^ ( crc >> 8 ); }
+
+    return crc;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      現在使用できる命令セット固有のCRC32更新関数を取得します. 使用できない場合は nullptr を返却します.
+//-------------------------------------------------------------------------------------------------
+wide::Crc32Func GetActiveCrc32Func()
+{
+    static const auto s_Func = wide::GetCrc32Hardware();
+
+    const auto& feature = GetCpuFeature();
+    switch( GetActiveSimdTier() )
+    {
+    case SimdTier::SSE4_1:
+    case SimdTier::AVX2:
+    case SimdTier::AVX512:
+        return feature.PCLMUL ? s_Func : nullptr;
+
+    case SimdTier::NEON:
+        return feature.CRC32 ? s_Func : nullptr;
+
+    default:
+        return nullptr;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      CRC32のレジスタ値を更新します.
+//-------------------------------------------------------------------------------------------------
+u32 UpdateCrc32( u32 crc, const u8* pBuffer, size_t size )
+{
+    if ( size >= wide::CRC32_HARDWARE_MIN_SIZE )
+    {
+        auto func = GetActiveCrc32Func();
+        if ( func != nullptr )
+        {
+            auto count = size & ~size_t( wide::CRC32_HARDWARE_ALIGN - 1 );
+            crc      = func( crc, pBuffer, count );
+            pBuffer += count;
+            size    -= count;
+        }
+    }
+
+    return UpdateCrc32Table( crc, pBuffer, size );
+}
+
+//-------------------------------------------------------------------------------------------------
+// xxHash3
+// ※ Yann Collet, "xxHash - Extremely fast hash algorithm" (XXH3, v0.8) を参照.
+//-------------------------------------------------------------------------------------------------
+const u32 XXH3_SECRET_SIZE       = 192;  //!< 既定のシークレットのバイト数です.
+const u32 XXH3_MIDSIZE_MAX       = 240;  //!< ストライプ処理を行わない最大サイズです.
+const u32 XXH3_STRIPES_PER_BLOCK = ( XXH3_SECRET_SIZE - wide::XXH3_STRIPE_SIZE ) / wide::XXH3_SECRET_CONSUME_RATE;  //!< かき混ぜるまでのストライプ数です.
+const u32 XXH3_BLOCK_SIZE        = wide::XXH3_STRIPE_SIZE * XXH3_STRIPES_PER_BLOCK;                                //!< ブロックのバイト数です.
+
+const u32 XXH_PRIME32_1 = 0x9E3779B1U;
+const u32 XXH_PRIME32_2 = 0x85EBCA77U;
+const u32 XXH_PRIME32_3 = 0xC2B2AE3DU;
+const u64 XXH_PRIME64_1 = 0x9E3779B185EBCA87ULL;
+const u64 XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+const u64 XXH_PRIME64_3 = 0x165667B19E3779F9ULL;
+const u64 XXH_PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+const u64 XXH_PRIME64_5 = 0x27D4EB2F165667C5ULL;
+const u64 XXH_PRIME_MX1 = 0x165667919E3779F9ULL;
+const u64 XXH_PRIME_MX2 = 0x9FB21C651E98DF25ULL;
+
+const u64 XXH3_INIT_ACC[ wide::XXH3_ACC_COUNT ] = {
+    XXH_PRIME32_3, XXH_PRIME64_1, XXH_PRIME64_2, XXH_PRIME64_3,
+    XXH_PRIME64_4, XXH_PRIME32_2, XXH_PRIME64_5, XXH_PRIME32_1,
+};
+
+const u8 XXH3_SECRET[ XXH3_SECRET_SIZE ] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+//-------------------------------------------------------------------------------------------------
+//      リトルエンディアンの値を読み込みます.
+//-------------------------------------------------------------------------------------------------
+inline u32 Read32( const u8* p )
+{
+    u32 value;
+    memcpy( &value, p, sizeof(value) );
+    return value;
+}
+
+inline u64 Read64( const u8* p )
+{
+    u64 value;
+    memcpy( &value, p, sizeof(value) );
+    return value;
+}
+
+inline void Write64( u8* p, u64 value )
+{ memcpy( p, &value, sizeof(value) ); }
+
+//-------------------------------------------------------------------------------------------------
+//      ビット操作です.
+//-------------------------------------------------------------------------------------------------
+inline u32 Swap32( u32 x )
+{
+    return ( ( x << 24 ) & 0xff000000 ) | ( ( x <<  8 ) & 0x00ff0000 )
+         | ( ( x >>  8 ) & 0x0000ff00 ) | ( ( x >> 24 ) & 0x000000ff );
+}
+
+inline u64 Swap64( u64 x )
+{ return ( u64( Swap32( u32( x ) ) ) << 32 ) | Swap32( u32( x >> 32 ) ); }
+
+inline u32 Rotl32( u32 x, u32 r )
+{ return ( x << r ) | ( x >> ( 32 - r ) ); }
+
+inline u64 Rotl64( u64 x, u32 r )
+{ return ( x << r ) | ( x >> ( 64 - r ) ); }
+
+//-------------------------------------------------------------------------------------------------
+//      64ビット同士の積を128ビットで求めます.
+//-------------------------------------------------------------------------------------------------
+inline Hash128 Mul128( u64 a, u64 b )
+{
+    Hash128 result;
+#if defined(_MSC_VER) && defined(_M_X64)
+    result.Low = _umul128( a, b, &result.High );
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    result.Low  = a * b;
+    result.High = __umulh( a, b );
+#elif defined(__SIZEOF_INT128__)
+    auto product = static_cast<unsigned __int128>( a ) * b;
+    result.Low  = u64( product );
+    result.High = u64( product >> 64 );
+#else
+    auto lolo  = ( a & 0xFFFFFFFF ) * ( b & 0xFFFFFFFF );
+    auto hilo  = ( a >> 32 )        * ( b & 0xFFFFFFFF );
+    auto lohi  = ( a & 0xFFFFFFFF ) * ( b >> 32 );
+    auto hihi  = ( a >> 32 )        * ( b >> 32 );
+    auto cross = ( lolo >> 32 ) + ( hilo & 0xFFFFFFFF ) + lohi;
+    result.Low  = ( cross << 32 ) | ( lolo & 0xFFFFFFFF );
+    result.High = ( hilo >> 32 ) + ( cross >> 32 ) + hihi;
+#endif
+    return result;
+}
+
+inline u64 Mul128Fold64( u64 a, u64 b )
+{
+    auto product = Mul128( a, b );
+    return product.Low ^ product.High;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      最終的なビットの拡散です.
+//-------------------------------------------------------------------------------------------------
+inline u64 Xxh64Avalanche( u64 h )
+{
+    h ^= h >> 33;
+    h *= XXH_PRIME64_2;
+    h ^= h >> 29;
+    h *= XXH_PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+inline u64 Xxh3Avalanche( u64 h )
+{
+    h ^= h >> 37;
+    h *= XXH_PRIME_MX1;
+    h ^= h >> 32;
+    return h;
+}
+
+inline u64 Rrmxmx( u64 h, u64 size )
+{
+    h ^= Rotl64( h, 49 ) ^ Rotl64( h, 24 );
+    h *= XXH_PRIME_MX2;
+    h ^= ( h >> 35 ) + size;
+    h *= XXH_PRIME_MX2;
+    h ^= h >> 28;
+    return h;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      16バイトを混ぜ合わせます.
+//-------------------------------------------------------------------------------------------------
+inline u64 Mix16( const u8* p, const u8* pSecret, u64 seed )
+{
+    return Mul128Fold64(
+        Read64( p + 0 ) ^ ( Read64( pSecret + 0 ) + seed ),
+        Read64( p + 8 ) ^ ( Read64( pSecret + 8 ) - seed ) );
+}
+
+inline void Mix32( Hash128& acc, const u8* p0, const u8* p1, const u8* pSecret, u64 seed )
+{
+    acc.Low  += Mix16( p0, pSecret + 0,  seed );
+    acc.Low  ^= Read64( p1 ) + Read64( p1 + 8 );
+    acc.High += Mix16( p1, pSecret + 16, seed );
+    acc.High ^= Read64( p0 ) + Read64( p0 + 8 );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      シード値からシークレットを生成します.
+//-------------------------------------------------------------------------------------------------
+void InitSecret( u64 seed, u8* pSecret )
+{
+    for( u32 i=0; i<XXH3_SECRET_SIZE; i += 16 )
+    {
+        Write64( pSecret + i + 0, Read64( XXH3_SECRET + i + 0 ) + seed );
+        Write64( pSecret + i + 8, Read64( XXH3_SECRET + i + 8 ) - seed );
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      アキュムレータを64ビットにまとめます.
+//-------------------------------------------------------------------------------------------------
+u64 MergeAccs( const u64* pAcc, const u8* pSecret, u64 start )
+{
+    auto result = start;
+    for( u32 i=0; i<4; ++i )
+    {
+        result += Mul128Fold64(
+            pAcc[2 * i + 0] ^ Read64( pSecret + 16 * i + 0 ),
+            pAcc[2 * i + 1] ^ Read64( pSecret + 16 * i + 8 ) );
+    }
+    return Xxh3Avalanche( result );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      240バイトを超えるバッファのアキュムレータを求めます.
+//-------------------------------------------------------------------------------------------------
+void AccumulateLong( const u8* p, size_t size, const u8* pSecret, u64* pAcc )
+{
+    const auto& kernel = wide::GetKernelTable();
+    const auto  stripe = wide::XXH3_STRIPE_SIZE;
+
+    memcpy( pAcc, XXH3_INIT_ACC, sizeof(XXH3_INIT_ACC) );
+
+    // 最後の1バイトを含むストライプは別に処理する.
+    auto blocks = ( size - 1 ) / XXH3_BLOCK_SIZE;
+    for( size_t n=0; n<blocks; ++n )
+    {
+        kernel.Xxh3Accumulate( pAcc, p + n * XXH3_BLOCK_SIZE, pSecret, XXH3_STRIPES_PER_BLOCK );
+        kernel.Xxh3Scramble( pAcc, pSecret + XXH3_SECRET_SIZE - stripe );
+    }
+
+    auto stripes = ( ( size - 1 ) - blocks * XXH3_BLOCK_SIZE ) / stripe;
+    kernel.Xxh3Accumulate( pAcc, p + blocks * XXH3_BLOCK_SIZE, pSecret, stripes );
+    kernel.Xxh3Accumulate( pAcc, p + size - stripe, pSecret + XXH3_SECRET_SIZE - stripe - 7, 1 );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      16バイト以下のバッファの64ビットハッシュを求めます.
+//-------------------------------------------------------------------------------------------------
+u64 Hash64Short( const u8* p, size_t size, const u8* pSecret, u64 seed )
+{
+    if ( size > 8 )
+    {
+        auto bitflip1 = ( Read64( pSecret + 24 ) ^ Read64( pSecret + 32 ) ) + seed;
+        auto bitflip2 = ( Read64( pSecret + 40 ) ^ Read64( pSecret + 48 ) ) - seed;
+        auto lo  = Read64( p ) ^ bitflip1;
+        auto hi  = Read64( p + size - 8 ) ^ bitflip2;
+        auto acc = size + Swap64( lo ) + hi + Mul128Fold64( lo, hi );
+        return Xxh3Avalanche( acc );
+    }
+
+    if ( size >= 4 )
+    {
+        seed ^= u64( Swap32( u32( seed ) ) ) << 32;
+        auto bitflip = ( Read64( pSecret + 8 ) ^ Read64( pSecret + 16 ) ) - seed;
+        auto input   = Read32( p + size - 4 ) + ( u64( Read32( p ) ) << 32 );
+        return Rrmxmx( input ^ bitflip, size );
+    }
+
+    if ( size > 0 )
+    {
+        auto combined = ( u32( p[0] ) << 16 ) | ( u32( p[size >> 1] ) << 24 ) | u32( p[size - 1] ) | ( u32( size ) << 8 );
+        auto bitflip  = u64( Read32( pSecret ) ^ Read32( pSecret + 4 ) ) + seed;
+        return Xxh64Avalanche( u64( combined ) ^ bitflip );
+    }
+
+    return Xxh64Avalanche( seed ^ Read64( pSecret + 56 ) ^ Read64( pSecret + 64 ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      240バイト以下のバッファの64ビットハッシュを求めます.
+//-------------------------------------------------------------------------------------------------
+u64 Hash64Mid( const u8* p, size_t size, const u8* pSecret, u64 seed )
+{
+    if ( size <= 16 )
+    { return Hash64Short( p, size, pSecret, seed ); }
+
+    auto acc = u64( size ) * XXH_PRIME64_1;
+
+    if ( size <= 128 )
+    {
+        if ( size > 32 )
+        {
+            if ( size > 64 )
+            {
+                if ( size > 96 )
+                {
+                    acc += Mix16( p + 48, pSecret + 96, seed );
+                    acc += Mix16( p + size - 64, pSecret + 112, seed );
+                }
+                acc += Mix16( p + 32, pSecret + 64, seed );
+                acc += Mix16( p + size - 48, pSecret + 80, seed );
+            }
+            acc += Mix16( p + 16, pSecret + 32, seed );
+            acc += Mix16( p + size - 32, pSecret + 48, seed );
+        }
+        acc += Mix16( p + 0, pSecret + 0, seed );
+        acc += Mix16( p + size - 16, pSecret + 16, seed );
+        return Xxh3Avalanche( acc );
+    }
+
+    auto rounds = size / 16;
+    for( size_t i=0; i<8; ++i )
+    { acc += Mix16( p + 16 * i, pSecret + 16 * i, seed ); }
+    acc = Xxh3Avalanche( acc );
+
+    for( size_t i=8; i<rounds; ++i )
+    { acc += Mix16( p + 16 * i, pSecret + 16 * ( i - 8 ) + 3, seed ); }
+    acc += Mix16( p + size - 16, pSecret + 136 - 17, seed );
+    return Xxh3Avalanche( acc );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      16バイト以下のバッファの128ビットハッシュを求めます.
+//-------------------------------------------------------------------------------------------------
+Hash128 Hash128Short( const u8* p, size_t size, const u8* pSecret, u64 seed )
+{
+    Hash128 result;
+
+    if ( size > 8 )
+    {
+        auto bitflipl = ( Read64( pSecret + 32 ) ^ Read64( pSecret + 40 ) ) - seed;
+        auto bitfliph = ( Read64( pSecret + 48 ) ^ Read64( pSecret + 56 ) ) + seed;
+        auto lo = Read64( p );
+        auto hi = Read64( p + size - 8 );
+
+        auto m = Mul128( lo ^ hi ^ bitflipl, XXH_PRIME64_1 );
+        m.Low += u64( size - 1 ) << 54;
+        hi ^= bitfliph;
+        m.High += hi + u64( u32( hi ) ) * ( XXH_PRIME32_2 - 1 );
+        m.Low  ^= Swap64( m.High );
+
+        result = Mul128( m.Low, XXH_PRIME64_2 );
+        result.High += m.High * XXH_PRIME64_2;
+        result.Low  = Xxh3Avalanche( result.Low );
+        result.High = Xxh3Avalanche( result.High );
+        return result;
+    }
+
+    if ( size >= 4 )
+    {
+        seed ^= u64( Swap32( u32( seed ) ) ) << 32;
+        auto input   = Read32( p ) + ( u64( Read32( p + size - 4 ) ) << 32 );
+        auto bitflip = ( Read64( pSecret + 16 ) ^ Read64( pSecret + 24 ) ) + seed;
+
+        result = Mul128( input ^ bitflip, XXH_PRIME64_1 + ( u64( size ) << 2 ) );
+        result.High += result.Low << 1;
+        result.Low  ^= result.High >> 3;
+        result.Low  ^= result.Low >> 35;
+        result.Low  *= XXH_PRIME_MX2;
+        result.Low  ^= result.Low >> 28;
+        result.High = Xxh3Avalanche( result.High );
+        return result;
+    }
+
+    if ( size > 0 )
+    {
+        auto combinedl = ( u32( p[0] ) << 16 ) | ( u32( p[size >> 1] ) << 24 ) | u32( p[size - 1] ) | ( u32( size ) << 8 );
+        auto combinedh = Rotl32( Swap32( combinedl ), 13 );
+        auto bitflipl  = u64( Read32( pSecret + 0 ) ^ Read32( pSecret + 4  ) ) + seed;
+        auto bitfliph  = u64( Read32( pSecret + 8 ) ^ Read32( pSecret + 12 ) ) - seed;
+        result.Low  = Xxh64Avalanche( u64( combinedl ) ^ bitflipl );
+        result.High = Xxh64Avalanche( u64( combinedh ) ^ bitfliph );
+        return result;
+    }
+
+    result.Low  = Xxh64Avalanche( seed ^ Read64( pSecret + 64 ) ^ Read64( pSecret + 72 ) );
+    result.High = Xxh64Avalanche( seed ^ Read64( pSecret + 80 ) ^ Read64( pSecret + 88 ) );
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      240バイト以下のバッファの128ビットハッシュを求めます.
+//-------------------------------------------------------------------------------------------------
+Hash128 Hash128Mid( const u8* p, size_t size, const u8* pSecret, u64 seed )
+{
+    if ( size <= 16 )
+    { return Hash128Short( p, size, pSecret, seed ); }
+
+    Hash128 acc;
+    acc.Low  = u64( size ) * XXH_PRIME64_1;
+    acc.High = 0;
+
+    if ( size <= 128 )
+    {
+        if ( size > 32 )
+        {
+            if ( size > 64 )
+            {
+                if ( size > 96 )
+                { Mix32( acc, p + 48, p + size - 64, pSecret + 96, seed ); }
+                Mix32( acc, p + 32, p + size - 48, pSecret + 64, seed );
+            }
+            Mix32( acc, p + 16, p + size - 32, pSecret + 32, seed );
+        }
+        Mix32( acc, p, p + size - 16, pSecret, seed );
+    }
+    else
+    {
+        auto rounds = size / 32;
+        for( size_t i=0; i<4; ++i )
+        { Mix32( acc, p + 32 * i, p + 32 * i + 16, pSecret + 32 * i, seed ); }
+        acc.Low  = Xxh3Avalanche( acc.Low );
+        acc.High = Xxh3Avalanche( acc.High );
+
+        for( size_t i=4; i<rounds; ++i )
+        { Mix32( acc, p + 32 * i, p + 32 * i + 16, pSecret + 3 + 32 * ( i - 4 ), seed ); }
+        Mix32( acc, p + size - 16, p + size - 32, pSecret + 136 - 17 - 16, 0 - seed );
+    }
+
+    Hash128 result;
+    result.Low  = acc.Low + acc.High;
+    result.High = acc.Low * XXH_PRIME64_1 + acc.High * XXH_PRIME64_4 + ( u64( size ) - seed ) * XXH_PRIME64_2;
+    result.Low  = Xxh3Avalanche( result.Low );
+    result.High = 0 - Xxh3Avalanche( result.High );
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      アキュムレータから128ビットハッシュを求めます.
+//-------------------------------------------------------------------------------------------------
+Hash128 MergeAccs128( const u64* pAcc, const u8* pSecret, u64 size )
+{
+    Hash128 result;
+    result.Low  = MergeAccs( pAcc, pSecret + 11, size * XXH_PRIME64_1 );
+    result.High = MergeAccs( pAcc, pSecret + XXH3_SECRET_SIZE - wide::XXH3_STRIPE_SIZE - 11, ~( size * XXH_PRIME64_2 ) );
+    return result;
+}
+
 } // namespace /* anonymous */
 
 
@@ -106,31 +611,26 @@ Crc32::Crc32()
 //      引数付きコンストラクタです.
 //-------------------------------------------------------------------------------------------------
 Crc32::Crc32( const u32 size, const u8* pBuffer )
-{
-    u32 c = 0xFFFFFFFF;
-    for( u32 i=0; i<size; ++i )
-    { c = CRC_TABLE[ ( c ^ pBuffer[ i ] ) & 0xFF ] ^ ( c >> 8 ); }
-    m_Hash = c ^ 0xFFFFFFFF;
-}
+: m_Hash( 0 )
+{ Update( size, pBuffer ); }
 
 //-------------------------------------------------------------------------------------------------
 //      引数付きコンストラクタです.
 //-------------------------------------------------------------------------------------------------
 Crc32::Crc32( const char8* pBuffer )
-{
-    u32 c = 0xFFFFFFFF;
-    for( u32 i=0; i<strlen(pBuffer); ++i )
-    { c = CRC_TABLE[ ( c ^ pBuffer[ i ] ) & 0xFF ] ^ ( c >> 8 ); }
-    m_Hash = c ^ 0xFFFFFFFF;
-}
+: m_Hash( 0 )
+{ Update( strlen( pBuffer ), pBuffer ); }
 
 //-------------------------------------------------------------------------------------------------
 //      引数付きコンストラクタです.
 //-------------------------------------------------------------------------------------------------
 Crc32::Crc32( const char16* pBuffer )
 {
+    // 各文字の下位8ビットのみを処理する.
+    const auto length = wcslen( pBuffer );
+
     u32 c = 0xFFFFFFFF;
-    for( u32 i=0; i<wcslen(pBuffer); ++i )
+    for( size_t i=0; i<length; ++i )
     { c = CRC_TABLE[ ( c ^ pBuffer[ i ] ) & 0xFF ] ^ ( c >> 8 ); }
     m_Hash = c ^ 0xFFFFFFFF;
 }
@@ -149,6 +649,15 @@ Crc32::Crc32( const Crc32& value )
 : m_Hash( value.m_Hash )
 { /* DO_NOTHING */  }
 
+//-------------------------------------------------------------------------------------------------
+//      バッファを追加してハッシュキーを更新します.
+//-------------------------------------------------------------------------------------------------
+void Crc32::Update( size_t size, const void* pBuffer )
+{
+    assert( pBuffer != nullptr || size == 0 );
+    m_Hash = UpdateCrc32( m_Hash ^ 0xFFFFFFFF, static_cast<const u8*>( pBuffer ), size ) ^ 0xFFFFFFFF;
+}
+
 //-------------------------------------------------------------------------------------------------
 //      ハッシュキーを返却します.
 //-------------------------------------------------------------------------------------------------
@@ -215,8 +724,10 @@ Fnv1::Fnv1( const u32 size, const u8* pBuffer )
 //-------------------------------------------------------------------------------------------------
 Fnv1::Fnv1( const char8* pBuffer )
 {
+    const auto length = strlen( pBuffer );
+
     m_Hash = FNV_OFFSET_BASIS_32;
-    for( u32 i=0; i<strlen(pBuffer); ++i )
+    for( size_t i=0; i<length; ++i )
     { m_Hash = (FNV_PRIME_32 * m_Hash) ^ pBuffer[ i ]; }
 }
 
@@ -225,8 +736,10 @@ Fnv1::Fnv1( const char8* pBuffer )
 //-------------------------------------------------------------------------------------------------
 Fnv1::Fnv1( const char16* pBuffer )
 {
+    const auto length = wcslen( pBuffer );
+
     m_Hash = FNV_OFFSET_BASIS_32;
-    for( u32 i=0; i<wcslen(pBuffer); ++i )
+    for( size_t i=0; i<length; ++i )
     { m_Hash = (FNV_PRIME_32 * m_Hash) ^ pBuffer[ i ]; }
 }
 
@@ -310,8 +823,10 @@ Fnv1a::Fnv1a( const u32 size, const u8* pBuffer )
 //-------------------------------------------------------------------------------------------------
 Fnv1a::Fnv1a( const char8* pBuffer )
 {
+    const auto length = strlen( pBuffer );
+
     m_Hash = FNV_OFFSET_BASIS_32;
-    for( u32 i=0; i<strlen(pBuffer); ++i )
+    for( size_t i=0; i<length; ++i )
     { m_Hash = ( m_Hash ^ pBuffer[i] ) * FNV_PRIME_32; }
 }
 
@@ -320,8 +835,10 @@ Fnv1a::Fnv1a( const char8* pBuffer )
 //-------------------------------------------------------------------------------------------------
 Fnv1a::Fnv1a( const char16* pBuffer )
 {
+    const auto length = wcslen( pBuffer );
+
     m_Hash = FNV_OFFSET_BASIS_32;
-    for( u32 i=0; i<wcslen(pBuffer); ++i )
+    for( size_t i=0; i<length; ++i )
     { m_Hash = ( m_Hash ^ pBuffer[i] ) * FNV_PRIME_32; }
 }
 
@@ -379,4 +896,203 @@ Fnv1a& Fnv1a::operator = ( const Fnv1a& value )
 }
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Xxh3 class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------------
+Xxh3::Xxh3( u64 seed )
+{ Reset( seed ); }
+
+//-------------------------------------------------------------------------------------------------
+//      空のバッファの状態に戻します.
+//-------------------------------------------------------------------------------------------------
+void Xxh3::Reset( u64 seed )
+{
+    static_assert( sizeof(m_Secret) == XXH3_SECRET_SIZE, "Invalid Secret Size." );
+    static_assert( sizeof(m_Acc)    == sizeof(XXH3_INIT_ACC), "Invalid Accumulator Size." );
+
+    memcpy( m_Acc, XXH3_INIT_ACC, sizeof(m_Acc) );
+    InitSecret( seed, m_Secret );
+    m_Seed          = seed;
+    m_TotalSize     = 0;
+    m_BufferedSize  = 0;
+    m_StripeCount   = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      バッファを追加します.
+//-------------------------------------------------------------------------------------------------
+void Xxh3::Update( size_t size, const void* pBuffer )
+{
+    if ( size == 0 )
+    { return; }
+
+    auto p    = static_cast<const u8*>( pBuffer );
+    auto pEnd = p + size;
+    m_TotalSize += size;
+
+    if ( size <= BUFFER_SIZE - m_BufferedSize )
+    {
+        memcpy( m_Buffer + m_BufferedSize, p, size );
+        m_BufferedSize += u32( size );
+        return;
+    }
+
+    const auto stripe = wide::XXH3_STRIPE_SIZE;
+
+    // 内部バッファを埋めて処理する.
+    if ( m_BufferedSize > 0 )
+    {
+        auto count = BUFFER_SIZE - m_BufferedSize;
+        memcpy( m_Buffer + m_BufferedSize, p, count );
+        p += count;
+        ConsumeStripes( m_Acc, m_StripeCount, m_Buffer, BUFFER_SIZE / stripe, m_Secret );
+        m_BufferedSize = 0;
+    }
+
+    // 最後のストライプになり得る末尾の1～64バイトを残して直接処理する.
+    if ( size_t( pEnd - p ) > BUFFER_SIZE )
+    {
+        auto stripes = size_t( pEnd - p - 1 ) / stripe;
+        ConsumeStripes( m_Acc, m_StripeCount, p, stripes, m_Secret );
+        p += stripes * stripe;
+
+        // 末尾が1ストライプに満たない場合のために, 直前の64バイトを保持しておく.
+        memcpy( m_Buffer + BUFFER_SIZE - stripe, p - stripe, stripe );
+    }
+
+    memcpy( m_Buffer, p, size_t( pEnd - p ) );
+    m_BufferedSize = u32( pEnd - p );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      64ビットハッシュを取得します.
+//-------------------------------------------------------------------------------------------------
+u64 Xxh3::GetHash64() const
+{
+    if ( m_TotalSize <= XXH3_MIDSIZE_MAX )
+    { return Hash64Mid( m_Buffer, size_t( m_TotalSize ), XXH3_SECRET, m_Seed ); }
+
+    u64 acc[ wide::XXH3_ACC_COUNT ];
+    DigestLong( acc );
+    return MergeAccs( acc, m_Secret + 11, m_TotalSize * XXH_PRIME64_1 );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      128ビットハッシュを取得します.
+//-------------------------------------------------------------------------------------------------
+Hash128 Xxh3::GetHash128() const
+{
+    if ( m_TotalSize <= XXH3_MIDSIZE_MAX )
+    { return Hash128Mid( m_Buffer, size_t( m_TotalSize ), XXH3_SECRET, m_Seed ); }
+
+    u64 acc[ wide::XXH3_ACC_COUNT ];
+    DigestLong( acc );
+    return MergeAccs128( acc, m_Secret, m_TotalSize );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ストライプを処理し, ブロックの終わりに達したらアキュムレータをかき混ぜます.
+//-------------------------------------------------------------------------------------------------
+void Xxh3::ConsumeStripes( u64* pAcc, u32& stripeCount, const u8* pInput, size_t stripes, const u8* pSecret )
+{
+    const auto& kernel = wide::GetKernelTable();
+
+    while( stripes > 0 )
+    {
+        auto count = XXH3_STRIPES_PER_BLOCK - stripeCount;
+        if ( count > stripes )
+        { count = u32( stripes ); }
+
+        kernel.Xxh3Accumulate( pAcc, pInput, pSecret + stripeCount * wide::XXH3_SECRET_CONSUME_RATE, count );
+        pInput      += count * wide::XXH3_STRIPE_SIZE;
+        stripes     -= count;
+        stripeCount += count;
+
+        if ( stripeCount == XXH3_STRIPES_PER_BLOCK )
+        {
+            kernel.Xxh3Scramble( pAcc, pSecret + XXH3_SECRET_SIZE - wide::XXH3_STRIPE_SIZE );
+            stripeCount = 0;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      最後のストライプまで処理したアキュムレータを求めます.
+//-------------------------------------------------------------------------------------------------
+void Xxh3::DigestLong( u64* pAcc ) const
+{
+    const auto stripe = wide::XXH3_STRIPE_SIZE;
+
+    memcpy( pAcc, m_Acc, sizeof(m_Acc) );
+
+    u8 lastStripe[ wide::XXH3_STRIPE_SIZE ];
+    const u8* pLast = nullptr;
+
+    if ( m_BufferedSize >= stripe )
+    {
+        auto count = m_StripeCount;
+        ConsumeStripes( pAcc, count, m_Buffer, ( m_BufferedSize - 1 ) / stripe, m_Secret );
+        pLast = m_Buffer + m_BufferedSize - stripe;
+    }
+    else
+    {
+        // 前回処理したバッファの末尾とつなげる.
+        auto catchup = stripe - m_BufferedSize;
+        memcpy( lastStripe, m_Buffer + BUFFER_SIZE - catchup, catchup );
+        memcpy( lastStripe + catchup, m_Buffer, m_BufferedSize );
+        pLast = lastStripe;
+    }
+
+    wide::GetKernelTable().Xxh3Accumulate( pAcc, pLast, m_Secret + XXH3_SECRET_SIZE - stripe - 7, 1 );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      バッファの xxHash3 64ビットハッシュを求めます.
+//-------------------------------------------------------------------------------------------------
+u64 CalcXxh3_64( size_t size, const void* pBuffer, u64 seed )
+{
+    auto p = static_cast<const u8*>( pBuffer );
+    if ( size <= XXH3_MIDSIZE_MAX )
+    { return Hash64Mid( p, size, XXH3_SECRET, seed ); }
+
+    u8 secret[ XXH3_SECRET_SIZE ];
+    const u8* pSecret = XXH3_SECRET;
+    if ( seed != 0 )
+    {
+        InitSecret( seed, secret );
+        pSecret = secret;
+    }
+
+    u64 acc[ wide::XXH3_ACC_COUNT ];
+    AccumulateLong( p, size, pSecret, acc );
+    return MergeAccs( acc, pSecret + 11, u64( size ) * XXH_PRIME64_1 );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      バッファの xxHash3 128ビットハッシュを求めます.
+//-------------------------------------------------------------------------------------------------
+Hash128 CalcXxh3_128( size_t size, const void* pBuffer, u64 seed )
+{
+    auto p = static_cast<const u8*>( pBuffer );
+    if ( size <= XXH3_MIDSIZE_MAX )
+    { return Hash128Mid( p, size, XXH3_SECRET, seed ); }
+
+    u8 secret[ XXH3_SECRET_SIZE ];
+    const u8* pSecret = XXH3_SECRET;
+    if ( seed != 0 )
+    {
+        InitSecret( seed, secret );
+        pSecret = secret;
+    }
+
+    u64 acc[ wide::XXH3_ACC_COUNT ];
+    AccumulateLong( p, size, pSecret, acc );
+    return MergeAccs128( acc, pSecret, u64( size ) );
+}
+
+
 } // namespace asdx
@@ -0,0 +1,309 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxMathBatch.cpp
+// Desc : Batch Math Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxMath.h>
+#include "kernels/asdxKernelTable.h"
+#include "kernels/asdxParallel.h"
+
+
+namespace /* anonymous */ {
+
+using namespace asdx;
+using namespace asdx::wide;
+
+static_assert( sizeof(Vector3) == sizeof(f32) * 3, "Vector3 must be tightly packed." );
+static_assert( sizeof(Vector4) == sizeof(f32) * 4, "Vector4 must be tightly packed." );
+static_assert( sizeof(Quaternion) == sizeof(f32) * 4, "Quaternion must be tightly packed." );
+
+//-------------------------------------------------------------------------------------------------
+//      xyz配列を変換します.
+//-------------------------------------------------------------------------------------------------
+template<TRANSFORM_MODE Mode>
+void BatchTransformArray3( const Vector3* pIn, u32 count, const Matrix& matrix, Vector3* pOut )
+{
+    auto src    = reinterpret_cast<const f32*>( pIn );
+    auto dst    = reinterpret_cast<f32*>( pOut );
+    auto kernel = GetKernelTable().TransformArray3[Mode];
+
+    ParallelFor( count, PARALLEL_GRAIN, [&]( u32 begin, u32 end )
+    { kernel( src, begin, end, &matrix._11, dst ); });
+}
+
+//-------------------------------------------------------------------------------------------------
+//      x, y, z 各成分の配列を変換します.
+//-------------------------------------------------------------------------------------------------
+template<TRANSFORM_MODE Mode>
+void BatchTransformStream3
+(
+    const f32*      pX,
+    const f32*      pY,
+    const f32*      pZ,
+    u32             count,
+    const Matrix&   matrix,
+    f32*            pOutX,
+    f32*            pOutY,
+    f32*            pOutZ
+)
+{
+    auto kernel = GetKernelTable().TransformStream3[Mode];
+
+    ParallelFor( count, PARALLEL_GRAIN, [&]( u32 begin, u32 end )
+    { kernel( pX, pY, pZ, begin, end, &matrix._11, pOutX, pOutY, pOutZ ); });
+}
+
+} // namespace /* anonymous */
+
+
+namespace asdx {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Vector3 structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      位置座標の配列をまとめて変換します.
+//-------------------------------------------------------------------------------------------------
+void Vector3::TransformArray( const Vector3* pPositions, u32 count, const Matrix& matrix, Vector3* pResults )
+{
+    assert( pPositions != nullptr || count == 0 );
+    assert( pResults   != nullptr || count == 0 );
+    BatchTransformArray3<TRANSFORM_POSITION>( pPositions, count, matrix, pResults );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      法線ベクトルの配列をまとめて変換します.
+//-------------------------------------------------------------------------------------------------
+void Vector3::TransformNormalArray( const Vector3* pNormals, u32 count, const Matrix& matrix, Vector3* pResults )
+{
+    assert( pNormals != nullptr || count == 0 );
+    assert( pResults != nullptr || count == 0 );
+    BatchTransformArray3<TRANSFORM_NORMAL>( pNormals, count, matrix, pResults );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ベクトルの配列をまとめて変換し，w=1に射影します.
+//-------------------------------------------------------------------------------------------------
+void Vector3::TransformCoordArray( const Vector3* pCoords, u32 count, const Matrix& matrix, Vector3* pResults )
+{
+    assert( pCoords  != nullptr || count == 0 );
+    assert( pResults != nullptr || count == 0 );
+    BatchTransformArray3<TRANSFORM_COORD>( pCoords, count, matrix, pResults );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      成分ごとの配列で与えられた位置座標をまとめて変換します.
+//-------------------------------------------------------------------------------------------------
+void Vector3::TransformStream
+(
+    const f32*      pX,
+    const f32*      pY,
+    const f32*      pZ,
+    u32             count,
+    const Matrix&   matrix,
+    f32*            pResultX,
+    f32*            pResultY,
+    f32*            pResultZ
+)
+{
+    BatchTransformStream3<TRANSFORM_POSITION>( pX, pY, pZ, count, matrix, pResultX, pResultY, pResultZ );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      成分ごとの配列で与えられた法線ベクトルをまとめて変換します.
+//-------------------------------------------------------------------------------------------------
+void Vector3::TransformNormalStream
+(
+    const f32*      pX,
+    const f32*      pY,
+    const f32*      pZ,
+    u32             count,
+    const Matrix&   matrix,
+    f32*            pResultX,
+    f32*            pResultY,
+    f32*            pResultZ
+)
+{
+    BatchTransformStream3<TRANSFORM_NORMAL>( pX, pY, pZ, count, matrix, pResultX, pResultY, pResultZ );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      成分ごとの配列で与えられたベクトルをまとめて変換し，w=1に射影します.
+//-------------------------------------------------------------------------------------------------
+void Vector3::TransformCoordStream
+(
+    const f32*      pX,
+    const f32*      pY,
+    const f32*      pZ,
+    u32             count,
+    const Matrix&   matrix,
+    f32*            pResultX,
+    f32*            pResultY,
+    f32*            pResultZ
+)
+{
+    BatchTransformStream3<TRANSFORM_COORD>( pX, pY, pZ, count, matrix, pResultX, pResultY, pResultZ );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Vector4 structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      ベクトルの配列をまとめて変換します.
+//-------------------------------------------------------------------------------------------------
+void Vector4::TransformArray( const Vector4* pPositions, u32 count, const Matrix& matrix, Vector4* pResults )
+{
+    assert( pPositions != nullptr || count == 0 );
+    assert( pResults   != nullptr || count == 0 );
+
+    auto src    = reinterpret_cast<const f32*>( pPositions );
+    auto dst    = reinterpret_cast<f32*>( pResults );
+    auto kernel = wide::GetKernelTable().TransformArray4;
+
+    wide::ParallelFor( count, wide::PARALLEL_GRAIN, [&]( u32 begin, u32 end )
+    { kernel( src, begin, end, &matrix._11, dst ); });
+}
+
+//-------------------------------------------------------------------------------------------------
+//      成分ごとの配列で与えられたベクトルをまとめて変換します.
+//-------------------------------------------------------------------------------------------------
+void Vector4::TransformStream
+(
+    const f32*      pX,
+    const f32*      pY,
+    const f32*      pZ,
+    const f32*      pW,
+    u32             count,
+    const Matrix&   matrix,
+    f32*            pResultX,
+    f32*            pResultY,
+    f32*            pResultZ,
+    f32*            pResultW
+)
+{
+    auto kernel = wide::GetKernelTable().TransformStream4;
+
+    wide::ParallelFor( count, wide::PARALLEL_GRAIN, [&]( u32 begin, u32 end )
+    { kernel( pX, pY, pZ, pW, begin, end, &matrix._11, pResultX, pResultY, pResultZ, pResultW ); });
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Quaternion structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      四元数の配列をまとめて球面線形補間します.
+//-------------------------------------------------------------------------------------------------
+void Quaternion::SlerpArray
+(
+    const Quaternion*   pA,
+    const Quaternion*   pB,
+    const f32*          pAmounts,
+    u32                 count,
+    Quaternion*         pResults
+)
+{
+    assert( ( pA != nullptr && pB != nullptr && pAmounts != nullptr && pResults != nullptr ) || count == 0 );
+
+    auto a   = reinterpret_cast<const f32*>( pA );
+    auto b   = reinterpret_cast<const f32*>( pB );
+    auto dst = reinterpret_cast<f32*>( pResults );
+
+    auto kernel = wide::GetKernelTable().SlerpArray;
+
+    wide::ParallelFor( count, wide::PARALLEL_GRAIN, [&]( u32 begin, u32 end )
+    { kernel( a, b, pAmounts, begin, end, dst ); });
+}
+
+//-------------------------------------------------------------------------------------------------
+//      四元数の配列をまとめて線形補間し, 正規化します.
+//-------------------------------------------------------------------------------------------------
+void Quaternion::NlerpArray
+(
+    const Quaternion*   pA,
+    const Quaternion*   pB,
+    const f32*          pAmounts,
+    u32                 count,
+    Quaternion*         pResults
+)
+{
+    assert( ( pA != nullptr && pB != nullptr && pAmounts != nullptr && pResults != nullptr ) || count == 0 );
+
+    auto a   = reinterpret_cast<const f32*>( pA );
+    auto b   = reinterpret_cast<const f32*>( pB );
+    auto dst = reinterpret_cast<f32*>( pResults );
+
+    auto kernel = wide::GetKernelTable().NlerpArray;
+
+    wide::ParallelFor( count, wide::PARALLEL_GRAIN, [&]( u32 begin, u32 end )
+    { kernel( a, b, pAmounts, begin, end, dst ); });
+}
+
+//-------------------------------------------------------------------------------------------------
+//      四元数の配列をまとめて正規化します.
+//-------------------------------------------------------------------------------------------------
+void Quaternion::NormalizeArray( const Quaternion* pValues, u32 count, Quaternion* pResults )
+{
+    assert( ( pValues != nullptr && pResults != nullptr ) || count == 0 );
+
+    auto src = reinterpret_cast<const f32*>( pValues );
+    auto dst = reinterpret_cast<f32*>( pResults );
+
+    auto kernel = wide::GetKernelTable().NormalizeArray;
+
+    wide::ParallelFor( count, wide::PARALLEL_GRAIN, [&]( u32 begin, u32 end )
+    { kernel( src, begin, end, dst ); });
+}
+
+//-------------------------------------------------------------------------------------------------
+//      四元数の配列を成分ごとの配列で表した3x4行列にまとめて変換します.
+//-------------------------------------------------------------------------------------------------
+void Quaternion::ToMatrix3x4Stream
+(
+    const Quaternion*   pRotations,
+    const Vector3*      pTranslations,
+    u32                 count,
+    u32                 stride,
+    f32*                pResults
+)
+{
+    assert( ( pRotations != nullptr && pResults != nullptr ) || count == 0 );
+    assert( stride >= count );
+
+    auto src = reinterpret_cast<const f32*>( pRotations );
+    auto pos = reinterpret_cast<const f32*>( pTranslations );
+
+    auto kernel = wide::GetKernelTable().ToMatrix3x4Stream;
+
+    wide::ParallelFor( count, wide::PARALLEL_GRAIN, [&]( u32 begin, u32 end )
+    { kernel( src, pos, begin, end, stride, pResults ); });
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// DualQuaternion structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      行列の配列をまとめて双対四元数に変換します.
+//-------------------------------------------------------------------------------------------------
+void DualQuaternion::CreateFromMatrixArray( const Matrix* pMatrices, u32 count, DualQuaternion* pResults )
+{
+    assert( ( pMatrices != nullptr && pResults != nullptr ) || count == 0 );
+
+    wide::ParallelFor( count, wide::PARALLEL_GRAIN, [&]( u32 begin, u32 end )
+    {
+        for( auto i=begin; i<end; ++i )
+        { CreateFromMatrix( pMatrices[i], pResults[i] ); }
+    });
+}
+
+} // namespace asdx
@@ -9,6 +9,7 @@
 //-------------------------------------------------------------------------------------------------
 #include <asdxMotionPlayer.h>
 #include <asdxResMesh.h>
+#include <asdxStringInterner.h>
 
 
 namespace asdx {
@@ -28,7 +29,9 @@ MotionPlayer::MotionPlayer()
 , m_BoneTransforms ()
 , m_WorldTransforms()
 , m_SkinTransforms ()
+, m_SkinDualQuaternions()
 , m_IsLoop         ( false )
+, m_MotionToBone   ()
 { /* DO_NOTHING */ }
 
 //-------------------------------------------------------------------------------------------------
@@ -44,7 +47,10 @@ MotionPlayer::~MotionPlayer()
 //      モーションを設定します.
 //-------------------------------------------------------------------------------------------------
 void MotionPlayer::SetMotion( const ResMotion* pMotion )
-{ m_pMotion = pMotion; }
+{
+    m_pMotion = pMotion;
+    UpdateBoneMap();
+}
 
 //-------------------------------------------------------------------------------------------------
 //      ループ再生フラグを設定します.
@@ -69,13 +75,17 @@ void MotionPlayer::Bind( u32 boneCount, const ResBone* pBones )
     m_BoneTransforms .resize( boneCount );
     m_WorldTransforms.resize( boneCount );
     m_SkinTransforms .resize( boneCount );
+    m_SkinDualQuaternions.resize( boneCount );
 
     for( u32 i=0; i<boneCount; ++i )
     {
         m_BoneTransforms [i].Identity();
         m_WorldTransforms[i].Identity();
         m_SkinTransforms [i].Identity();
+        m_SkinDualQuaternions[i] = DualQuaternion::CreateIdentity();
     }
+
+    UpdateBoneMap();
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -86,6 +96,8 @@ void MotionPlayer::Unbind()
     m_BoneTransforms .clear();
     m_WorldTransforms.clear();
     m_SkinTransforms .clear();
+    m_SkinDualQuaternions.clear();
+    m_MotionToBone.clear();
 
     m_BoneCount = 0;
     m_pBones    = nullptr;
@@ -121,6 +133,21 @@ const Matrix* MotionPlayer::GetWorldTransforms() const
 const Matrix* MotionPlayer::GetSkinTransforms() const
 { return ( m_BoneCount > 0 ) ? &m_SkinTransforms[0] : nullptr; }
 
+//-------------------------------------------------------------------------------------------------
+//      スキニング用の双対四元数を取得します.
+//-------------------------------------------------------------------------------------------------
+const DualQuaternion* MotionPlayer::GetSkinDualQuaternions() const
+{ return ( m_BoneCount > 0 ) ? &m_SkinDualQuaternions[0] : nullptr; }
+
+//-------------------------------------------------------------------------------------------------
+//      現在の姿勢のスキンメッシュを含むバウンディングボックスを求めます.
+//-------------------------------------------------------------------------------------------------
+BoundingBox MotionPlayer::CalcSkinnedBounds( const BoundingBox* pBoneBoxes ) const
+{
+    assert( pBoneBoxes != nullptr || m_BoneCount == 0 );
+    return BoundingBox::CreateFromTransformedBoxes( pBoneBoxes, GetWorldTransforms(), m_BoneCount );
+}
+
 //-------------------------------------------------------------------------------------------------
 //      指定時間からボーン行列を計算します.
 //-------------------------------------------------------------------------------------------------
@@ -197,8 +224,49 @@ void MotionPlayer::Update( f32 elapsedTime )
 //-------------------------------------------------------------------------------------------------
 void MotionPlayer::UpdateBoneTransforms()
 {
-    for( size_t i=0; i<m_pMotion->Bones.size(); ++i )
-    { m_BoneTransforms[i] = CalcBoneMatrix( m_FrameTime, m_pMotion->Bones[i] ); }
+    for( size_t i=0; i<m_MotionToBone.size(); ++i )
+    {
+        auto index = m_MotionToBone[i];
+        if ( index != U32_MAX )
+        { m_BoneTransforms[index] = CalcBoneMatrix( m_FrameTime, m_pMotion->Bones[i] ); }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      モーションとボーンをボーン名の名前IDで対応付けます.
+//-------------------------------------------------------------------------------------------------
+void MotionPlayer::UpdateBoneMap()
+{
+    m_MotionToBone.clear();
+
+    if ( m_pMotion == nullptr || m_pBones == nullptr )
+    { return; }
+
+    HashMap<u32, u32> indices( m_BoneCount );
+    for( u32 i=0; i<m_BoneCount; ++i )
+    {
+        if ( m_pBones[i].NameId != NAME_ID_INVALID )
+        { indices.Insert( m_pBones[i].NameId, i ); }
+    }
+
+    auto count = u32( m_pMotion->Bones.size() );
+    m_MotionToBone.resize( count, U32_MAX );
+
+    for( u32 i=0; i<count; ++i )
+    {
+        auto id = m_pMotion->Bones[i].BoneNameId;
+        if ( id == NAME_ID_INVALID )
+        {
+            // 名前IDがない場合は番号で対応付ける.
+            if ( i < m_BoneCount )
+            { m_MotionToBone[i] = i; }
+            continue;
+        }
+
+        auto pIndex = indices.Find( id );
+        if ( pIndex != nullptr )
+        { m_MotionToBone[i] = *pIndex; }
+    }
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -227,6 +295,8 @@ void MotionPlayer::UpdateSkinTransforms()
 {
     for( u32 i=0; i<m_BoneCount; ++i )
     { m_SkinTransforms[i] = m_pBones[i].InvBindPose * m_WorldTransforms[i]; }
+
+    DualQuaternion::CreateFromMatrixArray( m_SkinTransforms.data(), m_BoneCount, m_SkinDualQuaternions.data() );
 }
 
 } // namespace asdx
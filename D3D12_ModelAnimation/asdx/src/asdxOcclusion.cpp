@@ -0,0 +1,538 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxOcclusion.cpp
+// Desc : Software Occlusion Culling Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxOcclusion.h>
+#include <asdxResMesh.h>
+#include "kernels/asdxKernelTable.h"
+#include "kernels/asdxParallel.h"
+#include <cassert>
+#include <cmath>
+
+
+namespace /* anonymous */ {
+
+using namespace asdx;
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const u32 TRIANGLE_STRIDE    = 9;        //!< 設定済み三角形1つあたりの要素数です(カーネルと同じ).
+static const u32 RECT_STRIDE        = 5;        //!< 投影したボックス1つあたりの要素数です(カーネルと同じ).
+static const u32 TRIANGLE_CHUNK     = 256;      //!< 一度に設定する三角形の数です.
+static const u32 BOX_CHUNK          = 256;      //!< 一度に射影するボックスの数です.
+static const u32 FULL_ROW           = 0xffffffffu;  //!< 1行全てを覆うマスクです.
+static const f32 MAX_PIXEL_COORD    = 1048576.0f;   //!< 整数に変換する前にピクセル座標を制限する値です.
+
+static_assert( OCCLUSION_TILE_WIDTH == 32, "Tile row must fit in a 32bit mask." );
+static_assert( sizeof(BoundingBox) == sizeof(f32) * 6, "BoundingBox must be tightly packed." );
+static_assert( BOX_CHUNK % 32 == 0, "Box chunk must be a multiple of the mask word size." );
+static_assert( wide::PARALLEL_GRAIN % BOX_CHUNK == 0, "Parallel grain must be a multiple of the box chunk." );
+
+//-------------------------------------------------------------------------------------------------
+//      タイル内の区間 [left, right] を覆う1行分のマスクを求めます.
+//-------------------------------------------------------------------------------------------------
+u32 SpanMask( s32 left, s32 right )
+{
+    left  = ( left  < 0 ) ? 0 : left;
+    right = ( right > 31 ) ? 31 : right;
+    if ( left > right )
+    { return 0; }
+
+    return ( FULL_ROW >> ( 31 - ( right - left ) ) ) << left;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ピクセル座標を制限して整数に変換します.
+//-------------------------------------------------------------------------------------------------
+s32 ToPixel( f32 value )
+{
+    if ( !( value > -MAX_PIXEL_COORD ) )
+    { return -s32( MAX_PIXEL_COORD ); }
+
+    if ( value > MAX_PIXEL_COORD )
+    { return s32( MAX_PIXEL_COORD ); }
+
+    return s32( value );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      クリップ座標をピクセル座標と深度に変換します.
+//-------------------------------------------------------------------------------------------------
+void Project( const Vector4& clip, f32 width, f32 height, f32* pOut )
+{
+    auto invW = 1.0f / clip.w;
+    pOut[0] = ( clip.x * invW ) * ( width * 0.5f ) + ( width * 0.5f );
+    pOut[1] = ( height * 0.5f ) - ( clip.y * invW ) * ( height * 0.5f );
+    pOut[2] = clip.z * invW;
+}
+
+} // namespace /* anonymous */
+
+
+namespace asdx {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// OcclusionBuffer class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------------
+OcclusionBuffer::OcclusionBuffer()
+: m_Width       ( 0 )
+, m_Height      ( 0 )
+, m_TileCountX  ( 0 )
+, m_TileCountY  ( 0 )
+, m_ViewProj    ( Matrix::CreateIdentity() )
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------------
+OcclusionBuffer::~OcclusionBuffer()
+{ Term(); }
+
+//-------------------------------------------------------------------------------------------------
+//      初期化処理を行います.
+//-------------------------------------------------------------------------------------------------
+bool OcclusionBuffer::Init( u32 width, u32 height )
+{
+    Term();
+
+    if ( width == 0 || height == 0
+      || width  % OCCLUSION_TILE_WIDTH  != 0
+      || height % OCCLUSION_TILE_HEIGHT != 0
+      || width  > u32( MAX_PIXEL_COORD )
+      || height > u32( MAX_PIXEL_COORD ) )
+    { return false; }
+
+    m_Width      = width;
+    m_Height     = height;
+    m_TileCountX = width  / OCCLUSION_TILE_WIDTH;
+    m_TileCountY = height / OCCLUSION_TILE_HEIGHT;
+
+    m_Tiles    .resize( m_TileCountX * m_TileCountY );
+    m_Triangles.resize( TRIANGLE_CHUNK * TRIANGLE_STRIDE );
+
+    Clear( Matrix::CreateIdentity() );
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      終了処理を行います.
+//-------------------------------------------------------------------------------------------------
+void OcclusionBuffer::Term()
+{
+    m_Tiles    .clear();
+    m_Triangles.clear();
+    m_Tiles    .shrink_to_fit();
+    m_Triangles.shrink_to_fit();
+
+    m_Width      = 0;
+    m_Height     = 0;
+    m_TileCountX = 0;
+    m_TileCountY = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      深度をクリアし, ビュー射影行列を設定します.
+//-------------------------------------------------------------------------------------------------
+void OcclusionBuffer::Clear( const Matrix& viewProj )
+{
+    for( auto& tile : m_Tiles )
+    {
+        for( u32 i=0; i<OCCLUSION_TILE_HEIGHT; ++i )
+        { tile.mask[i] = 0; }
+
+        tile.zMax0 = F32_MAX;
+        tile.zMax1 = 0.0f;
+    }
+
+    m_ViewProj = viewProj;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      遮蔽物の三角形リストを描画します.
+//-------------------------------------------------------------------------------------------------
+void OcclusionBuffer::RenderTriangles
+(
+    const Matrix&   world,
+    const Vector3*  pPositions,
+    const u32*      pIndices,
+    u32             indexCount
+)
+{
+    assert( !m_Tiles.empty() );
+    assert( ( pPositions != nullptr && pIndices != nullptr ) || indexCount == 0 );
+
+    const auto worldViewProj = world * m_ViewProj;
+    const f32  viewport[2]   = { f32( m_Width ), f32( m_Height ) };
+    const auto triangleCount = indexCount / 3;
+
+    auto kernel = wide::GetKernelTable().SetupTriangles;
+    u32  clip[TRIANGLE_CHUNK];
+
+    for( u32 begin=0; begin<triangleCount; begin += TRIANGLE_CHUNK )
+    {
+        auto count     = ( triangleCount - begin < TRIANGLE_CHUNK ) ? triangleCount - begin : TRIANGLE_CHUNK;
+        auto indices   = pIndices + begin * 3;
+        u32  setup     = 0;
+        u32  clipCount = 0;
+
+        kernel( &pPositions[0].x, indices, 0, count, &worldViewProj._11, viewport,
+            m_Triangles.data(), &setup, clip, &clipCount );
+
+        for( u32 i=0; i<setup; ++i )
+        { RasterizeTriangle( m_Triangles.data() + i * TRIANGLE_STRIDE ); }
+
+        for( u32 i=0; i<clipCount; ++i )
+        { ClipTriangle( worldViewProj, pPositions, indices + clip[i] * 3 ); }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      遮蔽物のメッシュを描画します.
+//-------------------------------------------------------------------------------------------------
+void OcclusionBuffer::RenderMesh( const Matrix& world, const ResMesh& mesh )
+{
+    RenderTriangles(
+        world,
+        mesh.Positions.data(),
+        mesh.VertexIndices.data(),
+        u32( mesh.VertexIndices.size() ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ワールド空間のボックスが見えるかどうか判定します.
+//-------------------------------------------------------------------------------------------------
+bool OcclusionBuffer::TestBox( const BoundingBox& box ) const
+{
+    u32 result = 0;
+    TestBoxes( Matrix::CreateIdentity(), &box, 1, &result );
+    return ( result & 0x1 ) != 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ボックス配列をまとめて判定します.
+//-------------------------------------------------------------------------------------------------
+void OcclusionBuffer::TestBoxes
+(
+    const Matrix&       world,
+    const BoundingBox*  pBoxes,
+    u32                 count,
+    u32*                pResults
+) const
+{
+    assert( !m_Tiles.empty() );
+    assert( ( pBoxes != nullptr && pResults != nullptr ) || count == 0 );
+
+    const auto worldViewProj = world * m_ViewProj;
+    const f32  viewport[2]   = { f32( m_Width ), f32( m_Height ) };
+
+    auto kernel = wide::GetKernelTable().ProjectBoxes;
+
+    // ブロックの境界は BOX_CHUNK の倍数なので, マスクのワードをスレッド間で共有しない.
+    wide::ParallelFor( count, wide::PARALLEL_GRAIN, [&]( u32 begin, u32 end )
+    {
+        f32 rects[BOX_CHUNK * RECT_STRIDE];
+
+        for( auto i=begin; i<end; i += BOX_CHUNK )
+        {
+            auto chunk = ( end - i < BOX_CHUNK ) ? end - i : BOX_CHUNK;
+            kernel( &pBoxes[i].mini.x, 0, chunk, &worldViewProj._11, viewport, rects );
+
+            for( u32 j=0; j<chunk; j += 32 )
+            {
+                auto bits = ( chunk - j < 32 ) ? chunk - j : 32;
+                u32  mask = 0;
+                for( u32 k=0; k<bits; ++k )
+                { mask |= TestRect( rects + ( j + k ) * RECT_STRIDE ) ? ( 1u << k ) : 0u; }
+
+                pResults[( i + j ) / 32] = mask;
+            }
+        }
+    });
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ピクセルごとの保守的な深度を取得します.
+//-------------------------------------------------------------------------------------------------
+void OcclusionBuffer::ReadDepth( f32* pDepth ) const
+{
+    assert( pDepth != nullptr );
+
+    for( u32 y=0; y<m_Height; ++y )
+    {
+        for( u32 x=0; x<m_Width; ++x )
+        {
+            const auto& tile = m_Tiles[( y / OCCLUSION_TILE_HEIGHT ) * m_TileCountX + x / OCCLUSION_TILE_WIDTH];
+            auto covered = ( tile.mask[y % OCCLUSION_TILE_HEIGHT] >> ( x % OCCLUSION_TILE_WIDTH ) ) & 0x1;
+            pDepth[y * m_Width + x] = ( covered && tile.zMax1 < tile.zMax0 ) ? tile.zMax1 : tile.zMax0;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      横幅を取得します.
+//-------------------------------------------------------------------------------------------------
+u32 OcclusionBuffer::GetWidth() const
+{ return m_Width; }
+
+//-------------------------------------------------------------------------------------------------
+//      縦幅を取得します.
+//-------------------------------------------------------------------------------------------------
+u32 OcclusionBuffer::GetHeight() const
+{ return m_Height; }
+
+//-------------------------------------------------------------------------------------------------
+//      設定済みの三角形をラスタライズし, 深度タイルを更新します.
+//
+//      三角形は画面上で時計回りです. 1行ごとに3辺の内側となる区間を求めて32bitのマスクにし,
+//      タイルに対しては三角形の深度平面をタイルの四隅で評価した最大値を深度とします.
+//-------------------------------------------------------------------------------------------------
+void OcclusionBuffer::RasterizeTriangle( const f32* pTriangle )
+{
+    const f32 x[3] = { pTriangle[0], pTriangle[3], pTriangle[6] };
+    const f32 y[3] = { pTriangle[1], pTriangle[4], pTriangle[7] };
+    const f32 z[3] = { pTriangle[2], pTriangle[5], pTriangle[8] };
+
+    auto minX = Min( x[0], Min( x[1], x[2] ) );
+    auto maxX = Max( x[0], Max( x[1], x[2] ) );
+    auto minY = Min( y[0], Min( y[1], y[2] ) );
+    auto maxY = Max( y[0], Max( y[1], y[2] ) );
+
+    // 中心がバウンディングボックスに含まれるピクセルの範囲.
+    auto px0 = Max( ToPixel( ceilf ( minX - 0.5f ) ), 0 );
+    auto px1 = Min( ToPixel( floorf( maxX - 0.5f ) ), s32( m_Width  ) - 1 );
+    auto py0 = Max( ToPixel( ceilf ( minY - 0.5f ) ), 0 );
+    auto py1 = Min( ToPixel( floorf( maxY - 0.5f ) ), s32( m_Height ) - 1 );
+    if ( px0 > px1 || py0 > py1 )
+    { return; }
+
+    // 辺の方程式 a * x + b * y + c >= 0 が内側です.
+    f32 a[3], b[3], c[3], invA[3];
+    for( u32 k=0; k<3; ++k )
+    {
+        auto n = ( k + 1 ) % 3;
+        a[k] = y[k] - y[n];
+        b[k] = x[n] - x[k];
+        c[k] = -( a[k] * x[k] + b[k] * y[k] );
+        invA[k] = ( a[k] != 0.0f ) ? 1.0f / a[k] : 0.0f;
+    }
+
+    // 深度平面.
+    auto area = ( x[1] - x[0] ) * ( y[2] - y[0] ) - ( x[2] - x[0] ) * ( y[1] - y[0] );
+    auto dzdx = ( ( z[1] - z[0] ) * ( y[2] - y[0] ) - ( z[2] - z[0] ) * ( y[1] - y[0] ) ) / area;
+    auto dzdy = ( ( x[1] - x[0] ) * ( z[2] - z[0] ) - ( x[2] - x[0] ) * ( z[1] - z[0] ) ) / area;
+    auto zMax = Max( z[0], Max( z[1], z[2] ) );
+
+    auto depthAt = [&]( f32 px, f32 py )
+    { return z[0] + dzdx * ( px - x[0] ) + dzdy * ( py - y[0] ); };
+
+    const auto tx0 = u32( px0 ) / OCCLUSION_TILE_WIDTH;
+    const auto tx1 = u32( px1 ) / OCCLUSION_TILE_WIDTH;
+    const auto ty0 = u32( py0 ) / OCCLUSION_TILE_HEIGHT;
+    const auto ty1 = u32( py1 ) / OCCLUSION_TILE_HEIGHT;
+
+    for( auto ty=ty0; ty<=ty1; ++ty )
+    {
+        // 行ごとの被覆区間.
+        s32 left [OCCLUSION_TILE_HEIGHT];
+        s32 right[OCCLUSION_TILE_HEIGHT];
+        for( u32 r=0; r<OCCLUSION_TILE_HEIGHT; ++r )
+        {
+            auto row = s32( ty * OCCLUSION_TILE_HEIGHT + r );
+            left [r] = px0;
+            right[r] = ( row < py0 || row > py1 ) ? px0 - 1 : px1;
+
+            auto cy = f32( row ) + 0.5f;
+            for( u32 k=0; k<3 && left[r] <= right[r]; ++k )
+            {
+                auto value = b[k] * cy + c[k];
+                if ( a[k] > 0.0f )
+                { left[r] = Max( left[r], ToPixel( ceilf( -value * invA[k] - 0.5f ) ) ); }
+                else if ( a[k] < 0.0f )
+                { right[r] = Min( right[r], ToPixel( floorf( -value * invA[k] - 0.5f ) ) ); }
+                else if ( value < 0.0f )
+                { right[r] = left[r] - 1; }
+            }
+        }
+
+        // タイルの深度はタイルと三角形のバウンディングボックスの共通部分の四隅で評価する.
+        auto rectY0 = Max( f32( ty * OCCLUSION_TILE_HEIGHT ), minY );
+        auto rectY1 = Min( f32( ( ty + 1 ) * OCCLUSION_TILE_HEIGHT ), maxY );
+
+        for( auto tx=tx0; tx<=tx1; ++tx )
+        {
+            auto base = s32( tx * OCCLUSION_TILE_WIDTH );
+
+            u32 mask[OCCLUSION_TILE_HEIGHT];
+            u32 any = 0;
+            for( u32 r=0; r<OCCLUSION_TILE_HEIGHT; ++r )
+            {
+                mask[r] = SpanMask( left[r] - base, right[r] - base );
+                any |= mask[r];
+            }
+
+            if ( any == 0 )
+            { continue; }
+
+            auto rectX0 = Max( f32( base ), minX );
+            auto rectX1 = Min( f32( base + s32( OCCLUSION_TILE_WIDTH ) ), maxX );
+            auto depth  = Max( Max( depthAt( rectX0, rectY0 ), depthAt( rectX1, rectY0 ) ),
+                               Max( depthAt( rectX0, rectY1 ), depthAt( rectX1, rectY1 ) ) );
+            depth = Min( depth, zMax );
+
+            auto& tile = m_Tiles[ty * m_TileCountX + tx];
+            if ( !( depth < tile.zMax0 ) )
+            { continue; }
+
+            // 作業レイヤーより十分手前の三角形であれば, 作業レイヤーを捨てて置き換える.
+            if ( tile.zMax1 - depth > tile.zMax0 - tile.zMax1 )
+            {
+                for( u32 r=0; r<OCCLUSION_TILE_HEIGHT; ++r )
+                { tile.mask[r] = 0; }
+                tile.zMax1 = 0.0f;
+            }
+
+            auto full = FULL_ROW;
+            for( u32 r=0; r<OCCLUSION_TILE_HEIGHT; ++r )
+            {
+                tile.mask[r] |= mask[r];
+                full &= tile.mask[r];
+            }
+            tile.zMax1 = Max( tile.zMax1, depth );
+
+            // 作業レイヤーがタイル全体を覆ったら, タイル全体の深度として確定する.
+            if ( full == FULL_ROW )
+            {
+                tile.zMax0 = Min( tile.zMax0, tile.zMax1 );
+                tile.zMax1 = 0.0f;
+                for( u32 r=0; r<OCCLUSION_TILE_HEIGHT; ++r )
+                { tile.mask[r] = 0; }
+            }
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      手前のクリップ面をまたぐ三角形を切り取って描画します.
+//-------------------------------------------------------------------------------------------------
+void OcclusionBuffer::ClipTriangle( const Matrix& worldViewProj, const Vector3* pPositions, const u32* pIndices )
+{
+    Vector4 clip[3];
+    for( u32 k=0; k<3; ++k )
+    {
+        const auto& pos = pPositions[pIndices[k]];
+        clip[k] = Vector4::Transform( Vector4( pos.x, pos.y, pos.z, 1.0f ), worldViewProj );
+    }
+
+    // z >= 0 の側を残す. 結果は最大4頂点です.
+    Vector4 polygon[4];
+    u32 count = 0;
+    for( u32 k=0; k<3; ++k )
+    {
+        const auto& a = clip[k];
+        const auto& b = clip[( k + 1 ) % 3];
+
+        if ( a.z >= 0.0f )
+        { polygon[count++] = a; }
+
+        if ( ( a.z >= 0.0f ) != ( b.z >= 0.0f ) )
+        {
+            auto t = a.z / ( a.z - b.z );
+            polygon[count] = a + ( b - a ) * t;
+            polygon[count].z = 0.0f;
+            count++;
+        }
+    }
+
+    f32 screen[4][3];
+    for( u32 k=0; k<count; ++k )
+    {
+        if ( !( polygon[k].w > 0.0f ) )
+        { return; }
+
+        Project( polygon[k], f32( m_Width ), f32( m_Height ), screen[k] );
+    }
+
+    for( u32 k=2; k<count; ++k )
+    {
+        f32 triangle[TRIANGLE_STRIDE];
+        for( u32 c=0; c<3; ++c )
+        {
+            triangle[c + 0] = screen[0][c];
+            triangle[c + 3] = screen[k - 1][c];
+            triangle[c + 6] = screen[k][c];
+        }
+
+        auto area = ( triangle[3] - triangle[0] ) * ( triangle[7] - triangle[1] )
+                  - ( triangle[6] - triangle[0] ) * ( triangle[4] - triangle[1] );
+        if ( area > 0.0f )
+        { RasterizeTriangle( triangle ); }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      投影したボックスの矩形が見えるかどうか判定します.
+//-------------------------------------------------------------------------------------------------
+bool OcclusionBuffer::TestRect( const f32* pRect ) const
+{
+    auto minZ = pRect[4];
+    if ( !( minZ >= 0.0f ) )
+    { return true; }
+
+    // 矩形と重なるピクセルの範囲.
+    auto px0 = Max( ToPixel( floorf( pRect[0] ) ), 0 );
+    auto px1 = Min( ToPixel( floorf( pRect[2] ) ), s32( m_Width  ) - 1 );
+    auto py0 = Max( ToPixel( floorf( pRect[1] ) ), 0 );
+    auto py1 = Min( ToPixel( floorf( pRect[3] ) ), s32( m_Height ) - 1 );
+    if ( px0 > px1 || py0 > py1 )
+    { return false; }
+
+    const auto tx0 = u32( px0 ) / OCCLUSION_TILE_WIDTH;
+    const auto tx1 = u32( px1 ) / OCCLUSION_TILE_WIDTH;
+    const auto ty0 = u32( py0 ) / OCCLUSION_TILE_HEIGHT;
+    const auto ty1 = u32( py1 ) / OCCLUSION_TILE_HEIGHT;
+
+    for( auto ty=ty0; ty<=ty1; ++ty )
+    {
+        for( auto tx=tx0; tx<=tx1; ++tx )
+        {
+            const auto& tile = m_Tiles[ty * m_TileCountX + tx];
+            if ( minZ > tile.zMax0 )
+            { continue; }
+
+            // 矩形内のピクセルが全て作業レイヤーに覆われていれば, その深度でも判定する.
+            if ( minZ > tile.zMax1 )
+            {
+                auto base    = s32( tx * OCCLUSION_TILE_WIDTH );
+                auto covered = true;
+                for( u32 r=0; r<OCCLUSION_TILE_HEIGHT && covered; ++r )
+                {
+                    auto row = s32( ty * OCCLUSION_TILE_HEIGHT + r );
+                    if ( row < py0 || row > py1 )
+                    { continue; }
+
+                    auto span = SpanMask( px0 - base, px1 - base );
+                    covered = ( span & ~tile.mask[r] ) == 0;
+                }
+
+                if ( covered )
+                { continue; }
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace asdx
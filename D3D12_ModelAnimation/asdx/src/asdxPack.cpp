@@ -0,0 +1,150 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxPack.cpp
+// Desc : Data Packing Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxPack.h>
+#include "kernels/asdxKernelTable.h"
+#include "kernels/asdxParallel.h"
+
+
+namespace /* anonymous */ {
+
+using namespace asdx;
+using namespace asdx::wide;
+
+static_assert( sizeof(Vector2) == sizeof(f32) * 2, "Vector2 must be tightly packed." );
+static_assert( sizeof(Vector3) == sizeof(f32) * 3, "Vector3 must be tightly packed." );
+
+//-------------------------------------------------------------------------------------------------
+//      要素ごとの変換カーネルを並列に実行します.
+//-------------------------------------------------------------------------------------------------
+template<typename Src, typename Dst>
+void Convert
+(
+    void        (*kernel)( const Src*, u32, u32, Dst* ),
+    const Src*  pValues,
+    u32         count,
+    Dst*        pResults
+)
+{
+    assert( ( pValues != nullptr && pResults != nullptr ) || count == 0 );
+
+    ParallelFor( count, PARALLEL_GRAIN, [&]( u32 begin, u32 end )
+    { kernel( pValues, begin, end, pResults ); });
+}
+
+} // namespace /* anonymous */
+
+
+namespace asdx {
+
+//-------------------------------------------------------------------------------------------------
+//      f32型の配列をf16型にまとめて変換します.
+//-------------------------------------------------------------------------------------------------
+void F32ToF16Array( const f32* pValues, u32 count, f16* pResults )
+{ Convert( GetKernelTable().PackF16, pValues, count, pResults ); }
+
+//-------------------------------------------------------------------------------------------------
+//      f16型の配列をf32型にまとめて変換します.
+//-------------------------------------------------------------------------------------------------
+void F16ToF32Array( const f16* pValues, u32 count, f32* pResults )
+{ Convert( GetKernelTable().UnpackF16, pValues, count, pResults ); }
+
+//-------------------------------------------------------------------------------------------------
+//      値の配列を8bit符号付き正規化整数にまとめて変換します.
+//-------------------------------------------------------------------------------------------------
+void F32ToSnorm8Array( const f32* pValues, u32 count, s8* pResults )
+{ Convert( GetKernelTable().PackSnorm8, pValues, count, pResults ); }
+
+//-------------------------------------------------------------------------------------------------
+//      値の配列を16bit符号付き正規化整数にまとめて変換します.
+//-------------------------------------------------------------------------------------------------
+void F32ToSnorm16Array( const f32* pValues, u32 count, s16* pResults )
+{ Convert( GetKernelTable().PackSnorm16, pValues, count, pResults ); }
+
+//-------------------------------------------------------------------------------------------------
+//      8bit符号付き正規化整数の配列をまとめて変換します.
+//-------------------------------------------------------------------------------------------------
+void Snorm8ToF32Array( const s8* pValues, u32 count, f32* pResults )
+{ Convert( GetKernelTable().UnpackSnorm8, pValues, count, pResults ); }
+
+//-------------------------------------------------------------------------------------------------
+//      16bit符号付き正規化整数の配列をまとめて変換します.
+//-------------------------------------------------------------------------------------------------
+void Snorm16ToF32Array( const s16* pValues, u32 count, f32* pResults )
+{ Convert( GetKernelTable().UnpackSnorm16, pValues, count, pResults ); }
+
+//-------------------------------------------------------------------------------------------------
+//      値の配列を8bit符号なし正規化整数にまとめて変換します.
+//-------------------------------------------------------------------------------------------------
+void F32ToUnorm8Array( const f32* pValues, u32 count, u8* pResults )
+{ Convert( GetKernelTable().PackUnorm8, pValues, count, pResults ); }
+
+//-------------------------------------------------------------------------------------------------
+//      値の配列を16bit符号なし正規化整数にまとめて変換します.
+//-------------------------------------------------------------------------------------------------
+void F32ToUnorm16Array( const f32* pValues, u32 count, u16* pResults )
+{ Convert( GetKernelTable().PackUnorm16, pValues, count, pResults ); }
+
+//-------------------------------------------------------------------------------------------------
+//      8bit符号なし正規化整数の配列をまとめて変換します.
+//-------------------------------------------------------------------------------------------------
+void Unorm8ToF32Array( const u8* pValues, u32 count, f32* pResults )
+{ Convert( GetKernelTable().UnpackUnorm8, pValues, count, pResults ); }
+
+//-------------------------------------------------------------------------------------------------
+//      16bit符号なし正規化整数の配列をまとめて変換します.
+//-------------------------------------------------------------------------------------------------
+void Unorm16ToF32Array( const u16* pValues, u32 count, f32* pResults )
+{ Convert( GetKernelTable().UnpackUnorm16, pValues, count, pResults ); }
+
+//-------------------------------------------------------------------------------------------------
+//      単位ベクトルを八面体写像で符号化します.
+//-------------------------------------------------------------------------------------------------
+Vector2 EncodeOctahedral( const Vector3& normal )
+{
+    Vector2 result;
+    GetKernelTable().EncodeOctahedral( &normal.x, 0, 1, &result.x );
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      八面体写像で符号化された値を単位ベクトルに復号します.
+//-------------------------------------------------------------------------------------------------
+Vector3 DecodeOctahedral( const Vector2& value )
+{
+    Vector3 result;
+    GetKernelTable().DecodeOctahedral( &value.x, 0, 1, &result.x );
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      単位ベクトルの配列をまとめて八面体写像で符号化します.
+//-------------------------------------------------------------------------------------------------
+void EncodeOctahedralArray( const Vector3* pNormals, u32 count, Vector2* pResults )
+{
+    Convert(
+        GetKernelTable().EncodeOctahedral,
+        reinterpret_cast<const f32*>( pNormals ),
+        count,
+        reinterpret_cast<f32*>( pResults ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      八面体写像で符号化された値の配列をまとめて単位ベクトルに復号します.
+//-------------------------------------------------------------------------------------------------
+void DecodeOctahedralArray( const Vector2* pValues, u32 count, Vector3* pResults )
+{
+    Convert(
+        GetKernelTable().DecodeOctahedral,
+        reinterpret_cast<const f32*>( pValues ),
+        count,
+        reinterpret_cast<f32*>( pResults ) );
+}
+
+} // namespace asdx
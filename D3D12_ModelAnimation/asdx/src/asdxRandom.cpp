@@ -8,6 +8,120 @@
 // Includes
 //-------------------------------------------------------------------------------------------------
 #include <asdxMath.h>
+#include <cstring>
+#include "kernels/asdxKernelTable.h"
+
+
+namespace /* anonymous */ {
+
+using namespace asdx;
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const u32 FILL_BLOCK_STEPS = 512;    //!< Fill() で1度にカーネルへ渡す段数です(出力 16KiB 分).
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      XorShift128 の遷移行列の冪を表す多項式の係数です(下位ワードから順).
+//!
+//! @details    x^(2^n) mod (特性多項式) を求めたもので, bit i が立っている場合に
+//!             i 段進めた状態を排他的論理和で足し合わせると 2^n 段進めた状態になります.
+//-------------------------------------------------------------------------------------------------
+static const u32 JUMP_2_64[4] = { 0x35aac71c, 0x821e5343, 0xf52e65c4, 0xd8cd644e };
+static const u32 JUMP_2_67[4] = { 0xcc67a971, 0x4ab914f1, 0x7c7393b3, 0xdd86dbb3 };
+
+static_assert( RandomStream::LaneCount == wide::RANDOM_LANE_COUNT, "Lane count mismatch." );
+
+//-------------------------------------------------------------------------------------------------
+//      XorShift128 を1段進めます.
+//-------------------------------------------------------------------------------------------------
+inline void Step( u32& x, u32& y, u32& z, u32& w )
+{
+    u32 t = x ^ ( x << 11 );
+    x = y;
+    y = z;
+    z = w;
+    w = ( w ^ ( w >> 19 ) ) ^ ( t ^ ( t >> 8 ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      多項式 pPoly で表される段数だけ状態を進めます.
+//-------------------------------------------------------------------------------------------------
+void Jump( u32& x, u32& y, u32& z, u32& w, const u32* pPoly )
+{
+    u32 tx = 0, ty = 0, tz = 0, tw = 0;
+    for( u32 i=0; i<128; ++i )
+    {
+        if ( pPoly[i / 32] & ( 1u << ( i % 32 ) ) )
+        {
+            tx ^= x;
+            ty ^= y;
+            tz ^= z;
+            tw ^= w;
+        }
+        Step( x, y, z, w );
+    }
+
+    x = tx;
+    y = ty;
+    z = tz;
+    w = tw;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      count個の乱数を段単位で生成します.
+//      kernel( pState, steps, pOut ) は pState を steps 段進め, その乱数を pOut に書き込みます.
+//      offset は pState の次の段で出力済みのレーン数で, 途中まで使った段は状態を進めずに残します.
+//-------------------------------------------------------------------------------------------------
+template<typename T, typename Kernel>
+void FillSteps( T* pValues, u32 count, u32* pState, u32& offset, const Kernel& kernel )
+{
+    const u32 N = RandomStream::LaneCount;
+
+    // 前回途中まで使った段の残りを先に出力する. 段を使い切った場合のみ状態を進める.
+    if ( offset > 0 && count > 0 )
+    {
+        auto n = ( count < N - offset ) ? count : N - offset;
+
+        T temp[N];
+        if ( offset + n == N )
+        { kernel( pState, 1, temp ); }
+        else
+        {
+            u32 state[4 * N];
+            memcpy( state, pState, sizeof(state) );
+            kernel( state, 1, temp );
+        }
+
+        memcpy( pValues, temp + offset, sizeof(T) * n );
+        pValues += n;
+        count   -= n;
+        offset   = ( offset + n ) % N;
+    }
+
+    auto steps = count / N;
+    while ( steps > 0 )
+    {
+        auto n = ( steps < FILL_BLOCK_STEPS ) ? steps : FILL_BLOCK_STEPS;
+        kernel( pState, n, pValues );
+        pValues += n * N;
+        steps   -= n;
+    }
+
+    auto rest = count % N;
+    if ( rest > 0 )
+    {
+        u32 state[4 * N];
+        memcpy( state, pState, sizeof(state) );
+
+        T temp[N];
+        kernel( state, 1, temp );
+        memcpy( pValues, temp, sizeof(T) * rest );
+        offset = rest;
+    }
+}
+
+} // namespace /* anonymous */
 
 
 namespace asdx {
@@ -152,10 +266,18 @@ f64 Random::GetAsF64( f64 a, f64 b )
 {
     f64 x = GetAsF64();
     x *= ( b - a );
-    x *= a;
+    x += a;
     return x;
 }
 
+//-------------------------------------------------------------------------------------------------
+//      乱数列を 2^64 個先まで進めます.
+//-------------------------------------------------------------------------------------------------
+void Random::Jump()
+{
+    ::Jump( m_X, m_Y, m_Z, m_W, JUMP_2_64 );
+}
+
 //-------------------------------------------------------------------------------------------------
 //      代入演算子です.
 //-------------------------------------------------------------------------------------------------
@@ -184,4 +306,146 @@ bool Random::operator != ( const Random& random ) const
     return  ( this != &random );
 }
 
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// RandomStream class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------------
+RandomStream::RandomStream( s32 seed )
+{
+    SetSeed( seed );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      乱数生成器の現在の状態から生成します.
+//-------------------------------------------------------------------------------------------------
+RandomStream::RandomStream( const Random& random )
+{
+    SetState( random );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      コピーコンストラクタです.
+//-------------------------------------------------------------------------------------------------
+RandomStream::RandomStream( const RandomStream& stream )
+{
+    memcpy( m_State, stream.m_State, sizeof(m_State) );
+    m_Offset = stream.m_Offset;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------------
+RandomStream::~RandomStream()
+{
+    /* DO_NOTHING */
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ランダム種を設定します.
+//-------------------------------------------------------------------------------------------------
+void RandomStream::SetSeed( s32 seed )
+{
+    SetState( Random( seed ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      各レーンの状態を設定します.
+//-------------------------------------------------------------------------------------------------
+void RandomStream::SetState( const Random& random )
+{
+    auto x = random.m_X;
+    auto y = random.m_Y;
+    auto z = random.m_Z;
+    auto w = random.m_W;
+
+    for( u32 i=0; i<LaneCount; ++i )
+    {
+        if ( i > 0 )
+        { ::Jump( x, y, z, w, JUMP_2_64 ); }
+
+        m_State[0 * LaneCount + i] = x;
+        m_State[1 * LaneCount + i] = y;
+        m_State[2 * LaneCount + i] = z;
+        m_State[3 * LaneCount + i] = w;
+    }
+
+    m_Offset = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      乱数をu32型としてまとめて生成します.
+//-------------------------------------------------------------------------------------------------
+void RandomStream::Fill( u32* pValues, u32 count )
+{
+    assert( pValues != nullptr || count == 0 );
+
+    auto kernel = wide::GetKernelTable().RandomFillU32;
+    FillSteps( pValues, count, m_State, m_Offset, [&]( u32* pState, u32 steps, u32* pOut )
+    { kernel( pState, steps, pOut ); });
+}
+
+//-------------------------------------------------------------------------------------------------
+//      乱数をf32型としてまとめて生成します.
+//-------------------------------------------------------------------------------------------------
+void RandomStream::Fill( f32* pValues, u32 count )
+{
+    Fill( pValues, count, 0.0f, 1.0f );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      指定された値範囲で乱数をf32型としてまとめて生成します.
+//-------------------------------------------------------------------------------------------------
+void RandomStream::Fill( f32* pValues, u32 count, f32 a, f32 b )
+{
+    assert( pValues != nullptr || count == 0 );
+
+    auto kernel = wide::GetKernelTable().RandomFillF32;
+    auto scale  = b - a;
+    FillSteps( pValues, count, m_State, m_Offset, [&]( u32* pState, u32 steps, f32* pOut )
+    { kernel( pState, steps, a, scale, pOut ); });
+}
+
+//-------------------------------------------------------------------------------------------------
+//      全レーンの乱数列を 2^67 個先まで進めます.
+//-------------------------------------------------------------------------------------------------
+void RandomStream::Jump()
+{
+    for( u32 i=0; i<LaneCount; ++i )
+    {
+        ::Jump(
+            m_State[0 * LaneCount + i],
+            m_State[1 * LaneCount + i],
+            m_State[2 * LaneCount + i],
+            m_State[3 * LaneCount + i],
+            JUMP_2_67 );
+    }
+
+    // 途中まで使った段の残りは進めた先の乱数列と重複しないので, そのまま捨てる.
+    m_Offset = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      重複しない乱数列を分割します.
+//-------------------------------------------------------------------------------------------------
+RandomStream RandomStream::Split()
+{
+    RandomStream result( *this );
+    Jump();
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      代入演算子です.
+//-------------------------------------------------------------------------------------------------
+RandomStream& RandomStream::operator = ( const RandomStream& stream )
+{
+    memcpy( m_State, stream.m_State, sizeof(m_State) );
+    m_Offset = stream.m_Offset;
+    return (*this);
+}
+
 } // namespace asdx
@@ -33,7 +33,14 @@ bool MeshFactory::Create( const char16* filename, ResMesh* pResult )
     auto ext = GetExt( filename );
 
     if ( ext == L"msh" )
-    { return LoadResMeshFromMSH( filename, pResult ); }
+    {
+        if ( !LoadResMeshFromMSH( filename, pResult ) )
+        { return false; }
+
+        CalcSubsetBounds( pResult );
+        CalcBoneBounds  ( pResult );
+        return true;
+    }
 
     ELOG( "Error : Invalid File FOrmat. Extension is %s", ext.c_str() );;
     return false;
@@ -55,8 +62,77 @@ void MeshFactory::Dispose( ResMesh*& ptr )
     ptr->VertexIndices.clear();
     ptr->Subsets      .clear();
     ptr->Bones        .clear();
+    ptr->SubsetBoxes  .clear();
+    ptr->SubsetSpheres.clear();
+    ptr->BoneBoxes    .clear();
 
     SafeDelete( ptr );
 }
 
+//-------------------------------------------------------------------------------------------------
+//      サブセットごとのバウンディングボリュームを求めます.
+//-------------------------------------------------------------------------------------------------
+void MeshFactory::CalcSubsetBounds( ResMesh* pMesh )
+{
+    if ( pMesh == nullptr )
+    { return; }
+
+    const auto subsetCount = pMesh->Subsets.size();
+    const auto indexCount  = pMesh->VertexIndices.size();
+
+    pMesh->SubsetBoxes  .resize( subsetCount );
+    pMesh->SubsetSpheres.resize( subsetCount );
+
+    for( size_t i=0; i<subsetCount; ++i )
+    {
+        const auto& subset = pMesh->Subsets[i];
+        auto count = subset.Count;
+        if ( subset.Offset > indexCount || count > indexCount - subset.Offset )
+        {
+            ELOG( "Error : Subset Out Of Range. index = %u", u32( i ) );
+            count = 0;
+        }
+
+        auto pIndices = pMesh->VertexIndices.data() + ( ( count > 0 ) ? subset.Offset : 0 );
+        pMesh->SubsetBoxes  [i] = BoundingBox   ::CreateFromIndexedPoints( pMesh->Positions.data(), pIndices, count );
+        pMesh->SubsetSpheres[i] = BoundingSphere::CreateFromIndexedPoints( pMesh->Positions.data(), pIndices, count );
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ボーンごとのバウンディングボックスを求めます.
+//-------------------------------------------------------------------------------------------------
+void MeshFactory::CalcBoneBounds( ResMesh* pMesh )
+{
+    if ( pMesh == nullptr )
+    { return; }
+
+    const auto boneCount   = u32( pMesh->Bones.size() );
+    const auto vertexCount = pMesh->Positions.size();
+
+    pMesh->BoneBoxes.clear();
+    pMesh->BoneBoxes.resize( boneCount );
+
+    if ( pMesh->BoneIndices.size() < vertexCount || pMesh->BoneWeights.size() < vertexCount )
+    { return; }
+
+    for( size_t i=0; i<vertexCount; ++i )
+    {
+        const auto& indices = pMesh->BoneIndices[i];
+        const auto& weights = pMesh->BoneWeights[i];
+
+        const u32 bones[4] = { indices.x, indices.y, indices.z, indices.w };
+        const f32 values[4] = { weights.x, weights.y, weights.z, weights.w };
+
+        for( u32 j=0; j<4; ++j )
+        {
+            if ( values[j] <= 0.0f || bones[j] >= boneCount )
+            { continue; }
+
+            auto local = Vector3::Transform( pMesh->Positions[i], pMesh->Bones[bones[j]].InvBindPose );
+            pMesh->BoneBoxes[bones[j]].Merge( local );
+        }
+    }
+}
+
 } // namespace asdx
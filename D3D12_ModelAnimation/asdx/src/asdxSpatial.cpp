@@ -0,0 +1,1060 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxSpatial.cpp
+// Desc : Spatial Index Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxSpatial.h>
+#include <cassert>
+#include <cmath>
+
+
+namespace /* anonymous */ {
+
+using namespace asdx;
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const u32 QUERY_STACK_SIZE   = 64;           //!< 八分木の走査スタックの大きさです.
+static const u32 MIN_TABLE_SIZE     = 64;           //!< ハッシュ表の最小の大きさです(2のべき乗).
+static const f32 MAX_CELL_COORD     = 1073741824.0f;//!< セル座標の絶対値の上限です(2^30).
+
+static_assert( QUERY_STACK_SIZE >= 7 * LOOSE_OCTREE_MAX_DEPTH + 1, "Query stack is too small." );
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// CONTAINMENT_TYPE enum
+///////////////////////////////////////////////////////////////////////////////////////////////////
+enum CONTAINMENT_TYPE
+{
+    CONTAINMENT_DISJOINT = 0,   //!< 交差しません.
+    CONTAINMENT_INTERSECTS,     //!< 一部が交差します.
+    CONTAINMENT_CONTAINS,       //!< 完全に含みます.
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// FrustumVolume structure
+// ViewFrustum の6平面によるボックスの判定です.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct FrustumVolume
+{
+    Vector4 planes[6];
+
+    explicit FrustumVolume( const ViewFrustum& frustum )
+    { frustum.GetPlanes( planes ); }
+
+    CONTAINMENT_TYPE Classify( const BoundingBox& box ) const
+    {
+        auto center = ( box.maxi + box.mini ) * 0.5f;
+        auto extent = ( box.maxi - box.mini ) * 0.5f;
+        auto result = CONTAINMENT_CONTAINS;
+
+        for( const auto& plane : planes )
+        {
+            auto dist   = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+            auto radius = fabsf( plane.x ) * extent.x + fabsf( plane.y ) * extent.y + fabsf( plane.z ) * extent.z;
+            if ( dist + radius < 0.0f )
+            { return CONTAINMENT_DISJOINT; }
+
+            if ( dist - radius < 0.0f )
+            { result = CONTAINMENT_INTERSECTS; }
+        }
+
+        return result;
+    }
+
+    bool Test( const BoundingBox& box ) const
+    { return Classify( box ) != CONTAINMENT_DISJOINT; }
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// SphereVolume structure
+// 球によるボックスの判定です.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct SphereVolume
+{
+    Vector3 center;
+    f32     radiusSq;
+
+    SphereVolume( const Vector3& _center, f32 radius )
+    : center  ( _center )
+    , radiusSq( radius * radius )
+    { /* DO_NOTHING */ }
+
+    CONTAINMENT_TYPE Classify( const BoundingBox& box ) const
+    {
+        if ( !Test( box ) )
+        { return CONTAINMENT_DISJOINT; }
+
+        // 最も遠い頂点が球に含まれれば, ボックス全体が含まれる.
+        auto corner = Vector3(
+            ( center.x - box.mini.x > box.maxi.x - center.x ) ? box.mini.x : box.maxi.x,
+            ( center.y - box.mini.y > box.maxi.y - center.y ) ? box.mini.y : box.maxi.y,
+            ( center.z - box.mini.z > box.maxi.z - center.z ) ? box.mini.z : box.maxi.z );
+
+        return ( Vector3::DistanceSq( center, corner ) <= radiusSq ) ? CONTAINMENT_CONTAINS : CONTAINMENT_INTERSECTS;
+    }
+
+    bool Test( const BoundingBox& box ) const
+    { return Vector3::DistanceSq( center, Vector3::Clamp( center, box.mini, box.maxi ) ) <= radiusSq; }
+};
+
+//-------------------------------------------------------------------------------------------------
+//      バウンディングスフィアを囲むバウンディングボックスを求めます.
+//-------------------------------------------------------------------------------------------------
+BoundingBox ToBox( const BoundingSphere& sphere )
+{
+    auto extent = Vector3( sphere.radius, sphere.radius, sphere.radius );
+    return BoundingBox( sphere.center - extent, sphere.center + extent );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      a が b を含むかどうか判定します.
+//-------------------------------------------------------------------------------------------------
+bool IsInside( const BoundingBox& a, const BoundingBox& b )
+{
+    return a.mini.x <= b.mini.x && a.mini.y <= b.mini.y && a.mini.z <= b.mini.z
+        && b.maxi.x <= a.maxi.x && b.maxi.y <= a.maxi.y && b.maxi.z <= a.maxi.z;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトを確保します. 未使用のオブジェクトがあれば再利用します.
+//-------------------------------------------------------------------------------------------------
+template<typename T>
+u32 AllocObject( std::vector<T>& objects, u32& freeHead )
+{
+    if ( freeHead != U32_MAX )
+    {
+        auto handle = freeHead;
+        freeHead = objects[handle].next;
+        return handle;
+    }
+
+    objects.push_back( T() );
+    return u32( objects.size() - 1 );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトを未使用にします.
+//-------------------------------------------------------------------------------------------------
+template<typename T>
+void FreeObject( std::vector<T>& objects, u32& freeHead, u32 handle )
+{
+    objects[handle].owner = U32_MAX;
+    objects[handle].prev  = U32_MAX;
+    objects[handle].next  = freeHead;
+    freeHead = handle;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトをリストの先頭に追加します.
+//-------------------------------------------------------------------------------------------------
+template<typename T>
+void PushFront( std::vector<T>& objects, u32& head, u32 handle, u32 owner )
+{
+    auto& object = objects[handle];
+    object.owner = owner;
+    object.prev  = U32_MAX;
+    object.next  = head;
+
+    if ( head != U32_MAX )
+    { objects[head].prev = handle; }
+
+    head = handle;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトをリストから外します.
+//-------------------------------------------------------------------------------------------------
+template<typename T>
+void Erase( std::vector<T>& objects, u32& head, u32 handle )
+{
+    const auto& object = objects[handle];
+
+    if ( object.prev != U32_MAX )
+    { objects[object.prev].next = object.next; }
+    else
+    { head = object.next; }
+
+    if ( object.next != U32_MAX )
+    { objects[object.next].prev = object.prev; }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ルートからの相対位置を [0, n) のセル座標に変換します. 範囲外は端に寄せます.
+//-------------------------------------------------------------------------------------------------
+u32 ToNodeCoord( f32 value, u32 n )
+{
+    if ( !( value >= 0.0f ) )
+    { return 0; }
+
+    if ( value >= f32( n ) )
+    { return n - 1; }
+
+    return u32( value );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      座標を格子のセル座標に変換します.
+//-------------------------------------------------------------------------------------------------
+s32 ToCellCoord( f32 value, f32 invCellSize )
+{
+    auto coord = floorf( value * invCellSize );
+    if ( !( coord > -MAX_CELL_COORD ) )
+    { return ( coord == coord ) ? -s32( MAX_CELL_COORD ) : 0; }
+
+    if ( coord > MAX_CELL_COORD )
+    { return s32( MAX_CELL_COORD ); }
+
+    return s32( coord );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      セル座標のハッシュ値を求めます.
+//-------------------------------------------------------------------------------------------------
+u32 HashCell( s32 x, s32 y, s32 z )
+{
+    auto h = u32( x ) * 0x8da6b343u ^ u32( y ) * 0xd8163841u ^ u32( z ) * 0xcb1ab31fu;
+    h ^= h >> 15;
+    h *= 0x2c1b3c6du;
+    h ^= h >> 12;
+    return h;
+}
+
+} // namespace /* anonymous */
+
+
+namespace asdx {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// LooseOctree class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------------
+LooseOctree::LooseOctree()
+: m_FreeHead( U32_MAX )
+, m_Count   ( 0 )
+, m_Depth   ( 0 )
+, m_Origin  ( 0.0f, 0.0f, 0.0f )
+, m_Size    ( 0.0f )
+{
+    for( u32 i=0; i<LOOSE_OCTREE_MAX_DEPTH; ++i )
+    { m_LevelOffset[i] = 0; }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------------
+LooseOctree::~LooseOctree()
+{ Term(); }
+
+//-------------------------------------------------------------------------------------------------
+//      初期化処理を行います.
+//-------------------------------------------------------------------------------------------------
+bool LooseOctree::Init( const BoundingBox& bounds, u32 depth )
+{
+    Term();
+
+    if ( depth == 0 || depth > LOOSE_OCTREE_MAX_DEPTH )
+    { return false; }
+
+    auto size = bounds.maxi - bounds.mini;
+    auto edge = Max( size.x, Max( size.y, size.z ) );
+    if ( !( edge > 0.0f ) || edge == F32_MAX )
+    { return false; }
+
+    u32 nodeCount = 0;
+    for( u32 i=0; i<depth; ++i )
+    {
+        m_LevelOffset[i] = nodeCount;
+        nodeCount += 1u << ( 3 * i );
+    }
+
+    Node node;
+    node.head  = U32_MAX;
+    node.total = 0;
+    m_Nodes.assign( nodeCount, node );
+
+    m_Depth  = depth;
+    m_Size   = edge;
+    m_Origin = bounds.GetCenter() - Vector3( edge, edge, edge ) * 0.5f;
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      終了処理を行います.
+//-------------------------------------------------------------------------------------------------
+void LooseOctree::Term()
+{
+    m_Nodes  .clear();
+    m_Objects.clear();
+    m_Nodes  .shrink_to_fit();
+    m_Objects.shrink_to_fit();
+
+    m_FreeHead = U32_MAX;
+    m_Count    = 0;
+    m_Depth    = 0;
+    m_Size     = 0.0f;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      全てのオブジェクトを削除します.
+//-------------------------------------------------------------------------------------------------
+void LooseOctree::Clear()
+{
+    for( auto& node : m_Nodes )
+    {
+        node.head  = U32_MAX;
+        node.total = 0;
+    }
+
+    m_Objects.clear();
+    m_FreeHead = U32_MAX;
+    m_Count    = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトを登録します.
+//-------------------------------------------------------------------------------------------------
+u32 LooseOctree::Insert( const BoundingBox& box )
+{
+    assert( !m_Nodes.empty() );
+
+    auto handle = AllocObject( m_Objects, m_FreeHead );
+    m_Objects[handle].box = box;
+    Link( handle, FindNode( box ) );
+    m_Count++;
+
+    return handle;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトを登録します.
+//-------------------------------------------------------------------------------------------------
+u32 LooseOctree::Insert( const BoundingSphere& sphere )
+{ return Insert( ToBox( sphere ) ); }
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトを移動します.
+//-------------------------------------------------------------------------------------------------
+void LooseOctree::Move( u32 handle, const BoundingBox& box )
+{
+    assert( handle < m_Objects.size() && m_Objects[handle].owner != U32_MAX );
+
+    auto node = FindNode( box );
+    m_Objects[handle].box = box;
+
+    if ( m_Objects[handle].owner == node )
+    { return; }
+
+    Unlink( handle );
+    Link( handle, node );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトを移動します.
+//-------------------------------------------------------------------------------------------------
+void LooseOctree::Move( u32 handle, const BoundingSphere& sphere )
+{ Move( handle, ToBox( sphere ) ); }
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトを削除します.
+//-------------------------------------------------------------------------------------------------
+void LooseOctree::Remove( u32 handle )
+{
+    assert( handle < m_Objects.size() && m_Objects[handle].owner != U32_MAX );
+
+    Unlink( handle );
+    FreeObject( m_Objects, m_FreeHead, handle );
+    m_Count--;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      視錐台と交差するオブジェクトを求めます.
+//-------------------------------------------------------------------------------------------------
+void LooseOctree::QueryFrustum( const ViewFrustum& frustum, std::vector<u32>* pResults ) const
+{
+    assert( pResults != nullptr );
+
+    const FrustumVolume volume( frustum );
+    Query(
+        [&]( const BoundingBox& box ) { return volume.Classify( box ); },
+        [&]( const BoundingBox& box ) { return volume.Test( box ); },
+        pResults );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      球と交差するオブジェクトを求めます.
+//-------------------------------------------------------------------------------------------------
+void LooseOctree::QueryRadius( const Vector3& center, f32 radius, std::vector<u32>* pResults ) const
+{
+    assert( pResults != nullptr );
+
+    const SphereVolume volume( center, radius );
+    Query(
+        [&]( const BoundingBox& box ) { return volume.Classify( box ); },
+        [&]( const BoundingBox& box ) { return volume.Test( box ); },
+        pResults );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトのバウンディングボックスを取得します.
+//-------------------------------------------------------------------------------------------------
+const BoundingBox& LooseOctree::GetBounds( u32 handle ) const
+{
+    assert( handle < m_Objects.size() && m_Objects[handle].owner != U32_MAX );
+    return m_Objects[handle].box;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      登録されているオブジェクト数を取得します.
+//-------------------------------------------------------------------------------------------------
+u32 LooseOctree::GetCount() const
+{ return m_Count; }
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトの登録先のノードを求めます.
+//-------------------------------------------------------------------------------------------------
+u32 LooseOctree::FindNode( const BoundingBox& box ) const
+{
+    auto size   = box.maxi - box.mini;
+    auto edge   = Max( size.x, Max( size.y, size.z ) );
+    auto center = box.GetCenter() - m_Origin;
+
+    // 最も長い辺がセルの一辺以下となる最も深い階層から探す.
+    auto level    = m_Depth - 1;
+    auto cellSize = m_Size / f32( 1u << level );
+    while( level > 0 && !( edge <= cellSize ) )
+    {
+        level--;
+        cellSize *= 2.0f;
+    }
+
+    // 丸め誤差や範囲外の場合は, 広げたセルに収まるまで上の階層に移る.
+    while( level > 0 )
+    {
+        auto n = 1u << level;
+        auto x = ToNodeCoord( center.x / cellSize, n );
+        auto y = ToNodeCoord( center.y / cellSize, n );
+        auto z = ToNodeCoord( center.z / cellSize, n );
+
+        if ( IsInside( GetLooseBounds( level, x, y, z ), box ) )
+        { return m_LevelOffset[level] + ( z * n + y ) * n + x; }
+
+        level--;
+        cellSize *= 2.0f;
+    }
+
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトをノードに登録します.
+//-------------------------------------------------------------------------------------------------
+void LooseOctree::Link( u32 handle, u32 node )
+{
+    PushFront( m_Objects, m_Nodes[node].head, handle, node );
+
+    u32 level, x, y, z;
+    GetNodeCoord( node, level, x, y, z );
+    for( ;; )
+    {
+        auto n = 1u << level;
+        m_Nodes[m_LevelOffset[level] + ( z * n + y ) * n + x].total++;
+        if ( level == 0 )
+        { break; }
+
+        level--;
+        x >>= 1;
+        y >>= 1;
+        z >>= 1;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトをノードから外します.
+//-------------------------------------------------------------------------------------------------
+void LooseOctree::Unlink( u32 handle )
+{
+    auto node = m_Objects[handle].owner;
+    Erase( m_Objects, m_Nodes[node].head, handle );
+
+    u32 level, x, y, z;
+    GetNodeCoord( node, level, x, y, z );
+    for( ;; )
+    {
+        auto n = 1u << level;
+        m_Nodes[m_LevelOffset[level] + ( z * n + y ) * n + x].total--;
+        if ( level == 0 )
+        { break; }
+
+        level--;
+        x >>= 1;
+        y >>= 1;
+        z >>= 1;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ノード番号から階層とセル座標を求めます.
+//-------------------------------------------------------------------------------------------------
+void LooseOctree::GetNodeCoord( u32 node, u32& level, u32& x, u32& y, u32& z ) const
+{
+    level = m_Depth - 1;
+    while( m_LevelOffset[level] > node )
+    { level--; }
+
+    auto n     = 1u << level;
+    auto local = node - m_LevelOffset[level];
+    x = local % n;
+    y = ( local / n ) % n;
+    z = local / ( n * n );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ノードのセルを各辺2倍に広げたバウンディングボックスを求めます.
+//-------------------------------------------------------------------------------------------------
+BoundingBox LooseOctree::GetLooseBounds( u32 level, u32 x, u32 y, u32 z ) const
+{
+    auto cellSize = m_Size / f32( 1u << level );
+    auto mini = m_Origin + Vector3( f32( x ) - 0.5f, f32( y ) - 0.5f, f32( z ) - 0.5f ) * cellSize;
+    auto maxi = m_Origin + Vector3( f32( x ) + 1.5f, f32( y ) + 1.5f, f32( z ) + 1.5f ) * cellSize;
+    return BoundingBox( mini, maxi );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      問い合わせを行います.
+//      classify はノードの判定, test はオブジェクトの判定です. ルートは範囲外のオブジェクトも
+//      持つため, ノードの判定を行いません.
+//-------------------------------------------------------------------------------------------------
+template<typename Classify, typename Test>
+void LooseOctree::Query( const Classify& classify, const Test& test, std::vector<u32>* pResults ) const
+{
+    if ( m_Count == 0 )
+    { return; }
+
+    struct Entry
+    {
+        u32     level;
+        u32     x;
+        u32     y;
+        u32     z;
+        bool    inside;
+    };
+
+    Entry stack[QUERY_STACK_SIZE];
+    u32   top = 0;
+    stack[top++] = { 0, 0, 0, 0, false };
+
+    while( top > 0 )
+    {
+        auto entry = stack[--top];
+        auto n     = 1u << entry.level;
+        const auto& node = m_Nodes[m_LevelOffset[entry.level] + ( entry.z * n + entry.y ) * n + entry.x];
+
+        if ( !entry.inside && entry.level > 0 )
+        {
+            auto type = classify( GetLooseBounds( entry.level, entry.x, entry.y, entry.z ) );
+            if ( type == CONTAINMENT_DISJOINT )
+            { continue; }
+
+            entry.inside = ( type == CONTAINMENT_CONTAINS );
+        }
+
+        for( auto i=node.head; i != U32_MAX; i = m_Objects[i].next )
+        {
+            if ( entry.inside || test( m_Objects[i].box ) )
+            { pResults->push_back( i ); }
+        }
+
+        if ( entry.level + 1 >= m_Depth )
+        { continue; }
+
+        auto level  = entry.level + 1;
+        auto offset = m_LevelOffset[level];
+        auto m      = n * 2;
+        for( u32 j=0; j<8; ++j )
+        {
+            auto x = entry.x * 2 + ( j & 1 );
+            auto y = entry.y * 2 + ( ( j >> 1 ) & 1 );
+            auto z = entry.z * 2 + ( j >> 2 );
+            if ( m_Nodes[offset + ( z * m + y ) * m + x].total > 0 )
+            { stack[top++] = { level, x, y, z, entry.inside }; }
+        }
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// SpatialHashGrid class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------------
+SpatialHashGrid::SpatialHashGrid()
+: m_FreeHead    ( U32_MAX )
+, m_Count       ( 0 )
+, m_CellSize    ( 0.0f )
+, m_InvCellSize ( 0.0f )
+, m_MaxExtent   ( 0.0f )
+{
+    for( u32 i=0; i<3; ++i )
+    {
+        m_CellMin[i] = S32_MAX;
+        m_CellMax[i] = S32_MIN;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------------
+SpatialHashGrid::~SpatialHashGrid()
+{ Term(); }
+
+//-------------------------------------------------------------------------------------------------
+//      初期化処理を行います.
+//-------------------------------------------------------------------------------------------------
+bool SpatialHashGrid::Init( f32 cellSize )
+{
+    Term();
+
+    if ( !( cellSize > 0.0f ) || cellSize == F32_MAX )
+    { return false; }
+
+    m_CellSize    = cellSize;
+    m_InvCellSize = 1.0f / cellSize;
+    m_Table.assign( MIN_TABLE_SIZE, U32_MAX );
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      終了処理を行います.
+//-------------------------------------------------------------------------------------------------
+void SpatialHashGrid::Term()
+{
+    m_Cells  .clear();
+    m_Table  .clear();
+    m_Objects.clear();
+    m_Cells  .shrink_to_fit();
+    m_Table  .shrink_to_fit();
+    m_Objects.shrink_to_fit();
+
+    m_FreeHead    = U32_MAX;
+    m_Count       = 0;
+    m_CellSize    = 0.0f;
+    m_InvCellSize = 0.0f;
+    m_MaxExtent   = 0.0f;
+
+    for( u32 i=0; i<3; ++i )
+    {
+        m_CellMin[i] = S32_MAX;
+        m_CellMax[i] = S32_MIN;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      全てのオブジェクトを削除します.
+//-------------------------------------------------------------------------------------------------
+void SpatialHashGrid::Clear()
+{
+    m_Cells  .clear();
+    m_Objects.clear();
+    for( auto& slot : m_Table )
+    { slot = U32_MAX; }
+
+    m_FreeHead  = U32_MAX;
+    m_Count     = 0;
+    m_MaxExtent = 0.0f;
+
+    for( u32 i=0; i<3; ++i )
+    {
+        m_CellMin[i] = S32_MAX;
+        m_CellMax[i] = S32_MIN;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトを登録します.
+//-------------------------------------------------------------------------------------------------
+u32 SpatialHashGrid::Insert( const BoundingBox& box )
+{
+    assert( !m_Table.empty() );
+
+    auto handle = AllocObject( m_Objects, m_FreeHead );
+    m_Objects[handle].box = box;
+    Link( handle, box );
+    m_Count++;
+
+    return handle;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトを登録します.
+//-------------------------------------------------------------------------------------------------
+u32 SpatialHashGrid::Insert( const BoundingSphere& sphere )
+{ return Insert( ToBox( sphere ) ); }
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトを移動します.
+//-------------------------------------------------------------------------------------------------
+void SpatialHashGrid::Move( u32 handle, const BoundingBox& box )
+{
+    assert( handle < m_Objects.size() && m_Objects[handle].owner != U32_MAX );
+
+    auto center = box.GetCenter();
+    auto x = ToCellCoord( center.x, m_InvCellSize );
+    auto y = ToCellCoord( center.y, m_InvCellSize );
+    auto z = ToCellCoord( center.z, m_InvCellSize );
+
+    auto& object = m_Objects[handle];
+    auto& cell   = m_Cells[object.owner];
+    object.box = box;
+
+    if ( cell.x == x && cell.y == y && cell.z == z )
+    {
+        // セルが変わらない場合は, はみ出し量のみ更新する.
+        auto loose = GetLooseBounds( cell );
+        if ( !IsInside( loose, box ) )
+        {
+            Unlink( handle );
+            Link( handle, box );
+        }
+        return;
+    }
+
+    Unlink( handle );
+    Link( handle, box );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトを移動します.
+//-------------------------------------------------------------------------------------------------
+void SpatialHashGrid::Move( u32 handle, const BoundingSphere& sphere )
+{ Move( handle, ToBox( sphere ) ); }
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトを削除します.
+//-------------------------------------------------------------------------------------------------
+void SpatialHashGrid::Remove( u32 handle )
+{
+    assert( handle < m_Objects.size() && m_Objects[handle].owner != U32_MAX );
+
+    Unlink( handle );
+    FreeObject( m_Objects, m_FreeHead, handle );
+    m_Count--;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      視錐台と交差するオブジェクトを求めます.
+//-------------------------------------------------------------------------------------------------
+void SpatialHashGrid::QueryFrustum( const ViewFrustum& frustum, std::vector<u32>* pResults ) const
+{
+    assert( pResults != nullptr );
+
+    BoundingBox range;
+    for( const auto& corner : frustum.GetCorners() )
+    { range.Merge( corner ); }
+
+    const FrustumVolume volume( frustum );
+    Query( range,
+        [&]( const BoundingBox& box ) { return volume.Classify( box ); },
+        [&]( const BoundingBox& box ) { return volume.Test( box ); },
+        pResults );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      球と交差するオブジェクトを求めます.
+//-------------------------------------------------------------------------------------------------
+void SpatialHashGrid::QueryRadius( const Vector3& center, f32 radius, std::vector<u32>* pResults ) const
+{
+    assert( pResults != nullptr );
+
+    const SphereVolume volume( center, radius );
+    Query( ToBox( BoundingSphere( center, radius ) ),
+        [&]( const BoundingBox& box ) { return volume.Classify( box ); },
+        [&]( const BoundingBox& box ) { return volume.Test( box ); },
+        pResults );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトのバウンディングボックスを取得します.
+//-------------------------------------------------------------------------------------------------
+const BoundingBox& SpatialHashGrid::GetBounds( u32 handle ) const
+{
+    assert( handle < m_Objects.size() && m_Objects[handle].owner != U32_MAX );
+    return m_Objects[handle].box;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      登録されているオブジェクト数を取得します.
+//-------------------------------------------------------------------------------------------------
+u32 SpatialHashGrid::GetCount() const
+{ return m_Count; }
+
+//-------------------------------------------------------------------------------------------------
+//      使用中のセル数を取得します.
+//-------------------------------------------------------------------------------------------------
+u32 SpatialHashGrid::GetCellCount() const
+{ return u32( m_Cells.size() ); }
+
+//-------------------------------------------------------------------------------------------------
+//      セル座標からセル番号を求めます. 見つからない場合は U32_MAX を返却します.
+//-------------------------------------------------------------------------------------------------
+u32 SpatialHashGrid::FindCell( s32 x, s32 y, s32 z ) const
+{
+    const auto mask = u32( m_Table.size() - 1 );
+    for( auto slot = HashCell( x, y, z ) & mask; m_Table[slot] != U32_MAX; slot = ( slot + 1 ) & mask )
+    {
+        const auto& cell = m_Cells[m_Table[slot]];
+        if ( cell.x == x && cell.y == y && cell.z == z )
+        { return m_Table[slot]; }
+    }
+
+    return U32_MAX;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      セルを追加します.
+//-------------------------------------------------------------------------------------------------
+u32 SpatialHashGrid::AddCell( s32 x, s32 y, s32 z )
+{
+    // 使用率を1/2以下に保つ.
+    if ( ( m_Cells.size() + 1 ) * 2 > m_Table.size() )
+    { Rehash( u32( m_Table.size() * 2 ) ); }
+
+    Cell cell;
+    cell.x      = x;
+    cell.y      = y;
+    cell.z      = z;
+    cell.head   = U32_MAX;
+    cell.count  = 0;
+    cell.extent = 0.0f;
+
+    auto index = u32( m_Cells.size() );
+    m_Cells.push_back( cell );
+
+    const s32 coord[3] = { x, y, z };
+    for( u32 i=0; i<3; ++i )
+    {
+        m_CellMin[i] = Min( m_CellMin[i], coord[i] );
+        m_CellMax[i] = Max( m_CellMax[i], coord[i] );
+    }
+
+    const auto mask = u32( m_Table.size() - 1 );
+    auto slot = HashCell( x, y, z ) & mask;
+    while( m_Table[slot] != U32_MAX )
+    { slot = ( slot + 1 ) & mask; }
+
+    m_Table[slot] = index;
+    return index;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      空になったセルを削除します.
+//-------------------------------------------------------------------------------------------------
+void SpatialHashGrid::RemoveCell( u32 index )
+{
+    assert( m_Cells[index].count == 0 );
+
+    const auto mask = u32( m_Table.size() - 1 );
+    auto findSlot = [&]( u32 target )
+    {
+        const auto& cell = m_Cells[target];
+        auto slot = HashCell( cell.x, cell.y, cell.z ) & mask;
+        while( m_Table[slot] != target )
+        { slot = ( slot + 1 ) & mask; }
+        return slot;
+    };
+
+    // 後ろの要素を詰めて削除する(線形探索のため墓標は使わない).
+    auto hole = findSlot( index );
+    for( auto slot = ( hole + 1 ) & mask; m_Table[slot] != U32_MAX; slot = ( slot + 1 ) & mask )
+    {
+        const auto& cell = m_Cells[m_Table[slot]];
+        auto home = HashCell( cell.x, cell.y, cell.z ) & mask;
+
+        // home が (hole, slot] の外にあれば hole に移せる.
+        auto between = ( hole <= slot ) ? ( hole < home && home <= slot ) : ( hole < home || home <= slot );
+        if ( between )
+        { continue; }
+
+        m_Table[hole] = m_Table[slot];
+        hole = slot;
+    }
+    m_Table[hole] = U32_MAX;
+
+    // 末尾のセルを空いた位置に移す. 移したセルのオブジェクトは登録先を更新する.
+    auto last = u32( m_Cells.size() - 1 );
+    if ( index != last )
+    {
+        m_Table[findSlot( last )] = index;
+        m_Cells[index] = m_Cells[last];
+
+        for( auto i=m_Cells[index].head; i != U32_MAX; i = m_Objects[i].next )
+        { m_Objects[i].owner = index; }
+    }
+
+    m_Cells.pop_back();
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ハッシュ表を作り直します.
+//-------------------------------------------------------------------------------------------------
+void SpatialHashGrid::Rehash( u32 capacity )
+{
+    m_Table.assign( capacity, U32_MAX );
+
+    const auto mask = capacity - 1;
+    for( u32 i=0; i<m_Cells.size(); ++i )
+    {
+        const auto& cell = m_Cells[i];
+        auto slot = HashCell( cell.x, cell.y, cell.z ) & mask;
+        while( m_Table[slot] != U32_MAX )
+        { slot = ( slot + 1 ) & mask; }
+
+        m_Table[slot] = i;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトを中心が含まれるセルに登録します.
+//-------------------------------------------------------------------------------------------------
+void SpatialHashGrid::Link( u32 handle, const BoundingBox& box )
+{
+    auto center = box.GetCenter();
+    auto x = ToCellCoord( center.x, m_InvCellSize );
+    auto y = ToCellCoord( center.y, m_InvCellSize );
+    auto z = ToCellCoord( center.z, m_InvCellSize );
+
+    auto index = FindCell( x, y, z );
+    if ( index == U32_MAX )
+    { index = AddCell( x, y, z ); }
+
+    auto& cell = m_Cells[index];
+    PushFront( m_Objects, cell.head, handle, index );
+    cell.count++;
+
+    // セルからはみ出す量を記録する.
+    auto mini = Vector3( f32( x ), f32( y ), f32( z ) ) * m_CellSize;
+    auto maxi = mini + Vector3( m_CellSize, m_CellSize, m_CellSize );
+    auto lo   = mini - box.mini;
+    auto hi   = box.maxi - maxi;
+    auto over = Max( Max( lo.x, Max( lo.y, lo.z ) ), Max( hi.x, Max( hi.y, hi.z ) ) );
+
+    cell.extent = Max( cell.extent, over );
+    m_MaxExtent = Max( m_MaxExtent, cell.extent );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      オブジェクトをセルから外します. 空になったセルは削除します.
+//-------------------------------------------------------------------------------------------------
+void SpatialHashGrid::Unlink( u32 handle )
+{
+    auto  index = m_Objects[handle].owner;
+    auto& cell  = m_Cells[index];
+
+    Erase( m_Objects, cell.head, handle );
+    cell.count--;
+
+    if ( cell.count == 0 )
+    { RemoveCell( index ); }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      セルを登録されたオブジェクトのはみ出し量だけ広げたバウンディングボックスを求めます.
+//-------------------------------------------------------------------------------------------------
+BoundingBox SpatialHashGrid::GetLooseBounds( const Cell& cell ) const
+{
+    auto mini = Vector3( f32( cell.x ), f32( cell.y ), f32( cell.z ) ) * m_CellSize;
+    auto maxi = mini + Vector3( m_CellSize, m_CellSize, m_CellSize );
+    auto over = Vector3( cell.extent, cell.extent, cell.extent );
+    return BoundingBox( mini - over, maxi + over );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      問い合わせを行います.
+//      range は問い合わせ範囲を囲むボックス, classify はセルの判定, test はオブジェクトの判定です.
+//-------------------------------------------------------------------------------------------------
+template<typename Classify, typename Test>
+void SpatialHashGrid::Query
+(
+    const BoundingBox&  range,
+    const Classify&     classify,
+    const Test&         test,
+    std::vector<u32>*   pResults
+) const
+{
+    if ( m_Count == 0 )
+    { return; }
+
+    auto visit = [&]( const Cell& cell )
+    {
+        auto type = classify( GetLooseBounds( cell ) );
+        if ( type == CONTAINMENT_DISJOINT )
+        { return; }
+
+        for( auto i=cell.head; i != U32_MAX; i = m_Objects[i].next )
+        {
+            if ( type == CONTAINMENT_CONTAINS || test( m_Objects[i].box ) )
+            { pResults->push_back( i ); }
+        }
+    };
+
+    // はみ出し量の分だけ範囲を広げて, 対象となるセル座標の範囲を求める.
+    auto over = Vector3( m_MaxExtent, m_MaxExtent, m_MaxExtent );
+    auto mini = range.mini - over;
+    auto maxi = range.maxi + over;
+
+    s32 lo[3] = {
+        ToCellCoord( mini.x, m_InvCellSize ),
+        ToCellCoord( mini.y, m_InvCellSize ),
+        ToCellCoord( mini.z, m_InvCellSize ) };
+    s32 hi[3] = {
+        ToCellCoord( maxi.x, m_InvCellSize ),
+        ToCellCoord( maxi.y, m_InvCellSize ),
+        ToCellCoord( maxi.z, m_InvCellSize ) };
+
+    // 使用したことのあるセル座標の範囲に絞る.
+    u64 rangeCount = 1;
+    for( u32 i=0; i<3; ++i )
+    {
+        lo[i] = Max( lo[i], m_CellMin[i] );
+        hi[i] = Min( hi[i], m_CellMax[i] );
+        if ( hi[i] < lo[i] )
+        { return; }
+
+        rangeCount *= u64( s64( hi[i] ) - s64( lo[i] ) + 1 );
+        if ( rangeCount > m_Cells.size() )
+        { break; }
+    }
+
+    // 範囲内のセル数が使用中のセル数を超える場合は, 使用中のセルを全て判定する.
+    if ( rangeCount > m_Cells.size() )
+    {
+        for( const auto& cell : m_Cells )
+        { visit( cell ); }
+        return;
+    }
+
+    for( auto z=lo[2]; z<=hi[2]; ++z )
+    for( auto y=lo[1]; y<=hi[1]; ++y )
+    for( auto x=lo[0]; x<=hi[0]; ++x )
+    {
+        auto index = FindCell( x, y, z );
+        if ( index != U32_MAX )
+        { visit( m_Cells[index] ); }
+    }
+}
+
+} // namespace asdx
@@ -0,0 +1,146 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxStringInterner.cpp
+// Desc : String Interner.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxStringInterner.h>
+#include <asdxHash.h>
+#include <cassert>
+#include <cstring>
+#include <cwchar>
+
+
+namespace asdx {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// StringInterner class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+StringInterner StringInterner::s_Instance;
+
+//-------------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------------
+StringInterner::StringInterner()
+: m_Mutex      ()
+, m_Names      ()
+, m_Chunks     ()
+, m_ChunkUsed  ( 0 )
+, m_ChunkLength( 0 )
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------------
+StringInterner::~StringInterner()
+{
+    for( auto pChunk : m_Chunks )
+    { delete [] pChunk; }
+
+    m_Chunks.clear();
+    m_Names.Clear();
+}
+
+//-------------------------------------------------------------------------------------------------
+//      インスタンスを取得します.
+//-------------------------------------------------------------------------------------------------
+StringInterner& StringInterner::GetInstance()
+{ return s_Instance; }
+
+//-------------------------------------------------------------------------------------------------
+//      文字列を登録します.
+//-------------------------------------------------------------------------------------------------
+u32 StringInterner::Intern( const char16* pName )
+{
+    if ( pName == nullptr )
+    { return NAME_ID_INVALID; }
+
+    auto id     = Fnv1a( pName ).GetHash();
+    auto length = u32( wcslen( pName ) ) + 1;
+
+    std::lock_guard<std::mutex> guard( m_Mutex );
+
+    auto ppName = m_Names.Find( id );
+    if ( ppName != nullptr )
+    {
+        if ( wcscmp( *ppName, pName ) == 0 )
+        { return id; }
+
+        assert( false && "Name ID collision." );
+        return NAME_ID_INVALID;
+    }
+
+    if ( id == NAME_ID_INVALID )
+    {
+        assert( false && "Name ID collision." );
+        return NAME_ID_INVALID;
+    }
+
+    auto pChars = AllocChars( length );
+    memcpy( pChars, pName, sizeof(char16) * length );
+    m_Names.Insert( id, pChars );
+
+    return id;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      名前IDから文字列を取得します.
+//-------------------------------------------------------------------------------------------------
+const char16* StringInterner::GetName( u32 id ) const
+{
+    std::lock_guard<std::mutex> guard( m_Mutex );
+
+    auto ppName = m_Names.Find( id );
+    return ( ppName != nullptr ) ? *ppName : nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      登録した文字列の数を取得します.
+//-------------------------------------------------------------------------------------------------
+u32 StringInterner::GetCount() const
+{
+    std::lock_guard<std::mutex> guard( m_Mutex );
+    return m_Names.GetCount();
+}
+
+//-------------------------------------------------------------------------------------------------
+//      メモリを再確保せずに登録できる文字列の数と合計文字数を指定します.
+//-------------------------------------------------------------------------------------------------
+void StringInterner::Reserve( u32 count, u32 length )
+{
+    std::lock_guard<std::mutex> guard( m_Mutex );
+
+    m_Names.Reserve( m_Names.GetCount() + count );
+
+    if ( m_ChunkUsed + length > m_ChunkLength )
+    { AddChunk( length ); }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      文字列を格納する領域を追加します.
+//-------------------------------------------------------------------------------------------------
+void StringInterner::AddChunk( u32 length )
+{
+    auto size = ( length > CHUNK_LENGTH ) ? length : CHUNK_LENGTH;
+    m_Chunks.push_back( new char16 [size] );
+    m_ChunkUsed   = 0;
+    m_ChunkLength = size;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      文字列を格納する領域を確保します.
+//-------------------------------------------------------------------------------------------------
+char16* StringInterner::AllocChars( u32 length )
+{
+    if ( m_ChunkUsed + length > m_ChunkLength )
+    { AddChunk( length ); }
+
+    auto pChars = m_Chunks.back() + m_ChunkUsed;
+    m_ChunkUsed += length;
+    return pChars;
+}
+
+} // namespace asdx
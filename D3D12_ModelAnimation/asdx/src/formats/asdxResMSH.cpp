@@ -8,6 +8,7 @@
 // Includes
 //-------------------------------------------------------------------------------------------------
 #include <asdxLogger.h>
+#include <asdxStringInterner.h>
 #include "asdxResMSH.h"
 
 
@@ -146,9 +147,12 @@ bool LoadResMeshFromMSH( const char16* filename, ResMesh* pResult )
         fread( &bone, sizeof(bone), 1, pFile );
 
         (*pResult).Bones[i].Name        = bone.Name;
+        (*pResult).Bones[i].NameId      = asdx::StringInterner::GetInstance().Intern( (*pResult).Bones[i].Name.c_str() );
         (*pResult).Bones[i].ParentId    = bone.ParentId;
         (*pResult).Bones[i].BindPose    = asdx::Matrix::CreateTranslation( bone.Position );
-        (*pResult).Bones[i].InvBindPose = asdx::Matrix::Invert( (*pResult).Bones[i].BindPose );
+        (*pResult).Bones[i].InvBindPose = asdx::Matrix::Invert(
+            (*pResult).Bones[i].BindPose,
+            asdx::Matrix::Classify( (*pResult).Bones[i].BindPose ) );
     }
 
     fclose( pFile );
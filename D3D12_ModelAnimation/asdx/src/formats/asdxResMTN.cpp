@@ -8,6 +8,7 @@
 // Includes
 //-------------------------------------------------------------------------------------------------
 #include <asdxLogger.h>
+#include <asdxStringInterner.h>
 #include "asdxResMTN.h"
 
 
@@ -111,7 +112,8 @@ bool LoadResMotionFromMTN( const char16* filename, ResMotion* pResult )
         MTN_KEYFRAME_SET keyFrameSet;
         fread( &keyFrameSet, sizeof(keyFrameSet), 1, pFile );
 
-        (*pResult).Bones[i].BoneName = keyFrameSet.BoneName;
+        (*pResult).Bones[i].BoneName   = keyFrameSet.BoneName;
+        (*pResult).Bones[i].BoneNameId = asdx::StringInterner::GetInstance().Intern( (*pResult).Bones[i].BoneName.c_str() );
         (*pResult).Bones[i].KeyFrames.resize( keyFrameSet.KeyFrameCount );
 
         for( u32 j=0; j<keyFrameSet.KeyFrameCount; ++j )
@@ -0,0 +1,316 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxBoundsKernel.h
+// Desc : Batch Bounding Volume Kernels.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "asdxWide.h"
+
+
+namespace asdx {
+namespace wide {
+inline namespace ASDX_KERNEL_ISA {
+
+//-------------------------------------------------------------------------------------------------
+//      xyz配列(AoS)の区間 [begin, end) の最小値と最大値を求めます.
+//
+//      pMinMax は (minX, minY, minZ, maxX, maxY, maxZ) で, 求めた値とマージして書き戻します.
+//      W::Width 個の点を3レジスタで読み込み, レーンごとの成分は読み込み位置から決まります.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 BoundsArray3( const f32* pIn, u32 begin, u32 end, f32* pMinMax )
+{
+    typename W::Reg mini[3], maxi[3];
+    for( u32 r=0; r<3; ++r )
+    {
+        mini[r] = W::Replicate(  F32_MAX );
+        maxi[r] = W::Replicate( -F32_MAX );
+    }
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        for( u32 r=0; r<3; ++r )
+        {
+            auto v = W::Load( pIn + i * 3 + r * W::Width );
+            mini[r] = W::Min( mini[r], v );
+            maxi[r] = W::Max( maxi[r], v );
+        }
+    }
+
+    for( u32 r=0; r<3; ++r )
+    {
+        f32 lo[W::Width], hi[W::Width];
+        W::Store( lo, mini[r] );
+        W::Store( hi, maxi[r] );
+        for( u32 j=0; j<W::Width; ++j )
+        {
+            auto c = ( r * W::Width + j ) % 3;
+            pMinMax[c]     = ( lo[j] < pMinMax[c]     ) ? lo[j] : pMinMax[c];
+            pMinMax[3 + c] = ( hi[j] > pMinMax[3 + c] ) ? hi[j] : pMinMax[3 + c];
+        }
+    }
+
+    return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      インデックス配列の区間 [begin, end) が指す点をレジスタに読み込みます.
+//      pIndices が nullptr の場合は番号をそのまま点の番号とします.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+ASDX_INLINE void GatherPoints( const f32* pIn, const u32* pIndices, u32 i, typename W::Reg* p )
+{
+    if ( pIndices == nullptr )
+    {
+        W::LoadAoS3( pIn + i * 3, p[0], p[1], p[2] );
+        return;
+    }
+
+    f32 points[3][W::Width];
+    for( u32 j=0; j<W::Width; ++j )
+    {
+        const auto* pos = pIn + pIndices[i + j] * 3;
+        points[0][j] = pos[0];
+        points[1][j] = pos[1];
+        points[2][j] = pos[2];
+    }
+
+    p[0] = W::Load( points[0] );
+    p[1] = W::Load( points[1] );
+    p[2] = W::Load( points[2] );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      インデックス配列の区間 [begin, end) が指す点の最小値と最大値を求めます.
+//      pMinMax は BoundsArray3() と同じです.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 BoundsIndexed3( const f32* pIn, const u32* pIndices, u32 begin, u32 end, f32* pMinMax )
+{
+    typename W::Reg mini[3], maxi[3];
+    for( u32 c=0; c<3; ++c )
+    {
+        mini[c] = W::Replicate( pMinMax[c] );
+        maxi[c] = W::Replicate( pMinMax[3 + c] );
+    }
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        typename W::Reg p[3];
+        GatherPoints<W>( pIn, pIndices, i, p );
+        for( u32 c=0; c<3; ++c )
+        {
+            mini[c] = W::Min( mini[c], p[c] );
+            maxi[c] = W::Max( maxi[c], p[c] );
+        }
+    }
+
+    for( u32 c=0; c<3; ++c )
+    {
+        f32 lo[W::Width], hi[W::Width];
+        W::Store( lo, mini[c] );
+        W::Store( hi, maxi[c] );
+        for( u32 j=0; j<W::Width; ++j )
+        {
+            pMinMax[c]     = ( lo[j] < pMinMax[c]     ) ? lo[j] : pMinMax[c];
+            pMinMax[3 + c] = ( hi[j] > pMinMax[3 + c] ) ? hi[j] : pMinMax[3 + c];
+        }
+    }
+
+    return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      点と中心の距離の2乗を求めます.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+ASDX_INLINE typename W::Reg DistanceSq3( const typename W::Reg* p, const f32* pCenter )
+{
+    auto dx = W::Sub( p[0], W::Replicate( pCenter[0] ) );
+    auto dy = W::Sub( p[1], W::Replicate( pCenter[1] ) );
+    auto dz = W::Sub( p[2], W::Replicate( pCenter[2] ) );
+    return W::Mad( dz, dz, W::Mad( dy, dy, W::Mul( dx, dx ) ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      インデックス配列の区間 [begin, end) が指す点と中心の距離の2乗の最大値を求めます.
+//      pCenter は (cx, cy, cz) で, 求めた値と *pDistSq の大きい方を書き戻します.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 MaxDistanceSq3( const f32* pIn, const u32* pIndices, u32 begin, u32 end, const f32* pCenter, f32* pDistSq )
+{
+    auto maxi = W::Replicate( *pDistSq );
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        typename W::Reg p[3];
+        GatherPoints<W>( pIn, pIndices, i, p );
+        maxi = W::Max( maxi, DistanceSq3<W>( p, pCenter ) );
+    }
+
+    f32 values[W::Width];
+    W::Store( values, maxi );
+    for( u32 j=0; j<W::Width; ++j )
+    { *pDistSq = ( values[j] > *pDistSq ) ? values[j] : *pDistSq; }
+
+    return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      点がスフィアの外側にあれば, 点を含むようにスフィアを広げます(Ritter).
+//      pSphere は (cx, cy, cz, r) です.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE void GrowSphere( const f32* pPoint, f32* pSphere )
+{
+    auto dx = pPoint[0] - pSphere[0];
+    auto dy = pPoint[1] - pSphere[1];
+    auto dz = pPoint[2] - pSphere[2];
+    auto distSq = ( dz * dz ) + ( ( dy * dy ) + ( dx * dx ) );
+    if ( !( pSphere[3] * pSphere[3] < distSq ) )
+    { return; }
+
+    auto dist   = sqrtf( distSq );
+    auto radius = ( pSphere[3] + dist ) * 0.5f;
+    auto scale  = ( radius - pSphere[3] ) / dist;
+
+    pSphere[0] += dx * scale;
+    pSphere[1] += dy * scale;
+    pSphere[2] += dz * scale;
+    pSphere[3]  = radius;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      インデックス配列の区間 [begin, end) が指す点を順に含むようにスフィアを広げます.
+//
+//      pSphere は (cx, cy, cz, r) です. W::Width 個の点をまとめて内外判定し, 外側の点がある
+//      場合のみ, その組の点を先頭から1つずつ GrowSphere() で処理します.
+//      内外判定は GrowSphere() と同じ順序の演算で行うため, 結果はスカラー版と一致します.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 GrowSphere3( const f32* pIn, const u32* pIndices, u32 begin, u32 end, f32* pSphere )
+{
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        typename W::Reg p[3];
+        GatherPoints<W>( pIn, pIndices, i, p );
+
+        auto distSq   = DistanceSq3<W>( p, pSphere );
+        auto radiusSq = W::Replicate( pSphere[3] * pSphere[3] );
+
+        if ( W::LessMask( radiusSq, distSq ) == 0 )
+        { continue; }
+
+        for( u32 j=0; j<W::Width; ++j )
+        {
+            const auto* pos = pIn + ( ( pIndices != nullptr ) ? pIndices[i + j] : i + j ) * 3;
+            GrowSphere( pos, pSphere );
+        }
+    }
+
+    return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ボックス配列(最小値, 最大値の順で6要素ずつ)の区間 [begin, end) をそれぞれ対応する行列
+//      (16要素ずつ)で変換し, 変換後のボックスを pMinMax にマージします.
+//
+//      pMinMax は BoundsArray3() と同じです. 変換後のボックスは各軸の最小値と最大値に行列の行を
+//      掛けたもののうち小さい方と大きい方の和で求めます(Arvo). 空のボックス(最小値 > 最大値)は
+//      無視します.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 MergeTransformedBoxes( const f32* pBoxes, const f32* pMatrices, u32 begin, u32 end, f32* pMinMax )
+{
+    typename W::Reg mini[3], maxi[3];
+    for( u32 c=0; c<3; ++c )
+    {
+        mini[c] = W::Replicate( pMinMax[c] );
+        maxi[c] = W::Replicate( pMinMax[3 + c] );
+    }
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        // 空のボックスのレーンは有効なレーンの複製で埋める. 同じボックスのマージは結果を変えない.
+        u32 lanes[W::Width];
+        u32 validCount = 0;
+        for( u32 j=0; j<W::Width; ++j )
+        {
+            const auto* box = pBoxes + ( i + j ) * 6;
+            if ( box[0] <= box[3] && box[1] <= box[4] && box[2] <= box[5] )
+            { lanes[validCount++] = i + j; }
+        }
+
+        if ( validCount == 0 )
+        { continue; }
+
+        f32 bounds[6][W::Width];
+        f32 rows[12][W::Width];
+        for( u32 j=0; j<W::Width; ++j )
+        {
+            auto index = lanes[( j < validCount ) ? j : 0];
+            const auto* box = pBoxes    + index * 6;
+            const auto* mat = pMatrices + index * 16;
+            for( u32 c=0; c<6; ++c )
+            { bounds[c][j] = box[c]; }
+
+            // 4列目は射影成分なので使わない.
+            for( u32 r=0; r<4; ++r )
+            for( u32 c=0; c<3; ++c )
+            { rows[r * 3 + c][j] = mat[r * 4 + c]; }
+        }
+
+        typename W::Reg lo[3], hi[3];
+        for( u32 c=0; c<3; ++c )
+        {
+            lo[c] = W::Load( rows[9 + c] );
+            hi[c] = lo[c];
+        }
+
+        for( u32 a=0; a<3; ++a )
+        {
+            auto bmin = W::Load( bounds[a] );
+            auto bmax = W::Load( bounds[a + 3] );
+            for( u32 c=0; c<3; ++c )
+            {
+                auto m  = W::Load( rows[a * 3 + c] );
+                auto p0 = W::Mul( bmin, m );
+                auto p1 = W::Mul( bmax, m );
+                lo[c] = W::Add( lo[c], W::Min( p0, p1 ) );
+                hi[c] = W::Add( hi[c], W::Max( p0, p1 ) );
+            }
+        }
+
+        for( u32 c=0; c<3; ++c )
+        {
+            mini[c] = W::Min( mini[c], lo[c] );
+            maxi[c] = W::Max( maxi[c], hi[c] );
+        }
+    }
+
+    for( u32 c=0; c<3; ++c )
+    {
+        f32 lo[W::Width], hi[W::Width];
+        W::Store( lo, mini[c] );
+        W::Store( hi, maxi[c] );
+        for( u32 j=0; j<W::Width; ++j )
+        {
+            pMinMax[c]     = ( lo[j] < pMinMax[c]     ) ? lo[j] : pMinMax[c];
+            pMinMax[3 + c] = ( hi[j] > pMinMax[3 + c] ) ? hi[j] : pMinMax[3 + c];
+        }
+    }
+
+    return i;
+}
+
+} // inline namespace ASDX_KERNEL_ISA
+} // namespace wide
+} // namespace asdx
@@ -0,0 +1,169 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxCullingKernel.h
+// Desc : Batch Frustum Culling Kernels.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "asdxWide.h"
+
+
+namespace asdx {
+namespace wide {
+inline namespace ASDX_KERNEL_ISA {
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const u32 CULL_PLANE_COUNT = 6;      //!< 判定する平面の数です.
+static const u32 CULL_MASK_BITS   = 32;     //!< 可視判定マスク1ワードあたりの要素数です.
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PlaneReg structure
+// 平面 (nx, ny, nz, d) と法線の絶対値をレーン方向に複製したものです.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename W>
+struct PlaneReg
+{
+    typename W::Reg n[CULL_PLANE_COUNT][3];
+    typename W::Reg a[CULL_PLANE_COUNT][3];
+    typename W::Reg d[CULL_PLANE_COUNT];
+
+    explicit PlaneReg( const f32* pPlanes )
+    {
+        for( u32 i=0; i<CULL_PLANE_COUNT; ++i )
+        {
+            for( u32 j=0; j<3; ++j )
+            {
+                n[i][j] = W::Replicate( pPlanes[i * 4 + j] );
+                a[i][j] = W::Abs( n[i][j] );
+            }
+            d[i] = W::Replicate( pPlanes[i * 4 + 3] );
+        }
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+//      全平面のうち, 中心の符号付き距離に半径を足した値の最小値を求めます.
+//      半径はボックスでは法線方向への投影半径, スフィアでは半径そのものです.
+//-------------------------------------------------------------------------------------------------
+template<typename W, typename Radius>
+ASDX_INLINE typename W::Reg MinPlaneDistance
+(
+    const typename W::Reg&  cx,
+    const typename W::Reg&  cy,
+    const typename W::Reg&  cz,
+    const PlaneReg<W>&      planes,
+    const Radius&           radius
+)
+{
+    typename W::Reg result;
+    for( u32 i=0; i<CULL_PLANE_COUNT; ++i )
+    {
+        auto dist = W::Mad( planes.n[i][2], cz, W::Mad( planes.n[i][1], cy, W::Mad( planes.n[i][0], cx, planes.d[i] ) ) );
+        dist = W::Add( dist, radius( i ) );
+        result = ( i == 0 ) ? dist : W::Min( result, dist );
+    }
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      区間 [begin, end) の可視判定を32要素ずつビットマスクに書き込みます.
+//      test( index ) は index から W::Width 要素分の可視判定マスクを返却します.
+//      末尾の端数ワードが W::Width で割り切れない場合は処理せずに返却します.
+//-------------------------------------------------------------------------------------------------
+template<typename W, typename Test>
+ASDX_INLINE u32 CullWords( u32 begin, u32 end, u32* pMask, const Test& test )
+{
+    auto i = begin;
+    for( ; i < end; i += CULL_MASK_BITS )
+    {
+        auto count = ( end - i < CULL_MASK_BITS ) ? end - i : CULL_MASK_BITS;
+        if ( count % W::Width != 0 )
+        { break; }
+
+        u32 bits = 0;
+        for( u32 j=0; j<count; j += W::Width )
+        { bits |= test( i + j ) << j; }
+
+        pMask[i / CULL_MASK_BITS] = bits;
+    }
+
+    return ( i < end ) ? i : end;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      中心と半分の大きさで表したボックス配列(SoA)の区間 [begin, end) を判定します.
+//      begin は CULL_MASK_BITS の倍数である必要があります.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 CullBoxStream
+(
+    const f32*  pPlanes,
+    const f32*  pCX,
+    const f32*  pCY,
+    const f32*  pCZ,
+    const f32*  pEX,
+    const f32*  pEY,
+    const f32*  pEZ,
+    u32         begin,
+    u32         end,
+    u32*        pMask
+)
+{
+    const PlaneReg<W> planes( pPlanes );
+    const auto zero = W::Replicate( 0.0f );
+    const u32  all  = ( 1u << W::Width ) - 1u;
+
+    return CullWords<W>( begin, end, pMask, [&]( u32 index )
+    {
+        auto ex = W::Load( pEX + index );
+        auto ey = W::Load( pEY + index );
+        auto ez = W::Load( pEZ + index );
+
+        auto dist = MinPlaneDistance<W>( W::Load( pCX + index ), W::Load( pCY + index ), W::Load( pCZ + index ), planes,
+            [&]( u32 i ) { return W::Mad( planes.a[i][2], ez, W::Mad( planes.a[i][1], ey, W::Mul( planes.a[i][0], ex ) ) ); } );
+
+        return ~W::LessMask( dist, zero ) & all;
+    });
+}
+
+//-------------------------------------------------------------------------------------------------
+//      中心と半径で表したスフィア配列(SoA)の区間 [begin, end) を判定します.
+//      begin は CULL_MASK_BITS の倍数である必要があります.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 CullSphereStream
+(
+    const f32*  pPlanes,
+    const f32*  pCX,
+    const f32*  pCY,
+    const f32*  pCZ,
+    const f32*  pR,
+    u32         begin,
+    u32         end,
+    u32*        pMask
+)
+{
+    const PlaneReg<W> planes( pPlanes );
+    const auto zero = W::Replicate( 0.0f );
+    const u32  all  = ( 1u << W::Width ) - 1u;
+
+    return CullWords<W>( begin, end, pMask, [&]( u32 index )
+    {
+        auto r = W::Load( pR + index );
+
+        auto dist = MinPlaneDistance<W>( W::Load( pCX + index ), W::Load( pCY + index ), W::Load( pCZ + index ), planes,
+            [&]( u32 ) { return r; } );
+
+        return ~W::LessMask( dist, zero ) & all;
+    });
+}
+
+} // inline namespace ASDX_KERNEL_ISA
+} // namespace wide
+} // namespace asdx
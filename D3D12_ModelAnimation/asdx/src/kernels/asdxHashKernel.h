@@ -0,0 +1,231 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxHashKernel.h
+// Desc : Hash Kernels.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "asdxWide.h"
+#include "asdxKernelTable.h"
+
+
+namespace asdx {
+namespace wide {
+inline namespace ASDX_KERNEL_ISA {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// HashWide structure
+// ハッシュに使用するレーン幅です.
+// 1ストライプ(64バイト)を超える幅は一つ下の幅で処理します.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename W>
+struct HashWide
+{ using Type = W; };
+
+#if ASDX_IS_SIMD && ASDX_IS_AVX2 && ASDX_IS_AVX512
+template<>
+struct HashWide<Wide16>
+{ using Type = Wide8; };
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//      リトルエンディアンの64ビット値を読み込みます.
+//-------------------------------------------------------------------------------------------------
+ASDX_INLINE u64 ReadU64( const u8* pBuffer )
+{
+    u64 value;
+    memcpy( &value, pBuffer, sizeof(value) );
+    return value;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Xxh3Kernel structure
+// xxHash3 のストライプ処理です. 幅ごとに特殊化します.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename W>
+struct Xxh3Kernel
+{
+    //---------------------------------------------------------------------------------------------
+    //      ストライプを stripes 個アキュムレータに加算します.
+    //---------------------------------------------------------------------------------------------
+    static void Accumulate( u64* pAcc, const u8* pInput, const u8* pSecret, size_t stripes )
+    {
+        for( size_t n=0; n<stripes; ++n )
+        {
+            auto pData = pInput  + n * XXH3_STRIPE_SIZE;
+            auto pKey  = pSecret + n * XXH3_SECRET_CONSUME_RATE;
+            for( u32 i=0; i<XXH3_ACC_COUNT; ++i )
+            {
+                auto data = ReadU64( pData + i * 8 );
+                auto key  = data ^ ReadU64( pKey + i * 8 );
+                pAcc[i ^ 1] += data;
+                pAcc[i]     += u64( u32( key ) ) * ( key >> 32 );
+            }
+        }
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      アキュムレータをかき混ぜます.
+    //---------------------------------------------------------------------------------------------
+    static void Scramble( u64* pAcc, const u8* pSecret )
+    {
+        for( u32 i=0; i<XXH3_ACC_COUNT; ++i )
+        {
+            auto acc = pAcc[i];
+            acc ^= acc >> 47;
+            acc ^= ReadU64( pSecret + i * 8 );
+            acc *= XXH3_PRIME32_1;
+            pAcc[i] = acc;
+        }
+    }
+};
+
+#if ASDX_IS_SIMD
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Xxh3Kernel<Wide4> structure
+// 128ビットのレジスタ4本にアキュムレータを保持します.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<>
+struct Xxh3Kernel<Wide4>
+{
+#if ASDX_IS_SSE
+    static void Accumulate( u64* pAcc, const u8* pInput, const u8* pSecret, size_t stripes )
+    {
+        __m128i acc[4];
+        for( u32 i=0; i<4; ++i )
+        { acc[i] = _mm_loadu_si128( reinterpret_cast<const __m128i*>( pAcc ) + i ); }
+
+        for( size_t n=0; n<stripes; ++n )
+        {
+            auto pData = reinterpret_cast<const __m128i*>( pInput  + n * XXH3_STRIPE_SIZE );
+            auto pKey  = reinterpret_cast<const __m128i*>( pSecret + n * XXH3_SECRET_CONSUME_RATE );
+            for( u32 i=0; i<4; ++i )
+            {
+                auto data = _mm_loadu_si128( pData + i );
+                auto key  = _mm_xor_si128( data, _mm_loadu_si128( pKey + i ) );
+                auto prod = _mm_mul_epu32( key, _mm_shuffle_epi32( key, _MM_SHUFFLE( 0, 3, 0, 1 ) ) );
+                auto swap = _mm_shuffle_epi32( data, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+                acc[i] = _mm_add_epi64( acc[i], _mm_add_epi64( prod, swap ) );
+            }
+        }
+
+        for( u32 i=0; i<4; ++i )
+        { _mm_storeu_si128( reinterpret_cast<__m128i*>( pAcc ) + i, acc[i] ); }
+    }
+
+    static void Scramble( u64* pAcc, const u8* pSecret )
+    {
+        const auto prime = _mm_set1_epi32( s32( XXH3_PRIME32_1 ) );
+        for( u32 i=0; i<4; ++i )
+        {
+            auto acc = _mm_loadu_si128( reinterpret_cast<const __m128i*>( pAcc ) + i );
+            acc = _mm_xor_si128( acc, _mm_srli_epi64( acc, 47 ) );
+            acc = _mm_xor_si128( acc, _mm_loadu_si128( reinterpret_cast<const __m128i*>( pSecret ) + i ) );
+
+            // 64ビット x 32ビットの乗算を上位と下位に分けて行う.
+            auto lo = _mm_mul_epu32( acc, prime );
+            auto hi = _mm_mul_epu32( _mm_shuffle_epi32( acc, _MM_SHUFFLE( 0, 3, 0, 1 ) ), prime );
+            acc = _mm_add_epi64( lo, _mm_slli_epi64( hi, 32 ) );
+            _mm_storeu_si128( reinterpret_cast<__m128i*>( pAcc ) + i, acc );
+        }
+    }
+#elif ASDX_IS_NEON
+    static void Accumulate( u64* pAcc, const u8* pInput, const u8* pSecret, size_t stripes )
+    {
+        uint64x2_t acc[4];
+        for( u32 i=0; i<4; ++i )
+        { acc[i] = vld1q_u64( pAcc + i * 2 ); }
+
+        for( size_t n=0; n<stripes; ++n )
+        {
+            auto pData = pInput  + n * XXH3_STRIPE_SIZE;
+            auto pKey  = pSecret + n * XXH3_SECRET_CONSUME_RATE;
+            for( u32 i=0; i<4; ++i )
+            {
+                auto data = vreinterpretq_u64_u8( vld1q_u8( pData + i * 16 ) );
+                auto key  = veorq_u64( data, vreinterpretq_u64_u8( vld1q_u8( pKey + i * 16 ) ) );
+                acc[i] = vaddq_u64( acc[i], vextq_u64( data, data, 1 ) );
+                acc[i] = vmlal_u32( acc[i], vmovn_u64( key ), vshrn_n_u64( key, 32 ) );
+            }
+        }
+
+        for( u32 i=0; i<4; ++i )
+        { vst1q_u64( pAcc + i * 2, acc[i] ); }
+    }
+
+    static void Scramble( u64* pAcc, const u8* pSecret )
+    {
+        const auto prime = vdup_n_u32( XXH3_PRIME32_1 );
+        for( u32 i=0; i<4; ++i )
+        {
+            auto acc = vld1q_u64( pAcc + i * 2 );
+            acc = veorq_u64( acc, vshrq_n_u64( acc, 47 ) );
+            acc = veorq_u64( acc, vreinterpretq_u64_u8( vld1q_u8( pSecret + i * 16 ) ) );
+
+            // 64ビット x 32ビットの乗算を上位と下位に分けて行う.
+            auto hi = vshlq_n_u64( vmull_u32( vshrn_n_u64( acc, 32 ), prime ), 32 );
+            acc = vmlal_u32( hi, vmovn_u64( acc ), prime );
+            vst1q_u64( pAcc + i * 2, acc );
+        }
+    }
+#endif
+};
+#endif//ASDX_IS_SIMD
+
+#if ASDX_IS_SIMD && ASDX_IS_AVX2
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Xxh3Kernel<Wide8> structure
+// 256ビットのレジスタ2本にアキュムレータを保持します.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<>
+struct Xxh3Kernel<Wide8>
+{
+    static void Accumulate( u64* pAcc, const u8* pInput, const u8* pSecret, size_t stripes )
+    {
+        __m256i acc[2];
+        for( u32 i=0; i<2; ++i )
+        { acc[i] = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( pAcc ) + i ); }
+
+        for( size_t n=0; n<stripes; ++n )
+        {
+            auto pData = reinterpret_cast<const __m256i*>( pInput  + n * XXH3_STRIPE_SIZE );
+            auto pKey  = reinterpret_cast<const __m256i*>( pSecret + n * XXH3_SECRET_CONSUME_RATE );
+            for( u32 i=0; i<2; ++i )
+            {
+                auto data = _mm256_loadu_si256( pData + i );
+                auto key  = _mm256_xor_si256( data, _mm256_loadu_si256( pKey + i ) );
+                auto prod = _mm256_mul_epu32( key, _mm256_shuffle_epi32( key, _MM_SHUFFLE( 0, 3, 0, 1 ) ) );
+                auto swap = _mm256_shuffle_epi32( data, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+                acc[i] = _mm256_add_epi64( acc[i], _mm256_add_epi64( prod, swap ) );
+            }
+        }
+
+        for( u32 i=0; i<2; ++i )
+        { _mm256_storeu_si256( reinterpret_cast<__m256i*>( pAcc ) + i, acc[i] ); }
+    }
+
+    static void Scramble( u64* pAcc, const u8* pSecret )
+    {
+        const auto prime = _mm256_set1_epi32( s32( XXH3_PRIME32_1 ) );
+        for( u32 i=0; i<2; ++i )
+        {
+            auto acc = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( pAcc ) + i );
+            acc = _mm256_xor_si256( acc, _mm256_srli_epi64( acc, 47 ) );
+            acc = _mm256_xor_si256( acc, _mm256_loadu_si256( reinterpret_cast<const __m256i*>( pSecret ) + i ) );
+
+            // 64ビット x 32ビットの乗算を上位と下位に分けて行う.
+            auto lo = _mm256_mul_epu32( acc, prime );
+            auto hi = _mm256_mul_epu32( _mm256_shuffle_epi32( acc, _MM_SHUFFLE( 0, 3, 0, 1 ) ), prime );
+            acc = _mm256_add_epi64( lo, _mm256_slli_epi64( hi, 32 ) );
+            _mm256_storeu_si256( reinterpret_cast<__m256i*>( pAcc ) + i, acc );
+        }
+    }
+};
+#endif//ASDX_IS_SIMD && ASDX_IS_AVX2
+
+} // inline namespace ASDX_KERNEL_ISA
+} // namespace wide
+} // namespace asdx
@@ -0,0 +1,34 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxKernelAvx2.cpp
+// Desc : AVX2 Kernel Table.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+// MSVCでは Release 構成のみ /arch:AVX2 でビルドします. GCC/Clangでは -mavx2 -mf16c を指定します.
+// Debug 構成では __forceinline が展開されず, 共通のインライン関数がAVX2命令で
+// 出力されて他の翻訳単位から参照される恐れがあるため, この翻訳単位は空になります.
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#define ASDX_KERNEL_ISA     avx2
+#include "asdxKernelTableImpl.h"
+
+
+namespace asdx {
+namespace wide {
+
+//-------------------------------------------------------------------------------------------------
+//      AVX2版のカーネルテーブルを取得します.
+//-------------------------------------------------------------------------------------------------
+const KernelTable* GetKernelTableAvx2()
+{
+#if ASDX_IS_SIMD && ASDX_IS_AVX2
+    return GetKernelTableOf<Wide8>();
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace wide
+} // namespace asdx
@@ -0,0 +1,32 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxKernelAvx512.cpp
+// Desc : AVX-512 Kernel Table.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+// MSVCでは Release 構成かつ v141 以降のツールセットのみ /arch:AVX512 でビルドします.
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#define ASDX_KERNEL_ISA     avx512
+#include "asdxKernelTableImpl.h"
+
+
+namespace asdx {
+namespace wide {
+
+//-------------------------------------------------------------------------------------------------
+//      AVX-512版のカーネルテーブルを取得します.
+//-------------------------------------------------------------------------------------------------
+const KernelTable* GetKernelTableAvx512()
+{
+#if ASDX_IS_SIMD && ASDX_IS_AVX2 && ASDX_IS_AVX512
+    return GetKernelTableOf<Wide16>();
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace wide
+} // namespace asdx
@@ -0,0 +1,159 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxKernelCrc32.cpp
+// Desc : Hardware CRC32 Kernels.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+// MSVCでは Release 構成のみ ASDX_ENABLE_SSE4_1 を定義してビルドします.
+// GCC/Clangでは x86 は -msse4.1 -mpclmul, ARM64 は -march=armv8-a+crc を指定します.
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "asdxKernelTable.h"
+
+#if ASDX_IS_SSE4_1 && ( defined(__PCLMUL__) || defined(_MSC_VER) )
+    #define ASDX_IS_CRC32_CLMUL     (1)
+    #define ASDX_IS_CRC32_ARM       (0)
+    #include <smmintrin.h>
+    #include <wmmintrin.h>
+#elif ASDX_IS_NEON && ( defined(__ARM_FEATURE_CRC32) || defined(_M_ARM64) )
+    #define ASDX_IS_CRC32_CLMUL     (0)
+    #define ASDX_IS_CRC32_ARM       (1)
+    #include <cstring>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <arm_acle.h>
+    #endif
+#else
+    #define ASDX_IS_CRC32_CLMUL     (0)
+    #define ASDX_IS_CRC32_ARM       (0)
+#endif
+
+
+namespace /* anonymous */ {
+
+using namespace asdx;
+
+#if ASDX_IS_CRC32_CLMUL
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+// 多項式 0xEDB88320 (ビット反転表現) に対する x^n mod P の値です.
+// ※ Gopal et al. "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction", Intel, 2009 を参照.
+static const u64 FOLD_BY_4[2]  = { 0x0154442bd4, 0x01c6e41596 };    //!< 64バイト先へ畳み込む係数です.
+static const u64 FOLD_BY_1[2]  = { 0x01751997d0, 0x00ccaa009e };    //!< 16バイト先へ畳み込む係数です.
+static const u64 FOLD_TO_64[2] = { 0x0163cd6124, 0x0000000000 };    //!< 64ビットへ畳み込む係数です.
+static const u64 BARRETT[2]    = { 0x01db710641, 0x01f7011641 };    //!< Barrett還元の多項式と商の係数です.
+
+//-------------------------------------------------------------------------------------------------
+//      128ビットの値 x を係数 k で畳み込み, 次のデータ y と合わせます.
+//-------------------------------------------------------------------------------------------------
+inline __m128i Fold( __m128i x, __m128i k, __m128i y )
+{
+    auto lo = _mm_clmulepi64_si128( x, k, 0x00 );
+    auto hi = _mm_clmulepi64_si128( x, k, 0x11 );
+    return _mm_xor_si128( _mm_xor_si128( hi, lo ), y );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      キャリーレス乗算で畳み込んでCRC32を更新します.
+//-------------------------------------------------------------------------------------------------
+u32 UpdateCrc32Clmul( u32 crc, const u8* pBuffer, size_t size )
+{
+    auto p = reinterpret_cast<const __m128i*>( pBuffer );
+
+    // 64バイト単位で4本並列に畳み込む.
+    auto x0 = _mm_xor_si128( _mm_loadu_si128( p + 0 ), _mm_cvtsi32_si128( s32( crc ) ) );
+    auto x1 = _mm_loadu_si128( p + 1 );
+    auto x2 = _mm_loadu_si128( p + 2 );
+    auto x3 = _mm_loadu_si128( p + 3 );
+    p    += 4;
+    size -= 64;
+
+    auto k = _mm_loadu_si128( reinterpret_cast<const __m128i*>( FOLD_BY_4 ) );
+    while( size >= 64 )
+    {
+        x0 = Fold( x0, k, _mm_loadu_si128( p + 0 ) );
+        x1 = Fold( x1, k, _mm_loadu_si128( p + 1 ) );
+        x2 = Fold( x2, k, _mm_loadu_si128( p + 2 ) );
+        x3 = Fold( x3, k, _mm_loadu_si128( p + 3 ) );
+        p    += 4;
+        size -= 64;
+    }
+
+    // 128ビットにまとめ, 残りを16バイト単位で畳み込む.
+    k  = _mm_loadu_si128( reinterpret_cast<const __m128i*>( FOLD_BY_1 ) );
+    x0 = Fold( x0, k, x1 );
+    x0 = Fold( x0, k, x2 );
+    x0 = Fold( x0, k, x3 );
+    while( size >= 16 )
+    {
+        x0 = Fold( x0, k, _mm_loadu_si128( p ) );
+        p    += 1;
+        size -= 16;
+    }
+
+    // 64ビットへ畳み込む.
+    const auto mask32 = _mm_setr_epi32( -1, 0, -1, 0 );
+    auto t = _mm_clmulepi64_si128( x0, k, 0x10 );
+    x0 = _mm_xor_si128( _mm_srli_si128( x0, 8 ), t );
+
+    k  = _mm_loadl_epi64( reinterpret_cast<const __m128i*>( FOLD_TO_64 ) );
+    t  = _mm_srli_si128( x0, 4 );
+    x0 = _mm_clmulepi64_si128( _mm_and_si128( x0, mask32 ), k, 0x00 );
+    x0 = _mm_xor_si128( x0, t );
+
+    // Barrett還元で32ビットにする.
+    k = _mm_loadu_si128( reinterpret_cast<const __m128i*>( BARRETT ) );
+    t = _mm_clmulepi64_si128( _mm_and_si128( x0, mask32 ), k, 0x10 );
+    t = _mm_clmulepi64_si128( _mm_and_si128( t,  mask32 ), k, 0x00 );
+    x0 = _mm_xor_si128( x0, t );
+
+    return u32( _mm_extract_epi32( x0, 1 ) );
+}
+#endif//ASDX_IS_CRC32_CLMUL
+
+#if ASDX_IS_CRC32_ARM
+//-------------------------------------------------------------------------------------------------
+//      ARMv8のCRC32命令でCRC32を更新します.
+//-------------------------------------------------------------------------------------------------
+u32 UpdateCrc32Arm( u32 crc, const u8* pBuffer, size_t size )
+{
+    for( ; size >= 8; size -= 8, pBuffer += 8 )
+    {
+        u64 value;
+        memcpy( &value, pBuffer, sizeof(value) );
+        crc = __crc32d( crc, value );
+    }
+
+    for( ; size > 0; --size, ++pBuffer )
+    { crc = __crc32b( crc, *pBuffer ); }
+
+    return crc;
+}
+#endif//ASDX_IS_CRC32_ARM
+
+} // namespace /* anonymous */
+
+
+namespace asdx {
+namespace wide {
+
+//-------------------------------------------------------------------------------------------------
+//      命令セット固有のCRC32更新関数を取得します.
+//-------------------------------------------------------------------------------------------------
+Crc32Func GetCrc32Hardware()
+{
+#if ASDX_IS_CRC32_CLMUL
+    return UpdateCrc32Clmul;
+#elif ASDX_IS_CRC32_ARM
+    return UpdateCrc32Arm;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace wide
+} // namespace asdx
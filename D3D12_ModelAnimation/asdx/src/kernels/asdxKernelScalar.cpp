@@ -0,0 +1,26 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxKernelScalar.cpp
+// Desc : Scalar Kernel Table.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#define ASDX_KERNEL_ISA     scalar
+#include "asdxKernelTableImpl.h"
+
+
+namespace asdx {
+namespace wide {
+
+//-------------------------------------------------------------------------------------------------
+//      スカラー版のカーネルテーブルを取得します.
+//-------------------------------------------------------------------------------------------------
+const KernelTable* GetKernelTableScalar()
+{
+    return GetKernelTableOf<Wide1>();
+}
+
+} // namespace wide
+} // namespace asdx
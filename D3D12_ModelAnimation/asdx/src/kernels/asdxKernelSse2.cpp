@@ -0,0 +1,30 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxKernelSse2.cpp
+// Desc : SSE2/NEON Kernel Table.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#define ASDX_KERNEL_ISA     sse2
+#include "asdxKernelTableImpl.h"
+
+
+namespace asdx {
+namespace wide {
+
+//-------------------------------------------------------------------------------------------------
+//      SSE2(ARMではNEON)版のカーネルテーブルを取得します.
+//-------------------------------------------------------------------------------------------------
+const KernelTable* GetKernelTableSse2()
+{
+#if ASDX_IS_SIMD
+    return GetKernelTableOf<Wide4>();
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace wide
+} // namespace asdx
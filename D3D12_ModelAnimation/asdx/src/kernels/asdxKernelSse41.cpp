@@ -0,0 +1,33 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxKernelSse41.cpp
+// Desc : SSE4.1 Kernel Table.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+// MSVCでは Release 構成のみ ASDX_ENABLE_SSE4_1 を定義してビルドします.
+// GCC/Clangでは -msse4.1 を指定します.
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#define ASDX_KERNEL_ISA     sse41
+#include "asdxKernelTableImpl.h"
+
+
+namespace asdx {
+namespace wide {
+
+//-------------------------------------------------------------------------------------------------
+//      SSE4.1版のカーネルテーブルを取得します.
+//-------------------------------------------------------------------------------------------------
+const KernelTable* GetKernelTableSse41()
+{
+#if ASDX_IS_SIMD && ASDX_IS_SSE4_1
+    return GetKernelTableOf<Wide4>();
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace wide
+} // namespace asdx
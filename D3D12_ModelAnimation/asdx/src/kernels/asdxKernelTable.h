@@ -0,0 +1,177 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxKernelTable.h
+// Desc : Runtime Dispatch Table for Batch Kernels.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxTypedef.h>
+#include <cstddef>
+
+
+namespace asdx {
+namespace wide {
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const u32 RANDOM_LANE_COUNT = 8;     //!< 乱数生成器の独立したレーン数です(命令セットによらず固定).
+static const u32 CRC32_HARDWARE_MIN_SIZE  = 64;          //!< 命令セット固有のCRC32関数が処理できる最小サイズです.
+static const u32 CRC32_HARDWARE_ALIGN     = 16;          //!< 命令セット固有のCRC32関数が処理できるサイズの単位です.
+static const u32 XXH3_STRIPE_SIZE         = 64;          //!< xxHash3 の1ストライプのバイト数です.
+static const u32 XXH3_SECRET_CONSUME_RATE = 8;           //!< xxHash3 で1ストライプごとに進めるシークレットのバイト数です.
+static const u32 XXH3_ACC_COUNT           = 8;           //!< xxHash3 のアキュムレータ数です.
+static const u32 XXH3_PRIME32_1           = 0x9E3779B1;  //!< xxHash3 のかき混ぜに使用する素数です.
+
+//-------------------------------------------------------------------------------------------------
+// Type Definitions
+//-------------------------------------------------------------------------------------------------
+
+//! CRC32(多項式 0xEDB88320)のレジスタ値を更新する関数です. 反転前のレジスタ値を受け取り, 更新後の値を返却します.
+typedef u32 (*Crc32Func)( u32 crc, const u8* pBuffer, size_t size );
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TRANSFORM_MODE enum
+///////////////////////////////////////////////////////////////////////////////////////////////////
+enum TRANSFORM_MODE
+{
+    TRANSFORM_POSITION = 0,     //!< Vector3::Transform 相当(w=1).
+    TRANSFORM_NORMAL,           //!< Vector3::TransformNormal 相当(w=0).
+    TRANSFORM_COORD,            //!< Vector3::TransformCoord 相当(w除算あり).
+    TRANSFORM_MODE_COUNT,
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// KernelTable structure
+// 命令セットごとのカーネル関数テーブルです.
+// 各関数は区間 [begin, end) を端数も含めて全て処理します.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct KernelTable
+{
+    //! xyz配列(AoS)の変換です. 添字は TRANSFORM_MODE です.
+    void (*TransformArray3[TRANSFORM_MODE_COUNT])( const f32* pIn, u32 begin, u32 end, const f32* pMatrix, f32* pOut );
+
+    //! x, y, z 各成分の配列(SoA)の変換です. 添字は TRANSFORM_MODE です.
+    void (*TransformStream3[TRANSFORM_MODE_COUNT])(
+        const f32* pX, const f32* pY, const f32* pZ, u32 begin, u32 end,
+        const f32* pMatrix, f32* pOutX, f32* pOutY, f32* pOutZ );
+
+    //! xyzw配列(AoS)の変換です.
+    void (*TransformArray4)( const f32* pIn, u32 begin, u32 end, const f32* pMatrix, f32* pOut );
+
+    //! x, y, z, w 各成分の配列(SoA)の変換です.
+    void (*TransformStream4)(
+        const f32* pX, const f32* pY, const f32* pZ, const f32* pW, u32 begin, u32 end,
+        const f32* pMatrix, f32* pOutX, f32* pOutY, f32* pOutZ, f32* pOutW );
+
+    //! 四元数配列の球面線形補間です.
+    void (*SlerpArray)( const f32* pA, const f32* pB, const f32* pAmounts, u32 begin, u32 end, f32* pOut );
+
+    //! 四元数配列の正規化線形補間です.
+    void (*NlerpArray)( const f32* pA, const f32* pB, const f32* pAmounts, u32 begin, u32 end, f32* pOut );
+
+    //! 四元数配列の正規化です.
+    void (*NormalizeArray)( const f32* pIn, u32 begin, u32 end, f32* pOut );
+
+    //! 四元数配列から成分ごとの3x4行列への変換です.
+    void (*ToMatrix3x4Stream)(
+        const f32* pRotations, const f32* pTranslations, u32 begin, u32 end, u32 stride, f32* pOut );
+
+    //! 半精度浮動小数との変換です.
+    void (*PackF16)  ( const f32* pIn, u32 begin, u32 end, f16* pOut );
+    void (*UnpackF16)( const f16* pIn, u32 begin, u32 end, f32* pOut );
+
+    //! 正規化整数との変換です.
+    void (*PackSnorm8)   ( const f32* pIn, u32 begin, u32 end, s8*  pOut );
+    void (*UnpackSnorm8) ( const s8*  pIn, u32 begin, u32 end, f32* pOut );
+    void (*PackSnorm16)  ( const f32* pIn, u32 begin, u32 end, s16* pOut );
+    void (*UnpackSnorm16)( const s16* pIn, u32 begin, u32 end, f32* pOut );
+    void (*PackUnorm8)   ( const f32* pIn, u32 begin, u32 end, u8*  pOut );
+    void (*UnpackUnorm8) ( const u8*  pIn, u32 begin, u32 end, f32* pOut );
+    void (*PackUnorm16)  ( const f32* pIn, u32 begin, u32 end, u16* pOut );
+    void (*UnpackUnorm16)( const u16* pIn, u32 begin, u32 end, f32* pOut );
+
+    //! 単位ベクトルの八面体写像による符号化と復号です.
+    void (*EncodeOctahedral)( const f32* pIn, u32 begin, u32 end, f32* pOut );
+    void (*DecodeOctahedral)( const f32* pIn, u32 begin, u32 end, f32* pOut );
+
+    //! XorShift128 を RANDOM_LANE_COUNT レーン並列に steps 段進めて乱数を生成します.
+    void (*RandomFillU32)( u32* pState, u32 steps, u32* pOut );
+    void (*RandomFillF32)( u32* pState, u32 steps, f32 offset, f32 scale, f32* pOut );
+
+    //! 6平面による視錐台カリングです. 可視判定を32要素ごとのビットマスクで書き込みます.
+    void (*CullBoxStream)(
+        const f32* pPlanes, const f32* pCX, const f32* pCY, const f32* pCZ,
+        const f32* pEX, const f32* pEY, const f32* pEZ, u32 begin, u32 end, u32* pMask );
+    void (*CullSphereStream)(
+        const f32* pPlanes, const f32* pCX, const f32* pCY, const f32* pCZ,
+        const f32* pR, u32 begin, u32 end, u32* pMask );
+
+    //! 1本のレイと三角形リストの交差判定です. 区間は三角形の番号です.
+    void (*IntersectTriangles)(
+        const f32* pRay, const f32* pPositions, const u32* pIndices, u32 begin, u32 end,
+        f32* pHit, u32* pIndex );
+
+    //! レイ配列(SoA)と三角形リストの交差判定です. 区間はレイの番号です.
+    void (*IntersectPacket)(
+        const f32* pRays, u32 stride, u32 begin, u32 end,
+        const f32* pPositions, const u32* pIndices, u32 triBegin, u32 triEnd,
+        f32* pHits, u32* pIndex );
+    //! 点群の最小値と最大値です. pMinMax とマージして書き戻します.
+    void (*BoundsArray3)  ( const f32* pIn, u32 begin, u32 end, f32* pMinMax );
+    void (*BoundsIndexed3)( const f32* pIn, const u32* pIndices, u32 begin, u32 end, f32* pMinMax );
+    //! 点群を順に含むようにスフィアを広げます. pIndices が nullptr の場合は点を順に処理します.
+    void (*GrowSphere3)( const f32* pIn, const u32* pIndices, u32 begin, u32 end, f32* pSphere );
+    //! 点群と中心の距離の2乗の最大値です. pIndices が nullptr の場合は点を順に処理します.
+    void (*MaxDistanceSq3)( const f32* pIn, const u32* pIndices, u32 begin, u32 end, const f32* pCenter, f32* pDistSq );
+    //! ボックス配列をそれぞれの行列で変換して pMinMax にマージします. 空のボックスは無視します.
+    void (*MergeTransformedBoxes)( const f32* pBoxes, const f32* pMatrices, u32 begin, u32 end, f32* pMinMax );
+    //! 遮蔽物の三角形リストを射影して選別します. 区間は三角形の番号です.
+    void (*SetupTriangles)(
+        const f32* pPositions, const u32* pIndices, u32 begin, u32 end,
+        const f32* pMatrix, const f32* pViewport, f32* pOut, u32* pCount, u32* pClip, u32* pClipCount );
+    //! ボックス配列を射影して画面上の矩形と最も手前の深度を求めます.
+    void (*ProjectBoxes)( const f32* pBoxes, u32 begin, u32 end, const f32* pMatrix, const f32* pViewport, f32* pRects );
+    //! xxHash3 のストライプを stripes 個アキュムレータに加算します. シークレットはストライプごとに8バイト進めます.
+    void (*Xxh3Accumulate)( u64* pAcc, const u8* pInput, const u8* pSecret, size_t stripes );
+    //! xxHash3 のアキュムレータをかき混ぜます.
+    void (*Xxh3Scramble)( u64* pAcc, const u8* pSecret );
+};
+
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      命令セット別のカーネルテーブルを取得します.
+//!
+//! @return     コンパイル設定でその命令セットが有効でない場合は nullptr を返却します.
+//!             CPUが命令セットに対応しているかどうかは判定しません.
+//-------------------------------------------------------------------------------------------------
+const KernelTable* GetKernelTableScalar();
+const KernelTable* GetKernelTableSse2();
+const KernelTable* GetKernelTableSse41();
+const KernelTable* GetKernelTableAvx2();
+const KernelTable* GetKernelTableAvx512();
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      命令セット固有のCRC32更新関数を取得します.
+//!
+//! @details    x86はキャリーレス乗算(PCLMULQDQ)による畳み込み, ARM64はCRC32命令を使用します.
+//!             size は CRC32_HARDWARE_MIN_SIZE 以上かつ CRC32_HARDWARE_ALIGN の倍数を指定します.
+//!
+//! @return     コンパイル設定で有効でない場合は nullptr を返却します.
+//!             CPUが命令セットに対応しているかどうかは判定しません.
+//-------------------------------------------------------------------------------------------------
+Crc32Func GetCrc32Hardware();
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      現在有効なカーネルテーブルを取得します.
+//!
+//! @details    初回呼び出し時にCPUの対応命令セットを調べて選択します.
+//!             SetSimdTierLimit() で上限を変更すると以降の呼び出しに反映されます.
+//-------------------------------------------------------------------------------------------------
+const KernelTable& GetKernelTable();
+
+} // namespace wide
+} // namespace asdx
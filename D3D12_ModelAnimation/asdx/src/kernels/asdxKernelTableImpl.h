@@ -0,0 +1,302 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxKernelTableImpl.h
+// Desc : Kernel Table Instantiation Helper.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "asdxKernelTable.h"
+#include "asdxTransformKernel.h"
+#include "asdxQuaternionKernel.h"
+#include "asdxPackKernel.h"
+#include "asdxRandomKernel.h"
+#include "asdxCullingKernel.h"
+#include "asdxRayKernel.h"
+#include "asdxBoundsKernel.h"
+#include "asdxOcclusionKernel.h"
+#include "asdxHashKernel.h"
+
+
+namespace asdx {
+namespace wide {
+inline namespace ASDX_KERNEL_ISA {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// KernelEntry structure
+// 幅 W のカーネルを実行し, 端数を Wide1 で処理するエントリ関数群です.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename W>
+struct KernelEntry
+{
+    template<TRANSFORM_MODE Mode>
+    static void TransformArray3( const f32* pIn, u32 begin, u32 end, const f32* pMatrix, f32* pOut )
+    {
+        auto i = wide::TransformArray3<W, Mode>( pIn, begin, end, pMatrix, pOut );
+        wide::TransformArray3<Wide1, Mode>( pIn, i, end, pMatrix, pOut );
+    }
+
+    template<TRANSFORM_MODE Mode>
+    static void TransformStream3
+    (
+        const f32* pX, const f32* pY, const f32* pZ, u32 begin, u32 end,
+        const f32* pMatrix, f32* pOutX, f32* pOutY, f32* pOutZ
+    )
+    {
+        auto i = wide::TransformStream3<W, Mode>( pX, pY, pZ, begin, end, pMatrix, pOutX, pOutY, pOutZ );
+        wide::TransformStream3<Wide1, Mode>( pX, pY, pZ, i, end, pMatrix, pOutX, pOutY, pOutZ );
+    }
+
+    static void TransformArray4( const f32* pIn, u32 begin, u32 end, const f32* pMatrix, f32* pOut )
+    {
+        auto i = wide::TransformArray4<W>( pIn, begin, end, pMatrix, pOut );
+        wide::TransformArray4<Wide1>( pIn, i, end, pMatrix, pOut );
+    }
+
+    static void TransformStream4
+    (
+        const f32* pX, const f32* pY, const f32* pZ, const f32* pW, u32 begin, u32 end,
+        const f32* pMatrix, f32* pOutX, f32* pOutY, f32* pOutZ, f32* pOutW
+    )
+    {
+        auto i = wide::TransformStream4<W>( pX, pY, pZ, pW, begin, end, pMatrix, pOutX, pOutY, pOutZ, pOutW );
+        wide::TransformStream4<Wide1>( pX, pY, pZ, pW, i, end, pMatrix, pOutX, pOutY, pOutZ, pOutW );
+    }
+
+    static void SlerpArray( const f32* pA, const f32* pB, const f32* pAmounts, u32 begin, u32 end, f32* pOut )
+    {
+        auto i = wide::SlerpArray<W>( pA, pB, pAmounts, begin, end, pOut );
+        wide::SlerpArray<Wide1>( pA, pB, pAmounts, i, end, pOut );
+    }
+
+    static void NlerpArray( const f32* pA, const f32* pB, const f32* pAmounts, u32 begin, u32 end, f32* pOut )
+    {
+        auto i = wide::NlerpArray<W>( pA, pB, pAmounts, begin, end, pOut );
+        wide::NlerpArray<Wide1>( pA, pB, pAmounts, i, end, pOut );
+    }
+
+    static void NormalizeArray( const f32* pIn, u32 begin, u32 end, f32* pOut )
+    {
+        auto i = wide::NormalizeArray<W>( pIn, begin, end, pOut );
+        wide::NormalizeArray<Wide1>( pIn, i, end, pOut );
+    }
+
+    static void ToMatrix3x4Stream
+    (
+        const f32* pRotations, const f32* pTranslations, u32 begin, u32 end, u32 stride, f32* pOut
+    )
+    {
+        auto i = wide::ToMatrix3x4Stream<W>( pRotations, pTranslations, begin, end, stride, pOut );
+        wide::ToMatrix3x4Stream<Wide1>( pRotations, pTranslations, i, end, stride, pOut );
+    }
+
+    static void PackF16( const f32* pIn, u32 begin, u32 end, f16* pOut )
+    {
+        auto i = wide::PackF16<W>( pIn, begin, end, pOut );
+        wide::PackF16<Wide1>( pIn, i, end, pOut );
+    }
+
+    static void UnpackF16( const f16* pIn, u32 begin, u32 end, f32* pOut )
+    {
+        auto i = wide::UnpackF16<W>( pIn, begin, end, pOut );
+        wide::UnpackF16<Wide1>( pIn, i, end, pOut );
+    }
+
+    template<typename T>
+    static void PackNorm( const f32* pIn, u32 begin, u32 end, T* pOut )
+    {
+        auto i = wide::PackNorm<W, T>( pIn, begin, end, pOut );
+        wide::PackNorm<Wide1, T>( pIn, i, end, pOut );
+    }
+
+    template<typename T>
+    static void UnpackNorm( const T* pIn, u32 begin, u32 end, f32* pOut )
+    {
+        auto i = wide::UnpackNorm<W, T>( pIn, begin, end, pOut );
+        wide::UnpackNorm<Wide1, T>( pIn, i, end, pOut );
+    }
+
+    static void EncodeOctahedral( const f32* pIn, u32 begin, u32 end, f32* pOut )
+    {
+        auto i = wide::EncodeOctahedral<W>( pIn, begin, end, pOut );
+        wide::EncodeOctahedral<Wide1>( pIn, i, end, pOut );
+    }
+
+    static void DecodeOctahedral( const f32* pIn, u32 begin, u32 end, f32* pOut )
+    {
+        auto i = wide::DecodeOctahedral<W>( pIn, begin, end, pOut );
+        wide::DecodeOctahedral<Wide1>( pIn, i, end, pOut );
+    }
+
+    static void RandomFillU32( u32* pState, u32 steps, u32* pOut )
+    {
+        using R = typename RandomWide<W>::Type;
+        auto i = wide::RandomFillU32<R>( pState, 0, RANDOM_LANE_COUNT, steps, pOut );
+        wide::RandomFillU32<Wide1>( pState, i, RANDOM_LANE_COUNT, steps, pOut );
+    }
+
+    static void RandomFillF32( u32* pState, u32 steps, f32 offset, f32 scale, f32* pOut )
+    {
+        using R = typename RandomWide<W>::Type;
+        auto i = wide::RandomFillF32<R>( pState, 0, RANDOM_LANE_COUNT, steps, offset, scale, pOut );
+        wide::RandomFillF32<Wide1>( pState, i, RANDOM_LANE_COUNT, steps, offset, scale, pOut );
+    }
+
+    static void CullBoxStream
+    (
+        const f32* pPlanes, const f32* pCX, const f32* pCY, const f32* pCZ,
+        const f32* pEX, const f32* pEY, const f32* pEZ, u32 begin, u32 end, u32* pMask
+    )
+    {
+        auto i = wide::CullBoxStream<W>( pPlanes, pCX, pCY, pCZ, pEX, pEY, pEZ, begin, end, pMask );
+        wide::CullBoxStream<Wide1>( pPlanes, pCX, pCY, pCZ, pEX, pEY, pEZ, i, end, pMask );
+    }
+
+    static void CullSphereStream
+    (
+        const f32* pPlanes, const f32* pCX, const f32* pCY, const f32* pCZ,
+        const f32* pR, u32 begin, u32 end, u32* pMask
+    )
+    {
+        auto i = wide::CullSphereStream<W>( pPlanes, pCX, pCY, pCZ, pR, begin, end, pMask );
+        wide::CullSphereStream<Wide1>( pPlanes, pCX, pCY, pCZ, pR, i, end, pMask );
+    }
+
+    static void IntersectTriangles
+    (
+        const f32* pRay, const f32* pPositions, const u32* pIndices, u32 begin, u32 end,
+        f32* pHit, u32* pIndex
+    )
+    {
+        auto i = wide::IntersectTriangles<W>( pRay, pPositions, pIndices, begin, end, pHit, pIndex );
+        wide::IntersectTriangles<Wide1>( pRay, pPositions, pIndices, i, end, pHit, pIndex );
+    }
+
+    static void IntersectPacket
+    (
+        const f32* pRays, u32 stride, u32 begin, u32 end,
+        const f32* pPositions, const u32* pIndices, u32 triBegin, u32 triEnd,
+        f32* pHits, u32* pIndex
+    )
+    {
+        auto i = wide::IntersectPacket<W>( pRays, stride, begin, end, pPositions, pIndices, triBegin, triEnd, pHits, pIndex );
+        wide::IntersectPacket<Wide1>( pRays, stride, i, end, pPositions, pIndices, triBegin, triEnd, pHits, pIndex );
+    }
+
+    static void BoundsArray3( const f32* pIn, u32 begin, u32 end, f32* pMinMax )
+    {
+        auto i = wide::BoundsArray3<W>( pIn, begin, end, pMinMax );
+        wide::BoundsArray3<Wide1>( pIn, i, end, pMinMax );
+    }
+
+    static void BoundsIndexed3( const f32* pIn, const u32* pIndices, u32 begin, u32 end, f32* pMinMax )
+    {
+        auto i = wide::BoundsIndexed3<W>( pIn, pIndices, begin, end, pMinMax );
+        wide::BoundsIndexed3<Wide1>( pIn, pIndices, i, end, pMinMax );
+    }
+
+    static void GrowSphere3( const f32* pIn, const u32* pIndices, u32 begin, u32 end, f32* pSphere )
+    {
+        auto i = wide::GrowSphere3<W>( pIn, pIndices, begin, end, pSphere );
+        wide::GrowSphere3<Wide1>( pIn, pIndices, i, end, pSphere );
+    }
+
+    static void MaxDistanceSq3( const f32* pIn, const u32* pIndices, u32 begin, u32 end, const f32* pCenter, f32* pDistSq )
+    {
+        auto i = wide::MaxDistanceSq3<W>( pIn, pIndices, begin, end, pCenter, pDistSq );
+        wide::MaxDistanceSq3<Wide1>( pIn, pIndices, i, end, pCenter, pDistSq );
+    }
+
+    static void MergeTransformedBoxes( const f32* pBoxes, const f32* pMatrices, u32 begin, u32 end, f32* pMinMax )
+    {
+        auto i = wide::MergeTransformedBoxes<W>( pBoxes, pMatrices, begin, end, pMinMax );
+        wide::MergeTransformedBoxes<Wide1>( pBoxes, pMatrices, i, end, pMinMax );
+    }
+
+    static void SetupTriangles
+    (
+        const f32* pPositions, const u32* pIndices, u32 begin, u32 end,
+        const f32* pMatrix, const f32* pViewport, f32* pOut, u32* pCount, u32* pClip, u32* pClipCount
+    )
+    {
+        auto i = wide::SetupTriangles<W>( pPositions, pIndices, begin, end, pMatrix, pViewport, pOut, pCount, pClip, pClipCount );
+        wide::SetupTriangles<Wide1>( pPositions, pIndices, i, end, pMatrix, pViewport, pOut, pCount, pClip, pClipCount );
+    }
+
+    static void ProjectBoxes
+    (
+        const f32* pBoxes, u32 begin, u32 end, const f32* pMatrix, const f32* pViewport, f32* pRects
+    )
+    {
+        auto i = wide::ProjectBoxes<W>( pBoxes, begin, end, pMatrix, pViewport, pRects );
+        wide::ProjectBoxes<Wide1>( pBoxes, i, end, pMatrix, pViewport, pRects );
+    }
+
+    static void Xxh3Accumulate( u64* pAcc, const u8* pInput, const u8* pSecret, size_t stripes )
+    { Xxh3Kernel<typename HashWide<W>::Type>::Accumulate( pAcc, pInput, pSecret, stripes ); }
+
+    static void Xxh3Scramble( u64* pAcc, const u8* pSecret )
+    { Xxh3Kernel<typename HashWide<W>::Type>::Scramble( pAcc, pSecret ); }
+};
+
+//-------------------------------------------------------------------------------------------------
+//      幅 W のカーネルテーブルを取得します.
+//      関数アドレスのみで構成されるため, テーブルは定数初期化されます.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+const KernelTable* GetKernelTableOf()
+{
+    using E = KernelEntry<W>;
+    static const KernelTable s_Table = {
+        {
+            &E::template TransformArray3<TRANSFORM_POSITION>,
+            &E::template TransformArray3<TRANSFORM_NORMAL>,
+            &E::template TransformArray3<TRANSFORM_COORD>,
+        },
+        {
+            &E::template TransformStream3<TRANSFORM_POSITION>,
+            &E::template TransformStream3<TRANSFORM_NORMAL>,
+            &E::template TransformStream3<TRANSFORM_COORD>,
+        },
+        &E::TransformArray4,
+        &E::TransformStream4,
+        &E::SlerpArray,
+        &E::NlerpArray,
+        &E::NormalizeArray,
+        &E::ToMatrix3x4Stream,
+        &E::PackF16,
+        &E::UnpackF16,
+        &E::template PackNorm<s8>,
+        &E::template UnpackNorm<s8>,
+        &E::template PackNorm<s16>,
+        &E::template UnpackNorm<s16>,
+        &E::template PackNorm<u8>,
+        &E::template UnpackNorm<u8>,
+        &E::template PackNorm<u16>,
+        &E::template UnpackNorm<u16>,
+        &E::EncodeOctahedral,
+        &E::DecodeOctahedral,
+        &E::RandomFillU32,
+        &E::RandomFillF32,
+        &E::CullBoxStream,
+        &E::CullSphereStream,
+        &E::IntersectTriangles,
+        &E::IntersectPacket,
+        &E::BoundsArray3,
+        &E::BoundsIndexed3,
+        &E::GrowSphere3,
+        &E::MaxDistanceSq3,
+        &E::MergeTransformedBoxes,
+        &E::SetupTriangles,
+        &E::ProjectBoxes,
+        &E::Xxh3Accumulate,
+        &E::Xxh3Scramble,
+    };
+    return &s_Table;
+}
+
+} // inline namespace ASDX_KERNEL_ISA
+} // namespace wide
+} // namespace asdx
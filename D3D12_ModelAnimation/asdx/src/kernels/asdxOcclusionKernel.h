@@ -0,0 +1,275 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxOcclusionKernel.h
+// Desc : Occlusion Culling Setup Kernels.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "asdxWide.h"
+#include "asdxTransformKernel.h"
+
+
+namespace asdx {
+namespace wide {
+inline namespace ASDX_KERNEL_ISA {
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const u32 OCCLUSION_TRIANGLE_STRIDE = 9;     //!< 設定済み三角形1つあたりの要素数です(x, y, z を3頂点分).
+static const u32 OCCLUSION_RECT_STRIDE     = 5;     //!< 投影したボックス1つあたりの要素数です(minX, minY, maxX, maxY, minZ).
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// ViewportReg structure
+// 射影後の座標をピクセル座標に変換する値をレーン方向に複製したものです.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename W>
+struct ViewportReg
+{
+    typename W::Reg halfWidth;
+    typename W::Reg halfHeight;
+
+    explicit ViewportReg( const f32* pViewport )
+    {
+        halfWidth  = W::Replicate( pViewport[0] * 0.5f );
+        halfHeight = W::Replicate( pViewport[1] * 0.5f );
+    }
+
+    //! クリップ座標をピクセル座標と深度に変換します. y は下向きです.
+    ASDX_INLINE void Project
+    (
+        const typename W::Reg&  cx,
+        const typename W::Reg&  cy,
+        const typename W::Reg&  cz,
+        const typename W::Reg&  cw,
+        typename W::Reg&        sx,
+        typename W::Reg&        sy,
+        typename W::Reg&        sz
+    ) const
+    {
+        auto invW = W::Div( W::Replicate( 1.0f ), cw );
+        sx = W::Mad( W::Mul( cx, invW ), halfWidth, halfWidth );
+        sy = W::Sub( halfHeight, W::Mul( W::Mul( cy, invW ), halfHeight ) );
+        sz = W::Mul( cz, invW );
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+//      三角形 tri から W::Width 個分の k 番目の頂点をレジスタに読み込みます.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+ASDX_INLINE void GatherTriangleVertex( const f32* pPositions, const u32* pIndices, u32 tri, u32 k, typename W::Reg* p )
+{
+    f32 points[3][W::Width];
+    for( u32 j=0; j<W::Width; ++j )
+    {
+        const auto* pos = pPositions + pIndices[( tri + j ) * 3 + k] * 3;
+        points[0][j] = pos[0];
+        points[1][j] = pos[1];
+        points[2][j] = pos[2];
+    }
+
+    p[0] = W::Load( points[0] );
+    p[1] = W::Load( points[1] );
+    p[2] = W::Load( points[2] );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      三角形リストの区間 [begin, end) を射影し, 遮蔽物として描画する三角形を選別します.
+//
+//      pViewport は (width, height) です. 裏向き(画面上で反時計回り)と面積0の三角形,
+//      画面外と奥のクリップ面より奥の三角形は捨てます. 描画する三角形は pOut の *pCount 番目から
+//      OCCLUSION_TRIANGLE_STRIDE 要素ずつ書き込み, 手前のクリップ面をまたぐ三角形は番号を
+//      pClip の *pClipCount 番目から書き込みます. 全頂点が手前のクリップ面より手前の三角形は捨てます.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 SetupTriangles
+(
+    const f32*  pPositions,
+    const u32*  pIndices,
+    u32         begin,
+    u32         end,
+    const f32*  pMatrix,
+    const f32*  pViewport,
+    f32*        pOut,
+    u32*        pCount,
+    u32*        pClip,
+    u32*        pClipCount
+)
+{
+    const MatrixReg<W>   mat( pMatrix );
+    const ViewportReg<W> viewport( pViewport );
+    const auto zero   = W::Replicate( 0.0f );
+    const auto one    = W::Replicate( 1.0f );
+    const auto width  = W::Replicate( pViewport[0] );
+    const auto height = W::Replicate( pViewport[1] );
+    const u32  all    = ( 1u << W::Width ) - 1u;
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        typename W::Reg sx[3], sy[3], sz[3];
+        u32 nearAny = 0;
+        u32 nearAll = all;
+
+        for( u32 k=0; k<3; ++k )
+        {
+            typename W::Reg p[3], cx, cy, cz;
+            GatherTriangleVertex<W>( pPositions, pIndices, i, k, p );
+            Transform3<W, TRANSFORM_POSITION>( p[0], p[1], p[2], mat, cx, cy, cz );
+            auto cw = W::Add( W::Mad( p[2], mat.m[11], W::Mad( p[1], mat.m[7], W::Mul( p[0], mat.m[3] ) ) ), mat.m[15] );
+
+            auto nearMask = W::LessMask( cz, zero );
+            nearAny |= nearMask;
+            nearAll &= nearMask;
+
+            viewport.Project( cx, cy, cz, cw, sx[k], sy[k], sz[k] );
+        }
+
+        auto area = W::Sub(
+            W::Mul( W::Sub( sx[1], sx[0] ), W::Sub( sy[2], sy[0] ) ),
+            W::Mul( W::Sub( sx[2], sx[0] ), W::Sub( sy[1], sy[0] ) ) );
+
+        auto minX = W::Min( sx[0], W::Min( sx[1], sx[2] ) );
+        auto maxX = W::Max( sx[0], W::Max( sx[1], sx[2] ) );
+        auto minY = W::Min( sy[0], W::Min( sy[1], sy[2] ) );
+        auto maxY = W::Max( sy[0], W::Max( sy[1], sy[2] ) );
+        auto minZ = W::Min( sz[0], W::Min( sz[1], sz[2] ) );
+
+        auto visible = W::LessMask( zero, area )
+                     & W::LessMask( minX, width  ) & W::LessMask( zero, maxX )
+                     & W::LessMask( minY, height ) & W::LessMask( zero, maxY )
+                     & ~W::LessMask( one, minZ );
+
+        auto keep = visible & ~nearAny & all;
+        auto clip = nearAny & ~nearAll;
+        if ( ( keep | clip ) == 0 )
+        { continue; }
+
+        f32 values[OCCLUSION_TRIANGLE_STRIDE][W::Width];
+        for( u32 k=0; k<3; ++k )
+        {
+            W::Store( values[k * 3 + 0], sx[k] );
+            W::Store( values[k * 3 + 1], sy[k] );
+            W::Store( values[k * 3 + 2], sz[k] );
+        }
+
+        for( u32 j=0; j<W::Width; ++j )
+        {
+            if ( keep & ( 1u << j ) )
+            {
+                auto* dst = pOut + ( *pCount ) * OCCLUSION_TRIANGLE_STRIDE;
+                for( u32 c=0; c<OCCLUSION_TRIANGLE_STRIDE; ++c )
+                { dst[c] = values[c][j]; }
+                ( *pCount )++;
+            }
+            else if ( clip & ( 1u << j ) )
+            { pClip[( *pClipCount )++] = i + j; }
+        }
+    }
+
+    return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ボックス配列(最小値, 最大値の順で6要素ずつ)の区間 [begin, end) の8頂点を射影し,
+//      ピクセル座標の矩形と最も手前の深度を OCCLUSION_RECT_STRIDE 要素ずつ書き込みます.
+//      手前のクリップ面をまたぐボックスの深度は -1 とします.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 ProjectBoxes
+(
+    const f32*  pBoxes,
+    u32         begin,
+    u32         end,
+    const f32*  pMatrix,
+    const f32*  pViewport,
+    f32*        pRects
+)
+{
+    const MatrixReg<W>   mat( pMatrix );
+    const ViewportReg<W> viewport( pViewport );
+    const auto nearDepth = W::Replicate( -1.0f );
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        f32 bounds[6][W::Width];
+        for( u32 j=0; j<W::Width; ++j )
+        {
+            for( u32 c=0; c<6; ++c )
+            { bounds[c][j] = pBoxes[( i + j ) * 6 + c]; }
+        }
+
+        // 各軸の最小値と最大値に行列の行を掛けたもの. 8頂点はその組み合わせの和です.
+        typename W::Reg partial[3][2][4];
+        for( u32 a=0; a<3; ++a )
+        {
+            auto lo = W::Load( bounds[a] );
+            auto hi = W::Load( bounds[a + 3] );
+            for( u32 c=0; c<4; ++c )
+            {
+                partial[a][0][c] = W::Mul( lo, mat.m[a * 4 + c] );
+                partial[a][1][c] = W::Mul( hi, mat.m[a * 4 + c] );
+            }
+        }
+
+        // 最初の頂点で初期化してから, 残りの7頂点で範囲を広げる.
+        typename W::Reg clip[4];
+        for( u32 c=0; c<4; ++c )
+        { clip[c] = W::Add( W::Add( W::Add( partial[0][0][c], partial[1][0][c] ), partial[2][0][c] ), mat.m[12 + c] ); }
+
+        typename W::Reg minX, minY, minZ;
+        viewport.Project( clip[0], clip[1], clip[2], clip[3], minX, minY, minZ );
+
+        auto maxX     = minX;
+        auto maxY     = minY;
+        auto minClipZ = clip[2];
+
+        for( u32 corner=1; corner<8; ++corner )
+        {
+            auto bx = corner & 1;
+            auto by = ( corner >> 1 ) & 1;
+            auto bz = corner >> 2;
+
+            for( u32 c=0; c<4; ++c )
+            { clip[c] = W::Add( W::Add( W::Add( partial[0][bx][c], partial[1][by][c] ), partial[2][bz][c] ), mat.m[12 + c] ); }
+
+            typename W::Reg sx, sy, sz;
+            viewport.Project( clip[0], clip[1], clip[2], clip[3], sx, sy, sz );
+
+            minX = W::Min( minX, sx );
+            maxX = W::Max( maxX, sx );
+            minY = W::Min( minY, sy );
+            maxY = W::Max( maxY, sy );
+            minZ = W::Min( minZ, sz );
+            minClipZ = W::Min( minClipZ, clip[2] );
+        }
+
+        minZ = W::SelectSign( minClipZ, nearDepth, minZ );
+
+        f32 values[OCCLUSION_RECT_STRIDE][W::Width];
+        W::Store( values[0], minX );
+        W::Store( values[1], minY );
+        W::Store( values[2], maxX );
+        W::Store( values[3], maxY );
+        W::Store( values[4], minZ );
+
+        for( u32 j=0; j<W::Width; ++j )
+        {
+            auto* dst = pRects + ( i + j ) * OCCLUSION_RECT_STRIDE;
+            for( u32 c=0; c<OCCLUSION_RECT_STRIDE; ++c )
+            { dst[c] = values[c][j]; }
+        }
+    }
+
+    return i;
+}
+
+} // inline namespace ASDX_KERNEL_ISA
+} // namespace wide
+} // namespace asdx
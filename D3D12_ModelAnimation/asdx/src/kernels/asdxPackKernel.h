@@ -0,0 +1,170 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxPackKernel.h
+// Desc : Batch Data Packing Kernels.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "asdxWide.h"
+
+
+namespace asdx {
+namespace wide {
+inline namespace ASDX_KERNEL_ISA {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// NormTraits structure
+// 正規化整数の型ごとの定数です.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename T> struct NormTraits;
+
+template<> struct NormTraits<s8>
+{
+    static f32 Scale() { return 127.0f; }
+    static f32 Lower() { return -1.0f; }
+};
+
+template<> struct NormTraits<u8>
+{
+    static f32 Scale() { return 255.0f; }
+    static f32 Lower() { return 0.0f; }
+};
+
+template<> struct NormTraits<s16>
+{
+    static f32 Scale() { return 32767.0f; }
+    static f32 Lower() { return -1.0f; }
+};
+
+template<> struct NormTraits<u16>
+{
+    static f32 Scale() { return 65535.0f; }
+    static f32 Lower() { return 0.0f; }
+};
+
+//-------------------------------------------------------------------------------------------------
+//      区間 [begin, end) を半精度浮動小数に変換します.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 PackF16( const f32* pIn, u32 begin, u32 end, f16* pOut )
+{
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    { W::StoreF16( pOut + i, W::Load( pIn + i ) ); }
+
+    return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      区間 [begin, end) を半精度浮動小数から変換します.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 UnpackF16( const f16* pIn, u32 begin, u32 end, f32* pOut )
+{
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    { W::Store( pOut + i, W::LoadF16( pIn + i ) ); }
+
+    return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      区間 [begin, end) を正規化整数に変換します.
+//      値域外の値は飽和させ, 最近接偶数に丸めます. NaNは下限値になります.
+//-------------------------------------------------------------------------------------------------
+template<typename W, typename T>
+u32 PackNorm( const f32* pIn, u32 begin, u32 end, T* pOut )
+{
+    const auto lower = W::Replicate( NormTraits<T>::Lower() );
+    const auto upper = W::Replicate( 1.0f );
+    const auto scale = W::Replicate( NormTraits<T>::Scale() );
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        auto v = W::Min( W::Max( W::Load( pIn + i ), lower ), upper );
+        W::StoreInt( pOut + i, W::Mul( v, scale ) );
+    }
+
+    return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      区間 [begin, end) を正規化整数から変換します.
+//      符号付きの最小値(-128, -32768)は -1 になります.
+//-------------------------------------------------------------------------------------------------
+template<typename W, typename T>
+u32 UnpackNorm( const T* pIn, u32 begin, u32 end, f32* pOut )
+{
+    const auto lower = W::Replicate( NormTraits<T>::Lower() );
+    const auto scale = W::Replicate( NormTraits<T>::Scale() );
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    { W::Store( pOut + i, W::Max( W::Div( W::LoadInt( pIn + i ), scale ), lower ) ); }
+
+    return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      単位ベクトル配列の区間 [begin, end) を八面体写像で [-1, 1]^2 に符号化します.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 EncodeOctahedral( const f32* pIn, u32 begin, u32 end, f32* pOut )
+{
+    const auto one = W::Replicate( 1.0f );
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        typename W::Reg x, y, z;
+        W::LoadAoS3( pIn + i * 3, x, y, z );
+
+        // L1ノルムで正規化して八面体に射影.
+        auto l1 = W::Add( W::Add( W::Abs( x ), W::Abs( y ) ), W::Abs( z ) );
+        auto px = W::Div( x, l1 );
+        auto py = W::Div( y, l1 );
+
+        // 下半球は対角線で折り返す.
+        auto fx = W::MulSign( W::Sub( one, W::Abs( py ) ), px );
+        auto fy = W::MulSign( W::Sub( one, W::Abs( px ) ), py );
+
+        W::StoreAoS2( pOut + i * 2, W::SelectSign( z, fx, px ), W::SelectSign( z, fy, py ) );
+    }
+
+    return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      八面体写像で符号化された配列の区間 [begin, end) を単位ベクトルに復号します.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 DecodeOctahedral( const f32* pIn, u32 begin, u32 end, f32* pOut )
+{
+    const auto one  = W::Replicate( 1.0f );
+    const auto zero = W::Replicate( 0.0f );
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        typename W::Reg px, py;
+        W::LoadAoS2( pIn + i * 2, px, py );
+
+        auto z = W::Sub( W::Sub( one, W::Abs( px ) ), W::Abs( py ) );
+        auto t = W::Max( W::Sub( zero, z ), zero );
+        auto x = W::Sub( px, W::MulSign( t, px ) );
+        auto y = W::Sub( py, W::MulSign( t, py ) );
+
+        auto len = W::Sqrt( W::Mad( z, z, W::Mad( y, y, W::Mul( x, x ) ) ) );
+        W::StoreAoS3( pOut + i * 3, W::Div( x, len ), W::Div( y, len ), W::Div( z, len ) );
+    }
+
+    return i;
+}
+
+} // inline namespace ASDX_KERNEL_ISA
+} // namespace wide
+} // namespace asdx
@@ -0,0 +1,64 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxParallel.h
+// Desc : Parallel Loop Helper for Batch Kernels.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxTypedef.h>
+
+#if ASDX_IS_OPENMP
+    #include <omp.h>
+#endif
+
+
+namespace asdx {
+namespace wide {
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const u32 PARALLEL_GRAIN = 16384;    //!< 1スレッドが処理する要素数の単位です.
+
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      区間 [0, count) を grain 単位のブロックに分けて処理します.
+//!
+//! @details    OpenMPが有効かつ要素数が grain の2倍以上の場合はブロックをスレッドに分配します.
+//!             それ以外は呼び出しスレッドで func(0, count) を1回だけ呼び出します.
+//!             ブロック境界は grain の倍数になるため, grain をレーン幅の倍数にしておけば
+//!             端数処理は最後のブロックだけで発生します.
+//!
+//! @param[in]      count       要素数です.
+//! @param[in]      grain       ブロックあたりの要素数です.
+//! @param[in]      func        void(u32 begin, u32 end) の形式で呼び出される処理です.
+//-------------------------------------------------------------------------------------------------
+template<typename Func>
+inline void ParallelFor( u32 count, u32 grain, const Func& func )
+{
+#if ASDX_IS_OPENMP
+    if ( count >= grain * 2 )
+    {
+        const s32 blocks = s32( ( count + grain - 1 ) / grain );
+
+        #pragma omp parallel for schedule(static)
+        for( s32 i=0; i<blocks; ++i )
+        {
+            auto begin = u32(i) * grain;
+            auto end   = ( begin + grain < count ) ? begin + grain : count;
+            func( begin, end );
+        }
+        return;
+    }
+#else
+    ASDX_UNUSED_VAR( grain );
+#endif
+
+    func( 0, count );
+}
+
+} // namespace wide
+} // namespace asdx
@@ -0,0 +1,274 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxQuaternionKernel.h
+// Desc : Batch Quaternion Kernels.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "asdxWide.h"
+
+
+namespace asdx {
+namespace wide {
+inline namespace ASDX_KERNEL_ISA {
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const u32 SLERP_TERM_COUNT = 14;     //!< 球面線形補間の級数の項数です.
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      sin(tθ)/sin(θ) を (cosθ - 1) の級数で求める際の係数です.
+//!
+//! @details    i番目の項は (U[i] * t^2 - V[i]) * (cosθ - 1) です.
+//!             U[i] = 1 / (i(2i+1)), V[i] = i / (2i+1) (iは1始まり)で, 打ち切り誤差を
+//!             補正するため最終項のみ 1.90661 倍しています(θ <= π/2 で最大誤差 1.5e-7).
+//-------------------------------------------------------------------------------------------------
+static const f32 SLERP_U[SLERP_TERM_COUNT] = {
+    1.0f / (  1.0f *  3.0f ), 1.0f / (  2.0f *  5.0f ), 1.0f / (  3.0f *  7.0f ), 1.0f / (  4.0f *  9.0f ),
+    1.0f / (  5.0f * 11.0f ), 1.0f / (  6.0f * 13.0f ), 1.0f / (  7.0f * 15.0f ), 1.0f / (  8.0f * 17.0f ),
+    1.0f / (  9.0f * 19.0f ), 1.0f / ( 10.0f * 21.0f ), 1.0f / ( 11.0f * 23.0f ), 1.0f / ( 12.0f * 25.0f ),
+    1.0f / ( 13.0f * 27.0f ), 1.90661f / ( 14.0f * 29.0f ),
+};
+static const f32 SLERP_V[SLERP_TERM_COUNT] = {
+     1.0f /  3.0f,  2.0f /  5.0f,  3.0f /  7.0f,  4.0f /  9.0f,
+     5.0f / 11.0f,  6.0f / 13.0f,  7.0f / 15.0f,  8.0f / 17.0f,
+     9.0f / 19.0f, 10.0f / 21.0f, 11.0f / 23.0f, 12.0f / 25.0f,
+    13.0f / 27.0f, 1.90661f * 14.0f / 29.0f,
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// SlerpReg structure
+// 球面線形補間の係数をレーン方向に複製したものです.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename W>
+struct SlerpReg
+{
+    typename W::Reg u[SLERP_TERM_COUNT];
+    typename W::Reg v[SLERP_TERM_COUNT];
+    typename W::Reg one;
+
+    SlerpReg()
+    {
+        for( u32 i=0; i<SLERP_TERM_COUNT; ++i )
+        {
+            u[i] = W::Replicate( SLERP_U[i] );
+            v[i] = W::Replicate( SLERP_V[i] );
+        }
+        one = W::Replicate( 1.0f );
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+//      4成分の内積を求めます.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+ASDX_INLINE typename W::Reg Dot4
+(
+    const typename W::Reg& ax, const typename W::Reg& ay, const typename W::Reg& az, const typename W::Reg& aw,
+    const typename W::Reg& bx, const typename W::Reg& by, const typename W::Reg& bz, const typename W::Reg& bw
+)
+{ return W::Mad( aw, bw, W::Mad( az, bz, W::Mad( ay, by, W::Mul( ax, bx ) ) ) ); }
+
+//-------------------------------------------------------------------------------------------------
+//      sin(tθ)/sin(θ) を求めます. xm1 は cosθ - 1 です.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+ASDX_INLINE typename W::Reg SlerpWeight
+(
+    const typename W::Reg&  t,
+    const typename W::Reg&  xm1,
+    const SlerpReg<W>&      c
+)
+{
+    auto tt = W::Mul( t, t );
+    auto r  = c.one;
+    for( s32 i=SLERP_TERM_COUNT - 1; i>=0; --i )
+    { r = W::Mad( W::Mul( W::Sub( W::Mul( c.u[i], tt ), c.v[i] ), xm1 ), r, c.one ); }
+    return W::Mul( t, r );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      4成分を正規化します.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+ASDX_INLINE void Normalize4
+(
+    typename W::Reg& x,
+    typename W::Reg& y,
+    typename W::Reg& z,
+    typename W::Reg& w
+)
+{
+    auto len = W::Sqrt( Dot4<W>( x, y, z, w, x, y, z, w ) );
+    x = W::Div( x, len );
+    y = W::Div( y, len );
+    z = W::Div( z, len );
+    w = W::Div( w, len );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      四元数配列の区間 [begin, end) を球面線形補間します.
+//      最短経路を取るため, 内積が負の場合は b の符号を反転して補間します.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 SlerpArray
+(
+    const f32*  pA,
+    const f32*  pB,
+    const f32*  pAmounts,
+    u32         begin,
+    u32         end,
+    f32*        pOut
+)
+{
+    const SlerpReg<W> c;
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        typename W::Reg ax, ay, az, aw, bx, by, bz, bw;
+        W::LoadAoS4( pA + i * 4, ax, ay, az, aw );
+        W::LoadAoS4( pB + i * 4, bx, by, bz, bw );
+
+        auto t   = W::Load( pAmounts + i );
+        auto dot = Dot4<W>( ax, ay, az, aw, bx, by, bz, bw );
+        auto xm1 = W::Sub( W::Abs( dot ), c.one );
+
+        auto s0 = SlerpWeight<W>( W::Sub( c.one, t ), xm1, c );
+        auto s1 = W::MulSign( SlerpWeight<W>( t, xm1, c ), dot );
+
+        W::StoreAoS4( pOut + i * 4,
+            W::Mad( s1, bx, W::Mul( s0, ax ) ),
+            W::Mad( s1, by, W::Mul( s0, ay ) ),
+            W::Mad( s1, bz, W::Mul( s0, az ) ),
+            W::Mad( s1, bw, W::Mul( s0, aw ) ) );
+    }
+
+    return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      四元数配列の区間 [begin, end) を線形補間して正規化します.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 NlerpArray
+(
+    const f32*  pA,
+    const f32*  pB,
+    const f32*  pAmounts,
+    u32         begin,
+    u32         end,
+    f32*        pOut
+)
+{
+    const auto one = W::Replicate( 1.0f );
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        typename W::Reg ax, ay, az, aw, bx, by, bz, bw;
+        W::LoadAoS4( pA + i * 4, ax, ay, az, aw );
+        W::LoadAoS4( pB + i * 4, bx, by, bz, bw );
+
+        auto t   = W::Load( pAmounts + i );
+        auto dot = Dot4<W>( ax, ay, az, aw, bx, by, bz, bw );
+        auto s0  = W::Sub( one, t );
+        auto s1  = W::MulSign( t, dot );
+
+        auto rx = W::Mad( s1, bx, W::Mul( s0, ax ) );
+        auto ry = W::Mad( s1, by, W::Mul( s0, ay ) );
+        auto rz = W::Mad( s1, bz, W::Mul( s0, az ) );
+        auto rw = W::Mad( s1, bw, W::Mul( s0, aw ) );
+        Normalize4<W>( rx, ry, rz, rw );
+
+        W::StoreAoS4( pOut + i * 4, rx, ry, rz, rw );
+    }
+
+    return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      四元数配列の区間 [begin, end) を正規化します.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 NormalizeArray( const f32* pIn, u32 begin, u32 end, f32* pOut )
+{
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        typename W::Reg x, y, z, w;
+        W::LoadAoS4( pIn + i * 4, x, y, z, w );
+        Normalize4<W>( x, y, z, w );
+        W::StoreAoS4( pOut + i * 4, x, y, z, w );
+    }
+
+    return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      四元数配列の区間 [begin, end) を3x4行列(成分ごとの配列)に変換します.
+//      要素 (r, c) は pOut[(r * 4 + c) * stride + i] に格納されます.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 ToMatrix3x4Stream
+(
+    const f32*  pRotations,
+    const f32*  pTranslations,
+    u32         begin,
+    u32         end,
+    u32         stride,
+    f32*        pOut
+)
+{
+    const auto one  = W::Replicate( 1.0f );
+    const auto two  = W::Replicate( 2.0f );
+    const auto zero = W::Replicate( 0.0f );
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        typename W::Reg x, y, z, w;
+        W::LoadAoS4( pRotations + i * 4, x, y, z, w );
+
+        typename W::Reg tx = zero, ty = zero, tz = zero;
+        if ( pTranslations != nullptr )
+        { W::LoadAoS3( pTranslations + i * 3, tx, ty, tz ); }
+
+        auto xx = W::Mul( x, x );
+        auto yy = W::Mul( y, y );
+        auto zz = W::Mul( z, z );
+        auto xy = W::Mul( x, y );
+        auto yw = W::Mul( y, w );
+        auto yz = W::Mul( y, z );
+        auto xw = W::Mul( x, w );
+        auto zx = W::Mul( z, x );
+        auto zw = W::Mul( z, w );
+
+        // Matrix::CreateFromQuaternion() の転置.
+        W::Store( pOut +  0 * stride + i, W::Sub( one, W::Mul( two, W::Add( yy, zz ) ) ) );
+        W::Store( pOut +  1 * stride + i, W::Mul( two, W::Sub( xy, zw ) ) );
+        W::Store( pOut +  2 * stride + i, W::Mul( two, W::Add( zx, yw ) ) );
+        W::Store( pOut +  3 * stride + i, tx );
+
+        W::Store( pOut +  4 * stride + i, W::Mul( two, W::Add( xy, zw ) ) );
+        W::Store( pOut +  5 * stride + i, W::Sub( one, W::Mul( two, W::Add( zz, xx ) ) ) );
+        W::Store( pOut +  6 * stride + i, W::Mul( two, W::Sub( yz, xw ) ) );
+        W::Store( pOut +  7 * stride + i, ty );
+
+        W::Store( pOut +  8 * stride + i, W::Mul( two, W::Sub( zx, yw ) ) );
+        W::Store( pOut +  9 * stride + i, W::Mul( two, W::Add( yz, xw ) ) );
+        W::Store( pOut + 10 * stride + i, W::Sub( one, W::Mul( two, W::Add( yy, xx ) ) ) );
+        W::Store( pOut + 11 * stride + i, tz );
+    }
+
+    return i;
+}
+
+} // inline namespace ASDX_KERNEL_ISA
+} // namespace wide
+} // namespace asdx
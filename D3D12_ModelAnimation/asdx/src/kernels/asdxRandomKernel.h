@@ -0,0 +1,118 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxRandomKernel.h
+// Desc : Batch Random Number Generation Kernels.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "asdxWide.h"
+#include "asdxKernelTable.h"
+
+
+namespace asdx {
+namespace wide {
+inline namespace ASDX_KERNEL_ISA {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// RandomWide structure
+// 乱数生成に使用するレーン幅です.
+// 状態のレーン数(RANDOM_LANE_COUNT)を超える幅は一つ下の幅で処理します.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename W>
+struct RandomWide
+{ using Type = W; };
+
+#if ASDX_IS_SIMD && ASDX_IS_AVX2 && ASDX_IS_AVX512
+template<>
+struct RandomWide<Wide16>
+{ using Type = Wide8; };
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//      XorShift128 を1段進め, 生成した値を返却します.
+//      Random::GetAsU32() と同じ漸化式です.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+ASDX_INLINE typename W::UReg RandomStep
+(
+    typename W::UReg& x,
+    typename W::UReg& y,
+    typename W::UReg& z,
+    typename W::UReg& w
+)
+{
+    auto t = W::Xor( x, W::template Shl<11>( x ) );
+    x = y;
+    y = z;
+    z = w;
+    w = W::Xor( W::Xor( w, W::template Shr<19>( w ) ), W::Xor( t, W::template Shr<8>( t ) ) );
+    return w;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      レーン区間 [begin, end) の状態を steps 段進め, u32 の乱数を書き込みます.
+//      状態は x, y, z, w の順に RANDOM_LANE_COUNT 個ずつ並んだ配列で,
+//      s 段目のレーン k の値は pOut[s * RANDOM_LANE_COUNT + k] に格納されます.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 RandomFillU32( u32* pState, u32 begin, u32 end, u32 steps, u32* pOut )
+{
+    const u32 N = RANDOM_LANE_COUNT;
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        auto x = W::LoadU( pState + 0 * N + i );
+        auto y = W::LoadU( pState + 1 * N + i );
+        auto z = W::LoadU( pState + 2 * N + i );
+        auto w = W::LoadU( pState + 3 * N + i );
+
+        for( u32 s=0; s<steps; ++s )
+        { W::StoreU( pOut + s * N + i, RandomStep<W>( x, y, z, w ) ); }
+
+        W::StoreU( pState + 0 * N + i, x );
+        W::StoreU( pState + 1 * N + i, y );
+        W::StoreU( pState + 2 * N + i, z );
+        W::StoreU( pState + 3 * N + i, w );
+    }
+
+    return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      レーン区間 [begin, end) の状態を steps 段進め, offset + [0, 1) * scale の乱数を書き込みます.
+//      [0, 1) の値は上位24bitから誤差なしで求めるため, 全ての幅で同じ結果になります.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 RandomFillF32( u32* pState, u32 begin, u32 end, u32 steps, f32 offset, f32 scale, f32* pOut )
+{
+    const u32 N = RANDOM_LANE_COUNT;
+    const auto a = W::Replicate( offset );
+    const auto k = W::Replicate( scale );
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        auto x = W::LoadU( pState + 0 * N + i );
+        auto y = W::LoadU( pState + 1 * N + i );
+        auto z = W::LoadU( pState + 2 * N + i );
+        auto w = W::LoadU( pState + 3 * N + i );
+
+        for( u32 s=0; s<steps; ++s )
+        { W::Store( pOut + s * N + i, W::Mad( W::ToUnit( RandomStep<W>( x, y, z, w ) ), k, a ) ); }
+
+        W::StoreU( pState + 0 * N + i, x );
+        W::StoreU( pState + 1 * N + i, y );
+        W::StoreU( pState + 2 * N + i, z );
+        W::StoreU( pState + 3 * N + i, w );
+    }
+
+    return i;
+}
+
+} // inline namespace ASDX_KERNEL_ISA
+} // namespace wide
+} // namespace asdx
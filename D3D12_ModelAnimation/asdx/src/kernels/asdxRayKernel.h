@@ -0,0 +1,269 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxRayKernel.h
+// Desc : Batch Ray-Triangle Intersection Kernels.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "asdxWide.h"
+
+
+namespace asdx {
+namespace wide {
+inline namespace ASDX_KERNEL_ISA {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// RayReg structure
+// レイの始点と方向ベクトルです.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename W>
+struct RayReg
+{
+    typename W::Reg o[3];   //!< 始点です.
+    typename W::Reg d[3];   //!< 方向ベクトルです.
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TriangleReg structure
+// 三角形の頂点と2辺です.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename W>
+struct TriangleReg
+{
+    typename W::Reg v0[3];  //!< 頂点0です.
+    typename W::Reg e1[3];  //!< 頂点0から頂点1への辺です.
+    typename W::Reg e2[3];  //!< 頂点0から頂点2への辺です.
+};
+
+//-------------------------------------------------------------------------------------------------
+//      a * b - c * d を求めます.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+ASDX_INLINE typename W::Reg MulSub
+(
+    const typename W::Reg& a, const typename W::Reg& b,
+    const typename W::Reg& c, const typename W::Reg& d
+)
+{ return W::Sub( W::Mul( a, b ), W::Mul( c, d ) ); }
+
+//-------------------------------------------------------------------------------------------------
+//      3成分の内積を求めます.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+ASDX_INLINE typename W::Reg Dot3( const typename W::Reg* a, const typename W::Reg* b )
+{ return W::Mad( a[2], b[2], W::Mad( a[1], b[1], W::Mul( a[0], b[0] ) ) ); }
+
+//-------------------------------------------------------------------------------------------------
+//      3成分の外積を求めます.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+ASDX_INLINE void Cross3( const typename W::Reg* a, const typename W::Reg* b, typename W::Reg* r )
+{
+    r[0] = MulSub<W>( a[1], b[2], a[2], b[1] );
+    r[1] = MulSub<W>( a[2], b[0], a[0], b[2] );
+    r[2] = MulSub<W>( a[0], b[1], a[1], b[0] );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      レイと三角形の交差判定を行います(Moller-Trumbore).
+//
+//      交差したレーンのbitを立てたマスクを返却します. 条件は det != 0, u >= 0, v >= 0,
+//      u + v <= 1, 0 <= t < tMax で, 裏面も交差として扱います.
+//      全ての命令セットで同じ順序の乗算と加算のみを使うため, 結果はスカラー版と一致します.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+ASDX_INLINE u32 IntersectTriangle
+(
+    const RayReg<W>&        ray,
+    const TriangleReg<W>&   tri,
+    const typename W::Reg&  tMax,
+    typename W::Reg&        t,
+    typename W::Reg&        u,
+    typename W::Reg&        v
+)
+{
+    const auto zero = W::Replicate( 0.0f );
+    const auto one  = W::Replicate( 1.0f );
+    const u32  all  = ( 1u << W::Width ) - 1u;
+
+    typename W::Reg p[3], s[3], q[3];
+    Cross3<W>( ray.d, tri.e2, p );
+
+    auto det    = Dot3<W>( tri.e1, p );
+    auto invDet = W::Div( one, det );
+
+    s[0] = W::Sub( ray.o[0], tri.v0[0] );
+    s[1] = W::Sub( ray.o[1], tri.v0[1] );
+    s[2] = W::Sub( ray.o[2], tri.v0[2] );
+    u = W::Mul( Dot3<W>( s, p ), invDet );
+
+    Cross3<W>( s, tri.e1, q );
+    v = W::Mul( Dot3<W>( ray.d, q ), invDet );
+    t = W::Mul( Dot3<W>( tri.e2, q ), invDet );
+
+    auto reject = W::LessMask( u, zero )
+                | W::LessMask( v, zero )
+                | W::LessMask( one, W::Add( u, v ) )
+                | W::LessMask( t, zero );
+
+    return W::LessMask( zero, W::Abs( det ) ) & W::LessMask( t, tMax ) & ~reject & all;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      1本のレイと三角形リストの区間 [begin, end) の交差判定を行い, 最も近い交点を求めます.
+//
+//      pRay は (ox, oy, oz, dx, dy, dz) です. pHit は (t, u, v) で, pHit[0] より近い交点が
+//      見つかった場合のみ pHit と pIndex を更新します. 距離が等しい場合は番号の小さい方を残します.
+//      頂点位置は pIndices を通して pPositions から直接読み込みます.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 IntersectTriangles
+(
+    const f32*  pRay,
+    const f32*  pPositions,
+    const u32*  pIndices,
+    u32         begin,
+    u32         end,
+    f32*        pHit,
+    u32*        pIndex
+)
+{
+    RayReg<W> ray;
+    for( u32 c=0; c<3; ++c )
+    {
+        ray.o[c] = W::Replicate( pRay[c] );
+        ray.d[c] = W::Replicate( pRay[3 + c] );
+    }
+
+    auto tBest = pHit[0];
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        f32 vertices[9][W::Width];
+        for( u32 j=0; j<W::Width; ++j )
+        {
+            for( u32 k=0; k<3; ++k )
+            {
+                const auto* pos = pPositions + pIndices[( i + j ) * 3 + k] * 3;
+                vertices[k * 3 + 0][j] = pos[0];
+                vertices[k * 3 + 1][j] = pos[1];
+                vertices[k * 3 + 2][j] = pos[2];
+            }
+        }
+
+        TriangleReg<W> tri;
+        for( u32 c=0; c<3; ++c )
+        {
+            tri.v0[c] = W::Load( vertices[c] );
+            tri.e1[c] = W::Sub( W::Load( vertices[3 + c] ), tri.v0[c] );
+            tri.e2[c] = W::Sub( W::Load( vertices[6 + c] ), tri.v0[c] );
+        }
+
+        typename W::Reg t, u, v;
+        auto mask = IntersectTriangle<W>( ray, tri, W::Replicate( tBest ), t, u, v );
+        if ( mask == 0 )
+        { continue; }
+
+        f32 tt[W::Width], uu[W::Width], vv[W::Width];
+        W::Store( tt, t );
+        W::Store( uu, u );
+        W::Store( vv, v );
+        for( u32 j=0; j<W::Width; ++j )
+        {
+            if ( ( mask & ( 1u << j ) ) && tt[j] < tBest )
+            {
+                tBest   = tt[j];
+                pHit[1] = uu[j];
+                pHit[2] = vv[j];
+                *pIndex = i + j;
+            }
+        }
+    }
+
+    pHit[0] = tBest;
+    return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      レイ配列(SoA)の区間 [begin, end) と三角形リストの区間 [triBegin, triEnd) の交差判定を
+//      行い, レイごとに最も近い交点を求めます.
+//
+//      W::Width 本のレイを1つのパケットとして, 三角形を1つずつ全レーンに複製して判定します.
+//      レイの成分 c (ox, oy, oz, dx, dy, dz) は pRays[c * stride + i] です.
+//      交点の (t, u, v) は pHits[c * stride + i] で, pHits[i] より近い交点が見つかった場合のみ
+//      pHits と pIndex を更新します.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 IntersectPacket
+(
+    const f32*  pRays,
+    u32         stride,
+    u32         begin,
+    u32         end,
+    const f32*  pPositions,
+    const u32*  pIndices,
+    u32         triBegin,
+    u32         triEnd,
+    f32*        pHits,
+    u32*        pIndex
+)
+{
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        RayReg<W> ray;
+        for( u32 c=0; c<3; ++c )
+        {
+            ray.o[c] = W::Load( pRays + c * stride + i );
+            ray.d[c] = W::Load( pRays + ( 3 + c ) * stride + i );
+        }
+
+        auto tBest = W::Load( pHits + i );
+
+        for( auto j=triBegin; j<triEnd; ++j )
+        {
+            const auto* p0 = pPositions + pIndices[j * 3 + 0] * 3;
+            const auto* p1 = pPositions + pIndices[j * 3 + 1] * 3;
+            const auto* p2 = pPositions + pIndices[j * 3 + 2] * 3;
+
+            TriangleReg<W> tri;
+            for( u32 c=0; c<3; ++c )
+            {
+                tri.v0[c] = W::Replicate( p0[c] );
+                tri.e1[c] = W::Replicate( p1[c] - p0[c] );
+                tri.e2[c] = W::Replicate( p2[c] - p0[c] );
+            }
+
+            typename W::Reg t, u, v;
+            auto mask = IntersectTriangle<W>( ray, tri, tBest, t, u, v );
+            if ( mask == 0 )
+            { continue; }
+
+            f32 tt[W::Width], uu[W::Width], vv[W::Width];
+            W::Store( tt, t );
+            W::Store( uu, u );
+            W::Store( vv, v );
+            for( u32 k=0; k<W::Width; ++k )
+            {
+                if ( mask & ( 1u << k ) )
+                {
+                    pHits[i + k]              = tt[k];
+                    pHits[stride + i + k]     = uu[k];
+                    pHits[stride * 2 + i + k] = vv[k];
+                    pIndex[i + k]             = j;
+                }
+            }
+            tBest = W::Load( pHits + i );
+        }
+    }
+
+    return i;
+}
+
+} // inline namespace ASDX_KERNEL_ISA
+} // namespace wide
+} // namespace asdx
@@ -0,0 +1,206 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxTransformKernel.h
+// Desc : Batch Vector Transform Kernels.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "asdxWide.h"
+#include "asdxKernelTable.h"
+
+
+namespace asdx {
+namespace wide {
+inline namespace ASDX_KERNEL_ISA {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MatrixReg structure
+// 行列(行優先の16要素)の各要素をレーン方向に複製したものです.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename W>
+struct MatrixReg
+{
+    typename W::Reg m[16];
+
+    explicit MatrixReg( const f32* pMatrix )
+    {
+        for( auto i=0; i<16; ++i )
+        { m[i] = W::Replicate( pMatrix[i] ); }
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+//      3成分ベクトルを変換します.
+//      加算順序は Vector3::Transform* と同じ ((x*m1j + y*m2j) + z*m3j) + m4j です.
+//-------------------------------------------------------------------------------------------------
+template<typename W, TRANSFORM_MODE Mode>
+ASDX_INLINE void Transform3
+(
+    const typename W::Reg&  x,
+    const typename W::Reg&  y,
+    const typename W::Reg&  z,
+    const MatrixReg<W>&     mat,
+    typename W::Reg&        rx,
+    typename W::Reg&        ry,
+    typename W::Reg&        rz
+)
+{
+    const auto* m = mat.m;
+    rx = W::Mad( z, m[8],  W::Mad( y, m[4], W::Mul( x, m[0] ) ) );
+    ry = W::Mad( z, m[9],  W::Mad( y, m[5], W::Mul( x, m[1] ) ) );
+    rz = W::Mad( z, m[10], W::Mad( y, m[6], W::Mul( x, m[2] ) ) );
+
+    if ( Mode != TRANSFORM_NORMAL )
+    {
+        rx = W::Add( rx, m[12] );
+        ry = W::Add( ry, m[13] );
+        rz = W::Add( rz, m[14] );
+    }
+
+    if ( Mode == TRANSFORM_COORD )
+    {
+        auto rw = W::Add( W::Mad( z, m[11], W::Mad( y, m[7], W::Mul( x, m[3] ) ) ), m[15] );
+        rx = W::Div( rx, rw );
+        ry = W::Div( ry, rw );
+        rz = W::Div( rz, rw );
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      4成分ベクトルを変換します.
+//      加算順序は Vector4::Transform と同じ ((x*m1j + y*m2j) + z*m3j) + w*m4j です.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+ASDX_INLINE void Transform4
+(
+    const typename W::Reg&  x,
+    const typename W::Reg&  y,
+    const typename W::Reg&  z,
+    const typename W::Reg&  w,
+    const MatrixReg<W>&     mat,
+    typename W::Reg&        rx,
+    typename W::Reg&        ry,
+    typename W::Reg&        rz,
+    typename W::Reg&        rw
+)
+{
+    const auto* m = mat.m;
+    rx = W::Mad( w, m[12], W::Mad( z, m[8],  W::Mad( y, m[4], W::Mul( x, m[0] ) ) ) );
+    ry = W::Mad( w, m[13], W::Mad( z, m[9],  W::Mad( y, m[5], W::Mul( x, m[1] ) ) ) );
+    rz = W::Mad( w, m[14], W::Mad( z, m[10], W::Mad( y, m[6], W::Mul( x, m[2] ) ) ) );
+    rw = W::Mad( w, m[15], W::Mad( z, m[11], W::Mad( y, m[7], W::Mul( x, m[3] ) ) ) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//      xyz配列(AoS)の区間 [begin, end) を変換します.
+//-------------------------------------------------------------------------------------------------
+template<typename W, TRANSFORM_MODE Mode>
+u32 TransformArray3( const f32* pIn, u32 begin, u32 end, const f32* pMatrix, f32* pOut )
+{
+    const MatrixReg<W> mat( pMatrix );
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        typename W::Reg x, y, z, rx, ry, rz;
+        W::LoadAoS3( pIn + i * 3, x, y, z );
+        Transform3<W, Mode>( x, y, z, mat, rx, ry, rz );
+        W::StoreAoS3( pOut + i * 3, rx, ry, rz );
+    }
+
+    return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      xyzw配列(AoS)の区間 [begin, end) を変換します.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 TransformArray4( const f32* pIn, u32 begin, u32 end, const f32* pMatrix, f32* pOut )
+{
+    const MatrixReg<W> mat( pMatrix );
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        typename W::Reg x, y, z, w, rx, ry, rz, rw;
+        W::LoadAoS4( pIn + i * 4, x, y, z, w );
+        Transform4<W>( x, y, z, w, mat, rx, ry, rz, rw );
+        W::StoreAoS4( pOut + i * 4, rx, ry, rz, rw );
+    }
+
+    return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      x, y, z 各成分の配列(SoA)の区間 [begin, end) を変換します.
+//-------------------------------------------------------------------------------------------------
+template<typename W, TRANSFORM_MODE Mode>
+u32 TransformStream3
+(
+    const f32*      pX,
+    const f32*      pY,
+    const f32*      pZ,
+    u32             begin,
+    u32             end,
+    const f32*      pMatrix,
+    f32*            pOutX,
+    f32*            pOutY,
+    f32*            pOutZ
+)
+{
+    const MatrixReg<W> mat( pMatrix );
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        typename W::Reg rx, ry, rz;
+        Transform3<W, Mode>( W::Load( pX + i ), W::Load( pY + i ), W::Load( pZ + i ), mat, rx, ry, rz );
+        W::Store( pOutX + i, rx );
+        W::Store( pOutY + i, ry );
+        W::Store( pOutZ + i, rz );
+    }
+
+    return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      x, y, z, w 各成分の配列(SoA)の区間 [begin, end) を変換します.
+//-------------------------------------------------------------------------------------------------
+template<typename W>
+u32 TransformStream4
+(
+    const f32*      pX,
+    const f32*      pY,
+    const f32*      pZ,
+    const f32*      pW,
+    u32             begin,
+    u32             end,
+    const f32*      pMatrix,
+    f32*            pOutX,
+    f32*            pOutY,
+    f32*            pOutZ,
+    f32*            pOutW
+)
+{
+    const MatrixReg<W> mat( pMatrix );
+
+    auto i = begin;
+    for( ; i + W::Width <= end; i += W::Width )
+    {
+        typename W::Reg rx, ry, rz, rw;
+        Transform4<W>( W::Load( pX + i ), W::Load( pY + i ), W::Load( pZ + i ), W::Load( pW + i ), mat, rx, ry, rz, rw );
+        W::Store( pOutX + i, rx );
+        W::Store( pOutY + i, ry );
+        W::Store( pOutZ + i, rz );
+        W::Store( pOutW + i, rw );
+    }
+
+    return i;
+}
+
+} // inline namespace ASDX_KERNEL_ISA
+} // namespace wide
+} // namespace asdx
@@ -0,0 +1,970 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxWide.h
+// Desc : Wide Lane Abstraction for Batch Kernels.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxTypedef.h>
+#include <asdxSimd.h>
+#include <cmath>
+#include <cstring>
+
+#if ASDX_IS_SIMD && ( ASDX_IS_AVX2 || ASDX_IS_AVX512 )
+    #include <immintrin.h>
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      カーネルを配置する命令セットごとの名前空間です.
+//!
+//! @details    命令セット別の翻訳単位(src/kernels/asdxKernel*.cpp)はインクルード前に
+//!             それぞれ異なる名前を定義します. 同じテンプレートを異なるコンパイルオプションで
+//!             実体化しても名前が衝突しないため, リンカが別の命令セット版を選ぶことはありません.
+//-------------------------------------------------------------------------------------------------
+#ifndef ASDX_KERNEL_ISA
+#define ASDX_KERNEL_ISA     native
+#endif//ASDX_KERNEL_ISA
+
+
+namespace asdx {
+namespace wide {
+inline namespace ASDX_KERNEL_ISA {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Wide1 structure
+// スカラー版です. 端数処理とSIMD無効時に使用します.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct Wide1
+{
+    using Reg = f32;
+    static const u32 Width = 1;
+
+    static Reg  Load     ( const f32* p )               { return *p; }
+    static void Store    ( f32* p, Reg v )              { *p = v; }
+    static Reg  Replicate( f32 v )                      { return v; }
+    static Reg  Add      ( Reg a, Reg b )               { return a + b; }
+    static Reg  Sub      ( Reg a, Reg b )               { return a - b; }
+    static Reg  Mul      ( Reg a, Reg b )               { return a * b; }
+    static Reg  Mad      ( Reg a, Reg b, Reg c )        { return ( a * b ) + c; }
+    static Reg  Div      ( Reg a, Reg b )               { return a / b; }
+    static Reg  Sqrt     ( Reg a )                      { return sqrtf( a ); }
+    static Reg  Abs      ( Reg a )                      { return fabsf( a ); }
+    static Reg  Min      ( Reg a, Reg b )               { return ( a < b ) ? a : b; }
+    static Reg  Max      ( Reg a, Reg b )               { return ( a > b ) ? a : b; }
+    static Reg  MulSign  ( Reg a, Reg s )               { return std::signbit( s ) ? -a : a; }
+    static Reg  SelectSign( Reg s, Reg a, Reg b )       { return std::signbit( s ) ? a : b; }
+    static u32  LessMask ( Reg a, Reg b )               { return ( a < b ) ? 1u : 0u; }
+
+    using UReg = u32;
+    static UReg LoadU    ( const u32* p )               { return *p; }
+    static void StoreU   ( u32* p, UReg v )             { *p = v; }
+    static UReg Xor      ( UReg a, UReg b )             { return a ^ b; }
+    template<int N> static UReg Shl( UReg a )           { return a << N; }
+    template<int N> static UReg Shr( UReg a )           { return a >> N; }
+    static Reg  ToUnit   ( UReg v )                     { return f32( v >> 8 ) * ( 1.0f / 16777216.0f ); }
+
+    static Reg  LoadInt  ( const s8*  p )               { return f32( *p ); }
+    static Reg  LoadInt  ( const u8*  p )               { return f32( *p ); }
+    static Reg  LoadInt  ( const s16* p )               { return f32( *p ); }
+    static Reg  LoadInt  ( const u16* p )               { return f32( *p ); }
+    static void StoreInt ( s8*  p, Reg v )              { *p = s8 ( lrintf( v ) ); }
+    static void StoreInt ( u8*  p, Reg v )              { *p = u8 ( lrintf( v ) ); }
+    static void StoreInt ( s16* p, Reg v )              { *p = s16( lrintf( v ) ); }
+    static void StoreInt ( u16* p, Reg v )              { *p = u16( lrintf( v ) ); }
+
+    //---------------------------------------------------------------------------------------------
+    //      半精度浮動小数を読み込みます.
+    //      SIMD版と同じく, 指数部と仮数部を単精度の位置へずらして 2^112 を乗算します.
+    //---------------------------------------------------------------------------------------------
+    static Reg LoadF16( const f16* p )
+    {
+        const u32 magic   = 0x77800000u;    // 2^112.
+        const u32 expmant = u32( *p ) & 0x7fffu;
+
+        u32 bits = expmant << 13;
+        f32 scaled, scale;
+        memcpy( &scaled, &bits,  sizeof(f32) );
+        memcpy( &scale,  &magic, sizeof(f32) );
+        scaled *= scale;
+        memcpy( &bits, &scaled, sizeof(f32) );
+
+        if ( expmant > 0x7bffu )
+        { bits |= 0x7f800000u; }                // 無限大, NaN.
+        bits |= ( u32( *p ) & 0x8000u ) << 16;  // 符号.
+
+        f32 result;
+        memcpy( &result, &bits, sizeof(f32) );
+        return result;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      半精度浮動小数に最近接偶数丸めで変換して書き込みます.
+    //      範囲外の値は無限大に, NaNはquiet NaNになります.
+    //---------------------------------------------------------------------------------------------
+    static void StoreF16( f16* p, Reg v )
+    {
+        u32 bits;
+        memcpy( &bits, &v, sizeof(u32) );
+        const u32 sign = bits & 0x80000000u;
+        bits ^= sign;
+
+        u32 result;
+        if ( bits >= 0x47800000u )
+        { result = ( bits > 0x7f800000u ) ? 0x7e00u : 0x7c00u; }
+        else if ( bits < 0x38800000u )
+        {
+            // 0.5を加算して仮数部を下位10bitに揃え, 加算の丸めで最近接偶数に丸める.
+            f32 f;
+            memcpy( &f, &bits, sizeof(f32) );
+            f += 0.5f;
+            memcpy( &result, &f, sizeof(u32) );
+            result -= 0x3f000000u;
+        }
+        else
+        {
+            // 指数部のバイアスを掛け直し, 仮数部の最下位bitを足して最近接偶数に丸める.
+            result = ( bits + 0xc8000fffu + ( ( bits >> 13 ) & 1u ) ) >> 13;
+        }
+
+        *p = f16( result | ( sign >> 16 ) );
+    }
+
+    static void LoadAoS2( const f32* p, Reg& x, Reg& y )
+    {
+        x = p[0];
+        y = p[1];
+    }
+
+    static void StoreAoS2( f32* p, Reg x, Reg y )
+    {
+        p[0] = x;
+        p[1] = y;
+    }
+
+    static void LoadAoS3( const f32* p, Reg& x, Reg& y, Reg& z )
+    {
+        x = p[0];
+        y = p[1];
+        z = p[2];
+    }
+
+    static void StoreAoS3( f32* p, Reg x, Reg y, Reg z )
+    {
+        p[0] = x;
+        p[1] = y;
+        p[2] = z;
+    }
+
+    static void LoadAoS4( const f32* p, Reg& x, Reg& y, Reg& z, Reg& w )
+    {
+        x = p[0];
+        y = p[1];
+        z = p[2];
+        w = p[3];
+    }
+
+    static void StoreAoS4( f32* p, Reg x, Reg y, Reg z, Reg w )
+    {
+        p[0] = x;
+        p[1] = y;
+        p[2] = z;
+        p[3] = w;
+    }
+};
+
+#if ASDX_IS_SIMD
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Wide4 structure
+// Simdクラス(SSE/NEON)による4レーン版です.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct Wide4
+{
+    using Reg = b128;
+    static const u32 Width = 4;
+
+    static Reg  Load     ( const f32* p )                           { return Simd::Load( p ); }
+    static void Store    ( f32* p, const Reg& v )                   { Simd::Store( p, v ); }
+    static Reg  Replicate( f32 v )                                  { return Simd::Replicate( v ); }
+    static Reg  Add      ( const Reg& a, const Reg& b )             { return Simd::Add( a, b ); }
+    static Reg  Sub      ( const Reg& a, const Reg& b )             { return Simd::Sub( a, b ); }
+    static Reg  Mul      ( const Reg& a, const Reg& b )             { return Simd::Mul( a, b ); }
+    static Reg  Mad      ( const Reg& a, const Reg& b, const Reg& c ) { return Simd::Mad( a, b, c ); }
+    static Reg  Div      ( const Reg& a, const Reg& b )             { return Simd::Div( a, b ); }
+    static Reg  Sqrt     ( const Reg& a )                           { return Simd::Sqrt( a ); }
+    static Reg  Abs      ( const Reg& a )                           { return Simd::Abs( a ); }
+    static Reg  Min      ( const Reg& a, const Reg& b )             { return Simd::Min( a, b ); }
+    static Reg  Max      ( const Reg& a, const Reg& b )             { return Simd::Max( a, b ); }
+
+    //---------------------------------------------------------------------------------------------
+    //      s が負のレーンだけ a の符号を反転します.
+    //---------------------------------------------------------------------------------------------
+    static Reg MulSign( const Reg& a, const Reg& s )
+    {
+    #if ASDX_IS_SSE
+        return _mm_xor_ps( a, _mm_and_ps( s, _mm_set1_ps( -0.0f ) ) );
+    #elif ASDX_IS_NEON
+        auto mask = vandq_u32( vreinterpretq_u32_f32( s ), vdupq_n_u32( 0x80000000u ) );
+        return vreinterpretq_f32_u32( veorq_u32( vreinterpretq_u32_f32( a ), mask ) );
+    #endif
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      s の符号bitが立っているレーンは a を, それ以外は b を選択します.
+    //---------------------------------------------------------------------------------------------
+    static Reg SelectSign( const Reg& s, const Reg& a, const Reg& b )
+    {
+    #if ASDX_IS_SSE4_1
+        return _mm_blendv_ps( b, a, s );
+    #elif ASDX_IS_SSE
+        auto mask = _mm_castsi128_ps( _mm_srai_epi32( _mm_castps_si128( s ), 31 ) );
+        return _mm_or_ps( _mm_and_ps( mask, a ), _mm_andnot_ps( mask, b ) );
+    #elif ASDX_IS_NEON
+        return vbslq_f32( vcltq_s32( vreinterpretq_s32_f32( s ), vdupq_n_s32( 0 ) ), a, b );
+    #endif
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      a < b となるレーンのbitを立てたマスクを返却します(NaNは偽).
+    //---------------------------------------------------------------------------------------------
+    static u32 LessMask( const Reg& a, const Reg& b )
+    {
+    #if ASDX_IS_SSE
+        return u32( _mm_movemask_ps( _mm_cmplt_ps( a, b ) ) );
+    #elif ASDX_IS_NEON
+        static const u32 bits[4] = { 1, 2, 4, 8 };
+        auto m = vandq_u32( vcltq_f32( a, b ), vld1q_u32( bits ) );
+        #if defined(__aarch64__) || defined(_M_ARM64)
+            return vaddvq_u32( m );
+        #else
+            auto p = vpadd_u32( vget_low_u32( m ), vget_high_u32( m ) );
+            return vget_lane_u32( vpadd_u32( p, p ), 0 );
+        #endif
+    #endif
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      32bit符号なし整数のレーン演算です.
+    //      ToUnit() は上位24bitを [0, 1) の浮動小数に変換します(変換は誤差なしです).
+    //---------------------------------------------------------------------------------------------
+#if ASDX_IS_SSE
+    using UReg = __m128i;
+    static UReg LoadU ( const u32* p )                      { return _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) ); }
+    static void StoreU( u32* p, const UReg& v )             { _mm_storeu_si128( reinterpret_cast<__m128i*>( p ), v ); }
+    static UReg Xor   ( const UReg& a, const UReg& b )      { return _mm_xor_si128( a, b ); }
+    template<int N> static UReg Shl( const UReg& a )        { return _mm_slli_epi32( a, N ); }
+    template<int N> static UReg Shr( const UReg& a )        { return _mm_srli_epi32( a, N ); }
+    static Reg  ToUnit( const UReg& v )
+    { return _mm_mul_ps( _mm_cvtepi32_ps( _mm_srli_epi32( v, 8 ) ), _mm_set1_ps( 1.0f / 16777216.0f ) ); }
+#elif ASDX_IS_NEON
+    using UReg = uint32x4_t;
+    static UReg LoadU ( const u32* p )                      { return vld1q_u32( p ); }
+    static void StoreU( u32* p, const UReg& v )             { vst1q_u32( p, v ); }
+    static UReg Xor   ( const UReg& a, const UReg& b )      { return veorq_u32( a, b ); }
+    template<int N> static UReg Shl( const UReg& a )        { return vshlq_n_u32( a, N ); }
+    template<int N> static UReg Shr( const UReg& a )        { return vshrq_n_u32( a, N ); }
+    static Reg  ToUnit( const UReg& v )
+    { return vmulq_f32( vcvtq_f32_u32( vshrq_n_u32( v, 8 ) ), vdupq_n_f32( 1.0f / 16777216.0f ) ); }
+#endif
+
+#if ASDX_IS_SSE
+    //---------------------------------------------------------------------------------------------
+    //      4byteを読み込みます.
+    //---------------------------------------------------------------------------------------------
+    static __m128i Load32( const void* p )
+    {
+        s32 v;
+        memcpy( &v, p, sizeof(v) );
+        return _mm_cvtsi32_si128( v );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      下位4byteを書き込みます.
+    //---------------------------------------------------------------------------------------------
+    static void Store32( void* p, const __m128i& v )
+    {
+        s32 i = _mm_cvtsi128_si32( v );
+        memcpy( p, &i, sizeof(i) );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      整数を読み込んで浮動小数に変換します.
+    //---------------------------------------------------------------------------------------------
+    static Reg LoadInt( const s8* p )
+    {
+    #if ASDX_IS_SSE4_1
+        return _mm_cvtepi32_ps( _mm_cvtepi8_epi32( Load32( p ) ) );
+    #else
+        auto v = Load32( p );
+        v = _mm_unpacklo_epi8 ( v, v );
+        v = _mm_unpacklo_epi16( v, v );
+        return _mm_cvtepi32_ps( _mm_srai_epi32( v, 24 ) );
+    #endif
+    }
+
+    static Reg LoadInt( const u8* p )
+    {
+    #if ASDX_IS_SSE4_1
+        return _mm_cvtepi32_ps( _mm_cvtepu8_epi32( Load32( p ) ) );
+    #else
+        auto z = _mm_setzero_si128();
+        auto v = _mm_unpacklo_epi8( Load32( p ), z );
+        return _mm_cvtepi32_ps( _mm_unpacklo_epi16( v, z ) );
+    #endif
+    }
+
+    static Reg LoadInt( const s16* p )
+    {
+        auto v = _mm_loadl_epi64( reinterpret_cast<const __m128i*>( p ) );
+    #if ASDX_IS_SSE4_1
+        return _mm_cvtepi32_ps( _mm_cvtepi16_epi32( v ) );
+    #else
+        return _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( v, v ), 16 ) );
+    #endif
+    }
+
+    static Reg LoadInt( const u16* p )
+    {
+        auto v = _mm_loadl_epi64( reinterpret_cast<const __m128i*>( p ) );
+        return _mm_cvtepi32_ps( _mm_unpacklo_epi16( v, _mm_setzero_si128() ) );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      最近接偶数に丸めて整数で書き込みます. 値は型の範囲内である必要があります.
+    //---------------------------------------------------------------------------------------------
+    static void StoreInt( s8* p, const Reg& v )
+    {
+        auto i = _mm_cvtps_epi32( v );
+        i = _mm_packs_epi32( i, i );
+        Store32( p, _mm_packs_epi16( i, i ) );
+    }
+
+    static void StoreInt( u8* p, const Reg& v )
+    {
+        auto i = _mm_cvtps_epi32( v );
+        i = _mm_packs_epi32( i, i );
+        Store32( p, _mm_packus_epi16( i, i ) );
+    }
+
+    static void StoreInt( s16* p, const Reg& v )
+    {
+        auto i = _mm_cvtps_epi32( v );
+        _mm_storel_epi64( reinterpret_cast<__m128i*>( p ), _mm_packs_epi32( i, i ) );
+    }
+
+    static void StoreInt( u16* p, const Reg& v )
+    {
+        auto i = _mm_cvtps_epi32( v );
+    #if ASDX_IS_SSE4_1
+        i = _mm_packus_epi32( i, i );
+    #else
+        // 符号付きの範囲にずらして詰めてから戻す.
+        i = _mm_sub_epi32( i, _mm_set1_epi32( 0x8000 ) );
+        i = _mm_xor_si128( _mm_packs_epi32( i, i ), _mm_set1_epi16( s16( 0x8000u ) ) );
+    #endif
+        _mm_storel_epi64( reinterpret_cast<__m128i*>( p ), i );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      半精度浮動小数を読み込みます.
+    //---------------------------------------------------------------------------------------------
+    static Reg LoadF16( const f16* p )
+    {
+        auto h       = _mm_unpacklo_epi16( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( p ) ), _mm_setzero_si128() );
+        auto expmant = _mm_and_si128( h, _mm_set1_epi32( 0x7fff ) );
+        auto scaled  = _mm_mul_ps(
+            _mm_castsi128_ps( _mm_slli_epi32( expmant, 13 ) ),
+            _mm_castsi128_ps( _mm_set1_epi32( 0x77800000 ) ) );
+        auto infnan  = _mm_and_si128( _mm_cmpgt_epi32( expmant, _mm_set1_epi32( 0x7bff ) ), _mm_set1_epi32( 0x7f800000 ) );
+        auto sign    = _mm_slli_epi32( _mm_xor_si128( h, expmant ), 16 );
+        return _mm_or_ps( scaled, _mm_castsi128_ps( _mm_or_si128( sign, infnan ) ) );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      半精度浮動小数に最近接偶数丸めで変換して書き込みます.
+    //      Wide1::StoreF16() と同じ処理を整数演算で行います.
+    //---------------------------------------------------------------------------------------------
+    static void StoreF16( f16* p, const Reg& v )
+    {
+        auto bits = _mm_castps_si128( v );
+        auto sign = _mm_and_si128( bits, _mm_set1_epi32( s32( 0x80000000u ) ) );
+        bits = _mm_xor_si128( bits, sign );
+
+        // 無限大, NaN.
+        auto isInfNan = _mm_cmpgt_epi32( bits, _mm_set1_epi32( 0x477fffff ) );
+        auto infnan   = _mm_or_si128( _mm_set1_epi32( 0x7c00 ),
+            _mm_and_si128( _mm_cmpgt_epi32( bits, _mm_set1_epi32( 0x7f800000 ) ), _mm_set1_epi32( 0x0200 ) ) );
+
+        // 非正規化数.
+        auto isDenorm = _mm_cmpgt_epi32( _mm_set1_epi32( 0x38800000 ), bits );
+        auto denorm   = _mm_sub_epi32(
+            _mm_castps_si128( _mm_add_ps( _mm_castsi128_ps( bits ), _mm_set1_ps( 0.5f ) ) ),
+            _mm_set1_epi32( 0x3f000000 ) );
+
+        // 正規化数.
+        auto odd    = _mm_and_si128( _mm_srli_epi32( bits, 13 ), _mm_set1_epi32( 1 ) );
+        auto normal = _mm_srli_epi32( _mm_add_epi32( _mm_add_epi32( bits, _mm_set1_epi32( s32( 0xc8000fffu ) ) ), odd ), 13 );
+
+        auto r = _mm_or_si128( _mm_and_si128( isDenorm, denorm ), _mm_andnot_si128( isDenorm, normal ) );
+        r = _mm_or_si128( _mm_and_si128( isInfNan, infnan ), _mm_andnot_si128( isInfNan, r ) );
+        r = _mm_or_si128( r, _mm_srli_epi32( sign, 16 ) );
+
+        // 符号拡張してから飽和なしで16bitに詰める.
+        r = _mm_srai_epi32( _mm_slli_epi32( r, 16 ), 16 );
+        _mm_storel_epi64( reinterpret_cast<__m128i*>( p ), _mm_packs_epi32( r, r ) );
+    }
+#elif ASDX_IS_NEON
+    //---------------------------------------------------------------------------------------------
+    //      最近接偶数に丸めて整数に変換します.
+    //---------------------------------------------------------------------------------------------
+    static int32x4_t ToInt( const Reg& v )
+    {
+    #if defined(__aarch64__) || defined(_M_ARM64)
+        return vcvtnq_s32_f32( v );
+    #else
+        // 1.5 * 2^23 の加減算で小数部を丸めてから切り捨て変換する.
+        auto magic = vdupq_n_f32( 12582912.0f );
+        return vcvtq_s32_f32( vsubq_f32( vaddq_f32( v, magic ), magic ) );
+    #endif
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      整数を読み込んで浮動小数に変換します.
+    //---------------------------------------------------------------------------------------------
+    static Reg LoadInt( const s8* p )
+    {
+        s32 v;
+        memcpy( &v, p, sizeof(v) );
+        auto w = vmovl_s8( vreinterpret_s8_s32( vdup_n_s32( v ) ) );
+        return vcvtq_f32_s32( vmovl_s16( vget_low_s16( w ) ) );
+    }
+
+    static Reg LoadInt( const u8* p )
+    {
+        u32 v;
+        memcpy( &v, p, sizeof(v) );
+        auto w = vmovl_u8( vreinterpret_u8_u32( vdup_n_u32( v ) ) );
+        return vcvtq_f32_u32( vmovl_u16( vget_low_u16( w ) ) );
+    }
+
+    static Reg LoadInt( const s16* p )
+    { return vcvtq_f32_s32( vmovl_s16( vld1_s16( p ) ) ); }
+
+    static Reg LoadInt( const u16* p )
+    { return vcvtq_f32_u32( vmovl_u16( vld1_u16( p ) ) ); }
+
+    //---------------------------------------------------------------------------------------------
+    //      最近接偶数に丸めて整数で書き込みます. 値は型の範囲内である必要があります.
+    //---------------------------------------------------------------------------------------------
+    static void StoreInt( s8* p, const Reg& v )
+    {
+        auto h = vmovn_s32( ToInt( v ) );
+        auto b = vmovn_s16( vcombine_s16( h, h ) );
+        s32 i = vget_lane_s32( vreinterpret_s32_s8( b ), 0 );
+        memcpy( p, &i, sizeof(i) );
+    }
+
+    static void StoreInt( u8* p, const Reg& v )
+    {
+        auto h = vmovn_u32( vreinterpretq_u32_s32( ToInt( v ) ) );
+        auto b = vmovn_u16( vcombine_u16( h, h ) );
+        u32 i = vget_lane_u32( vreinterpret_u32_u8( b ), 0 );
+        memcpy( p, &i, sizeof(i) );
+    }
+
+    static void StoreInt( s16* p, const Reg& v )
+    { vst1_s16( p, vmovn_s32( ToInt( v ) ) ); }
+
+    static void StoreInt( u16* p, const Reg& v )
+    { vst1_u16( p, vmovn_u32( vreinterpretq_u32_s32( ToInt( v ) ) ) ); }
+
+    //---------------------------------------------------------------------------------------------
+    //      半精度浮動小数を読み込みます.
+    //---------------------------------------------------------------------------------------------
+    static Reg LoadF16( const f16* p )
+    {
+    #if defined(__aarch64__) || defined(_M_ARM64)
+        return vcvt_f32_f16( vreinterpret_f16_u16( vld1_u16( p ) ) );
+    #else
+        f32 v[4];
+        for( auto i=0; i<4; ++i )
+        { v[i] = Wide1::LoadF16( p + i ); }
+        return vld1q_f32( v );
+    #endif
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      半精度浮動小数に最近接偶数丸めで変換して書き込みます.
+    //---------------------------------------------------------------------------------------------
+    static void StoreF16( f16* p, const Reg& v )
+    {
+    #if defined(__aarch64__) || defined(_M_ARM64)
+        vst1_u16( p, vreinterpret_u16_f16( vcvt_f16_f32( v ) ) );
+    #else
+        f32 t[4];
+        vst1q_f32( t, v );
+        for( auto i=0; i<4; ++i )
+        { Wide1::StoreF16( p + i, t[i] ); }
+    #endif
+    }
+#endif
+
+    //---------------------------------------------------------------------------------------------
+    //      xyxyxyxy の並びを xxxx, yyyy に展開します.
+    //---------------------------------------------------------------------------------------------
+    static void LoadAoS2( const f32* p, Reg& x, Reg& y )
+    {
+    #if ASDX_IS_SSE
+        b128 a = _mm_loadu_ps( p + 0 );     // x0 y0 x1 y1
+        b128 b = _mm_loadu_ps( p + 4 );     // x2 y2 x3 y3
+        x = _mm_shuffle_ps( a, b, _MM_SHUFFLE(2, 0, 2, 0) );
+        y = _mm_shuffle_ps( a, b, _MM_SHUFFLE(3, 1, 3, 1) );
+    #elif ASDX_IS_NEON
+        float32x4x2_t v = vld2q_f32( p );
+        x = v.val[0];
+        y = v.val[1];
+    #endif
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      xxxx, yyyy を xyxyxyxy の並びで書き込みます.
+    //---------------------------------------------------------------------------------------------
+    static void StoreAoS2( f32* p, const Reg& x, const Reg& y )
+    {
+    #if ASDX_IS_SSE
+        _mm_storeu_ps( p + 0, _mm_unpacklo_ps( x, y ) );
+        _mm_storeu_ps( p + 4, _mm_unpackhi_ps( x, y ) );
+    #elif ASDX_IS_NEON
+        float32x4x2_t v;
+        v.val[0] = x;
+        v.val[1] = y;
+        vst2q_f32( p, v );
+    #endif
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      xyzxyzxyzxyz の並びを xxxx, yyyy, zzzz に展開します.
+    //---------------------------------------------------------------------------------------------
+    static void LoadAoS3( const f32* p, Reg& x, Reg& y, Reg& z )
+    {
+    #if ASDX_IS_SSE
+        b128 a = _mm_loadu_ps( p + 0 );     // x0 y0 z0 x1
+        b128 b = _mm_loadu_ps( p + 4 );     // y1 z1 x2 y2
+        b128 c = _mm_loadu_ps( p + 8 );     // z2 x3 y3 z3
+
+        x = _mm_shuffle_ps(
+                _mm_shuffle_ps( a, a, _MM_SHUFFLE(3, 3, 0, 0) ),
+                _mm_shuffle_ps( b, c, _MM_SHUFFLE(1, 1, 2, 2) ),
+                _MM_SHUFFLE(2, 0, 2, 0) );
+        y = _mm_shuffle_ps(
+                _mm_shuffle_ps( a, b, _MM_SHUFFLE(0, 0, 1, 1) ),
+                _mm_shuffle_ps( b, c, _MM_SHUFFLE(2, 2, 3, 3) ),
+                _MM_SHUFFLE(2, 0, 2, 0) );
+        z = _mm_shuffle_ps(
+                _mm_shuffle_ps( a, b, _MM_SHUFFLE(1, 1, 2, 2) ),
+                _mm_shuffle_ps( c, c, _MM_SHUFFLE(3, 3, 0, 0) ),
+                _MM_SHUFFLE(2, 0, 2, 0) );
+    #elif ASDX_IS_NEON
+        float32x4x3_t v = vld3q_f32( p );
+        x = v.val[0];
+        y = v.val[1];
+        z = v.val[2];
+    #endif
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      xxxx, yyyy, zzzz を xyzxyzxyzxyz の並びで書き込みます.
+    //---------------------------------------------------------------------------------------------
+    static void StoreAoS3( f32* p, const Reg& x, const Reg& y, const Reg& z )
+    {
+    #if ASDX_IS_SSE
+        b128 xy01 = _mm_unpacklo_ps( x, y );                            // x0 y0 x1 y1
+        b128 xy23 = _mm_unpackhi_ps( x, y );                            // x2 y2 x3 y3
+        b128 zx01 = _mm_shuffle_ps( z, x, _MM_SHUFFLE(1, 1, 0, 0) );    // z0 z0 x1 x1
+        b128 yz11 = _mm_shuffle_ps( y, z, _MM_SHUFFLE(1, 1, 1, 1) );    // y1 y1 z1 z1
+        b128 zx23 = _mm_shuffle_ps( z, x, _MM_SHUFFLE(3, 3, 2, 2) );    // z2 z2 x3 x3
+        b128 yz33 = _mm_shuffle_ps( y, z, _MM_SHUFFLE(3, 3, 3, 3) );    // y3 y3 z3 z3
+
+        _mm_storeu_ps( p + 0, _mm_shuffle_ps( xy01, zx01, _MM_SHUFFLE(2, 0, 1, 0) ) );
+        _mm_storeu_ps( p + 4, _mm_shuffle_ps( yz11, xy23, _MM_SHUFFLE(1, 0, 2, 0) ) );
+        _mm_storeu_ps( p + 8, _mm_shuffle_ps( zx23, yz33, _MM_SHUFFLE(2, 0, 2, 0) ) );
+    #elif ASDX_IS_NEON
+        float32x4x3_t v;
+        v.val[0] = x;
+        v.val[1] = y;
+        v.val[2] = z;
+        vst3q_f32( p, v );
+    #endif
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      xyzw x 4 の並びを xxxx, yyyy, zzzz, wwww に展開します.
+    //---------------------------------------------------------------------------------------------
+    static void LoadAoS4( const f32* p, Reg& x, Reg& y, Reg& z, Reg& w )
+    {
+        x = Simd::Load( p + 0  );
+        y = Simd::Load( p + 4  );
+        z = Simd::Load( p + 8  );
+        w = Simd::Load( p + 12 );
+        Simd::Transpose( x, y, z, w );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      xxxx, yyyy, zzzz, wwww を xyzw x 4 の並びで書き込みます.
+    //---------------------------------------------------------------------------------------------
+    static void StoreAoS4( f32* p, Reg x, Reg y, Reg z, Reg w )
+    {
+        Simd::Transpose( x, y, z, w );
+        Simd::Store( p + 0,  x );
+        Simd::Store( p + 4,  y );
+        Simd::Store( p + 8,  z );
+        Simd::Store( p + 12, w );
+    }
+};
+#endif//ASDX_IS_SIMD
+
+#if ASDX_IS_SIMD && ASDX_IS_AVX2
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Wide8 structure
+// AVX2による8レーン版です.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct Wide8
+{
+    using Reg = __m256;
+    static const u32 Width = 8;
+
+    static Reg  Load     ( const f32* p )                           { return _mm256_loadu_ps( p ); }
+    static void Store    ( f32* p, const Reg& v )                   { _mm256_storeu_ps( p, v ); }
+    static Reg  Replicate( f32 v )                                  { return _mm256_set1_ps( v ); }
+    static Reg  Add      ( const Reg& a, const Reg& b )             { return _mm256_add_ps( a, b ); }
+    static Reg  Sub      ( const Reg& a, const Reg& b )             { return _mm256_sub_ps( a, b ); }
+    static Reg  Mul      ( const Reg& a, const Reg& b )             { return _mm256_mul_ps( a, b ); }
+    static Reg  Mad      ( const Reg& a, const Reg& b, const Reg& c ) { return _mm256_add_ps( _mm256_mul_ps( a, b ), c ); }
+    static Reg  Div      ( const Reg& a, const Reg& b )             { return _mm256_div_ps( a, b ); }
+    static Reg  Sqrt     ( const Reg& a )                           { return _mm256_sqrt_ps( a ); }
+    static Reg  Abs      ( const Reg& a )                           { return _mm256_andnot_ps( _mm256_set1_ps( -0.0f ), a ); }
+    static Reg  Min      ( const Reg& a, const Reg& b )             { return _mm256_min_ps( a, b ); }
+    static Reg  Max      ( const Reg& a, const Reg& b )             { return _mm256_max_ps( a, b ); }
+    static Reg  MulSign  ( const Reg& a, const Reg& s )             { return _mm256_xor_ps( a, _mm256_and_ps( s, _mm256_set1_ps( -0.0f ) ) ); }
+    static Reg  SelectSign( const Reg& s, const Reg& a, const Reg& b ) { return _mm256_blendv_ps( b, a, s ); }
+    static u32  LessMask ( const Reg& a, const Reg& b )             { return u32( _mm256_movemask_ps( _mm256_cmp_ps( a, b, _CMP_LT_OQ ) ) ); }
+
+    //---------------------------------------------------------------------------------------------
+    //      32bit符号なし整数のレーン演算です.
+    //---------------------------------------------------------------------------------------------
+    using UReg = __m256i;
+    static UReg LoadU ( const u32* p )                      { return _mm256_loadu_si256( reinterpret_cast<const __m256i*>( p ) ); }
+    static void StoreU( u32* p, const UReg& v )             { _mm256_storeu_si256( reinterpret_cast<__m256i*>( p ), v ); }
+    static UReg Xor   ( const UReg& a, const UReg& b )      { return _mm256_xor_si256( a, b ); }
+    template<int N> static UReg Shl( const UReg& a )        { return _mm256_slli_epi32( a, N ); }
+    template<int N> static UReg Shr( const UReg& a )        { return _mm256_srli_epi32( a, N ); }
+    static Reg  ToUnit( const UReg& v )
+    { return _mm256_mul_ps( _mm256_cvtepi32_ps( _mm256_srli_epi32( v, 8 ) ), _mm256_set1_ps( 1.0f / 16777216.0f ) ); }
+
+    //---------------------------------------------------------------------------------------------
+    //      128bitレジスタ2つを連結します.
+    //---------------------------------------------------------------------------------------------
+    static Reg Combine( const Wide4::Reg& lo, const Wide4::Reg& hi )
+    { return _mm256_insertf128_ps( _mm256_castps128_ps256( lo ), hi, 1 ); }
+
+    //---------------------------------------------------------------------------------------------
+    //      整数を読み込んで浮動小数に変換します.
+    //---------------------------------------------------------------------------------------------
+    static Reg LoadInt( const s8*  p ) { return _mm256_cvtepi32_ps( _mm256_cvtepi8_epi32 ( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( p ) ) ) ); }
+    static Reg LoadInt( const u8*  p ) { return _mm256_cvtepi32_ps( _mm256_cvtepu8_epi32 ( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( p ) ) ) ); }
+    static Reg LoadInt( const s16* p ) { return _mm256_cvtepi32_ps( _mm256_cvtepi16_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) ) ) ); }
+    static Reg LoadInt( const u16* p ) { return _mm256_cvtepi32_ps( _mm256_cvtepu16_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) ) ) ); }
+
+    //---------------------------------------------------------------------------------------------
+    //      最近接偶数に丸めて整数で書き込みます. 値は型の範囲内である必要があります.
+    //---------------------------------------------------------------------------------------------
+    template<typename T>
+    static void StoreInt( T* p, const Reg& v )
+    {
+        Wide4::StoreInt( p + 0, _mm256_castps256_ps128( v ) );
+        Wide4::StoreInt( p + 4, _mm256_extractf128_ps( v, 1 ) );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      半精度浮動小数を読み込みます.
+    //---------------------------------------------------------------------------------------------
+    static Reg LoadF16( const f16* p )
+    {
+    #if ASDX_IS_F16C
+        return _mm256_cvtph_ps( _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) ) );
+    #else
+        return Combine( Wide4::LoadF16( p + 0 ), Wide4::LoadF16( p + 4 ) );
+    #endif
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      半精度浮動小数に最近接偶数丸めで変換して書き込みます.
+    //---------------------------------------------------------------------------------------------
+    static void StoreF16( f16* p, const Reg& v )
+    {
+    #if ASDX_IS_F16C
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( p ), _mm256_cvtps_ph( v, _MM_FROUND_TO_NEAREST_INT ) );
+    #else
+        Wide4::StoreF16( p + 0, _mm256_castps256_ps128( v ) );
+        Wide4::StoreF16( p + 4, _mm256_extractf128_ps( v, 1 ) );
+    #endif
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      xy x 8 の並びを xxxxxxxx, yyyyyyyy に展開します.
+    //---------------------------------------------------------------------------------------------
+    static void LoadAoS2( const f32* p, Reg& x, Reg& y )
+    {
+        Wide4::Reg x0, y0, x1, y1;
+        Wide4::LoadAoS2( p + 0, x0, y0 );
+        Wide4::LoadAoS2( p + 8, x1, y1 );
+        x = Combine( x0, x1 );
+        y = Combine( y0, y1 );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      xxxxxxxx, yyyyyyyy を xy x 8 の並びで書き込みます.
+    //---------------------------------------------------------------------------------------------
+    static void StoreAoS2( f32* p, const Reg& x, const Reg& y )
+    {
+        Wide4::StoreAoS2( p + 0, _mm256_castps256_ps128( x ), _mm256_castps256_ps128( y ) );
+        Wide4::StoreAoS2( p + 8, _mm256_extractf128_ps( x, 1 ), _mm256_extractf128_ps( y, 1 ) );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      xyz x 8 の並びを xxxxxxxx, yyyyyyyy, zzzzzzzz に展開します.
+    //---------------------------------------------------------------------------------------------
+    static void LoadAoS3( const f32* p, Reg& x, Reg& y, Reg& z )
+    {
+        Wide4::Reg x0, y0, z0, x1, y1, z1;
+        Wide4::LoadAoS3( p + 0,  x0, y0, z0 );
+        Wide4::LoadAoS3( p + 12, x1, y1, z1 );
+        x = Combine( x0, x1 );
+        y = Combine( y0, y1 );
+        z = Combine( z0, z1 );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      xxxxxxxx, yyyyyyyy, zzzzzzzz を xyz x 8 の並びで書き込みます.
+    //---------------------------------------------------------------------------------------------
+    static void StoreAoS3( f32* p, const Reg& x, const Reg& y, const Reg& z )
+    {
+        Wide4::StoreAoS3( p + 0,
+            _mm256_castps256_ps128( x ),
+            _mm256_castps256_ps128( y ),
+            _mm256_castps256_ps128( z ) );
+        Wide4::StoreAoS3( p + 12,
+            _mm256_extractf128_ps( x, 1 ),
+            _mm256_extractf128_ps( y, 1 ),
+            _mm256_extractf128_ps( z, 1 ) );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      xyzw x 8 の並びを xxxxxxxx, yyyyyyyy, zzzzzzzz, wwwwwwww に展開します.
+    //---------------------------------------------------------------------------------------------
+    static void LoadAoS4( const f32* p, Reg& x, Reg& y, Reg& z, Reg& w )
+    {
+        Wide4::Reg x0, y0, z0, w0, x1, y1, z1, w1;
+        Wide4::LoadAoS4( p + 0,  x0, y0, z0, w0 );
+        Wide4::LoadAoS4( p + 16, x1, y1, z1, w1 );
+        x = Combine( x0, x1 );
+        y = Combine( y0, y1 );
+        z = Combine( z0, z1 );
+        w = Combine( w0, w1 );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      xxxxxxxx, yyyyyyyy, zzzzzzzz, wwwwwwww を xyzw x 8 の並びで書き込みます.
+    //---------------------------------------------------------------------------------------------
+    static void StoreAoS4( f32* p, const Reg& x, const Reg& y, const Reg& z, const Reg& w )
+    {
+        Wide4::StoreAoS4( p + 0,
+            _mm256_castps256_ps128( x ),
+            _mm256_castps256_ps128( y ),
+            _mm256_castps256_ps128( z ),
+            _mm256_castps256_ps128( w ) );
+        Wide4::StoreAoS4( p + 16,
+            _mm256_extractf128_ps( x, 1 ),
+            _mm256_extractf128_ps( y, 1 ),
+            _mm256_extractf128_ps( z, 1 ),
+            _mm256_extractf128_ps( w, 1 ) );
+    }
+};
+#endif//ASDX_IS_SIMD && ASDX_IS_AVX2
+
+#if ASDX_IS_SIMD && ASDX_IS_AVX2 && ASDX_IS_AVX512
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Wide16 structure
+// AVX-512Fによる16レーン版です.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct Wide16
+{
+    using Reg = __m512;
+    static const u32 Width = 16;
+
+    static Reg  Load     ( const f32* p )                           { return _mm512_loadu_ps( p ); }
+    static void Store    ( f32* p, const Reg& v )                   { _mm512_storeu_ps( p, v ); }
+    static Reg  Replicate( f32 v )                                  { return _mm512_set1_ps( v ); }
+    static Reg  Add      ( const Reg& a, const Reg& b )             { return _mm512_add_ps( a, b ); }
+    static Reg  Sub      ( const Reg& a, const Reg& b )             { return _mm512_sub_ps( a, b ); }
+    static Reg  Mul      ( const Reg& a, const Reg& b )             { return _mm512_mul_ps( a, b ); }
+    static Reg  Mad      ( const Reg& a, const Reg& b, const Reg& c ) { return _mm512_add_ps( _mm512_mul_ps( a, b ), c ); }
+    static Reg  Div      ( const Reg& a, const Reg& b )             { return _mm512_div_ps( a, b ); }
+    static Reg  Sqrt     ( const Reg& a )                           { return _mm512_sqrt_ps( a ); }
+    static Reg  Abs      ( const Reg& a )                           { return _mm512_abs_ps( a ); }
+    static Reg  Min      ( const Reg& a, const Reg& b )             { return _mm512_min_ps( a, b ); }
+    static Reg  Max      ( const Reg& a, const Reg& b )             { return _mm512_max_ps( a, b ); }
+
+    //---------------------------------------------------------------------------------------------
+    //      s が負のレーンだけ a の符号を反転します.
+    //      _mm512_xor_ps はAVX-512DQが必要なため整数演算で行います.
+    //---------------------------------------------------------------------------------------------
+    static Reg MulSign( const Reg& a, const Reg& s )
+    {
+        auto sign = _mm512_and_si512( _mm512_castps_si512( s ), _mm512_set1_epi32( s32( 0x80000000u ) ) );
+        return _mm512_castsi512_ps( _mm512_xor_si512( _mm512_castps_si512( a ), sign ) );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      s の符号bitが立っているレーンは a を, それ以外は b を選択します.
+    //---------------------------------------------------------------------------------------------
+    static Reg SelectSign( const Reg& s, const Reg& a, const Reg& b )
+    {
+        auto mask = _mm512_test_epi32_mask( _mm512_castps_si512( s ), _mm512_set1_epi32( s32( 0x80000000u ) ) );
+        return _mm512_mask_blend_ps( mask, b, a );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      a < b となるレーンのbitを立てたマスクを返却します(NaNは偽).
+    //---------------------------------------------------------------------------------------------
+    static u32 LessMask( const Reg& a, const Reg& b )
+    { return u32( _mm512_cmp_ps_mask( a, b, _CMP_LT_OQ ) ); }
+
+    //---------------------------------------------------------------------------------------------
+    //      整数を読み込んで浮動小数に変換します.
+    //---------------------------------------------------------------------------------------------
+    static Reg LoadInt( const s8*  p ) { return _mm512_cvtepi32_ps( _mm512_cvtepi8_epi32 ( _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) ) ) ); }
+    static Reg LoadInt( const u8*  p ) { return _mm512_cvtepi32_ps( _mm512_cvtepu8_epi32 ( _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) ) ) ); }
+    static Reg LoadInt( const s16* p ) { return _mm512_cvtepi32_ps( _mm512_cvtepi16_epi32( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( p ) ) ) ); }
+    static Reg LoadInt( const u16* p ) { return _mm512_cvtepi32_ps( _mm512_cvtepu16_epi32( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( p ) ) ) ); }
+
+    //---------------------------------------------------------------------------------------------
+    //      最近接偶数に丸めて整数で書き込みます. 値は型の範囲内である必要があります.
+    //---------------------------------------------------------------------------------------------
+    static void StoreInt( s8*  p, const Reg& v ) { _mm_storeu_si128   ( reinterpret_cast<__m128i*>( p ), _mm512_cvtepi32_epi8 ( _mm512_cvtps_epi32( v ) ) ); }
+    static void StoreInt( u8*  p, const Reg& v ) { _mm_storeu_si128   ( reinterpret_cast<__m128i*>( p ), _mm512_cvtepi32_epi8 ( _mm512_cvtps_epi32( v ) ) ); }
+    static void StoreInt( s16* p, const Reg& v ) { _mm256_storeu_si256( reinterpret_cast<__m256i*>( p ), _mm512_cvtepi32_epi16( _mm512_cvtps_epi32( v ) ) ); }
+    static void StoreInt( u16* p, const Reg& v ) { _mm256_storeu_si256( reinterpret_cast<__m256i*>( p ), _mm512_cvtepi32_epi16( _mm512_cvtps_epi32( v ) ) ); }
+
+    //---------------------------------------------------------------------------------------------
+    //      半精度浮動小数を読み書きします.
+    //---------------------------------------------------------------------------------------------
+    static Reg  LoadF16 ( const f16* p )            { return _mm512_cvtph_ps( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( p ) ) ); }
+    static void StoreF16( f16* p, const Reg& v )    { _mm256_storeu_si256( reinterpret_cast<__m256i*>( p ), _mm512_cvtps_ph( v, _MM_FROUND_TO_NEAREST_INT ) ); }
+
+    //---------------------------------------------------------------------------------------------
+    //      8レーンのレジスタ2つを連結します.
+    //---------------------------------------------------------------------------------------------
+    static Reg Combine( const Wide8::Reg& lo, const Wide8::Reg& hi )
+    {
+        auto v = _mm512_castpd256_pd512( _mm256_castps_pd( lo ) );
+        return _mm512_castpd_ps( _mm512_insertf64x4( v, _mm256_castps_pd( hi ), 1 ) );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      上位8レーンを取り出します.
+    //---------------------------------------------------------------------------------------------
+    static Wide8::Reg High( const Reg& v )
+    { return _mm256_castpd_ps( _mm512_extractf64x4_pd( _mm512_castps_pd( v ), 1 ) ); }
+
+    //---------------------------------------------------------------------------------------------
+    //      xy x 16 の並びを成分ごとのレジスタに展開します.
+    //---------------------------------------------------------------------------------------------
+    static void LoadAoS2( const f32* p, Reg& x, Reg& y )
+    {
+        Wide8::Reg x0, y0, x1, y1;
+        Wide8::LoadAoS2( p + 0,  x0, y0 );
+        Wide8::LoadAoS2( p + 16, x1, y1 );
+        x = Combine( x0, x1 );
+        y = Combine( y0, y1 );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      成分ごとのレジスタを xy x 16 の並びで書き込みます.
+    //---------------------------------------------------------------------------------------------
+    static void StoreAoS2( f32* p, const Reg& x, const Reg& y )
+    {
+        Wide8::StoreAoS2( p + 0,  _mm512_castps512_ps256( x ), _mm512_castps512_ps256( y ) );
+        Wide8::StoreAoS2( p + 16, High( x ), High( y ) );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      xyz x 16 の並びを成分ごとのレジスタに展開します.
+    //---------------------------------------------------------------------------------------------
+    static void LoadAoS3( const f32* p, Reg& x, Reg& y, Reg& z )
+    {
+        Wide8::Reg x0, y0, z0, x1, y1, z1;
+        Wide8::LoadAoS3( p + 0,  x0, y0, z0 );
+        Wide8::LoadAoS3( p + 24, x1, y1, z1 );
+        x = Combine( x0, x1 );
+        y = Combine( y0, y1 );
+        z = Combine( z0, z1 );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      成分ごとのレジスタを xyz x 16 の並びで書き込みます.
+    //---------------------------------------------------------------------------------------------
+    static void StoreAoS3( f32* p, const Reg& x, const Reg& y, const Reg& z )
+    {
+        Wide8::StoreAoS3( p + 0,  _mm512_castps512_ps256( x ), _mm512_castps512_ps256( y ), _mm512_castps512_ps256( z ) );
+        Wide8::StoreAoS3( p + 24, High( x ), High( y ), High( z ) );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      xyzw x 16 の並びを成分ごとのレジスタに展開します.
+    //---------------------------------------------------------------------------------------------
+    static void LoadAoS4( const f32* p, Reg& x, Reg& y, Reg& z, Reg& w )
+    {
+        Wide8::Reg x0, y0, z0, w0, x1, y1, z1, w1;
+        Wide8::LoadAoS4( p + 0,  x0, y0, z0, w0 );
+        Wide8::LoadAoS4( p + 32, x1, y1, z1, w1 );
+        x = Combine( x0, x1 );
+        y = Combine( y0, y1 );
+        z = Combine( z0, z1 );
+        w = Combine( w0, w1 );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //      成分ごとのレジスタを xyzw x 16 の並びで書き込みます.
+    //---------------------------------------------------------------------------------------------
+    static void StoreAoS4( f32* p, const Reg& x, const Reg& y, const Reg& z, const Reg& w )
+    {
+        Wide8::StoreAoS4( p + 0,
+            _mm512_castps512_ps256( x ),
+            _mm512_castps512_ps256( y ),
+            _mm512_castps512_ps256( z ),
+            _mm512_castps512_ps256( w ) );
+        Wide8::StoreAoS4( p + 32, High( x ), High( y ), High( z ), High( w ) );
+    }
+};
+#endif//ASDX_IS_SIMD && ASDX_IS_AVX2 && ASDX_IS_AVX512
+
+
+//-------------------------------------------------------------------------------------------------
+// Type Definitions
+//-------------------------------------------------------------------------------------------------
+#if ASDX_IS_SIMD && ASDX_IS_AVX2 && ASDX_IS_AVX512
+using WideNative = Wide16;      //!< コンパイル設定で利用できる最大幅です.
+#elif ASDX_IS_SIMD && ASDX_IS_AVX2
+using WideNative = Wide8;       //!< コンパイル設定で利用できる最大幅です.
+#elif ASDX_IS_SIMD
+using WideNative = Wide4;       //!< コンパイル設定で利用できる最大幅です.
+#else
+using WideNative = Wide1;       //!< コンパイル設定で利用できる最大幅です.
+#endif
+
+} // inline namespace ASDX_KERNEL_ISA
+} // namespace wide
+} // namespace asdx
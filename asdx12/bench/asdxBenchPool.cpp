@@ -0,0 +1,213 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxBenchPool.cpp
+// Desc : Pool Container Contention Benchmark.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxPoolContainer.h>
+#include <asdxLockFreePoolContainer.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+
+namespace /* anonymous */ {
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values
+//-------------------------------------------------------------------------------------------------
+static const uint32_t THREAD_COUNTS[] = { 1, 2, 4, 8, 16, 32 };   //!< 計測するスレッド数です.
+static const uint32_t BATCH_SIZE      = 16;                       //!< 1スレッドが同時に保持するアイテム数です.
+static const uint32_t POOL_SIZE       = BATCH_SIZE * 3;           //!< 1スレッドあたりのプールのアイテム数です(マガジンに保持する分を含みます).
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Item structure
+// Descriptor と同程度の大きさのアイテムです.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct Item
+{
+    void*                   pOwner;
+    uint64_t                HandleCPU;
+    uint64_t                HandleGPU;
+    std::atomic<uint32_t>   RefCount;
+
+    Item()
+    : pOwner(nullptr), HandleCPU(0), HandleGPU(0), RefCount(1)
+    { /* DO_NOTHING */ }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// CachedPool class
+// スレッドキャッシュを有効にしたロックフリー版のプールです.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class CachedPool : public asdx::LockFreePoolContainer<Item>
+{
+public:
+    bool Init(uint32_t count)
+    { return asdx::LockFreePoolContainer<Item>::Init(count, true); }
+};
+
+//-------------------------------------------------------------------------------------------------
+//      "--key=value" 形式の引数であれば value を返却します.
+//-------------------------------------------------------------------------------------------------
+const char* GetOption(const char* arg, const char* key)
+{
+    auto len = strlen(key);
+    if (strncmp(arg, key, len) == 0 && arg[len] == '=')
+    { return arg + len + 1; }
+
+    return nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      全スレッドで確保と解放を繰り返し, 1回の確保と解放にかかった時間(ns)を返却します.
+//      確保したアイテムを他のスレッドが同時に保持していないかと, スレッド終了後に全て戻ったかも検証します.
+//-------------------------------------------------------------------------------------------------
+template<typename Pool>
+double Measure(uint32_t threadCount, uint32_t iterations, uint32_t& errors)
+{
+    using Clock = std::chrono::steady_clock;
+
+    Pool pool;
+    if (!pool.Init(threadCount * POOL_SIZE))
+    {
+        errors++;
+        return 0.0;
+    }
+
+    std::atomic<uint32_t> ready(0);
+    std::atomic<bool>     start(false);
+    std::atomic<uint32_t> failed(0);
+
+    auto worker = [&]()
+    {
+        Item* items[BATCH_SIZE];
+        auto  owner = &items;
+
+        ready++;
+        while (!start.load(std::memory_order_acquire))
+        { std::this_thread::yield(); }
+
+        for(auto n=0u; n<iterations; ++n)
+        {
+            for(auto i=0u; i<BATCH_SIZE; ++i)
+            {
+                items[i] = pool.Alloc();
+                if (items[i] == nullptr)
+                {
+                    failed++;
+                    return;
+                }
+                items[i]->pOwner = owner;
+            }
+
+            for(auto i=0u; i<BATCH_SIZE; ++i)
+            {
+                if (items[i]->pOwner != owner)
+                { failed++; }
+                pool.Free(items[i]);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(auto i=0u; i<threadCount; ++i)
+    { threads.emplace_back(worker); }
+
+    while (ready.load() != threadCount)
+    { std::this_thread::yield(); }
+
+    auto begin = Clock::now();
+    start.store(true, std::memory_order_release);
+
+    for(auto& thread : threads)
+    { thread.join(); }
+
+    auto seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+
+    errors += failed.load();
+    if (pool.GetUsedCount() != 0)
+    { errors++; }
+
+    return seconds * 1e9 / (double(threadCount) * iterations * BATCH_SIZE);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      repeat 回計測して中央値を返却します.
+//-------------------------------------------------------------------------------------------------
+template<typename Pool>
+double MeasureMedian(uint32_t threadCount, uint32_t iterations, uint32_t repeat, uint32_t& errors)
+{
+    std::vector<double> results;
+    for(auto i=0u; i<repeat; ++i)
+    { results.push_back(Measure<Pool>(threadCount, iterations, errors)); }
+
+    std::sort(results.begin(), results.end());
+    return results[results.size() / 2];
+}
+
+} // namespace /* anonymous */
+
+
+//-------------------------------------------------------------------------------------------------
+//      メインエントリーポイントです.
+//-------------------------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    uint32_t iterations = 20000;
+    uint32_t repeat     = 5;
+    uint32_t maxThreads = 32;
+
+    for(auto i=1; i<argc; ++i)
+    {
+        const char* value;
+        if ((value = GetOption(argv[i], "--iterations")) != nullptr)
+        { iterations = uint32_t(atoi(value)); }
+        else if ((value = GetOption(argv[i], "--repeat")) != nullptr)
+        { repeat = std::max(uint32_t(atoi(value)), 1u); }
+        else if ((value = GetOption(argv[i], "--max-threads")) != nullptr)
+        { maxThreads = uint32_t(atoi(value)); }
+        else
+        {
+            fprintf(stderr,
+                "usage: %s [options]\n"
+                "  --iterations=<count>  alloc/free rounds of %u items per thread (default 20000).\n"
+                "  --repeat=<count>      number of samples per case (default 5).\n"
+                "  --max-threads=<count> largest thread count to measure (default 32).\n",
+                argv[0], BATCH_SIZE);
+            return -1;
+        }
+    }
+
+    fprintf(stderr, "hardware threads : %u\n", std::thread::hardware_concurrency());
+    fprintf(stderr, "%8s %16s %16s %16s %10s\n", "threads", "mutex ns/op", "lock-free ns/op", "cached ns/op", "speedup");
+
+    uint32_t errors = 0;
+    for(auto threadCount : THREAD_COUNTS)
+    {
+        if (threadCount > maxThreads)
+        { break; }
+
+        auto mutex    = MeasureMedian<asdx::PoolContainer<Item>>        (threadCount, iterations, repeat, errors);
+        auto lockFree = MeasureMedian<asdx::LockFreePoolContainer<Item>>(threadCount, iterations, repeat, errors);
+        auto cached   = MeasureMedian<CachedPool>                       (threadCount, iterations, repeat, errors);
+
+        fprintf(stderr, "%8u %16.3f %16.3f %16.3f %9.2fx\n", threadCount, mutex, lockFree, cached, mutex / cached);
+    }
+
+    if (errors != 0)
+    {
+        fprintf(stderr, "errors : %u\n", errors);
+        return -1;
+    }
+
+    return 0;
+}
@@ -11,7 +11,7 @@
 #include <d3d12.h>
 #include <atomic>
 #include <asdxRefPtr.h>
-#include <asdxPoolContainer.h>
+#include <asdxLockFreePoolContainer.h>
 
 
 namespace asdx {
@@ -25,7 +25,7 @@ class Descriptor : public IReference
     // list of friend classes and methods.
     //=============================================================================================
     friend class DescriptorHeap;
-    friend class PoolContainer<Descriptor>;
+    friend class LockFreePoolContainer<Descriptor>;
 
 public:
     //=============================================================================================
@@ -61,6 +61,14 @@ private:
     void operator = (const Descriptor&) = delete;
 };
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// DescriptorHandle
+// ディスクリプタを参照カウントを増やさずに参照するハンドルです.
+// ディスクリプタが破棄されると DescriptorHeap::Resolve() で nullptr が返ります.
+// インデックスは20bitなので, DescriptorHeap::Init() は 2^20 個を超えるヒープの生成に失敗します.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+using DescriptorHandle = Handle<Descriptor>;
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // DescriptorHeap class
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -85,6 +93,8 @@ public:
     bool Init(ID3D12Device* pDevice, const D3D12_DESCRIPTOR_HEAP_DESC* pDesc);
     void Term();
     Descriptor* CreateDescriptor();
+    DescriptorHandle GetHandle(const Descriptor* pDescriptor) const;
+    Descriptor* Resolve(DescriptorHandle handle) const;
     uint32_t GetAvailableHandleCount() const;
     uint32_t GetAllocatedHandleCount() const;
     uint32_t GetHandleCount() const;
@@ -94,9 +104,9 @@ private:
     //=============================================================================================
     // private variables.
     //=============================================================================================
-    RefPtr<ID3D12DescriptorHeap>    m_pHeap;
-    PoolContainer<Descriptor>       m_Pool;
-    uint32_t                        m_IncrementSize;
+    RefPtr<ID3D12DescriptorHeap>        m_pHeap;
+    LockFreePoolContainer<Descriptor>   m_Pool;
+    uint32_t                            m_IncrementSize;
 
     //=============================================================================================
     // private methods.
@@ -10,8 +10,8 @@
 //-------------------------------------------------------------------------------------------------
 #include <d3d12.h>
 #include <vector>
-#include <map>
 #include <asdxRefPtr.h>
+#include <asdxHashMap.h>
 
 
 namespace asdx {
@@ -112,7 +112,7 @@ private:
     // private variables.
     //=============================================================================================
     RefPtr<ID3D12RootSignature>     m_pRootSignature;
-    std::map<uint32_t, Table>       m_Tables;
+    HashMap<uint32_t, Table>        m_Tables;
 
     //=============================================================================================
     // private methods.
@@ -14,6 +14,7 @@
 #include <asdxRefPtr.h>
 #include <asdxCommandQueue.h>
 #include <asdxDescriptorHeap.h>
+#include <asdxFrameArena.h>
 
 
 namespace asdx {
@@ -31,6 +32,8 @@ struct DeviceContextDesc
     uint32_t    MaxSubmitCountCompute;      //!< コンピュートキューの最大サブミット数.
     uint32_t    MaxSubmitCountCopy;         //!< コピーキューの最大サブミット数.
     bool        EnableDebug;                //!< デバッグモードフラグ.
+    uint32_t    FrameCount;                 //!< フレームアリーナが保持するフレーム数. 0 の場合は 2 とします.
+    size_t      FrameArenaSize;             //!< フレームアリーナの1フレームあたりのバイト数. 0 の場合は作成しません.
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -70,6 +73,7 @@ public:
     CommandQueue*       GetComputeQueue     ();
     CommandQueue*       GetCopyQueue        ();
     DescriptorHeap*     GetDescriptorHeap   (uint32_t index);
+    FrameArena*         GetFrameArena       ();
 
 private:
     struct DisposeItem
@@ -89,6 +93,7 @@ private:
     CommandQueue            m_Queue[3];             //!< コマンドキューです.
     DescriptorHeap          m_DescriptorHeap[4];    //!< ディスクリプタヒープです.
     std::list<DisposeItem>  m_Disposer;             //!< 破棄リスト.
+    FrameArena              m_FrameArena;           //!< フレームアリーナです.
     std::mutex              m_Mutex;
 
     //=============================================================================================
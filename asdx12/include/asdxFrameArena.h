@@ -0,0 +1,158 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxFrameArena.h
+// Desc : Per-Frame Linear Allocator.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <type_traits>
+
+
+namespace asdx {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// FrameArena class
+// フレーム内でのみ使う一時データ用の線形アロケータです.
+// frameCount 個の領域をリングとして使い, NextFrame() で frameCount フレーム前の領域を再利用します.
+// 確保したメモリは個別に解放せず, 再利用時にポインタを戻すだけなのでリセットは O(1) です.
+// 各スレッドはスレッドスロットごとのサブアリーナからアトミック操作なしで確保し,
+// サブアリーナが尽きた場合のみ共有の領域からブロック単位で取り出します.
+// デバッグビルドでは再利用する領域を 0xCD で埋め, 解放済みのデータの読み取りを見つけやすくします.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class FrameArena
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    static const size_t kDefaultAlignment = 16;     //!< 既定のアライメントです.
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------------------
+    FrameArena();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //---------------------------------------------------------------------------------------------
+    ~FrameArena();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      初期化処理を行います.
+    //!
+    //! @param[in]      frameCount      同時に保持するフレーム数です.
+    //! @param[in]      frameSize       1フレームで確保できるバイト数です.
+    //! @retval true    初期化に成功.
+    //! @retval false   初期化に失敗.
+    //---------------------------------------------------------------------------------------------
+    bool Init(uint32_t frameCount, size_t frameSize);
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      終了処理を行います.
+    //---------------------------------------------------------------------------------------------
+    void Term();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      現在のフレームの領域からメモリを確保します. スレッドセーフです.
+    //!
+    //! @param[in]      size            確保するバイト数です.
+    //! @param[in]      alignment       アライメントです. 2の累乗を指定します.
+    //! @return     確保したメモリへのポインタを返却します. 領域が足りない場合は nullptr を返却します.
+    //---------------------------------------------------------------------------------------------
+    void* Alloc(size_t size, size_t alignment = kDefaultAlignment);
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      現在のフレームの領域から配列を確保します. 要素は初期化しません.
+    //!
+    //! @param[in]      count           要素数です.
+    //! @return     確保した配列へのポインタを返却します. 領域が足りない場合は nullptr を返却します.
+    //---------------------------------------------------------------------------------------------
+    template<typename T>
+    T* AllocArray(size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena does not call destructors.");
+        return static_cast<T*>(Alloc(sizeof(T) * count, alignof(T) > kDefaultAlignment ? alignof(T) : kDefaultAlignment));
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      次のフレームに進み, frameCount フレーム前の領域を再利用します.
+    //!
+    //! @details    Alloc() と同時に呼び出さないでください.
+    //---------------------------------------------------------------------------------------------
+    void NextFrame();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      現在のフレームのリング内の番号を取得します.
+    //---------------------------------------------------------------------------------------------
+    uint32_t GetFrameIndex() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      同時に保持するフレーム数を取得します.
+    //---------------------------------------------------------------------------------------------
+    uint32_t GetFrameCount() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      1フレームで確保できるバイト数を取得します.
+    //---------------------------------------------------------------------------------------------
+    size_t GetFrameSize() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      現在のフレームで共有の領域から取り出したバイト数を取得します.
+    //!
+    //! @details    サブアリーナに取り出したブロックの未使用分を含みます.
+    //---------------------------------------------------------------------------------------------
+    size_t GetUsedSize() const;
+
+private:
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // SubArena structure
+    // スレッドスロットごとの確保位置です. 他のスレッドとキャッシュラインを共有しません.
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct SubArena
+    {
+        uint8_t*    pCurrent;       //!< 次に確保する位置です.
+        uint8_t*    pEnd;           //!< ブロックの終端です.
+        uint64_t    Epoch;          //!< ブロックを取り出したフレームの通し番号です.
+        uint8_t     Padding[64 - sizeof(uint8_t*) * 2 - sizeof(uint64_t)];
+    };
+
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    std::atomic<size_t>     m_Offset;           //!< 現在のフレームで共有の領域から取り出したバイト数です.
+    uint8_t                 m_Padding[64 - sizeof(size_t)];
+    std::atomic<uint64_t>   m_Epoch;            //!< フレームの通し番号です.
+    uint8_t*                m_pBuffer;          //!< 全フレームの領域です.
+    uint8_t*                m_pFrame;           //!< 現在のフレームの領域の先頭です.
+    uint8_t*                m_pSubArenaBuffer;  //!< サブアリーナのバッファです.
+    SubArena*               m_pSubArenas;       //!< スレッドスロットごとのサブアリーナです.
+    size_t                  m_FrameSize;        //!< 1フレームの領域のバイト数です.
+    size_t                  m_BlockSize;        //!< サブアリーナが一度に取り出すバイト数です.
+    uint32_t                m_FrameCount;       //!< 同時に保持するフレーム数です.
+    uint32_t                m_FrameIndex;       //!< 現在のフレームのリング内の番号です.
+
+    //=============================================================================================
+    // private methods.
+    //=============================================================================================
+    void* AllocShared(size_t size, size_t alignment);
+
+    FrameArena      (const FrameArena&) = delete;
+    void operator = (const FrameArena&) = delete;
+};
+
+} // namespace asdx
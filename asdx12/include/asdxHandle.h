@@ -0,0 +1,93 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxHandle.h
+// Desc : Generational Handle.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <cassert>
+
+
+namespace asdx {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Handle structure
+// プールのインデックスと世代番号を1つの整数にまとめたハンドルです.
+// 32bit版は下位20bitがインデックス, 上位12bitが世代番号で, 64bit版は32bitずつです.
+// 世代番号はアイテムの確保と解放ごとに増えるので, 解放済みのアイテムを指すハンドルは無効になります.
+// 32bit版は同じスロットで2048回確保と解放を繰り返すと世代番号が一巡します.
+// 値が0のハンドルは常に無効です.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename T, typename ValueType = uint32_t>
+struct Handle
+{
+    static const uint32_t kIndexBits      = (sizeof(ValueType) >= 8) ? 32 : 20;                     //!< インデックスのビット数です.
+    static const uint32_t kGenerationBits = uint32_t(sizeof(ValueType) * 8) - kIndexBits;           //!< 世代番号のビット数です.
+    static const uint64_t kIndexMask      = (uint64_t(1) << kIndexBits) - 1;                        //!< インデックスのマスクです.
+    static const uint64_t kGenerationMask = (uint64_t(1) << kGenerationBits) - 1;                   //!< 世代番号のマスクです.
+
+    ValueType   Value;      //!< ハンドルの値です.
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです. 無効なハンドルになります.
+    //---------------------------------------------------------------------------------------------
+    Handle()
+    : Value(0)
+    { /* DO_NOTHING */ }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      値を指定するコンストラクタです.
+    //---------------------------------------------------------------------------------------------
+    explicit Handle(ValueType value)
+    : Value(value)
+    { /* DO_NOTHING */ }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      インデックスと世代番号からハンドルを生成します.
+    //!
+    //! @param[in]      index           インデックスです.
+    //! @param[in]      generation      世代番号です. 世代番号のビット数に切り詰めます.
+    //! @return     生成したハンドルを返却します.
+    //---------------------------------------------------------------------------------------------
+    static Handle Make(uint32_t index, uint32_t generation)
+    {
+        assert(index <= kIndexMask);
+        return Handle(ValueType(((generation & kGenerationMask) << kIndexBits) | index));
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      インデックスを取得します.
+    //---------------------------------------------------------------------------------------------
+    uint32_t GetIndex() const
+    { return uint32_t(Value & kIndexMask); }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      世代番号を取得します.
+    //---------------------------------------------------------------------------------------------
+    uint32_t GetGeneration() const
+    { return uint32_t((uint64_t(Value) >> kIndexBits) & kGenerationMask); }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      無効なハンドルかどうかチェックします.
+    //---------------------------------------------------------------------------------------------
+    bool IsNull() const
+    { return Value == 0; }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      等価比較演算子です.
+    //---------------------------------------------------------------------------------------------
+    bool operator == (const Handle& value) const
+    { return Value == value.Value; }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      非等価比較演算子です.
+    //---------------------------------------------------------------------------------------------
+    bool operator != (const Handle& value) const
+    { return Value != value.Value; }
+};
+
+} // namespace asdx
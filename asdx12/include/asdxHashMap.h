@@ -0,0 +1,325 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxHashMap.h
+// Desc : Open Addressing Hash Map.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+
+namespace asdx {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// HashOf structure
+// キーのハッシュ値を求める関数オブジェクトです.
+// 連続した整数のキーも配列全体に散らばるように, MurmurHash3 の最終処理でビットを拡散します.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+struct HashOf;
+
+template<>
+struct HashOf<uint32_t>
+{
+    uint32_t operator () (uint32_t value) const
+    {
+        value ^= value >> 16;
+        value *= 0x85ebca6b;
+        value ^= value >> 13;
+        value *= 0xc2b2ae35;
+        value ^= value >> 16;
+        return value;
+    }
+};
+
+template<>
+struct HashOf<uint64_t>
+{
+    uint32_t operator () (uint64_t value) const
+    {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ULL;
+        value ^= value >> 33;
+        return uint32_t(value);
+    }
+};
+
+template<typename T>
+struct HashOf<T*>
+{
+    uint32_t operator () (const T* value) const
+    { return HashOf<uint64_t>()(uint64_t(reinterpret_cast<uintptr_t>(value))); }
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// HashMap class
+// オープンアドレス法(Robin Hood hashing)によるハッシュマップです.
+// 要素はキーと値を並べた1つの配列に格納し, 探索は連続したメモリを順に読みます.
+// 容量を確保した後は, 要素数が容量の7/8以下であれば追加と削除でメモリを確保しません.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename KeyType, typename ValueType, typename Hasher = HashOf<KeyType>>
+class HashMap
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    /* NOTHING */
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------------------
+    HashMap()
+    : m_Slots ()
+    , m_Count (0)
+    , m_Mask  (0)
+    , m_Hasher()
+    { /* DO_NOTHING */ }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      メモリを再確保せずに格納できる要素数を指定します.
+    //!
+    //! @param[in]      count       要素数です.
+    //---------------------------------------------------------------------------------------------
+    void Reserve(uint32_t count)
+    {
+        auto capacity = MIN_CAPACITY;
+        while(uint64_t(count) * 8 > uint64_t(capacity) * 7)
+        { capacity *= 2; }
+
+        if (capacity > m_Slots.size())
+        { Rehash(capacity); }
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      要素を削除します.
+    //!
+    //! @param[in]      key         キーです.
+    //! @retval true    削除しました.
+    //! @retval false   キーが存在しません.
+    //---------------------------------------------------------------------------------------------
+    bool Erase(const KeyType& key)
+    {
+        auto index = FindIndex(key);
+        if (index == UINT32_MAX)
+        { return false; }
+
+        // 後続の要素を1つずつ前に詰める(墓標を残さない).
+        auto next = (index + 1) & m_Mask;
+        while(m_Slots[next].Distance > 1)
+        {
+            m_Slots[index] = std::move(m_Slots[next]);
+            m_Slots[index].Distance--;
+            index = next;
+            next  = (next + 1) & m_Mask;
+        }
+
+        m_Slots[index] = Slot();
+        m_Count--;
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      全ての要素を削除します. 容量は変更しません.
+    //---------------------------------------------------------------------------------------------
+    void Clear()
+    {
+        for(auto& slot : m_Slots)
+        {
+            if (slot.Distance != 0)
+            { slot = Slot(); }
+        }
+
+        m_Count = 0;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      値を検索します.
+    //!
+    //! @param[in]      key         キーです.
+    //! @return     値へのポインタを返却します. キーが存在しない場合は nullptr を返却します.
+    //---------------------------------------------------------------------------------------------
+    ValueType* Find(const KeyType& key)
+    {
+        auto index = FindIndex(key);
+        return (index != UINT32_MAX) ? &m_Slots[index].Value : nullptr;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      値を検索します.
+    //!
+    //! @param[in]      key         キーです.
+    //! @return     値へのポインタを返却します. キーが存在しない場合は nullptr を返却します.
+    //---------------------------------------------------------------------------------------------
+    const ValueType* Find(const KeyType& key) const
+    {
+        auto index = FindIndex(key);
+        return (index != UINT32_MAX) ? &m_Slots[index].Value : nullptr;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      値を取得します. キーが存在しない場合はデフォルト値で追加します.
+    //!
+    //! @param[in]      key         キーです.
+    //! @return     値への参照を返却します.
+    //---------------------------------------------------------------------------------------------
+    ValueType& operator [] (const KeyType& key)
+    {
+        auto index = FindIndex(key);
+        if (index == UINT32_MAX)
+        { index = InsertNew(KeyType(key), ValueType()); }
+
+        return m_Slots[index].Value;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      全ての要素に対して関数を呼び出します. 順序は不定です.
+    //!
+    //! @param[in]      func        void(const KeyType&, const ValueType&) 形式の関数です.
+    //---------------------------------------------------------------------------------------------
+    template<typename Func>
+    void ForEach(Func func) const
+    {
+        for(auto& slot : m_Slots)
+        {
+            if (slot.Distance != 0)
+            { func(slot.Key, slot.Value); }
+        }
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      要素数を取得します.
+    //!
+    //! @return     要素数を返却します.
+    //---------------------------------------------------------------------------------------------
+    uint32_t GetCount() const
+    { return m_Count; }
+
+private:
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Slot structure
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct Slot
+    {
+        Slot()
+        : Distance(0), Key(), Value()
+        { /* DO_NOTHING */ }
+
+        uint32_t    Distance;   //!< 本来の位置からの距離 + 1 です. 0 は空きです.
+        KeyType     Key;        //!< キーです.
+        ValueType   Value;      //!< 値です.
+    };
+
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    static const uint32_t MIN_CAPACITY = 16;    //!< 最小の配列の大きさです.
+
+    std::vector<Slot>   m_Slots;    //!< 要素の配列です. 大きさは2の累乗です.
+    uint32_t            m_Count;    //!< 要素数です.
+    uint32_t            m_Mask;     //!< 配列の大きさ - 1 です.
+    Hasher              m_Hasher;   //!< ハッシュ関数です.
+
+    //=============================================================================================
+    // private methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      キーの位置を検索します. 存在しない場合は UINT32_MAX を返却します.
+    //---------------------------------------------------------------------------------------------
+    uint32_t FindIndex(const KeyType& key) const
+    {
+        if (m_Count == 0)
+        { return UINT32_MAX; }
+
+        // 本来の位置からの距離が探索中の距離より短い要素に達したら, キーは存在しない.
+        auto index    = m_Hasher(key) & m_Mask;
+        auto distance = 1u;
+        for(;;)
+        {
+            const auto& slot = m_Slots[index];
+            if (slot.Distance < distance)
+            { return UINT32_MAX; }
+
+            if (slot.Distance == distance && slot.Key == key)
+            { return index; }
+
+            index = (index + 1) & m_Mask;
+            distance++;
+        }
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      存在しないキーを追加し, 位置を返却します.
+    //---------------------------------------------------------------------------------------------
+    uint32_t InsertNew(KeyType&& key, ValueType&& value)
+    {
+        if (uint64_t(m_Count + 1) * 8 > uint64_t(m_Slots.size()) * 7)
+        { Rehash((m_Slots.empty()) ? MIN_CAPACITY : uint32_t(m_Slots.size()) * 2); }
+
+        Slot incoming;
+        incoming.Distance = 1;
+        incoming.Key      = std::move(key);
+        incoming.Value    = std::move(value);
+
+        // 本来の位置から遠い要素を優先して配置し, 探索距離のばらつきを抑える.
+        auto index  = m_Hasher(incoming.Key) & m_Mask;
+        auto result = UINT32_MAX;
+        for(;;)
+        {
+            auto& slot = m_Slots[index];
+            if (slot.Distance == 0)
+            {
+                slot = std::move(incoming);
+                m_Count++;
+                return (result != UINT32_MAX) ? result : index;
+            }
+
+            if (slot.Distance < incoming.Distance)
+            {
+                std::swap(slot, incoming);
+                if (result == UINT32_MAX)
+                { result = index; }
+            }
+
+            index = (index + 1) & m_Mask;
+            incoming.Distance++;
+        }
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      配列の大きさを変更して再配置します.
+    //---------------------------------------------------------------------------------------------
+    void Rehash(uint32_t capacity)
+    {
+        std::vector<Slot> slots(capacity);
+        m_Slots.swap(slots);
+        m_Mask  = capacity - 1;
+        m_Count = 0;
+
+        for(auto& slot : slots)
+        {
+            if (slot.Distance != 0)
+            { InsertNew(std::move(slot.Key), std::move(slot.Value)); }
+        }
+    }
+};
+
+} // namespace asdx
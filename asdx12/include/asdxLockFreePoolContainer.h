@@ -0,0 +1,534 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxLockFreePoolContainer.h
+// Desc : Lock-Free Item Pool.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cassert>
+#include <atomic>
+#include <functional>
+#include <new>
+#include <asdxThreadSlot.h>
+#include <asdxHandle.h>
+
+
+namespace asdx {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// LockFreePoolContainer class
+// PoolContainer と同じインタフェースを持つロックフリー版のプールです.
+// 空きアイテムはインデックスで連結したスタック(Treiber stack)で管理し,
+// 先頭のインデックスと更新ごとに増やすタグを1つの64bit値としてCASで更新してABA問題を防ぎます.
+// 値の配列と次のインデックスの配列は分けて確保し, アイテムのインデックスは Init() から Term() まで変わりません.
+// PoolContainer::InitPaged() のようなページ単位の拡張は行いません. 主な用途の DescriptorHeap では
+// インデックスが ID3D12DescriptorHeap 内の位置に対応し, ヒープを作り直さずに拡張できないためです.
+//
+// スレッドキャッシュを有効にすると, スレッドごとのマガジンにインデックスを保持し,
+// 共有のスタックとは kMagazineBatch 個単位でまとめてやり取りします.
+// マガジンが空でも満杯でもなければ, 確保と解放は他のスレッドと共有するメモリに触れません.
+// 1スレッドが保持するアイテムは kMagazineSize 個までで, スレッド終了時に共有のスタックへ戻します.
+//
+// アイテムごとに世代番号を持ち, 確保で奇数, 解放で偶数になるように1ずつ増やします.
+// GetHandle() で取得したハンドルは, アイテムを解放すると Resolve() で nullptr になります.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+class LockFreePoolContainer
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    /* NOTHING */
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      コンストラクタです.
+    //---------------------------------------------------------------------------------------------
+    LockFreePoolContainer()
+    : m_Head    (MakeHead(0, kInvalidIndex))
+    , m_Count   (0)
+    , m_pBuffer (nullptr)
+    , m_pNext   (nullptr)
+    , m_pGeneration(nullptr)
+    , m_pMagazineBuffer(nullptr)
+    , m_pMagazines(nullptr)
+    , m_Capacity(0)
+    { /* DO_NOTHING */ }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      デストラクタです.
+    //---------------------------------------------------------------------------------------------
+    ~LockFreePoolContainer()
+    { Term(); }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      初期化処理を行います. スレッドセーフではありません.
+    //!
+    //! @param[in]      count           確保するアイテム数です.
+    //! @param[in]      useThreadCache  スレッドごとのキャッシュを使う場合は true を指定します.
+    //! @retval true    初期化に成功.
+    //! @retval false   初期化に失敗.
+    //---------------------------------------------------------------------------------------------
+    bool Init(uint32_t count, bool useThreadCache = false)
+    {
+        if (count == 0 || count == kInvalidIndex)
+        { return false; }
+
+        m_pBuffer = static_cast<uint8_t*>(malloc(sizeof(T) * count));
+        if ( m_pBuffer == nullptr )
+        { return false; }
+
+        m_pNext       = new (std::nothrow) std::atomic<uint32_t>[count];
+        m_pGeneration = new (std::nothrow) std::atomic<uint32_t>[count];
+        if ( m_pNext == nullptr || m_pGeneration == nullptr )
+        {
+            Term();
+            return false;
+        }
+
+        m_Capacity = count;
+
+        // インデックス順に取り出されるように連結する.
+        for(auto i=0u; i<m_Capacity; ++i)
+        {
+            m_pNext[i]      .store(i + 1 < m_Capacity ? i + 1 : kInvalidIndex, std::memory_order_relaxed);
+            m_pGeneration[i].store(0, std::memory_order_relaxed);
+        }
+
+        m_Count.store(0, std::memory_order_relaxed);
+        m_Head .store(MakeHead(0, 0), std::memory_order_release);
+
+        if (useThreadCache)
+        {
+            // マガジン同士が同じキャッシュラインに乗らないように揃える.
+            m_pMagazineBuffer = static_cast<uint8_t*>(malloc(sizeof(Magazine) * kMaxThreadSlot + kCacheLine));
+            if ( m_pMagazineBuffer == nullptr )
+            {
+                Term();
+                return false;
+            }
+
+            auto address = (reinterpret_cast<uintptr_t>(m_pMagazineBuffer) + kCacheLine - 1) & ~uintptr_t(kCacheLine - 1);
+            m_pMagazines = reinterpret_cast<Magazine*>(address);
+            for(auto i=0u; i<kMaxThreadSlot; ++i)
+            { new (&m_pMagazines[i]) Magazine(); }
+
+            RegisterThreadCache(this, &LockFreePoolContainer::DrainMagazine);
+        }
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      終了処理を行います. スレッドセーフではありません.
+    //---------------------------------------------------------------------------------------------
+    void Term()
+    {
+        if ( m_pMagazineBuffer )
+        {
+            UnregisterThreadCache(this);
+            free(m_pMagazineBuffer);
+            m_pMagazineBuffer = nullptr;
+            m_pMagazines      = nullptr;
+        }
+
+        if ( m_pBuffer )
+        {
+            free(m_pBuffer);
+            m_pBuffer = nullptr;
+        }
+
+        if ( m_pNext )
+        {
+            delete[] m_pNext;
+            m_pNext = nullptr;
+        }
+
+        if ( m_pGeneration )
+        {
+            delete[] m_pGeneration;
+            m_pGeneration = nullptr;
+        }
+
+        m_Head .store(MakeHead(0, kInvalidIndex), std::memory_order_relaxed);
+        m_Count.store(0, std::memory_order_relaxed);
+        m_Capacity = 0;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      アイテムを確保します.
+    //!
+    //! @param[in]      func        ユーザによる初期化処理です.
+    //! @return     確保したアイテムへのポインタ. 確保に失敗した場合は nullptr が返却されます.
+    //---------------------------------------------------------------------------------------------
+    T* Alloc(std::function<void(uint32_t, T*)> func = nullptr)
+    {
+        auto pMagazine = GetMagazine();
+        auto index     = kInvalidIndex;
+        if (pMagazine != nullptr)
+        {
+            // 空の場合のみ共有のスタックから補充する.
+            auto count = pMagazine->Count.load(std::memory_order_relaxed);
+            if (count == 0)
+            { count = PopBatch(pMagazine->Indices, kMagazineBatch); }
+
+            if (count == 0)
+            { return nullptr; }
+
+            index = pMagazine->Indices[--count];
+            pMagazine->Count.store(count, std::memory_order_relaxed);
+        }
+        else
+        {
+            index = Pop();
+            if ( index == kInvalidIndex )
+            { return nullptr; }
+
+            m_Count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // メモリ割り当て.
+        auto val = new (GetItem(index)) T();
+
+        // 初期化の必要があれば呼び出す.
+        if (func != nullptr)
+        { func(index, val); }
+
+        // 初期化が終わってからハンドルを有効にする.
+        // 世代番号を書き換えるのはアイテムを所有するスレッドだけなので, 読み取りと書き込みに分けてよい.
+        m_pGeneration[index].store(m_pGeneration[index].load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+        return val;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      アイテムを解放します.
+    //!
+    //! @param[in]      pValue      解放するアイテムへのポインタ.
+    //---------------------------------------------------------------------------------------------
+    void Free(T* pValue)
+    {
+        if (pValue == nullptr)
+        { return; }
+
+        auto index     = GetIndex(pValue);
+        auto pMagazine = GetMagazine();
+
+        m_pGeneration[index].store(m_pGeneration[index].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        if (pMagazine == nullptr)
+        {
+            m_Count.fetch_sub(1, std::memory_order_relaxed);
+            Push(index);
+            return;
+        }
+
+        // 満杯の場合は古い方の半分を共有のスタックへ戻し, 最近解放したものを手元に残す.
+        auto count = pMagazine->Count.load(std::memory_order_relaxed);
+        if (count == kMagazineSize)
+        {
+            PushBatch(pMagazine->Indices, kMagazineBatch);
+            memmove(pMagazine->Indices, pMagazine->Indices + kMagazineBatch, sizeof(uint32_t) * (kMagazineSize - kMagazineBatch));
+            count -= kMagazineBatch;
+        }
+
+        pMagazine->Indices[count++] = index;
+        pMagazine->Count.store(count, std::memory_order_relaxed);
+    }
+
+    //--------------------------------------------------------------------------------------------
+    //! @brief      アイテムのインデックスを取得します.
+    //!
+    //! @param[in]      pValue      確保したアイテムへのポインタ.
+    //! @return     Alloc() の初期化処理に渡されたインデックスを返却します.
+    //--------------------------------------------------------------------------------------------
+    uint32_t GetIndex(const T* pValue) const
+    {
+        auto offset = reinterpret_cast<const uint8_t*>(pValue) - m_pBuffer;
+        assert(0 <= offset && size_t(offset) < sizeof(T) * m_Capacity);
+        return uint32_t(size_t(offset) / sizeof(T));
+    }
+
+    //--------------------------------------------------------------------------------------------
+    //! @brief      アイテムのハンドルを取得します.
+    //!
+    //! @param[in]      pValue      確保したアイテムへのポインタ.
+    //! @return     ハンドルを返却します. pValue が nullptr の場合は無効なハンドルを返却します.
+    //--------------------------------------------------------------------------------------------
+    template<typename U = uint32_t>
+    Handle<T, U> GetHandle(const T* pValue) const
+    {
+        if (pValue == nullptr)
+        { return Handle<T, U>(); }
+
+        auto index = GetIndex(pValue);
+        return Handle<T, U>::Make(index, m_pGeneration[index].load(std::memory_order_relaxed));
+    }
+
+    //--------------------------------------------------------------------------------------------
+    //! @brief      ハンドルが確保中のアイテムを指しているかチェックします.
+    //!
+    //! @param[in]      handle      チェックするハンドルです.
+    //! @retval true    有効です.
+    //! @retval false   無効なハンドルか, アイテムが解放済みです.
+    //--------------------------------------------------------------------------------------------
+    template<typename U>
+    bool IsValid(Handle<T, U> handle) const
+    {
+        auto index = handle.GetIndex();
+        if (handle.IsNull() || index >= m_Capacity)
+        { return false; }
+
+        auto generation = m_pGeneration[index].load(std::memory_order_acquire);
+        return ((generation & 1) != 0) && (generation & Handle<T, U>::kGenerationMask) == handle.GetGeneration();
+    }
+
+    //--------------------------------------------------------------------------------------------
+    //! @brief      ハンドルからアイテムを取得します.
+    //!
+    //! @details    検証した時点で確保中であることのみ保証します. 他のスレッドが解放する可能性がある場合は,
+    //!             フレームの境界などで寿命を保証してください.
+    //! @param[in]      handle      ハンドルです.
+    //! @return     アイテムへのポインタを返却します. 無効なハンドルの場合は nullptr を返却します.
+    //--------------------------------------------------------------------------------------------
+    template<typename U>
+    T* Resolve(Handle<T, U> handle) const
+    {
+        if (!IsValid(handle))
+        { return nullptr; }
+
+        return reinterpret_cast<T*>(m_pBuffer + sizeof(T) * handle.GetIndex());
+    }
+
+    //--------------------------------------------------------------------------------------------
+    //! @brief      総アイテム数を取得します.
+    //!
+    //! @return     総アイテム数を返却します.
+    //--------------------------------------------------------------------------------------------
+    uint32_t GetSize() const
+    { return m_Capacity; }
+
+    //--------------------------------------------------------------------------------------------
+    //! @brief      使用中のアイテム数を取得します.
+    //!
+    //! @return     使用中のアイテム数を返却します. 他のスレッドが確保中の場合は近似値です.
+    //--------------------------------------------------------------------------------------------
+    uint32_t GetUsedCount() const
+    {
+        // 共有のスタックから取り出した数から, マガジンに残っている数を除く.
+        auto count = int64_t(m_Count.load(std::memory_order_relaxed));
+        if (m_pMagazines != nullptr)
+        {
+            for(auto i=0u; i<kMaxThreadSlot; ++i)
+            { count -= m_pMagazines[i].Count.load(std::memory_order_relaxed); }
+        }
+        return (count > 0) ? uint32_t(count) : 0;
+    }
+
+    //--------------------------------------------------------------------------------------------
+    //! @brief      利用可能なアイテム数を取得します.
+    //!
+    //! @return     利用可能なアイテム数を返却します. 他のスレッドが確保中の場合は近似値です.
+    //--------------------------------------------------------------------------------------------
+    uint32_t GetAvailableCount() const
+    { return m_Capacity - GetUsedCount(); }
+
+    //--------------------------------------------------------------------------------------------
+    //! @brief      全スレッドのマガジンが保持しうるアイテム数の上限を取得します.
+    //!
+    //! @details    この数だけ共有のスタックから取り出されていても確保に失敗しないように,
+    //!             スレッドキャッシュは十分に大きいプールでのみ有効にしてください.
+    //! @return     保持しうるアイテム数の上限を返却します.
+    //--------------------------------------------------------------------------------------------
+    static uint32_t GetMaxCachedCount()
+    { return kMaxThreadSlot * kMagazineSize; }
+
+private:
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    static const uint32_t kInvalidIndex  = UINT32_MAX;          //!< 無効なインデックスです.
+    static const size_t   kCacheLine     = 64;                  //!< キャッシュラインのサイズです.
+    static const uint32_t kMagazineSize  = 32;                  //!< 1スレッドが保持するインデックスの最大数です.
+    static const uint32_t kMagazineBatch = kMagazineSize / 2;   //!< 共有のスタックとまとめてやり取りする数です.
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Magazine structure
+    // 1スレッドだけが更新し, Count は GetUsedCount() のために他のスレッドからも読み取ります.
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct Magazine
+    {
+        std::atomic<uint32_t>   Count;                      //!< 保持しているインデックス数です.
+        uint32_t                Indices[kMagazineSize];     //!< 保持しているインデックスです.
+        uint8_t                 Padding[kCacheLine - (sizeof(uint32_t) * (kMagazineSize + 1)) % kCacheLine];
+
+        Magazine()
+        : Count(0)
+        { /* DO_NOTHING */ }
+    };
+
+    // 先頭とカウンタは全スレッドが更新するので, 別のキャッシュラインに置く.
+    std::atomic<uint64_t>   m_Head;                                         //!< 上位32bitがタグ, 下位32bitが空きアイテムの先頭インデックスです.
+    uint8_t                 m_Pad0[kCacheLine - sizeof(uint64_t)];          //!< パディングです.
+    std::atomic<uint32_t>   m_Count;                                        //!< 確保したアイテム数です.
+    uint8_t                 m_Pad1[kCacheLine - sizeof(uint32_t)];          //!< パディングです.
+    uint8_t*                m_pBuffer;                                      //!< 値のバッファです.
+    std::atomic<uint32_t>*  m_pNext;                                        //!< 空きアイテムの次のインデックスです.
+    std::atomic<uint32_t>*  m_pGeneration;                                  //!< アイテムの世代番号です. 奇数が確保中です.
+    uint8_t*                m_pMagazineBuffer;                              //!< マガジンのバッファです.
+    Magazine*               m_pMagazines;                                   //!< スレッドスロットごとのマガジンです.
+    uint32_t                m_Capacity;                                     //!< 総アイテム数です.
+
+    //=============================================================================================
+    // private methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      タグとインデックスから先頭の値を生成します.
+    //---------------------------------------------------------------------------------------------
+    static uint64_t MakeHead(uint32_t tag, uint32_t index)
+    { return (uint64_t(tag) << 32) | index; }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      空きアイテムを取り出します. 空の場合は kInvalidIndex を返却します.
+    //---------------------------------------------------------------------------------------------
+    uint32_t Pop()
+    {
+        auto head = m_Head.load(std::memory_order_acquire);
+        for(;;)
+        {
+            auto index = uint32_t(head);
+            if (index == kInvalidIndex)
+            { return kInvalidIndex; }
+
+            // 他のスレッドが先に取り出して next を書き換えていてもタグが変わるのでCASが失敗する.
+            auto next = m_pNext[index].load(std::memory_order_relaxed);
+            auto tag  = uint32_t(head >> 32) + 1;
+            if (m_Head.compare_exchange_weak(head, MakeHead(tag, next), std::memory_order_acquire, std::memory_order_acquire))
+            { return index; }
+        }
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      空きアイテムを最大 count 個まとめて取り出し, 取り出した数を返却します.
+    //---------------------------------------------------------------------------------------------
+    uint32_t PopBatch(uint32_t* pIndices, uint32_t count)
+    {
+        auto head = m_Head.load(std::memory_order_acquire);
+        for(;;)
+        {
+            auto index = uint32_t(head);
+            if (index == kInvalidIndex)
+            { return 0; }
+
+            // 途中で他のスレッドが更新した場合は, 辿った連結が壊れていてもCASが失敗する.
+            auto n = 0u;
+            while(n < count && index != kInvalidIndex)
+            {
+                pIndices[n++] = index;
+                index = m_pNext[index].load(std::memory_order_relaxed);
+            }
+
+            auto tag = uint32_t(head >> 32) + 1;
+            if (m_Head.compare_exchange_weak(head, MakeHead(tag, index), std::memory_order_acquire, std::memory_order_acquire))
+            {
+                m_Count.fetch_add(n, std::memory_order_relaxed);
+                return n;
+            }
+        }
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      空きアイテムを count 個まとめて戻します.
+    //---------------------------------------------------------------------------------------------
+    void PushBatch(const uint32_t* pIndices, uint32_t count)
+    {
+        if (count == 0)
+        { return; }
+
+        for(auto i=0u; i + 1<count; ++i)
+        { m_pNext[pIndices[i]].store(pIndices[i + 1], std::memory_order_relaxed); }
+
+        m_Count.fetch_sub(count, std::memory_order_relaxed);
+
+        auto last = pIndices[count - 1];
+        auto head = m_Head.load(std::memory_order_relaxed);
+        for(;;)
+        {
+            m_pNext[last].store(uint32_t(head), std::memory_order_relaxed);
+            auto tag = uint32_t(head >> 32) + 1;
+            if (m_Head.compare_exchange_weak(head, MakeHead(tag, pIndices[0]), std::memory_order_release, std::memory_order_relaxed))
+            { return; }
+        }
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      呼び出したスレッドのマガジンを取得します. 使用しない場合は nullptr を返却します.
+    //---------------------------------------------------------------------------------------------
+    Magazine* GetMagazine()
+    {
+        if (m_pMagazines == nullptr)
+        { return nullptr; }
+
+        auto slot = GetThreadSlot();
+        return (slot != kInvalidThreadSlot) ? &m_pMagazines[slot] : nullptr;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      終了したスレッドのマガジンを共有のスタックへ戻します.
+    //---------------------------------------------------------------------------------------------
+    static void DrainMagazine(void* pContext, uint32_t slot)
+    {
+        auto pThis     = static_cast<LockFreePoolContainer*>(pContext);
+        auto pMagazine = &pThis->m_pMagazines[slot];
+        pThis->PushBatch(pMagazine->Indices, pMagazine->Count.load(std::memory_order_relaxed));
+        pMagazine->Count.store(0, std::memory_order_relaxed);
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      空きアイテムを戻します.
+    //---------------------------------------------------------------------------------------------
+    void Push(uint32_t index)
+    {
+        auto head = m_Head.load(std::memory_order_relaxed);
+        for(;;)
+        {
+            m_pNext[index].store(uint32_t(head), std::memory_order_relaxed);
+            auto tag = uint32_t(head >> 32) + 1;
+            if (m_Head.compare_exchange_weak(head, MakeHead(tag, index), std::memory_order_release, std::memory_order_relaxed))
+            { return; }
+        }
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      アイテムのメモリを取得します.
+    //!
+    //! @param[in]      index       取得するアイテムのインデックス.
+    //! @return     アイテムのメモリへのポインタを返却します.
+    //---------------------------------------------------------------------------------------------
+    void* GetItem(uint32_t index)
+    {
+        assert(index < m_Capacity);
+        return m_pBuffer + sizeof(T) * index;
+    }
+
+    LockFreePoolContainer(const LockFreePoolContainer&) = delete;
+    void operator =      (const LockFreePoolContainer&) = delete;
+};
+
+} // namespace asdx
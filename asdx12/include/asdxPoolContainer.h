@@ -12,12 +12,17 @@
 #include <mutex>
 #include <cstdlib>
 #include <cassert>
+#include <functional>
+#include <new>
+#include <vector>
 
 
 namespace asdx {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // PoolContainer class
+// アイテムはページ単位で確保します. Init() は1ページに全アイテムを確保し, InitPaged() は
+// 空きがなくなった時点でページを追加します. アイテムのアドレスとインデックスは解放するまで変わりません.
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename T>
 class PoolContainer
@@ -36,11 +41,14 @@ public:
     //! @brief      コンストラクタです.
     //---------------------------------------------------------------------------------------------
     PoolContainer()
-    : m_pBuffer (nullptr)
-    , m_pActive (nullptr)
-    , m_pFree   (nullptr)
-    , m_Capacity(0)
-    , m_Count   (0)
+    : m_pSentinel       (nullptr)
+    , m_pActive         (nullptr)
+    , m_pFree           (nullptr)
+    , m_PageSize        (0)
+    , m_MaxPageCount    (0)
+    , m_ReleaseEmptyPage(false)
+    , m_Capacity        (0)
+    , m_Count           (0)
     { /* DO_NOTHING */ }
 
     //---------------------------------------------------------------------------------------------
@@ -57,40 +65,58 @@ public:
     //! @retval false   初期化に失敗.
     //---------------------------------------------------------------------------------------------
     bool Init(uint32_t count)
+    {
+        // 0個の場合も初期化に成功し, 確保は常に失敗する.
+        return (count > 0) ? InitPaged(count, 1, false) : InitPaged(1, 0, false);
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ページ単位で拡張する初期化処理を行います.
+    //!
+    //! @details    最初のページのみ確保し, 空きがなくなると maxPageCount までページを追加します.
+    //!             インデックスは (ページ番号 * pageSize + ページ内の位置) で, 追加したページは既存の
+    //!             アイテムを移動しません.
+    //! @param[in]      pageSize            1ページのアイテム数です.
+    //! @param[in]      maxPageCount        最大ページ数です. 0 の場合はアイテムを持たないプールになります.
+    //! @param[in]      releaseEmptyPage    空になったページを解放する場合は true を指定します.
+    //!                                     他のページに1ページ分以上の空きがある場合のみ解放します.
+    //! @retval true    初期化に成功.
+    //! @retval false   初期化に失敗.
+    //---------------------------------------------------------------------------------------------
+    bool InitPaged(uint32_t pageSize, uint32_t maxPageCount, bool releaseEmptyPage = false)
     {
         std::lock_guard<std::mutex> guard(m_Mutex);
 
-        m_pBuffer = static_cast<uint8_t*>(malloc(sizeof(Item) * (count + 2)));
-        if ( m_pBuffer == nullptr )
+        if (pageSize == 0 || uint64_t(pageSize) * maxPageCount > UINT32_MAX)
         { return false; }
 
-        m_Capacity = count;
-
-        // インデックスを振る.
-        for(auto i=2u, j=0u; i<m_Capacity + 2; ++i, ++j)
-        {
-            auto item = GetItem(i);
-            item->m_Index = j;
-        }
+        m_pSentinel = static_cast<uint8_t*>(malloc(sizeof(Item) * 2));
+        if ( m_pSentinel == nullptr )
+        { return false; }
 
-        m_pActive = GetItem(0);
+        m_pActive = reinterpret_cast<Item*>(m_pSentinel);
         m_pActive->m_pPrev = m_pActive->m_pNext = m_pActive;
         m_pActive->m_Index = uint32_t(-1);
 
-        m_pFree = GetItem(1);
+        m_pFree = reinterpret_cast<Item*>(m_pSentinel + sizeof(Item));
+        m_pFree->m_pPrev = m_pFree->m_pNext = m_pFree;
         m_pFree->m_Index = uint32_t(-2);
 
-        for(auto i=1u; i<m_Capacity + 2; ++i)
+        m_PageSize          = pageSize;
+        m_MaxPageCount      = maxPageCount;
+        m_ReleaseEmptyPage  = releaseEmptyPage;
+        m_Capacity          = 0;
+        m_Count             = 0;
+
+        if (maxPageCount > 0 && !AddPage())
         {
-            GetItem(i)->m_pPrev = nullptr;
-            GetItem(i)->m_pNext = GetItem( i + 1 );
+            free(m_pSentinel);
+            m_pSentinel = nullptr;
+            m_pActive   = nullptr;
+            m_pFree     = nullptr;
+            return false;
         }
 
-        GetItem( m_Capacity + 1 )->m_pPrev = m_pFree;
-
-
-        m_Count = 0;
-
         return true;
     }
 
@@ -101,10 +127,17 @@ public:
     {
         std::lock_guard<std::mutex> guard(m_Mutex);
 
-        if ( m_pBuffer )
+        for(auto& page : m_Pages)
         {
-            free(m_pBuffer);
-            m_pBuffer = nullptr;
+            if ( page.pBuffer )
+            { free(page.pBuffer); }
+        }
+        m_Pages.clear();
+
+        if ( m_pSentinel )
+        {
+            free(m_pSentinel);
+            m_pSentinel = nullptr;
         }
 
         m_pActive   = nullptr;
@@ -123,16 +156,17 @@ public:
     {
         std::lock_guard<std::mutex> guard(m_Mutex);
 
-        if ( m_pFree->m_pNext == m_pFree || m_Count + 1 > m_Capacity )
+        if ( m_pFree == nullptr )
         { return nullptr; }
 
-        auto item = m_pFree->m_pNext;
-        m_pFree->m_pNext = item->m_pNext;
+        if ( m_pFree->m_pNext == m_pFree && !AddPage() )
+        { return nullptr; }
 
-        item->m_pPrev = m_pActive->m_pPrev;
-        item->m_pNext = m_pActive;
-        item->m_pPrev->m_pNext = item->m_pNext->m_pPrev = item;
+        auto item = m_pFree->m_pNext;
+        Unlink(item);
+        LinkBefore(m_pActive, item);
 
+        m_Pages[item->m_Index / m_PageSize].Used++;
         m_Count++;
 
         // メモリ割り当て.
@@ -159,17 +193,21 @@ public:
 
         auto item = reinterpret_cast<Item*>(pValue);
 
-        item->m_pPrev->m_pNext = item->m_pNext;
-        item->m_pNext->m_pPrev = item->m_pPrev;
-
-        item->m_pPrev = nullptr;
-        item->m_pNext = m_pFree->m_pNext;
-        m_pFree->m_pNext = item;
+        Unlink(item);
+        LinkBefore(m_pFree->m_pNext, item);
         m_Count--;
+
+        auto pageIndex = item->m_Index / m_PageSize;
+        auto& page = m_Pages[pageIndex];
+        page.Used--;
+
+        // 解放したページ以外に1ページ分以上の空きが残る場合のみ解放し, 境界での確保と解放の繰り返しを防ぐ.
+        if ( m_ReleaseEmptyPage && page.Used == 0 && m_Capacity - m_Count >= 2 * m_PageSize )
+        { ReleasePage(pageIndex); }
     }
 
     //--------------------------------------------------------------------------------------------
-    //! @brief      総アイテム数を取得します.
+    //! @brief      総アイテム数を取得します. ページ単位で拡張する場合は確保済みのページの合計です.
     //!
     //! @return     総アイテム数を返却します.
     //--------------------------------------------------------------------------------------------
@@ -217,40 +255,109 @@ private:
     //=============================================================================================
     // private variables.
     //=============================================================================================
-    uint8_t*    m_pBuffer;      //!< バッファです.
-    Item*       m_pActive;      //!< アクティブアイテムの先頭です.
-    Item*       m_pFree;        //!< フリーアイテムの先頭です.
-    uint32_t    m_Capacity;     //!< 総アイテム数です.
-    uint32_t    m_Count;        //!< 確保したアイテム数です.
-    std::mutex  m_Mutex;        //!< ミューテックスです.
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Page structure
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct Page
+    {
+        uint8_t*    pBuffer;        //!< アイテムのバッファです. 解放済みの場合は nullptr です.
+        uint32_t    Used;           //!< 確保したアイテム数です.
+    };
+
+    uint8_t*            m_pSentinel;        //!< 番兵アイテムのバッファです.
+    Item*               m_pActive;          //!< アクティブアイテムの先頭です.
+    Item*               m_pFree;            //!< フリーアイテムの先頭です.
+    std::vector<Page>   m_Pages;            //!< ページです. 要素の番号がページ番号です.
+    uint32_t            m_PageSize;         //!< 1ページのアイテム数です.
+    uint32_t            m_MaxPageCount;     //!< 最大ページ数です.
+    bool                m_ReleaseEmptyPage; //!< 空になったページを解放するかどうか.
+    uint32_t            m_Capacity;         //!< 総アイテム数です.
+    uint32_t            m_Count;            //!< 確保したアイテム数です.
+    std::mutex          m_Mutex;            //!< ミューテックスです.
 
     //=============================================================================================
     // private methods.
     //=============================================================================================
 
     //---------------------------------------------------------------------------------------------
-    //! @brief      アイテムを取得します.
+    //! @brief      アイテムをリストから外します.
+    //---------------------------------------------------------------------------------------------
+    static void Unlink(Item* item)
+    {
+        item->m_pPrev->m_pNext = item->m_pNext;
+        item->m_pNext->m_pPrev = item->m_pPrev;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      アイテムを next の前に挿入します.
+    //---------------------------------------------------------------------------------------------
+    static void LinkBefore(Item* next, Item* item)
+    {
+        item->m_pPrev = next->m_pPrev;
+        item->m_pNext = next;
+        item->m_pPrev->m_pNext = item->m_pNext->m_pPrev = item;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ページを追加し, アイテムをフリーリストに繋ぎます.
     //!
-    //! @param[in]      index       取得するアイテムのインデックス.
-    //! @return     アイテムへのポインタを返却します.
+    //! @details    解放済みのページ番号があれば再利用し, インデックスの範囲が広がらないようにします.
+    //! @retval true    追加に成功.
+    //! @retval false   最大ページ数に達しているか, メモリの確保に失敗.
     //---------------------------------------------------------------------------------------------
-    Item* GetItem( uint32_t index )
+    bool AddPage()
     {
-        assert( 0 <= index && index <= m_Capacity + 2 );
-        return reinterpret_cast<Item*>( m_pBuffer + sizeof(Item) * index );
+        auto pageIndex = uint32_t(m_Pages.size());
+        for(auto i=0u; i<m_Pages.size(); ++i)
+        {
+            if (m_Pages[i].pBuffer == nullptr)
+            {
+                pageIndex = i;
+                break;
+            }
+        }
+
+        if (pageIndex >= m_MaxPageCount)
+        { return false; }
+
+        auto buffer = static_cast<uint8_t*>(malloc(sizeof(Item) * m_PageSize));
+        if ( buffer == nullptr )
+        { return false; }
+
+        if (pageIndex == m_Pages.size())
+        { m_Pages.push_back(Page()); }
+
+        m_Pages[pageIndex].pBuffer = buffer;
+        m_Pages[pageIndex].Used    = 0;
+
+        // インデックス順に取り出されるように末尾へ繋ぐ.
+        for(auto i=0u; i<m_PageSize; ++i)
+        {
+            auto item = reinterpret_cast<Item*>(buffer + sizeof(Item) * i);
+            item->m_Index = pageIndex * m_PageSize + i;
+            LinkBefore(m_pFree, item);
+        }
+
+        m_Capacity += m_PageSize;
+        return true;
     }
 
     //---------------------------------------------------------------------------------------------
-    //! @brief      アイテムにメモリを割り当てます.
+    //! @brief      空のページを解放します.
     //!
-    //! @param[in]      index       取得するアイテムのインデックス.
-    //! @return     アイテムへのポインタを返却します.
+    //! @param[in]      pageIndex       解放するページ番号です.
     //---------------------------------------------------------------------------------------------
-    Item* AssignItem( uint32_t index )
+    void ReleasePage(uint32_t pageIndex)
     {
-        assert( 0 <= index && index <= m_Capacity + 2 );
-        auto buf = (m_pBuffer + sizeof(Item) * index);
-        return new (buf) Item;
+        auto& page = m_Pages[pageIndex];
+        assert(page.pBuffer != nullptr && page.Used == 0);
+
+        for(auto i=0u; i<m_PageSize; ++i)
+        { Unlink(reinterpret_cast<Item*>(page.pBuffer + sizeof(Item) * i)); }
+
+        free(page.pBuffer);
+        page.pBuffer = nullptr;
+        m_Capacity -= m_PageSize;
     }
 
     PoolContainer   (const PoolContainer&) = delete;
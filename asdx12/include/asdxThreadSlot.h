@@ -0,0 +1,71 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxThreadSlot.h
+// Desc : Thread Slot.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <cstdint>
+
+
+namespace asdx {
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values.
+//-------------------------------------------------------------------------------------------------
+constexpr uint32_t kMaxThreadSlot     = 64;             //!< スレッドスロットの最大数です.
+constexpr uint32_t kInvalidThreadSlot = UINT32_MAX;     //!< スロットを割り当てられなかったことを示す値です.
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      スレッド終了時にスロットのキャッシュを戻す関数です.
+//!
+//! @param[in]      pContext        登録時に指定したコンテキストです.
+//! @param[in]      slot            終了するスレッドのスロット番号です.
+//-------------------------------------------------------------------------------------------------
+using ThreadCacheDrainFunc = void (*)(void* pContext, uint32_t slot);
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      スレッドスロットを割り当てます.
+//!
+//! @details    GetThreadSlot() から初回のみ呼び出されます.
+//! @return     スロット番号を返却します. 空きがない場合は kInvalidThreadSlot を返却します.
+//-------------------------------------------------------------------------------------------------
+uint32_t AcquireThreadSlot();
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      呼び出したスレッドのスロット番号を取得します.
+//!
+//! @details    スロット番号は 0 から kMaxThreadSlot - 1 までの値で, 生存中のスレッド間で重複しません.
+//!             スレッドが終了すると, 登録済みの全キャッシュを戻してから番号を再利用します.
+//! @return     スロット番号を返却します. 空きがない場合は kInvalidThreadSlot を返却します.
+//-------------------------------------------------------------------------------------------------
+inline uint32_t GetThreadSlot()
+{
+    // 未割り当てを kInvalidThreadSlot - 1 で表し, 割り当てに失敗したスレッドは再試行しない.
+    static thread_local uint32_t s_Slot = kInvalidThreadSlot - 1;
+    if (s_Slot == kInvalidThreadSlot - 1)
+    { s_Slot = AcquireThreadSlot(); }
+
+    return s_Slot;
+}
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      スレッドごとのキャッシュを登録します.
+//!
+//! @param[in]      pContext        コンテキストです. 登録を解除する際のキーになります.
+//! @param[in]      func            スレッド終了時に呼び出す関数です.
+//-------------------------------------------------------------------------------------------------
+void RegisterThreadCache(void* pContext, ThreadCacheDrainFunc func);
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      スレッドごとのキャッシュの登録を解除します.
+//!
+//! @details    解除後は func が呼び出されないことを保証します.
+//! @param[in]      pContext        登録時に指定したコンテキストです.
+//-------------------------------------------------------------------------------------------------
+void UnregisterThreadCache(void* pContext);
+
+} // namespace asdx
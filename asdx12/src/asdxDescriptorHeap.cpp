@@ -8,6 +8,7 @@
 // Includes
 //-------------------------------------------------------------------------------------------------
 #include <asdxDescriptorHeap.h>
+#include <asdxLogger.h>
 
 
 namespace asdx {
@@ -100,6 +101,14 @@ bool DescriptorHeap::Init(ID3D12Device* pDevice, const D3D12_DESCRIPTOR_HEAP_DES
     if (pDesc->NumDescriptors == 0)
     { return true; }
 
+    // DescriptorHandle のインデックスで表せない位置は別のディスクリプタと区別できなくなる.
+    if (pDesc->NumDescriptors - 1 > DescriptorHandle::kIndexMask)
+    {
+        ELOG("Error : NumDescriptors = %u exceeds DescriptorHandle limit %u.",
+            pDesc->NumDescriptors, uint32_t(DescriptorHandle::kIndexMask + 1));
+        return false;
+    }
+
     auto hr = pDevice->CreateDescriptorHeap(pDesc, IID_PPV_ARGS(m_pHeap.GetAddress()));
     if ( FAILED(hr) )
     { return false; }
@@ -107,7 +116,10 @@ bool DescriptorHeap::Init(ID3D12Device* pDevice, const D3D12_DESCRIPTOR_HEAP_DES
     // インクリメントサイズを取得.
     m_IncrementSize = pDevice->GetDescriptorHandleIncrementSize(pDesc->Type);
 
-    if (!m_Pool.Init(pDesc->NumDescriptors))
+    // マガジンに保持される分が全体の半分以下になる場合のみスレッドキャッシュを使う.
+    auto useThreadCache = (pDesc->NumDescriptors >= 2 * LockFreePoolContainer<Descriptor>::GetMaxCachedCount());
+
+    if (!m_Pool.Init(pDesc->NumDescriptors, useThreadCache))
     { return false; }
 
     return true;
@@ -154,6 +166,18 @@ Descriptor* DescriptorHeap::CreateDescriptor()
     return m_Pool.Alloc(initializer);
 }
 
+//-------------------------------------------------------------------------------------------------
+//      ディスクリプタのハンドルを取得します.
+//-------------------------------------------------------------------------------------------------
+DescriptorHandle DescriptorHeap::GetHandle(const Descriptor* pDescriptor) const
+{ return m_Pool.GetHandle(pDescriptor); }
+
+//-------------------------------------------------------------------------------------------------
+//      ハンドルからディスクリプタを取得します.
+//-------------------------------------------------------------------------------------------------
+Descriptor* DescriptorHeap::Resolve(DescriptorHandle handle) const
+{ return m_Pool.Resolve(handle); }
+
 //-------------------------------------------------------------------------------------------------
 //      ディスクリプタを破棄します.
 //-------------------------------------------------------------------------------------------------
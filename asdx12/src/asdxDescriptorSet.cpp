@@ -206,6 +206,7 @@ bool DescriptorSet::Init(ID3D12Device* pDevice, const DescriptorLayout& layout)
     if (pDevice == nullptr)
     { return false; }
 
+    m_Tables.Reserve(uint32_t(layout.m_Param.size()));
     for(size_t i=0; i<layout.m_Param.size(); ++i)
     { m_Tables[layout.m_Hash[i]].Index = uint32_t(i); }
 
@@ -246,7 +247,7 @@ bool DescriptorSet::Init(ID3D12Device* pDevice, const DescriptorLayout& layout)
 //-------------------------------------------------------------------------------------------------
 void DescriptorSet::Term()
 {
-    m_Tables.clear();
+    m_Tables.Clear();
     m_pRootSignature.Reset();
 }
 
@@ -256,10 +257,11 @@ void DescriptorSet::Term()
 bool DescriptorSet::SetCBV(ShaderStage stage, uint32_t reg, D3D12_GPU_DESCRIPTOR_HANDLE handle)
 {
     auto hash = CalcHash(stage, kTypeCBV, reg);
-    if (m_Tables.find(hash) == m_Tables.end())
+    auto table = m_Tables.Find(hash);
+    if (table == nullptr)
     { return false; }
 
-    m_Tables[hash].Handle = handle;
+    table->Handle = handle;
     return true;
 }
 
@@ -269,10 +271,11 @@ bool DescriptorSet::SetCBV(ShaderStage stage, uint32_t reg, D3D12_GPU_DESCRIPTOR
 bool DescriptorSet::SetSRV(ShaderStage stage, uint32_t reg, D3D12_GPU_DESCRIPTOR_HANDLE handle)
 {
     auto hash = CalcHash(stage, kTypeSRV, reg);
-    if (m_Tables.find(hash) == m_Tables.end())
+    auto table = m_Tables.Find(hash);
+    if (table == nullptr)
     { return false; }
 
-    m_Tables[hash].Handle = handle;
+    table->Handle = handle;
     return true;
 }
 
@@ -282,10 +285,11 @@ bool DescriptorSet::SetSRV(ShaderStage stage, uint32_t reg, D3D12_GPU_DESCRIPTOR
 bool DescriptorSet::SetUAV(ShaderStage stage, uint32_t reg, D3D12_GPU_DESCRIPTOR_HANDLE handle)
 {
     auto hash = CalcHash(stage, kTypeUAV, reg);
-    if (m_Tables.find(hash) == m_Tables.end())
+    auto table = m_Tables.Find(hash);
+    if (table == nullptr)
     { return false; }
 
-    m_Tables[hash].Handle = handle;
+    table->Handle = handle;
     return true;
 }
 
@@ -295,10 +299,11 @@ bool DescriptorSet::SetUAV(ShaderStage stage, uint32_t reg, D3D12_GPU_DESCRIPTOR
 bool DescriptorSet::SetSmp(ShaderStage stage, uint32_t reg, D3D12_GPU_DESCRIPTOR_HANDLE handle)
 {
     auto hash = CalcHash(stage, kTypeSmp, reg);
-    if (m_Tables.find(hash) == m_Tables.end())
+    auto table = m_Tables.Find(hash);
+    if (table == nullptr)
     { return false; }
 
-    m_Tables[hash].Handle = handle;
+    table->Handle = handle;
     return true;
 }
 
@@ -307,8 +312,8 @@ bool DescriptorSet::SetSmp(ShaderStage stage, uint32_t reg, D3D12_GPU_DESCRIPTOR
 //-------------------------------------------------------------------------------------------------
 void DescriptorSet::MakeCommand(ID3D12GraphicsCommandList* pCmdList) const
 {
-    for(auto& item : m_Tables)
-    { pCmdList->SetGraphicsRootDescriptorTable(item.second.Index, item.second.Handle); }
+    m_Tables.ForEach([pCmdList](uint32_t, const Table& table)
+    { pCmdList->SetGraphicsRootDescriptorTable(table.Index, table.Handle); });
 
     pCmdList->SetGraphicsRootSignature(m_pRootSignature.GetPtr());
 }
@@ -114,6 +114,13 @@ bool DeviceContext::Init(const DeviceContextDesc& desc)
     if (!m_Queue[2].Init(m_pDevice.GetPtr(), D3D12_COMMAND_LIST_TYPE_COPY, desc.MaxSubmitCountCopy))
     { return false; }
 
+    if (desc.FrameArenaSize > 0)
+    {
+        auto frameCount = (desc.FrameCount > 0) ? desc.FrameCount : 2;
+        if (!m_FrameArena.Init(frameCount, desc.FrameArenaSize))
+        { return false; }
+    }
+
     m_Desc = desc;
 
     return true;
@@ -132,6 +139,8 @@ void DeviceContext::Term()
     for(auto i=0; i<4; ++i)
     { m_DescriptorHeap[i].Term(); }
 
+    m_FrameArena.Term();
+
     auto itr = m_Disposer.begin();
     while(itr != m_Disposer.end())
     {
@@ -191,6 +200,9 @@ void DeviceContext::NextFrame()
             itr++;
         }
     }
+
+    // フレームアリーナの最も古いフレームの領域を再利用する.
+    m_FrameArena.NextFrame();
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -250,4 +262,10 @@ DescriptorHeap* DeviceContext::GetDescriptorHeap(uint32_t index)
     return &m_DescriptorHeap[index];
 }
 
+//-------------------------------------------------------------------------------------------------
+//      フレームアリーナを取得します.
+//-------------------------------------------------------------------------------------------------
+FrameArena* DeviceContext::GetFrameArena()
+{ return &m_FrameArena; }
+
 } // namespace asdx
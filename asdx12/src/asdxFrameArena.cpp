@@ -0,0 +1,238 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxFrameArena.cpp
+// Desc : Per-Frame Linear Allocator.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxFrameArena.h>
+#include <asdxThreadSlot.h>
+#include <cstdlib>
+#include <cstring>
+#include <cassert>
+
+
+namespace {
+
+//------------------------------------------------------------------------------------------------
+// Constant Values.
+//------------------------------------------------------------------------------------------------
+constexpr size_t  kCacheLine    = 64;           // キャッシュラインのサイズです.
+constexpr size_t  kMaxBlockSize = 16 * 1024;    // サブアリーナが一度に取り出す最大バイト数です.
+constexpr uint8_t kPoisonValue  = 0xCD;         // 再利用する領域を埋める値です.
+
+//-------------------------------------------------------------------------------------------------
+//      値を切り上げます.
+//-------------------------------------------------------------------------------------------------
+inline size_t AlignUp(size_t value, size_t alignment)
+{ return (value + alignment - 1) & ~(alignment - 1); }
+
+} // namespace
+
+
+namespace asdx {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// FrameArena class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------------
+FrameArena::FrameArena()
+: m_Offset          (0)
+, m_Epoch           (0)
+, m_pBuffer         (nullptr)
+, m_pFrame          (nullptr)
+, m_pSubArenaBuffer (nullptr)
+, m_pSubArenas      (nullptr)
+, m_FrameSize       (0)
+, m_BlockSize       (0)
+, m_FrameCount      (0)
+, m_FrameIndex      (0)
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------------
+FrameArena::~FrameArena()
+{ Term(); }
+
+//-------------------------------------------------------------------------------------------------
+//      初期化処理を行います.
+//-------------------------------------------------------------------------------------------------
+bool FrameArena::Init(uint32_t frameCount, size_t frameSize)
+{
+    if (frameCount == 0 || frameSize == 0)
+    { return false; }
+
+    // 各フレームの先頭がキャッシュラインに揃うようにする.
+    m_FrameSize  = AlignUp(frameSize, kCacheLine);
+    m_FrameCount = frameCount;
+
+    m_pBuffer = static_cast<uint8_t*>(malloc(m_FrameSize * m_FrameCount + kCacheLine));
+    m_pSubArenaBuffer = static_cast<uint8_t*>(malloc(sizeof(SubArena) * kMaxThreadSlot + kCacheLine));
+    if (m_pBuffer == nullptr || m_pSubArenaBuffer == nullptr)
+    {
+        Term();
+        return false;
+    }
+
+    m_pSubArenas = reinterpret_cast<SubArena*>(AlignUp(reinterpret_cast<uintptr_t>(m_pSubArenaBuffer), kCacheLine));
+    memset(m_pSubArenas, 0, sizeof(SubArena) * kMaxThreadSlot);
+
+    // 全スレッドがブロックを取り出しても1フレームの半分に収まる大きさにする.
+    m_BlockSize = m_FrameSize / (kMaxThreadSlot * 2);
+    m_BlockSize = (m_BlockSize < kMaxBlockSize) ? m_BlockSize : kMaxBlockSize;
+    m_BlockSize = m_BlockSize & ~(kCacheLine - 1);
+
+    m_FrameIndex = 0;
+    m_pFrame     = reinterpret_cast<uint8_t*>(AlignUp(reinterpret_cast<uintptr_t>(m_pBuffer), kCacheLine));
+    m_Offset.store(0, std::memory_order_relaxed);
+
+    // サブアリーナの通し番号は0で初期化しているので, 1から始めて最初の確保でブロックを取り出させる.
+    m_Epoch.store(1, std::memory_order_release);
+
+#if defined(DEBUG) || defined(_DEBUG)
+    memset(m_pFrame, kPoisonValue, m_FrameSize * m_FrameCount);
+#endif
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      終了処理を行います.
+//-------------------------------------------------------------------------------------------------
+void FrameArena::Term()
+{
+    if (m_pBuffer != nullptr)
+    {
+        free(m_pBuffer);
+        m_pBuffer = nullptr;
+    }
+
+    if (m_pSubArenaBuffer != nullptr)
+    {
+        free(m_pSubArenaBuffer);
+        m_pSubArenaBuffer = nullptr;
+    }
+
+    m_pFrame     = nullptr;
+    m_pSubArenas = nullptr;
+    m_FrameSize  = 0;
+    m_BlockSize  = 0;
+    m_FrameCount = 0;
+    m_FrameIndex = 0;
+    m_Offset.store(0, std::memory_order_relaxed);
+    m_Epoch .store(0, std::memory_order_relaxed);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      現在のフレームの領域からメモリを確保します.
+//-------------------------------------------------------------------------------------------------
+void* FrameArena::Alloc(size_t size, size_t alignment)
+{
+    assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+    if (m_pFrame == nullptr)
+    { return nullptr; }
+
+    // ブロックの1/4を超える確保は共有の領域から直接取り出し, ブロックの無駄を抑える.
+    auto slot = GetThreadSlot();
+    if (slot == kInvalidThreadSlot || size + alignment > m_BlockSize / 4)
+    { return AllocShared(size, alignment); }
+
+    auto& sub   = m_pSubArenas[slot];
+    auto  epoch = m_Epoch.load(std::memory_order_relaxed);
+    if (sub.Epoch != epoch)
+    {
+        sub.pCurrent = nullptr;
+        sub.pEnd     = nullptr;
+        sub.Epoch    = epoch;
+    }
+
+    auto ptr = reinterpret_cast<uint8_t*>(AlignUp(reinterpret_cast<uintptr_t>(sub.pCurrent), alignment));
+    if (sub.pCurrent == nullptr || ptr + size > sub.pEnd)
+    {
+        auto block = static_cast<uint8_t*>(AllocShared(m_BlockSize, kCacheLine));
+        if (block == nullptr)
+        { return AllocShared(size, alignment); }
+
+        sub.pEnd = block + m_BlockSize;
+        ptr      = reinterpret_cast<uint8_t*>(AlignUp(reinterpret_cast<uintptr_t>(block), alignment));
+    }
+
+    sub.pCurrent = ptr + size;
+    return ptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      次のフレームに進みます.
+//-------------------------------------------------------------------------------------------------
+void FrameArena::NextFrame()
+{
+    if (m_pFrame == nullptr)
+    { return; }
+
+    m_FrameIndex = (m_FrameIndex + 1) % m_FrameCount;
+    m_pFrame     = reinterpret_cast<uint8_t*>(AlignUp(reinterpret_cast<uintptr_t>(m_pBuffer), kCacheLine)) + m_FrameSize * m_FrameIndex;
+
+#if defined(DEBUG) || defined(_DEBUG)
+    memset(m_pFrame, kPoisonValue, m_FrameSize);
+#endif
+
+    // 通し番号を進めると, 各スレッドは次の確保で古いブロックを捨てる.
+    m_Offset.store(0, std::memory_order_relaxed);
+    m_Epoch .fetch_add(1, std::memory_order_release);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      現在のフレームのリング内の番号を取得します.
+//-------------------------------------------------------------------------------------------------
+uint32_t FrameArena::GetFrameIndex() const
+{ return m_FrameIndex; }
+
+//-------------------------------------------------------------------------------------------------
+//      同時に保持するフレーム数を取得します.
+//-------------------------------------------------------------------------------------------------
+uint32_t FrameArena::GetFrameCount() const
+{ return m_FrameCount; }
+
+//-------------------------------------------------------------------------------------------------
+//      1フレームで確保できるバイト数を取得します.
+//-------------------------------------------------------------------------------------------------
+size_t FrameArena::GetFrameSize() const
+{ return m_FrameSize; }
+
+//-------------------------------------------------------------------------------------------------
+//      現在のフレームで共有の領域から取り出したバイト数を取得します.
+//-------------------------------------------------------------------------------------------------
+size_t FrameArena::GetUsedSize() const
+{
+    auto offset = m_Offset.load(std::memory_order_relaxed);
+    return (offset < m_FrameSize) ? offset : m_FrameSize;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      共有の領域からメモリを確保します.
+//-------------------------------------------------------------------------------------------------
+void* FrameArena::AllocShared(size_t size, size_t alignment)
+{
+    // フレームの先頭はキャッシュラインに揃っているので, それ以下のアライメントはオフセットで揃える.
+    auto base   = reinterpret_cast<uintptr_t>(m_pFrame);
+    auto offset = m_Offset.load(std::memory_order_relaxed);
+    for(;;)
+    {
+        auto begin = AlignUp(base + offset, alignment) - base;
+        auto end   = begin + size;
+        if (end > m_FrameSize || end < begin)
+        { return nullptr; }
+
+        if (m_Offset.compare_exchange_weak(offset, end, std::memory_order_relaxed))
+        { return m_pFrame + begin; }
+    }
+}
+
+} // namespace asdx
@@ -0,0 +1,136 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : asdxThreadSlot.cpp
+// Desc : Thread Slot.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <asdxThreadSlot.h>
+#include <mutex>
+#include <vector>
+
+
+namespace /* anonymous */ {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// CacheEntry structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct CacheEntry
+{
+    void*                       pContext;   //!< コンテキストです.
+    asdx::ThreadCacheDrainFunc  Func;       //!< スレッド終了時に呼び出す関数です.
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Registry structure
+// スロットの使用状況と登録済みのキャッシュです. スレッドの開始と終了時にのみアクセスします.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct Registry
+{
+    std::mutex              Mutex;                          //!< ミューテックスです.
+    bool                    Used[asdx::kMaxThreadSlot];     //!< スロットが使用中かどうか.
+    std::vector<CacheEntry> Caches;                         //!< 登録済みのキャッシュです.
+
+    Registry()
+    : Used()
+    { /* DO_NOTHING */ }
+};
+
+//-------------------------------------------------------------------------------------------------
+//      レジストリを取得します.
+//-------------------------------------------------------------------------------------------------
+Registry& GetRegistry()
+{
+    // スレッドの終了時に参照するため, 破棄しない.
+    static Registry* s_pRegistry = new Registry();
+    return *s_pRegistry;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// SlotGuard structure
+// スレッド終了時にキャッシュを戻してスロットを解放します.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct SlotGuard
+{
+    uint32_t Slot = asdx::kInvalidThreadSlot;   //!< 割り当てたスロット番号です.
+
+    ~SlotGuard()
+    {
+        if (Slot == asdx::kInvalidThreadSlot)
+        { return; }
+
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> guard(registry.Mutex);
+
+        for(auto& entry : registry.Caches)
+        { entry.Func(entry.pContext, Slot); }
+
+        registry.Used[Slot] = false;
+    }
+};
+
+thread_local SlotGuard t_SlotGuard;
+
+} // namespace /* anonymous */
+
+
+namespace asdx {
+
+//-------------------------------------------------------------------------------------------------
+//      スレッドスロットを割り当てます.
+//-------------------------------------------------------------------------------------------------
+uint32_t AcquireThreadSlot()
+{
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.Mutex);
+
+    for(auto i=0u; i<kMaxThreadSlot; ++i)
+    {
+        if (registry.Used[i])
+        { continue; }
+
+        registry.Used[i]   = true;
+        t_SlotGuard.Slot   = i;
+        return i;
+    }
+
+    return kInvalidThreadSlot;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      スレッドごとのキャッシュを登録します.
+//-------------------------------------------------------------------------------------------------
+void RegisterThreadCache(void* pContext, ThreadCacheDrainFunc func)
+{
+    if (pContext == nullptr || func == nullptr)
+    { return; }
+
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.Mutex);
+
+    CacheEntry entry = { pContext, func };
+    registry.Caches.push_back(entry);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      スレッドごとのキャッシュの登録を解除します.
+//-------------------------------------------------------------------------------------------------
+void UnregisterThreadCache(void* pContext)
+{
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.Mutex);
+
+    for(size_t i=0; i<registry.Caches.size(); ++i)
+    {
+        if (registry.Caches[i].pContext != pContext)
+        { continue; }
+
+        registry.Caches[i] = registry.Caches.back();
+        registry.Caches.pop_back();
+        return;
+    }
+}
+
+} // namespace asdx